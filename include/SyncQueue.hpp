@@ -2,63 +2,54 @@
 #define __SYNCQUEUE_HPP
 
 #include <lang/Exception.hpp>
-#include <atomic>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
+#include <util/concurrent/MPMCQueue.hpp>
+#include <type_traits>
 
 class SyncQueueException : extends Exception {
 public:
 	SyncQueueException() : Exception("The SyncQueue has been stopped.") {}
 };
 
+/**
+ * Blocking queue, throwing SyncQueueException once stopped (dequeue: once stopped and empty).
+ * Backed by the bounded lock-free MPMCQueue, enqueue waits while the queue is full.
+ */
 template<class T>
 class SyncQueue {
 private:
-	std::queue<T> queue;
-	std::mutex mutex;
-	std::condition_variable cond;
-	bool running = true;
+	util::concurrent::MPMCQueue<T> queue;
 public:
+	static const unsigned long DEFAULT_CAPACITY = 1024;
+
 	SyncQueue(const SyncQueue& other) = delete;
 	SyncQueue(SyncQueue&& other) = delete;
 	SyncQueue& operator=(const SyncQueue& other) = delete;
 	SyncQueue& operator=(SyncQueue&& other) = delete;
 	virtual ~SyncQueue() = default;
 
-	SyncQueue(){}
+	SyncQueue(unsigned long capacity=DEFAULT_CAPACITY) : queue(capacity) {}
 
 	void stop() {
-		running = false;
-		cond.notify_all();
+		queue.close();
 	}
 
 	bool isEmpty() {
-		std::lock_guard<std::mutex> lock(mutex);
-		return queue.empty();
+		return queue.isEmpty();
 	}
 
-	void enqueue(T& o) {
-		std::unique_lock<std::mutex> lock(mutex);
-		if (!running) throw SyncQueueException();
-		queue.push(o);
-		lock.unlock(); // unlock before notify
-		cond.notify_one();
+	void enqueue(const T& o) {
+		if (!queue.enqueue(o)) throw SyncQueueException();
+	}
+	void enqueue(T&& o) {
+		if (!queue.enqueue(std::move(o))) throw SyncQueueException();
 	}
 
 	T dequeue() {
-		std::unique_lock<std::mutex> lock(mutex);
-		while (queue.empty() && running) {
-			cond.wait(lock);
-		}
-		if (queue.empty()) {
-			// Check for queue empty here, as running could
-			// have been changed after we returned but we could still
-			// return useful data.
-			throw SyncQueueException();
-		}
-		auto o = std::move(queue.front());
-		queue.pop();
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type raw;
+		if (!queue.dequeueRaw(&raw)) throw SyncQueueException();
+		T *p = (T *)&raw;
+		T o(std::move(*p));
+		p->~T();
 		return o;
 	}
 };
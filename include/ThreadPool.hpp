@@ -1,39 +1,204 @@
 #ifndef __THREADPOOL_HPP
 #define __THREADPOOL_HPP
 
-#include <thread>
-#include <functional>
-#include <SyncQueue.hpp>
-#include <util/ArrayList.hpp>
+#include <lang/Exception.hpp>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
 
+namespace lang { class Thread; class ThreadGroup; }
+namespace util { namespace concurrent { template<class T> class Future; }}
+
+class RejectedExecutionException : extends RuntimeException {
+public:
+	RejectedExecutionException() : RuntimeException("The ThreadPool has been shut down.") {}
+};
+
+/**
+ * Work stealing executor. Each worker owns a Chase-Lev deque: tasks submitted from
+ * a worker go to its own deque (LIFO for the owner), idle workers steal from the
+ * other end of the others' deques. Tasks from other threads go to a shared
+ * injection queue. Callables up to Task::INLINE_SIZE bytes are stored in the task
+ * node, the nodes are recycled per thread.
+ * Metrics (shared by all pools): ThreadPool.queued gauge of the tasks waiting,
+ * ThreadPool.task.wait.ns and ThreadPool.task.latency.ns histograms (push to
+ * start, push to completion) of every 16th task pushed by a thread.
+ */
 class ThreadPool {
+public:
+	class Task {
+		friend class ThreadPool;
 	public:
+		static const size_t INLINE_SIZE = 64;
+	private:
+		void (*invoke)(Task *t, boolean run);   // runs (when run) and destroys the callable
+		void *callable;
+		jlong queued;                           // push time of the sampled tasks, else 0
+		union {
+			std::max_align_t align;
+			char storage[INLINE_SIZE];
+		};
+		Task() {}
+
+		template<class F> static void invokeInline(Task *t, boolean run) {
+			F *f = (F *)t->storage;
+			if (run) {
+				try { (*f)(); } catch (...) { f->~F(); throw; }
+			}
+			f->~F();
+		}
+		template<class F> static void invokeHeap(Task *t, boolean run) {
+			std::unique_ptr<F> f((F *)t->callable);
+			if (run) (*f)();
+		}
+		template<class F> static Task *make(F&& f);
+	};
+
 	ThreadPool(const ThreadPool& other) = delete;
 	ThreadPool(ThreadPool&& other) = delete;
 	ThreadPool& operator=(const ThreadPool& other) = delete;
 	ThreadPool& operator=(ThreadPool&& other) = delete;
-	~ThreadPool() = default;
+	// graceful shutdown, waits for the queued tasks
+	~ThreadPool();
+
+	// hardware_concurrency workers when threads <= 0
+	ThreadPool(int threads=0);
+	// workers in group, which pins them when it has a placement
+	ThreadPool(int threads, lang::ThreadGroup& group);
+
+	int getPoolSize() const { return (int)workers.size(); }
+	/**
+	 * Runs f on the pool, an exception it throws is printed.
+	 * @throws RejectedExecutionException after shutdown
+	 */
+	template<class F> void execute(F&& f) { push(Task::make(std::forward<F>(f))); }
+	template<class F> void enqueue(F&& f) { execute(std::forward<F>(f)); }
+	/**
+	 * Runs f on the pool, the future gets its result or exception
+	 * (RejectedExecutionException when shutdownNow drops the task).
+	 * Defined in util/concurrent/Future.hpp.
+	 * @throws RejectedExecutionException after shutdown
+	 */
+	template<class F> auto submit(F&& f) -> util::concurrent::Future<decltype(f())>;
+
+	/**
+	 * Calls f(i) for i in [begin, end), in chunks of grain indices (0 for automatic)
+	 * run by the workers and the calling thread. Returns when all are done,
+	 * rethrows the first exception (the chunks not yet started are skipped).
+	 */
+	template<class F> void parallelFor(long begin, long end, long grain, F f);
+	/**
+	 * Combines f(lo, hi) of the chunks of [begin, end) with combine, in index order,
+	 * starting from identity.
+	 */
+	template<class T, class F, class C> T parallelReduce(long begin, long end, long grain, T identity, F f, C combine);
+
+	// no new tasks, the queued ones still run
+	void shutdown();
+	// no new tasks, the queued ones are dropped, returns their number
+	int shutdownNow();
+	boolean isShutdown() const { return state.load() != RUNNING; }
+	/**
+	 * Waits for the workers to finish after shutdown, at most millis (0 forever).
+	 * Returns false on timeout.
+	 */
+	boolean awaitTermination(long millis=0);
+	boolean isTerminated() const { return live.load() == 0 && isShutdown(); }
 
-	ThreadPool(int threads=0){
-		if (threads > 0) maxThreads = threads;
-		else maxThreads = std::thread::hardware_concurrency();
+private:
+	enum { RUNNING, SHUTDOWN, STOP };
+	class Deque;
+	struct Worker;
+	struct ChunkJob;
+	struct TaskCache;
+	static thread_local Worker *currentWorker;
+	static thread_local TaskCache taskCache;
+
+	std::vector<Worker*> workers;
+	std::mutex injectLock;
+	std::deque<Task*> injected;
+	std::atomic<int> injectedCount{0};
+	std::atomic<int> state{RUNNING};
+	std::atomic<int> idle{0};
+	std::atomic<int> signal{0};              // futex word of the idle workers
+	std::atomic<int> live{0};                // futex word, running workers
+
+	static Task *allocTask();
+	static void freeTask(Task *t);
+	static void run(Task *t);
+	// destroys a task which will not run
+	static void drop(Task *t);
+	void push(Task *t);
+	Task *find(Worker *w);
+	void workerLoop(Worker *w);
+	void start(int threads, lang::ThreadGroup *group);
+	void wakeWorker();
+	// runs body(ctx, chunk) for every chunk on the pool and the calling thread
+	void runChunks(long chunks, void (*body)(void *ctx, long chunk), void *ctx);
+
+	template<class F> struct ForChunks;
+	template<class T, class F> struct ReduceChunks;
+	static long chunkCount(long n, long& grain, int workers);
+};
+
+template<class F> ThreadPool::Task *ThreadPool::Task::make(F&& f) {
+	typedef typename std::decay<F>::type Fn;
+	Task *t = allocTask();
+	if (sizeof(Fn) <= INLINE_SIZE && alignof(Fn) <= alignof(std::max_align_t)) {
+		new (t->storage) Fn(std::forward<F>(f));
+		t->invoke = invokeInline<Fn>;
+	}
+	else {
+		t->callable = new Fn(std::forward<F>(f));
+		t->invoke = invokeHeap<Fn>;
 	}
+	return t;
+}
 
-	void enqueue(std::function<void()> f) {
-		queue.enqueue(f);
+template<class F> struct ThreadPool::ForChunks {
+	long begin, end, grain;
+	F& f;
+	static void body(void *ctx, long chunk) {
+		ForChunks& c = *(ForChunks *)ctx;
+		long lo = c.begin + chunk * c.grain, hi = lo + c.grain < c.end ? lo + c.grain : c.end;
+		for (long i = lo; i < hi; ++i) c.f(i);
 	}
-	private:
-	void workerLoop() {
-		while (true) {
-			std::function<void()> work = queue.dequeue();
-			work(); // function<void()> type
-		}
-	};
+};
+template<class F> void ThreadPool::parallelFor(long begin, long end, long grain, F f) {
+	if (end <= begin) return;
+	long chunks = chunkCount(end - begin, grain, getPoolSize());
+	ForChunks<F> c{begin, end, grain, f};
+	runChunks(chunks, ForChunks<F>::body, &c);
+}
 
-	private:
-	int maxThreads;
-	SyncQueue<std::function<void()>> queue;
-	ArrayList<std::thread*> workers;
+template<class T, class F> struct ThreadPool::ReduceChunks {
+	long begin, end, grain;
+	F& f;
+	// a distinct object per chunk, std::vector<bool> would pack the workers' results into shared words
+	struct Slot { T value; };
+	std::vector<Slot> results;
+	static void body(void *ctx, long chunk) {
+		ReduceChunks& c = *(ReduceChunks *)ctx;
+		long lo = c.begin + chunk * c.grain, hi = lo + c.grain < c.end ? lo + c.grain : c.end;
+		c.results[(size_t)chunk].value = c.f(lo, hi);
+	}
 };
+template<class T, class F, class C> T ThreadPool::parallelReduce(long begin, long end, long grain, T identity, F f, C combine) {
+	if (end <= begin) return identity;
+	long chunks = chunkCount(end - begin, grain, getPoolSize());
+	ReduceChunks<T,F> c{begin, end, grain, f, std::vector<typename ReduceChunks<T,F>::Slot>((size_t)chunks, {identity})};
+	runChunks(chunks, ReduceChunks<T,F>::body, &c);
+	T r = identity;
+	for (const auto& v : c.results) r = combine(r, v.value);
+	return r;
+}
+
+// submit returns a Future
+#include <util/concurrent/Future.hpp>
 
 #endif
@@ -20,7 +20,7 @@ public:
 	PrintStream(OutputStream& o) : out(o) {}
 
 	void flush() {TRACE;
-		if (this == null) {std::cerr << "NULL" << std::endl;return ;}
+		if (isNull(this)) {std::cerr << "NULL" << std::endl;return ;}
 		synchronized (*this) {
 			out.flush();
 		}
@@ -61,22 +61,27 @@ public:
 		}
 	}
 
-	const PrintStream& printf(const String& fmt...) const {
-		va_list args;
-		va_start(args, fmt);
-		format(fmt.cstr(),args);
-		va_end(args);
+	/**
+	 * Formats like String::format, into a per thread buffer which is then written out.
+	 * Only the argument types are checked when compiling: a conversion that does not
+	 * fit its argument, a missing or an extra argument throws IllegalFormatException
+	 * at run time and nothing is written.
+	 */
+	template<class... Args>
+	const PrintStream& printf(const char *fmt, const Args&... args) const {
+		FormatBuffer fb;
+		fb.sb.appendFormat(fmt, args...);
+		write(fb.sb.toString());
 		return *this;
 	}
-	const PrintStream& printf(const char *fmt...) const {
-		va_list args;
-		va_start(args, fmt);
-		format(fmt,args);
-		va_end(args);
-		return *this;
+	template<class... Args>
+	const PrintStream& printf(const String& fmt, const Args&... args) const {
+		return printf(fmt.cstr(), args...);
 	}
 	void format(const char *fmt, va_list& args) const {
-		write(String::format(fmt,args));
+		FormatBuffer fb;
+		fb.sb.appendFormat(fmt, args);
+		write(fb.sb.toString());
 	}
 
 	const PrintStream& append(const CharSequence& csq) const {
@@ -85,18 +90,35 @@ public:
 	}
 
 protected:
+	// reused by the thread, a nested printf (from a toString()) gets its own
+	class FormatBuffer {
+	private:
+		static std::unique_ptr<StringBuilder>& cached() {
+			static thread_local std::unique_ptr<StringBuilder> sb;
+			return sb;
+		}
+	public:
+		StringBuilder& sb;
+		FormatBuffer() : sb(cached() ? *cached().release() : *new StringBuilder(128)) {
+			sb.setLength(0);
+		}
+		~FormatBuffer() {
+			if (!cached()) cached().reset(&sb);
+			else delete &sb;
+		}
+	};
 	void newLine() const {
-		if (this == null) {std::cerr << "NULL" << std::endl;return ;}
+		if (isNull(this)) {std::cerr << "NULL" << std::endl;return ;}
 		out.write('\n');
 	}
 	void write(const char *s) const {
-		if (this == null) {std::cerr << "NULL" << s;return ;}
+		if (isNull(this)) {std::cerr << "NULL" << s;return ;}
 		synchronized (*this) {
 			out.write(s,(int)strlen(s));
 		}
 	}
 	void write(const String& s) const {
-		if (this == null) {std::cerr << "NULL" << s.intern();return ;}
+		if (isNull(this)) {std::cerr << "NULL" << s.intern();return ;}
 		synchronized (*this) {
 			out.write(s.cstr(),s.length());
 		}
@@ -0,0 +1,89 @@
+#ifndef __LANG_AFFINITY_HPP
+#define __LANG_AFFINITY_HPP
+
+#include <lang/String.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace lang {
+
+/**
+ * Set of CPU numbers, as the kernel cpu_set_t: the CPUs a thread may run on.
+ */
+class CpuSet final {
+public:
+	static const int MAX_CPUS = 1024;
+private:
+	static const int WORDS = MAX_CPUS / 64;
+	uint64_t bits[WORDS];
+	static void check(int cpu);
+public:
+	CpuSet() { clear(); }
+	CpuSet(std::initializer_list<int> cpus);
+	/**
+	 * Parses a kernel cpu list as "0-3,8,10-11".
+	 * @throws IllegalArgumentException when malformed
+	 */
+	static CpuSet parse(const String& list);
+	// the CPUs this process may run on
+	static CpuSet online();
+
+	/**
+	 * @throws IndexOutOfBoundsException when cpu is not in 0..MAX_CPUS-1
+	 */
+	void set(int cpu) { check(cpu); bits[cpu >> 6] |= (uint64_t)1 << (cpu & 63); }
+	void clear(int cpu) { check(cpu); bits[cpu >> 6] &= ~((uint64_t)1 << (cpu & 63)); }
+	boolean get(int cpu) const { return cpu >= 0 && cpu < MAX_CPUS && (bits[cpu >> 6] >> (cpu & 63) & 1) != 0; }
+	void clear() { for (uint64_t& w : bits) w = 0; }
+	void andWith(const CpuSet& o) { for (int i = 0; i < WORDS; ++i) bits[i] &= o.bits[i]; }
+	void orWith(const CpuSet& o) { for (int i = 0; i < WORDS; ++i) bits[i] |= o.bits[i]; }
+	// the first CPU >= from in the set, -1 when none (as BitSet)
+	int nextSetBit(int from) const;
+	int cardinality() const;
+	boolean isEmpty() const { return nextSetBit(0) < 0; }
+	boolean equals(const CpuSet& o) const;
+	// in the cpu list format of parse
+	String toString() const;
+};
+
+/**
+ * NUMA topology from /sys/devices/system/node (a single node holding all CPUs
+ * where it is missing) and node local memory.
+ * Linux places a page on the node of the thread which first writes it, the
+ * allocations below rely on that instead of a memory policy (libnuma).
+ */
+class Numa final {
+public:
+	Numa() = delete;
+
+	// number of node ids (the highest node + 1)
+	static int nodeCount();
+	// empty for an id without node
+	static CpuSet cpusOfNode(int node);
+	// 0 for a CPU of no known node
+	static int nodeOfCpu(int cpu);
+	static int currentCpu();
+	static int currentNode();
+
+	/**
+	 * Maps size bytes of zeroed pages, not placed on any node yet.
+	 * @throws OutOfMemoryError when the mapping fails
+	 */
+	static void *allocate(size_t size);
+	// allocate, the pages written by the calling thread: local to the node it runs on
+	static void *allocateLocal(size_t size);
+	/**
+	 * allocate, the pages written by the calling thread while it is pinned to the CPUs
+	 * of node (its affinity is restored afterwards).
+	 * @throws IllegalArgumentException when node has no CPUs
+	 */
+	static void *allocateOnNode(size_t size, int node);
+	// writes one byte of each page of [p, p+size)
+	static void touch(void *p, size_t size);
+	static void free(void *p, size_t size);
+};
+
+} //namespace lang
+
+#endif
@@ -6,11 +6,41 @@
 
 namespace lang {
 
-class CharacterData : Object {
+class String;
+
+/**
+ * Unicode properties of the Basic Multilingual Plane.
+ * Latin-1 is a flat table built at compile time, the rest of the plane a two stage table
+ * (blocks of 128 code points sharing records) generated by tools/GenerateCharacter.pl.
+ * Supplementary code points are not tabled and read as unassigned.
+ */
+class CharacterData final {
 public:
-	static CharacterData& of(int ch);
-	virtual int getType(int ch) = 0;
-	virtual int digit(int ch, int radix) = 0;
+	struct Properties {
+		byte type;
+		byte digit;            // value as a digit of radix 36, 0xFF if none
+		boolean whitespace;
+		unsigned short upper;  // offsets to the simple case mappings, modulo 2^16
+		unsigned short lower;
+	};
+	struct Latin1 {
+		Properties properties[256];
+		char upper[256];       // case mappings which stay in Latin-1, others unchanged
+		char lower[256];
+	};
+	static const Latin1 latin1;
+
+	static const Properties& of(int ch) {
+		if ((unsigned)ch < 256) return latin1.properties[ch];
+		if ((unsigned)ch <= 0xFFFF) return records[blocks[index[ch >> 7] * 128 + (ch & 127)]];
+		return unassigned;
+	}
+
+private:
+	static const Properties unassigned;
+	static const Properties records[];
+	static const unsigned short blocks[];
+	static const unsigned char index[];
 };
 
 class Character : extends Object, implements Comparable<Character> {
@@ -39,27 +69,78 @@ public:
 	static const byte FORMAT = 16;
 	static const byte PRIVATE_USE = 18;
 	static const byte SURROGATE = 19;
-
+	static const byte DASH_PUNCTUATION = 20;
+	static const byte START_PUNCTUATION = 21;
+	static const byte END_PUNCTUATION = 22;
+	static const byte CONNECTOR_PUNCTUATION = 23;
+	static const byte OTHER_PUNCTUATION = 24;
+	static const byte MATH_SYMBOL = 25;
+	static const byte CURRENCY_SYMBOL = 26;
+	static const byte MODIFIER_SYMBOL = 27;
+	static const byte OTHER_SYMBOL = 28;
+	static const byte INITIAL_QUOTE_PUNCTUATION = 29;
 	static const byte FINAL_QUOTE_PUNCTUATION = 30;
 
 	static const int ERROR = 0xFFFFFFFF;
 
-	static boolean isDigit(char ch) {
-		return isDigit((int)ch);
+	// chars are Latin-1 code points
+	static int getType(char ch) { return getType((int)(byte)ch); }
+	static int getType(int codePoint) {
+		return CharacterData::of(codePoint).type;
 	}
+	static boolean isDigit(char ch) { return isDigit((int)(byte)ch); }
 	static boolean isDigit(int codePoint) {
-		return getType(codePoint) == Character::DECIMAL_DIGIT_NUMBER;
+		return getType(codePoint) == DECIMAL_DIGIT_NUMBER;
+	}
+	static boolean isLetter(char ch) { return isLetter((int)(byte)ch); }
+	static boolean isLetter(int codePoint) {
+		return (unsigned)(getType(codePoint) - UPPERCASE_LETTER) <= OTHER_LETTER - UPPERCASE_LETTER;
 	}
-	static int digit(char ch, int radix) {
-		return digit((int)ch, radix);
+	static boolean isLetterOrDigit(char ch) { return isLetterOrDigit((int)(byte)ch); }
+	static boolean isLetterOrDigit(int codePoint) {
+		return isLetter(codePoint) || isDigit(codePoint);
 	}
+	static boolean isUpperCase(char ch) { return isUpperCase((int)(byte)ch); }
+	static boolean isUpperCase(int codePoint) {
+		return getType(codePoint) == UPPERCASE_LETTER;
+	}
+	static boolean isLowerCase(char ch) { return isLowerCase((int)(byte)ch); }
+	static boolean isLowerCase(int codePoint) {
+		return getType(codePoint) == LOWERCASE_LETTER;
+	}
+	static boolean isWhitespace(char ch) { return isWhitespace((int)(byte)ch); }
+	static boolean isWhitespace(int codePoint) {
+		return CharacterData::of(codePoint).whitespace;
+	}
+	static int digit(char ch, int radix) { return digit((int)(byte)ch, radix); }
 	static int digit(int codePoint, int radix) {
-		return CharacterData::of(codePoint).digit(codePoint, radix);
+		int d = CharacterData::of(codePoint).digit;
+		return (unsigned)(radix - MIN_RADIX) <= MAX_RADIX - MIN_RADIX && d < radix ? d : -1;
 	}
-	
-	static int getType(int codePoint) {
-		return CharacterData::of(codePoint).getType(codePoint);
+	static char toUpperCase(char ch) { return CharacterData::latin1.upper[(byte)ch]; }
+	static int toUpperCase(int codePoint) {
+		if ((unsigned)codePoint > MAX_VALUE) return codePoint;
+		return (jchar)(codePoint + CharacterData::of(codePoint).upper);
+	}
+	static char toLowerCase(char ch) { return CharacterData::latin1.lower[(byte)ch]; }
+	static int toLowerCase(int codePoint) {
+		if ((unsigned)codePoint > MAX_VALUE) return codePoint;
+		return (jchar)(codePoint + CharacterData::of(codePoint).lower);
 	}
+
+	/**
+	 * Bulk variants over runs of Latin-1 chars.
+	 * The case conversions may work in place (dst == src).
+	 */
+	static void getType(const char *src, int count, byte dst[]);
+	static void toUpperCase(const char *src, int count, char dst[]);
+	static void toLowerCase(const char *src, int count, char dst[]);
+	static void getType(const Array<char>& a, int offset, int count, Array<byte>& types);
+	static void toUpperCase(Array<char>& a, int offset, int count);
+	static void toLowerCase(Array<char>& a, int offset, int count);
+	static void getType(const String& s, int beginIndex, int endIndex, byte dst[]);
+	static void toUpperCase(const String& s, int beginIndex, int endIndex, char dst[]);
+	static void toLowerCase(const String& s, int beginIndex, int endIndex, char dst[]);
 };
 
 }
@@ -2,6 +2,7 @@
 #define __LANG_CLASS_HPP
 
 #include <lang/Object.hpp>
+#include <lang/String.hpp>
 #include <typeinfo>
 
 namespace lang {
@@ -10,8 +11,11 @@ class Class : extends Object {
 	friend class Object;
 private:
 	const std::type_info& type;
+	// demangled once, when the class is registered
+	const String name;
+	const String simpleName;
 protected:
-	Class(const std::type_info& t) : type(t) {}
+	Class(const std::type_info& t);
 public:
 	String toString() const;
 	/*
@@ -19,8 +23,8 @@ public:
 	 * information about modifiers and type parameters.
 	 */
 	String toGenericString() const;
-	String getName() const;
-	String getSimpleName() const;
+	const String& getName() const { return name; }
+	const String& getSimpleName() const { return simpleName; }
 	String getCanonicalName() const;
 	boolean isInstance(const Object& obj) const {
 		//return instanceof<typename(obj)>(this);
@@ -38,6 +42,16 @@ public:
 	}
 };
 
+/**
+ * Class of the static type T.
+ * The registry is consulted only on the first call for each T.
+ */
+template<class T>
+inline const Class& classOf() {
+	static const Class& c = Object::getClass(typeid(T));
+	return c;
+}
+
 } //namespace lang
 
 #endif
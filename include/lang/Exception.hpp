@@ -2,6 +2,7 @@
 #define __LANG_EXCEPTION_HPP
 
 #include <util/List.hpp>
+#include <atomic>
 
 namespace io { class PrintStream; }
 
@@ -49,6 +50,11 @@ public:
 		fptr = null;
 	}
 
+	/**
+	 * Demangled name of the function at addr (dladdr), "??" if it is not exported.
+	 */
+	static String functionName(const void *addr);
+
 	const String&  getMethodName() const { return methodName; }
    	const String& getFileName() const { return fileName; }
 	int getLineNumber() const { return lineNumber; }
@@ -60,15 +66,24 @@ public:
 
 class Throwable : extends Object {
 private:
+	static const int MAX_FRAMES = 50;
 	String threadInfo;
 	String detailMessage;
-	Array<StackTraceElement> stackTrace;
+	// raw return addresses, symbolized on first getStackTrace()
+	void *frames[MAX_FRAMES];
+	int depth = 0;
+	mutable Array<StackTraceElement> stackTrace;
+	// stackTrace holds the frames symbolized, set once for a Throwable shared by threads
+	mutable std::atomic<boolean> symbolized{false};
 	const Throwable *cause = this;
 	util::List<Throwable*> *suppressedExceptions = null;
 	void move(Throwable* o) {
 		threadInfo = std::move(o->threadInfo);
 		detailMessage = std::move(o->detailMessage);
+		std::memcpy(frames, o->frames, (size_t)o->depth * sizeof(void*));
+		depth = o->depth; o->depth = 0;
 		stackTrace = std::move(o->stackTrace);
+		symbolized.store(o->symbolized.load(std::memory_order_acquire), std::memory_order_relaxed);
 		cause = o->cause; o->cause = o;
 	}
 
@@ -91,9 +106,20 @@ public:
 	String toString() const;
 	void printStackTrace() const;
 	void printStackTrace(io::PrintStream& s) const;
+	/**
+	 * Records the current stack as return addresses only,
+	 * the symbols are resolved when the trace is printed or requested.
+	 */
 	Throwable& fillInStackTrace();
-	const Array<StackTraceElement>& getStackTrace() const { return stackTrace; }
-	void setStackTrace(Array<StackTraceElement>& st) { stackTrace=std::move(st); }
+	boolean hasStackTrace() const { return depth > 0 || stackTrace.length > 0; }
+	const Array<StackTraceElement>& getStackTrace() const;
+	void setStackTrace(Array<StackTraceElement>& st) { stackTrace=std::move(st); depth = 0; symbolized.store(false, std::memory_order_relaxed); }
+	/**
+	 * Enables or disables the stack trace capture when an exception of exactly
+	 * this class is thrown, for exceptions used as ordinary control flow.
+	 */
+	static void setStackTraceEnabled(const Class& type, boolean enabled);
+	static boolean isStackTraceEnabled(const Class& type);
 	void addSuppressed(const Throwable& exception) {}
 	Array<Throwable*> getSuppressed() {
 		return suppressedExceptions == null ? Array<Throwable*>() : suppressedExceptions->toArray();
@@ -155,6 +181,11 @@ public:
 	   IndexOutOfBoundsException("String index out of range: " + String::valueOf(i)) {}
 };
 
+class ArrayStoreException : extends Exception {
+public:
+	using Exception::Exception;
+};
+
 class IllegalThreadStateException : extends Exception {
 public:
 	using Exception::Exception;
@@ -165,11 +196,21 @@ public:
 	using Exception::Exception;
 };
 
+class IllegalFormatException : extends IllegalArgumentException {
+public:
+	using IllegalArgumentException::IllegalArgumentException;
+};
+
 class IllegalStateException : extends Exception {
 public:
 	using Exception::Exception;
 };
 
+class IllegalMonitorStateException : extends Exception {
+public:
+	using Exception::Exception;
+};
+
 } //namespace lang
 
 #endif
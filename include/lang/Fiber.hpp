@@ -0,0 +1,217 @@
+#ifndef __LANG_FIBER_HPP
+#define __LANG_FIBER_HPP
+
+#include <lang/Thread.hpp>
+#include <atomic>
+#include <climits>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace lang {
+
+class FiberScheduler;
+
+/**
+ * User mode thread: a Runnable run on a small stack of its own by the carrier
+ * threads of a FiberScheduler, any number of fibers on a few threads.
+ * A fiber blocking in a fiber aware call is switched out (parked) and its carrier
+ * runs the next one; a parked fiber costs the stack pages it touched and this object.
+ * Fiber aware are sleep, yield, join, park, synchronized and Object::wait (and
+ * Thread::sleep and yield called on a fiber), and the blocking reads of the nio
+ * channels. Any other blocking call blocks the carrier, with the fibers queued on it.
+ *
+ * Thread::currentThread() on a fiber is its carrier, which may change at every
+ * switch; the TRACE frames and the exceptions being handled go with the fiber.
+ */
+class Fiber : extends Object, implements Runnable {
+	friend class FiberScheduler;
+public:
+	// usable bytes, below it is a guard page
+	static const long DEFAULT_STACK_SIZE = 64 * 1024;
+
+	enum State {
+		NEW,
+		RUNNABLE,
+		WAITING,
+		TERMINATED
+	};
+
+	/**
+	 * Fibers parked on a word, the futex of the fibers: blocking primitives park
+	 * fibers here and threads on the futex.
+	 */
+	class WaitQueue {
+		friend class Fiber;
+	private:
+		struct Node {
+			Fiber *fiber;
+			Node *prev, *next;
+			boolean queued;
+		};
+		std::mutex lock;
+		std::atomic<int> size{0};
+		Node *head = null, *tail = null;
+		void unlink(Node *n);
+	public:
+		/**
+		 * Parks the current fiber while word == expected, at most nanos nanoseconds
+		 * (negative means no timeout). Returns false on timeout. Spurious wakeups are
+		 * possible, callers must recheck the word.
+		 */
+		boolean wait(std::atomic<int>& word, int expected, jlong nanos=-1);
+		// wakes count fibers parked here, to be called after the word changed
+		void wake(int count);
+		void wakeAll() { wake(INT_MAX); }
+	};
+
+private:
+	struct Context {
+		void *sp = null;                     // saved stack pointer while switched out
+	};
+	enum Action { NONE, YIELD, PARK, EXIT };
+
+	FiberScheduler *scheduler = null;
+	Runnable *target = null;
+	std::function<void()> func;
+	String name;
+	long fid;
+	size_t stackSize;
+	void *stack = null;                      // the mapping, guard page first
+	Context context;
+	Context *carrier = null;                 // of the carrier running it
+	Fiber *next = null;                      // run queue link
+	Action action = NONE;                    // why it switched out
+	std::atomic<int> permit{0};              // 0, PERMIT or PARKED
+	std::atomic<int> state{NEW};             // futex word of the threads joining
+	std::atomic<boolean> released{false};    // the carrier is done with this object
+	WaitQueue joiners;
+	// saved while switched out: the TRACE frames above the carrier's, the exception stack
+	std::vector<CallTrace::Frame> frames;
+	unsigned traceDepth = 0;
+	void *caughtExceptions = null;
+	unsigned uncaughtExceptions = 0;
+
+	void init(FiberScheduler *s, long stackSize);
+	// runs on the fiber's stack
+	static void main();
+	// back to the carrier, which completes the action
+	void switchOut(Action a);
+
+	static const int PERMIT = 1;
+	static const int PARKED = 2;
+
+public:
+	Fiber(const Fiber& other) = delete;
+	Fiber& operator=(const Fiber& other) = delete;
+
+	/**
+	 * A fiber of the default scheduler, stackSize 0 means DEFAULT_STACK_SIZE.
+	 * @throws IllegalArgumentException when stackSize is negative
+	 */
+	Fiber(Runnable& target, long stackSize=0) : target(&target) {init(null, stackSize);}
+	Fiber(std::function<void()> f, long stackSize=0) : func(std::move(f)) {init(null, stackSize);}
+	Fiber(FiberScheduler& scheduler, Runnable& target, long stackSize=0) : target(&target) {init(&scheduler, stackSize);}
+	Fiber(FiberScheduler& scheduler, std::function<void()> f, long stackSize=0) : func(std::move(f)) {init(&scheduler, stackSize);}
+	// joins the fiber when started
+	~Fiber();
+
+	/**
+	 * Maps the stack and queues the fiber on its scheduler.
+	 * @throws IllegalThreadStateException when started already
+	 * @throws OutOfMemoryError when the stack can not be mapped
+	 * @throws RejectedExecutionException after the scheduler shut down
+	 */
+	void start();
+	void run() {TRACE;
+		if (target != null) target->run();
+		else if (func) func();
+	}
+	// waits until the fiber terminated, parking the calling fiber or blocking the calling thread
+	void join();
+	boolean isAlive() const { State s = getState(); return s != NEW && s != TERMINATED; }
+	State getState() const { return (State)state.load(std::memory_order_acquire); }
+	long getId() const { return fid; }
+	void setName(const String& name) { this->name = name; }
+	const String& getName() const { return name; }
+	String toString() const { return "Fiber:" + name; }
+
+	// the fiber running on the calling thread, null on a plain thread
+	static Fiber *current() { return running(); }
+	// lets the other runnable fibers run first
+	static void yield();
+	/**
+	 * Parks the current fiber for millis milliseconds (at the timer tick resolution),
+	 * a plain thread sleeps.
+	 */
+	static void sleep(long millis);
+	/**
+	 * Parks the current fiber until unparked, returns at once when a permit was
+	 * given (as LockSupport.park). Spurious returns are possible.
+	 * @throws IllegalStateException on a plain thread
+	 */
+	static void park();
+	// park for at most nanos nanoseconds
+	static void parkNanos(jlong nanos);
+	// makes f runnable, or gives it the permit of its next park
+	static void unpark(Fiber& f);
+	/**
+	 * Parks the current fiber until fd is readable, a plain thread polls it.
+	 * Returns at once for a descriptor epoll does not take (a regular file).
+	 * A fiber waiting on a descriptor closed meanwhile is not woken.
+	 */
+	static void awaitReadable(int fd);
+
+private:
+	// constant initialized, so it may be read in any switched code without a guard
+	static Fiber*& running() {
+		__attribute__((tls_model("initial-exec"))) static thread_local Fiber *f = null;
+		return f;
+	}
+};
+
+/**
+ * Runs fibers on a fixed set of "fiber-N" carrier threads, from a shared FIFO run
+ * queue; idle carriers sleep on a futex.
+ * The stacks of the default size come from slabs of mmap'd stacks and are reused
+ * (the memory follows the peak number of fibers), other sizes are mapped each.
+ * Their guard pages are MADV_GUARD_INSTALL markers (Linux 6.13), which cost no
+ * mapping; older kernels get mprotect'ed pages, a mapping each, which limits the
+ * fibers to about vm.max_map_count / 2.
+ */
+class FiberScheduler {
+	friend class Fiber;
+private:
+	std::vector<Thread*> carriers;
+	std::mutex lock;                         // guards the run queue and shut
+	Fiber *head = null, *tail = null;
+	int idle = 0;
+	boolean shut = false;
+	std::atomic<int> wakeups{0};             // futex word of the idle carriers
+	std::atomic<int> alive{0};               // fibers started and not terminated, futex word
+
+	void enqueue(Fiber *f);
+	// the next runnable fiber, null once shut down
+	Fiber *take();
+	void carrierLoop();
+	// runs f until it switches out and completes its action
+	void resume(Fiber::Context& self, Fiber *f);
+	void terminated(Fiber *f);
+public:
+	FiberScheduler(const FiberScheduler&) = delete;
+	FiberScheduler& operator=(const FiberScheduler&) = delete;
+	// availableProcessors carriers when carriers <= 0
+	FiberScheduler(int carriers=0);
+	// waits until no fiber is alive, then stops the carriers
+	~FiberScheduler();
+
+	// the scheduler of the fibers constructed without one, never destroyed
+	static FiberScheduler& getDefault();
+	int getCarrierCount() const { return (int)carriers.size(); }
+	// fibers started and not terminated, parked ones included
+	int getFiberCount() const { return alive.load(std::memory_order_relaxed); }
+};
+
+} //namespace lang
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef __LANG_FLOATINGDECIMAL_HPP
+#define __LANG_FLOATINGDECIMAL_HPP
+
+#include <lang/Object.hpp>
+
+namespace lang {
+
+/**
+ * Conversions between binary floating point and decimal text, backing Double and Float.
+ * Formatting produces the shortest digits that read back to the same value
+ * (Ryu algorithm), in the layout of Java's Double.toString.
+ */
+class FloatingDecimal final {
+public:
+	// enough for any result of toChars
+	static const int MAX_CHARS = 32;
+
+	/**
+	 * Writes v to buf (not terminated), returns the number of chars.
+	 */
+	static int toChars(double v, char *buf);
+	static int toChars(float v, char *buf);
+
+	/**
+	 * Parses a decimal (or hexadecimal) floating point literal,
+	 * surrounding whitespace and a trailing f/F/d/D are allowed.
+	 * @throws NumberFormatException
+	 */
+	static double parseDouble(const char *s, int n);
+	static float parseFloat(const char *s, int n);
+};
+
+}
+
+#endif
@@ -55,6 +55,8 @@ private:
 public:
 	static const int MIN_VALUE = (int)0x80000000;
 	static const int MAX_VALUE = 0x7fffffff;
+	// chars needed by Long::toChars
+	static const int MAX_CHARS = 66;
 
 	static String toString(jint i, int radix=10);
 	static String toUnsignedString(jint i, int radix=10);
@@ -62,6 +64,8 @@ public:
 	static String toOctalString(jint i) {return toUnsignedString(i, 8);}
 	static String toBinaryString(jint i) {return toUnsignedString(i, 2);}
 	static int parseInt(const String& s, int radix=10);
+	// parses s[beginIndex, endIndex) in place
+	static int parseInt(const char *s, int beginIndex, int endIndex, int radix);
 	static int parseUnsignedInt(const String& s, int radix=10);
 	static Integer valueOf(const String& s, int radix) {return Integer::valueOf(parseInt(s,radix));}
 	static Integer valueOf(const String& s) {return Integer::valueOf(parseInt(s, 10));}
@@ -203,12 +207,22 @@ private:
 public:
 	static const long MIN_VALUE = (long)0x8000000000000000L;
 	static const long MAX_VALUE = 0x7fffffffffffffffL;
+	// chars needed by toChars: 64 binary digits and a sign
+	static const int MAX_CHARS = 66;
+
+	/**
+	 * Writes the digits of i to buf (not terminated), returns their number.
+	 * Decimal digits are produced two at a time, a power of two radix by shifts.
+	 */
+	static int toChars(long i, char *buf, int radix=10);
+	static int toUnsignedChars(unsigned long i, char *buf, int radix=10);
 	static String toString(long i, int radix=10);
 	static String toUnsignedString(long i, int radix=10);
 	static String toHexString(long i) {return toUnsignedString(i, 16);}
 	static String toOctalString(long i) {return toUnsignedString(i, 8);}
 	static String toBinaryString(long i) {return toUnsignedString(i, 2);}
 	static long parseLong(const String& s, int radix=10);
+	static long parseLong(const char *s, int beginIndex, int endIndex, int radix);
 	static long parseUnsignedLong(const String& s, int radix=10);
 	static Long valueOf(const String& s, int radix=10) {return Long::valueOf(parseLong(s, radix));}
 	static Long valueOf(long l) {return Long(l);}
@@ -247,6 +261,117 @@ public:
 	Long& operator+=(Long v) { value+=v.value; return *this;}
 };
 
+class Float : extends Number, implements Comparable<Float> {
+private:
+	float value;
+public:
+	static constexpr float MAX_VALUE = 3.4028235e+38f;
+	static constexpr float MIN_VALUE = 1.4e-45f;
+	static constexpr float POSITIVE_INFINITY = __builtin_inff();
+	static constexpr float NEGATIVE_INFINITY = -__builtin_inff();
+	static constexpr float NaN = __builtin_nanf("");
+
+	/**
+	 * The shortest decimal that reads back as v, e.g. 0.1, 1.0E10.
+	 */
+	static String toString(float v);
+	static float parseFloat(const String& s);
+	static Float valueOf(const String& s) {return Float(parseFloat(s));}
+	static Float valueOf(float f) {return Float(f);}
+	static boolean isNaN(float v) {return v != v;}
+	static boolean isInfinite(float v) {return v == POSITIVE_INFINITY || v == NEGATIVE_INFINITY;}
+	static int floatToIntBits(float v) {
+		if (isNaN(v)) return 0x7fc00000;
+		int i;
+		std::memcpy(&i, &v, sizeof(i));
+		return i;
+	}
+	static jint hashCode(float value) {return (jint)floatToIntBits(value);}
+	static int compare(float x, float y) {
+		if (x < y) return -1;
+		if (x > y) return 1;
+		int a = floatToIntBits(x), b = floatToIntBits(y);
+		return a == b ? 0 : (a < b ? -1 : 1);
+	}
+
+	Float(const Float& o) : value(o.value) {}
+	Float(float value) : value(value) {}
+	Float(const String& s) : value(parseFloat(s)) {}
+	int intValue() const {return (int)value;}
+	long longValue() const {return (long)value;}
+	float floatValue() const {return value;}
+	double doubleValue() const {return (double)value;}
+	boolean isNaN() const {return isNaN(value);}
+	boolean isInfinite() const {return isInfinite(value);}
+	String toString() const { return toString(value); }
+	jint hashCode() const { return Float::hashCode(value); }
+	boolean equals(const Object& o) const {
+		if (instanceof<Float>(&o)) {
+			return floatToIntBits(value) == floatToIntBits(((const Float&)o).floatValue());
+		}
+		return false;
+	}
+	int compareTo(const Float& b) const { return compare(value,b.value); }
+	operator float() const { return value; }
+};
+
+class Double : extends Number, implements Comparable<Double> {
+private:
+	double value;
+public:
+	static constexpr double MAX_VALUE = 1.7976931348623157e+308;
+	static constexpr double MIN_VALUE = 4.9e-324;
+	static constexpr double POSITIVE_INFINITY = __builtin_inf();
+	static constexpr double NEGATIVE_INFINITY = -__builtin_inf();
+	static constexpr double NaN = __builtin_nan("");
+
+	/**
+	 * The shortest decimal that reads back as v, e.g. 0.1, 1.0E-5.
+	 */
+	static String toString(double v);
+	static double parseDouble(const String& s);
+	static Double valueOf(const String& s) {return Double(parseDouble(s));}
+	static Double valueOf(double d) {return Double(d);}
+	static boolean isNaN(double v) {return v != v;}
+	static boolean isInfinite(double v) {return v == POSITIVE_INFINITY || v == NEGATIVE_INFINITY;}
+	static jlong doubleToLongBits(double v) {
+		if (isNaN(v)) return 0x7ff8000000000000L;
+		jlong l;
+		std::memcpy(&l, &v, sizeof(l));
+		return l;
+	}
+	static jint hashCode(double value) {
+		jlong bits = doubleToLongBits(value);
+		return (jint)(int)(bits ^ (bits >> 32));
+	}
+	static int compare(double x, double y) {
+		if (x < y) return -1;
+		if (x > y) return 1;
+		jlong a = doubleToLongBits(x), b = doubleToLongBits(y);
+		return a == b ? 0 : (a < b ? -1 : 1);
+	}
+
+	Double(const Double& o) : value(o.value) {}
+	Double(double value) : value(value) {}
+	Double(const String& s) : value(parseDouble(s)) {}
+	int intValue() const {return (int)value;}
+	long longValue() const {return (long)value;}
+	float floatValue() const {return (float)value;}
+	double doubleValue() const {return value;}
+	boolean isNaN() const {return isNaN(value);}
+	boolean isInfinite() const {return isInfinite(value);}
+	String toString() const { return toString(value); }
+	jint hashCode() const { return Double::hashCode(value); }
+	boolean equals(const Object& o) const {
+		if (instanceof<Double>(&o)) {
+			return doubleToLongBits(value) == doubleToLongBits(((const Double&)o).doubleValue());
+		}
+		return false;
+	}
+	int compareTo(const Double& b) const { return compare(value,b.value); }
+	operator double() const { return value; }
+};
+
 } //namespace lang
 
 #endif
@@ -1,10 +1,15 @@
 #ifndef __LANG_OBJECT_HPP
 #define __LANG_OBJECT_HPP
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <mutex>
 #include <memory> //shared_ptr
+#include <type_traits>
 
 #define interface class
 #define extends public
@@ -29,6 +34,7 @@ namespace lang {
 class Class;
 class Object;
 class String;
+class System;
 
 class Interface {
 protected:
@@ -40,49 +46,126 @@ protected:
 	Interface() {}
 };
 
+template<class T> class Array;
+class StackTraceElement;
+
+/*
+ * Shadow call stack of the functions annotated with TRACE, built with -DTRACE.
+ * Each thread pushes to its own stack, allocated by its first push: a frame is
+ * three stores and the top word, nothing is locked or looked up. The top word
+ * holds the depth and a push count, odd while a push writes its frame, so a reader
+ * of another thread's stack (Thread::getStackTrace) can tell whether the frames it
+ * copied were being written (a seqlock).
+ */
+class CallTrace final {
+public:
+	static const unsigned MAX_DEPTH = 2048;  // deeper frames are counted, not kept
+	struct Frame {
+		const char *func;
+		const char *file;
+		unsigned line;
+	};
+	struct Stack {
+		std::atomic<uint64_t> top{0};  // pushes << 32 | depth
+		// relaxed, ordered by the push count
+		struct Slot {
+			std::atomic<const char *> func, file;
+			std::atomic<unsigned> line;
+		} slots[MAX_DEPTH];
+
+		Frame get(unsigned i) const {
+			return {slots[i].func.load(std::memory_order_relaxed), slots[i].file.load(std::memory_order_relaxed),
+				slots[i].line.load(std::memory_order_relaxed)};
+		}
+		void set(unsigned i, const Frame& f) {
+			slots[i].func.store(f.func, std::memory_order_relaxed);
+			slots[i].file.store(f.file, std::memory_order_relaxed);
+			slots[i].line.store(f.line, std::memory_order_relaxed);
+		}
+		// marks the frames above the depth of t as being written, returns the marked top
+		uint64_t beginWrite(uint64_t t) {
+			t += 1ull << 32;
+			top.store(t, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			return t;
+		}
+	};
+
+	CallTrace(const char *func, const char *file, unsigned line) {
+		Stack& s = stack();
+		uint64_t t = s.top.load(std::memory_order_relaxed);
+		unsigned depth = (unsigned)t;
+		if (depth < MAX_DEPTH) {
+			t = s.beginWrite(t);
+			s.set(depth, {func, file, line});
+			t += 1ull << 32;
+		}
+		s.top.store(t + 1, std::memory_order_release);
+	}
+	~CallTrace() {
+		Stack& s = stack();
+		s.top.store(s.top.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+	}
+	CallTrace(const CallTrace&) = delete;
+	CallTrace& operator=(const CallTrace&) = delete;
+
+	// the stack of the calling thread, allocated on first use
+	static Stack& stack() {
+		Stack *s = current().load(std::memory_order_relaxed);
+		return s != null ? *s : allocate();
+	}
+	// the stack of the calling thread, null until it pushed (constant initialized, one word of TLS)
+	static std::atomic<Stack*>& current() {
+		__attribute__((tls_model("initial-exec"))) static thread_local std::atomic<Stack*> s{null};
+		return s;
+	}
+	/**
+	 * The frames of s, innermost first; retries while the owning thread pushes.
+	 */
+	static Array<StackTraceElement> getStackTrace(const Stack& s);
+private:
+	// freed when the thread exits
+	static Stack& allocate();
+};
+
 #ifndef TRACE
 #define TRACE
 #undef BACKTRACE
 #else
+#undef TRACE
+#define TRACE ::lang::CallTrace UNIQUE_NAME(the_calltrace)(__FUNCTION__, __FILE__, __LINE__)
 #define BACKTRACE
-class Thread;
-class CallTrace {
-	Thread *t;
-public:
-	const char *func;
-	const char *file;
-	unsigned line;
-	CallTrace(const char *func, const char *file,unsigned line):func(func),file(file),line(line){t=null;}
-	void add();
-	~CallTrace();
-};
 #endif
 
-class CondMonitor;
 class Object {
 	friend class Lock;
 // http://hg.openjdk.java.net/jdk7/jdk7/hotspot/file/9b0ca45cd756/src/share/vm/runtime/objectMonitor.cpp#l1430
 private:
-	std::recursive_mutex *mtx = null;
-	CondMonitor* cond = null;
-	void move(Object *o) {
-		if (this == o) return ;
-		mtx = o->mtx; o->mtx = null;
-		cond = o->cond; o->cond = null;
-	}
+	/*
+	 * Monitor lock word:
+	 *   0                  - unlocked
+	 *   owner|depth<<1     - thin lock, held by owner (recursion depth in bits 1..7)
+	 *   monitor|1          - inflated, points into the monitor table
+	 * Never copied nor moved, a lock belongs to the object's address.
+	 */
+	mutable std::atomic<uintptr_t> lockword{0};
+	static void monitorEnter(const Object& o);
+	static void monitorExit(const Object& o);
 protected:
 	virtual void finalize() {}
 	virtual Object& clone() const;
 public:
 	static Object& null_obj;
 	static long null_val;
+	// address check for the null object model, where a null reference can reach a member
+	static boolean isNull(const void *p) { return reinterpret_cast<uintptr_t>(p) == 0; }
 	static Class *findClass(const std::type_info& type);
 	static void registerClass(Class *c);
 
 	Object(const Object& o) {}
 	Object& operator=(const Object& o) {return *this;}
-	Object(Object&& o) {move(&o);}
-	Object& operator=(Object&& o) {move(&o);return *this;}
+	Object(Object&& o) {}
+	Object& operator=(Object&& o) {return *this;}
 	virtual ~Object();
 
 	Object() {}
@@ -100,15 +183,23 @@ public:
 	virtual void wait() final {wait(0); }
 
 	boolean operator==(const std::nullptr_t&) const {
-		boolean b = (this == null || this == (void*)&null_obj);
+		boolean b = (isNull(this) || this == (void*)&null_obj);
 		return b;
 	}
-	boolean operator!=(const std::nullptr_t&) const {return this != null && this != &null_obj;}
+	boolean operator!=(const std::nullptr_t&) const {return !isNull(this) && this != &null_obj;}
 	boolean operator==(const Object& o) const {return this == &o;}
 	boolean operator!=(const Object& o) const {return this != &o;}
 
 	static const Class& getClass(const std::type_info& type);
 
+	struct MonitorStatistics {
+		jlong inflations; // thin locks turned into monitors (contention or wait)
+		jlong deflations; // monitors returned to the table
+		jlong contended;  // monitor enters that had to block
+		jlong waits;
+	};
+	static MonitorStatistics getMonitorStatistics();
+
 	class Lock {
 	private:
 		const Object& obj;
@@ -116,19 +207,16 @@ public:
 	public:
 		Lock(const Object* o) : Lock(*o) {}
 		Lock(const Object& o) : obj(o) {
-			if (&o == null) {
+			if (isNull(&o)) {
 				std::cerr << "Lock: obj is null" << std::endl;
 				locked=false;
 				return ;
 			}
-			if (obj.mtx == null) {
-				const_cast<Object&>(obj).mtx = new std::recursive_mutex;
-			}
-			obj.mtx->lock();
+			monitorEnter(obj);
 		}
 		~Lock() {
-			if (&obj == null) return ;
-			obj.mtx->unlock();
+			if (isNull(&obj)) return ;
+			monitorExit(obj);
 		}
 		operator boolean () const { return locked; }
 		void unlock() { locked=false; }
@@ -148,48 +236,77 @@ Shared<T> makeShared(Args&&... args) { return std::make_shared<T>(args...); }
 
 
 class AbstractArray : extends Object {
-private:
-	static void registerArrayClass(const std::type_info& type);
 protected:
-	AbstractArray() {
-		registerArrayClass(typeid(*this));
-	};
+	static const Class& registerArrayClass(const std::type_info& type);
 	static void checkArrayBounds(int i, int l);
+	static void checkArrayCopy(int srcPos, int srcLength, int destPos, int destLength, int length);
+	static void checkArrayStore(const AbstractArray *dest);
+public:
+	virtual void copyTo(int srcPos, AbstractArray& dest, int destPos, int length) const = 0;
 };
 
 template<class T>
 class Array : extends AbstractArray {
+	friend class System;
+private:
+	// registered once per element type, during static initialization
+	static const Class& arrayClass;
+
+	static void copy(T *d, const T *s, int n, std::true_type) {
+		if (n > 0) std::memmove(d, s, (size_t)n * sizeof(T));
+	}
+	static void copy(T *d, const T *s, int n, std::false_type) {
+		if (d <= s) for (int i=0; i < n; ++i) d[i] = s[i];
+		else for (int i=n; i-- > 0; ) d[i] = s[i];
+	}
+	// copy n elements, the ranges may overlap
+	static void copy(T *d, const T *s, int n) {
+		copy(d, s, n, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+	}
+
 protected:
 	T *a;
+	boolean owner = true;
+	// non-owning when !own
+	Array(T* v, int l, boolean own) : length(l), mEnd(this) {
+		checkArrayBounds(l, l+1);
+		a = v; owner = own;
+		mEnd.idx = l;
+	}
 
 public:
 	const int length;
 	Array(const Array<T>& o) : length(o.length), mEnd(this) {
 		a = new T[length];
-		for (int i=0; i < length; ++i) a[i] = o.a[i];
+		copy(a, o.a, length);
 		mEnd.idx = length;
 	}
 	Array(Array<T>&& o) : length(o.length), mEnd(this) {
 		const_cast<int&>(o.length) = 0;
 		a = o.a; o.a = null;
+		owner = o.owner; o.owner = true;
 		mEnd.idx = length; o.mEnd.idx = 0;
 	}
 	Array<T>& operator=(const Array<T>&o) {
 		if (this == &o) return *this;
 		if (length != o.length) {
-			delete [] a; const_cast<int&>(length) = 0;
+			if (owner) delete [] a;
+			a = null; owner = true;
+			const_cast<int&>(length) = 0;
 			a = new T[o.length];
 			const_cast<int&>(length) = o.length;
 		}
-		for (int i=0; i < length; ++i) a[i] = o.a[i];
+		copy(a, o.a, length);
 		mEnd.idx = length;
 		return *this;
 	}
 	Array<T>& operator=(Array<T>&& o) {
 		if (this == &o) return *this;
+		if (owner) delete [] a;
 		const_cast<int&>(length) = o.length; const_cast<int&>(o.length) = 0;
 		a = o.a; o.a = null;
-		mEnd.idx = length;
+		owner = o.owner; o.owner = true;
+		mEnd.idx = length; o.mEnd.idx = 0;
 		return *this;
 	}
 
@@ -199,13 +316,20 @@ public:
 		a = new T[l];
 		mEnd.idx = l;
 	}
-	Array(T* v, int l) : length(l), mEnd(this) {
+	Array(const T* v, int l) : length(l), mEnd(this) {
 		checkArrayBounds(l, l+1);
 		a = new T[l];
-		for (int i=0; i < l; ++i) a[i]=v[i];
+		copy(a, v, l);
 		mEnd.idx = l;
 	}
-	~Array() { delete [] a; }
+	~Array() { (void)&arrayClass; if (owner) delete [] a; }
+
+	/**
+	 * Returns an array backed by v, no copy is made.
+	 * The memory must outlive the returned array and all its moved-to instances.
+	 */
+	static Array<T> wrap(T* v, int l) { return Array<T>(v, l, false); }
+
 	T& operator[](int i) {
 		checkArrayBounds(i, length);
 		return a[i];
@@ -214,6 +338,12 @@ public:
 		checkArrayBounds(i, length);
 		return a[i];
 	}
+	void copyTo(int srcPos, AbstractArray& dest, int destPos, int length) const {
+		Array<T> *d = dynamic_cast<Array<T>*>(&dest);
+		checkArrayStore(d);
+		checkArrayCopy(srcPos, this->length, destPos, d->length, length);
+		copy(d->a + destPos, a + srcPos, length);
+	}
 
 	// c++11 range-based loops [[for ( range_declaration : range_expression ) loop_statement;]]
 	class ArrayRange {
@@ -235,9 +365,13 @@ private:
 	ArrayRange mEnd;
 };
 template<class T>
+const Class& Array<T>::arrayClass = AbstractArray::registerArrayClass(typeid(Array<T>));
+
+// array over a buffer owned by someone else
+template<class T>
 class BufArray : extends Array<T> {
-	using Array<T>::Array;
-	~BufArray() { this->a=null;}
+public:
+	BufArray(T* v, int l) : Array<T>(v, l, false) {}
 };
 
 //usage if: (instanceof<Integer>(objPtr)) {...}
@@ -0,0 +1,51 @@
+#ifndef __LANG_PROFILER_HPP
+#define __LANG_PROFILER_HPP
+
+#include <lang/String.hpp>
+
+namespace lang {
+
+/**
+ * Function entry profiler for code built with -finstrument-functions -DINSTRUMENTATION
+ * (e.g. make DEBUG="-g -finstrument-functions -DINSTRUMENTATION").
+ * Enter and exit events go to a lock free ring of the calling thread, a background
+ * thread appends them to path.events while recording. stop() symbolizes the functions
+ * and writes path.json (Chrome trace events, for chrome://tracing or Perfetto) and
+ * path.txt (calls, inclusive and exclusive time per function).
+ */
+class Profiler final {
+public:
+	Profiler() = delete;
+
+	/**
+	 * Records only the functions in [begin, end), all of them if begin == end.
+	 */
+	static void setAddressRange(const void *begin, const void *end);
+	/**
+	 * Writes only the functions whose demangled name starts with one of the prefixes
+	 * (all without prefixes), the time of the others counts to their nearest written caller.
+	 */
+	static void addSymbolPrefix(const String& prefix);
+	static void clearSymbolPrefixes();
+
+	/**
+	 * @throws IOException
+	 */
+	static void start(const String& path);
+	/**
+	 * Stops recording and writes the outputs.
+	 * @throws IOException
+	 */
+	static void stop();
+	static boolean isRecording();
+	// events lost to full rings
+	static jlong getDropped();
+
+	// called by the instrumentation hooks
+	static void enter(const void *fn);
+	static void leave(const void *fn);
+};
+
+}
+
+#endif
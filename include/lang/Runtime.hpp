@@ -15,9 +15,13 @@ class Shutdown final {
 };
 
 class Runtime : extends Object {
+	friend class Thread;
 private:
 	static io::File null_file;
 	static Runtime currentRuntime;
+	// threads started as Thread (and main) can be sampled
+	static void threadStarted();
+	static void threadFinished();
 public:
 	static Runtime& getRuntime() { return currentRuntime; }
 	void exit(int status) {Shutdown::exit(status);}
@@ -57,6 +61,23 @@ public:
 	long maxMemory() {return 0;}
 	void gc() {}
 	void runFinalization() {}
+	/**
+	 * Sampling CPU profiler: a timer on the CPU clock of each thread started as Thread
+	 * (and main) sends SIGPROF at the frequency, the handler stores a backtrace in
+	 * a preallocated ring of the thread. The samples are aggregated and symbolized
+	 * by a background thread and dump.
+	 * @throws IllegalStateException when already profiling
+	 */
+	void startProfiling(int frequency = 100);
+	void stopProfiling();
+	boolean isProfiling();
+	/**
+	 * Writes the stacks sampled since start as folded stacks, one
+	 * "thread;outermost;...;innermost count" per line (input of flamegraph.pl).
+	 */
+	void dumpProfile(io::PrintStream& out);
+	// samples lost to full rings
+	jlong getProfileDropped();
 	void traceInstructions(boolean on) {}
 	void traceMethodCalls(boolean on) {}
 	void load(String filename) {}
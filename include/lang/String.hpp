@@ -2,6 +2,7 @@
 #define __LANG_STRING_HPP
 
 #include <lang/Comparable.hpp>
+#include <lang/StringKernels.hpp>
 #include <algorithm>
 #include <cstdarg>
 #include <iostream>
@@ -30,31 +31,95 @@ public:
 	virtual String toString() const = 0;
 };
 
+/**
+ * Immutable character string.
+ * Up to SSO_MAX characters are stored inline. Longer strings live in a shared,
+ * reference counted buffer: copies and substrings point into it without copying.
+ */
 class String final : extends Object, implements CharSequence, implements Comparable<String> {
+	friend class StringBuilder;
+	friend class Character;
 private:
-	std::string value;
-	long hash = 0;
+	static const int SSO_MAX = 15;
+	struct Buffer {
+		std::atomic<int> refs;
+		std::atomic<jint> hash;  // of the whole buffer
+		int length;              // characters in use, data[length] is 0
+		int capacity;
+		char data[1];
+	};
 
-	static const char * emptystr;
-	static void copystr(String *d, const char *s);
-	static void copy(String *d, const String *s);
-	static void move(String *d, const String *s);
+	const char *ptr;     // the characters, inline or within buf
+	Buffer *buf;         // null for inline strings
+	int len;
+	mutable jint hash = 0;
+	union {
+		char sso[SSO_MAX+1];
+		mutable std::atomic<Buffer*> zbuf;  // 0 terminated copy of a substring, made by cstr()
+	};
 
+	static Buffer *allocate(int capacity);
+	static void release(Buffer *b);
+	// takes over a reference to b, which holds n characters
+	String(Buffer *b, int n);
+	static String concat(const char *a, int alen, const char *b, int blen);
+
+	[[noreturn]] static void nullPointer();
+	[[noreturn]] static void outOfBounds(int beginIndex, int endIndex);
 	static String valueHex(long);
 	static String className(const std::type_info&);
 
+	void assign(const char *s, int n);
+	// this must be unset (constructed or cleared)
+	void share(const String& o, int offset, int n) {
+		if (n <= SSO_MAX) {
+			std::memcpy(sso, o.ptr + offset, (size_t)n);
+			sso[n] = 0;
+			ptr = sso; buf = null; len = n; hash = 0;
+		}
+		else shareBuffer(o, offset, n);
+	}
+	void shareBuffer(const String& o, int offset, int n);
+	void move(String& o);
+	void clear() {
+		if (buf != null) {
+			release(buf);
+			Buffer *z = zbuf.load(std::memory_order_relaxed);
+			if (z != null) release(z);
+		}
+	}
+	void append(const char *s, int n);
 	void init(const byte* s, int vlen, int offset, int count);
+	String(const char *s, int n) { assign(s, n); }
+
+	static int compare(const char *a, int alen, const char *b, int blen) {
+		int r = std::memcmp(a, b, (size_t)std::min(alen, blen));
+		return r != 0 ? r : alen - blen;
+	}
+	static jint hashOf(const char *s, int n) {
+		return StringKernels::hash(s, n);
+	}
 public:
-	String(String&& o) {move(this,&o);}
-	String(const String& o) {copy(this,&o); }
-	String& operator=(String&& o) {move(this,&o);return*this;}
-	String& operator=(const String& o) {copy(this,&o);return*this;}
-	String(const std::string& v) {value = v; }
+	String(String&& o) {move(o);}
+	String(const String& o) {share(o, 0, o.len); hash = o.hash;}
+	String& operator=(String&& o) {
+		if (this != &o) { clear(); move(o); }
+		return*this;
+	}
+	String& operator=(const String& o) {
+		if (this != &o) { String t(o); clear(); move(t); }
+		return*this;
+	}
+	~String() { clear(); }
+	String(const std::string& v) { assign(v.data(), (int)v.length()); }
 
-	String(const char *v) {copystr(this, v); }
-	explicit String(const std::nullptr_t&) {copystr(this, (const char *)0); }
+	String(const char *v) {
+		if (v == null) nullPointer();
+		assign(v, (int)std::strlen(v));
+	}
+	explicit String(const std::nullptr_t&) : String((const char *)0) {}
 
-	String() : value(emptystr) {}
+	String() { assign(null, 0); }
 	String(const Array<char>& s) : String(s, 0, s.length) {}
 	String(const Array<char>& s, int offset, int count);
 	String(const Array<int>& cp, int offset, int count);
@@ -65,152 +130,157 @@ public:
 	String(const Array<byte>& s) : String(s, 0, s.length) {}
 	String(const Array<byte>& s, int offset, int count);
 
-	const std::string& intern() const { return value; }
-	const char *cstr() const { return value.c_str(); }
+	std::string intern() const { return std::string(ptr, (size_t)len); }
+	/**
+	 * Returns the characters 0 terminated.
+	 * A substring in the middle of a shared buffer is copied once, on the first call.
+	 */
+	const char *cstr() const {
+		if (ptr[len] == 0) return ptr;
+		return terminated();
+	}
+	const char *terminated() const;
 
-	int length() const { return (int)value.length(); }
-	boolean isEmpty() const { return value.length() == 0; }
+	int length() const { return len; }
+	boolean isEmpty() const { return len == 0; }
 	char charAt(int index) const;
 	void getChars(int srcBegin, int srcEnd, char dst[], int dstBegin) const;
 	Array<byte> getBytes() const {
-		return Array<byte>((byte*)value.c_str(),(int)value.length());
+		return Array<byte>((const byte*)ptr, len);
 	}
 	Array<byte> getBytes(const String& charsetName) const;
 	Array<byte> getBytes(const nio::charset::Charset& charset) const;
 
 	String operator+(char c) const {
-		return value+c;
+		return concat(ptr, len, &c, 1);
 	}
 	String operator+(const char *s) const {
-		if (s == null) return value+"<null>";
-		return value+s;
+		if (s == null) s = "<null>";
+		return concat(ptr, len, s, (int)std::strlen(s));
 	}
 	String operator+(char *s) const {
-		if (s == null) return value+"<null>";
-		return value+s;
+		return *this + (const char *)s;
 	}
 	String operator+(const std::string& s) const {
-		return value+s;
+		return concat(ptr, len, s.data(), (int)s.length());
 	}
 	String operator+(const String& s) const {
-		return value+s.value;
+		if (len == 0) return s;
+		if (s.len == 0) return *this;
+		return concat(ptr, len, s.ptr, s.len);
 	}
 	String operator+(const Object& s) const {
-		return value+s.toString().intern();
+		return *this + s.toString();
 	}
-	template<class T, class std::enable_if<!std::is_base_of<Object,T>::value,Object>::type* = nullptr>
-	String operator+(const T& v) const {
-		return value+std::to_string(v);
+	// numbers as String::valueOf prints them
+	template<class T, typename std::enable_if<(std::is_integral<T>::value && std::is_signed<T>::value) || std::is_enum<T>::value>::type* = nullptr>
+	String operator+(T v) const {
+		return *this + valueOf((long)v);
+	}
+	template<class T, typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type* = nullptr>
+	String operator+(T v) const {
+		return *this + (std::is_same<T, bool>::value ? valueOf((boolean)v) : valueOf((unsigned long)v));
+	}
+	template<class T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+	String operator+(T v) const {
+		return *this + (sizeof(T) == sizeof(float) ? valueOf((float)v) : valueOf((double)v));
 	}
 	String& operator+=(char rhs){
-		value += rhs;
+		append(&rhs, 1);
 		return *this;
 	}
 	String& operator+=(const char *rhs){
-		if (rhs == null) value += "<null>";
-		else value += rhs;
+		if (rhs == null) rhs = "<null>";
+		append(rhs, (int)std::strlen(rhs));
 		return *this;
 	}
 	String& operator+=(const String& rhs){
-		value += rhs.value;
+		if (len == 0) return *this = rhs;
+		append(rhs.ptr, rhs.len);
 		return *this;
 	}
 	boolean equals(const char *str) const {
-		return str==null ? value == "" : value == str;
+		if (str == null) return len == 0;
+		// the length first, str may be shorter than len (or ptr hold a 0)
+		return ::strnlen(str, (size_t)len + 1) == (size_t)len && std::memcmp(ptr, str, (size_t)len) == 0;
 	}
 	boolean equals(const String& o) const {
 		if (this == &o) return true;
-		return value == o.value;
+		if (len != o.len) return false;
+		if (ptr == o.ptr) return true;
+		if (hash != 0 && o.hash != 0 && hash != o.hash) return false;
+		return StringKernels::equals(ptr, o.ptr, len);
 	}
 	boolean equals(const Object& o) const {
 		if (this == &o) return true;
 		if (!instanceof<String>(&o)) return false;
-		return value == ((const String&)o).value;
+		return equals((const String&)o);
 	}
 	boolean equalsIgnoreCase(const String& s) const {
-		size_t sz = value.size();
-		if (s.value.size() != sz) return false;
-		for (size_t i=0; i < sz; ++i) {
-			if (tolower(value[i]) != tolower(s.value[i])) return false;
-		}
-		return true;
+		if (s.len != len) return false;
+		return ptr == s.ptr || StringKernels::equalsIgnoreCase(ptr, s.ptr, len);
 	}
 
 	boolean startsWith(const String& prefix, int toffset) const {
-		int pc = (int)prefix.value.length();
-		if ((toffset < 0) || (toffset > length() - pc)) {
+		if ((toffset < 0) || (toffset > len - prefix.len)) {
 			return false;
 		}
-		for (unsigned po = 0; --pc >= 0; ++toffset,++po) {
-			if (value[(unsigned)toffset] != prefix.value[po]) return false;
-		}
-		return true;
+		return StringKernels::equals(ptr + toffset, prefix.ptr, prefix.len);
 	}
 	boolean startsWith(const String& prefix) const {
 		return startsWith(prefix, 0);
 	}
 	boolean endsWith(const String& suffix) const {
-		return startsWith(suffix, (int)(value.length() - suffix.value.length()));
+		return startsWith(suffix, len - suffix.len);
 	}
 
 	jint hashCode() const {
 		jint h = hash;
-		if (h == 0 && value.length() > 0) {
-			for (int i = 0; i < length(); i++) {
-				h = 31 * h + value[(unsigned)i];
+		if (h == 0 && len > 0) {
+			boolean whole = buf != null && ptr == buf->data && len == buf->length;
+			if (whole) h = buf->hash.load(std::memory_order_relaxed);
+			if (h == 0) {
+				h = hashOf(ptr, len);
+				if (whole) buf->hash.store(h, std::memory_order_relaxed);
 			}
-			const_cast<jint&>(this->hash) = h;
+			hash = h;
 		}
 		return h;
 	}
 
-	int indexOf(int ch, int fromIndex=0) const { return (int)value.find((char)ch, (unsigned)fromIndex); }
-	int indexOf(const String& str, int fromIndex=0) const { return (int)value.find(str.value, (unsigned)fromIndex); }
+	int indexOf(int ch, int fromIndex=0) const {
+		if (fromIndex < 0) fromIndex = 0;
+		if (fromIndex >= len) return -1;
+		const char *p = (const char *)std::memchr(ptr + fromIndex, (char)ch, (size_t)(len - fromIndex));
+		return p == null ? -1 : (int)(p - ptr);
+	}
+	int indexOf(const String& str, int fromIndex=0) const;
 
 	int lastIndexOf(int ch, int fromIndex=-1) const {
-	   return (int)value.rfind((char)ch, fromIndex < 0 ? std::string::npos : (unsigned)fromIndex);
-	}
-	int lastIndexOf(const String& str, int fromIndex=-1) const {
-		return (int)value.rfind(str.value, fromIndex < 0 ? std::string::npos : (unsigned)fromIndex);
+		if (fromIndex < 0 || fromIndex >= len) fromIndex = len - 1;
+		for (int i = fromIndex; i >= 0; --i) {
+			if (ptr[i] == (char)ch) return i;
+		}
+		return -1;
 	}
+	int lastIndexOf(const String& str, int fromIndex=-1) const;
 
 	String substring(int beginIndex) const {
-		return value.substr((unsigned)beginIndex);
+		return substring(beginIndex, len);
 	}
 	String substring(int beginIndex, int endIndex) const {
-		return value.substr((unsigned)beginIndex,(unsigned)(endIndex-beginIndex));
+		if (beginIndex < 0 || endIndex > len || beginIndex > endIndex) outOfBounds(beginIndex, endIndex);
+		String r;
+		r.share(*this, beginIndex, endIndex - beginIndex);
+		return r;
 	}
 	Shared<CharSequence> subSequence(int beginIndex, int endIndex) const {
 		return makeShared<String>(substring(beginIndex, endIndex));
 	}
 	String concat(String str) { return *this + str; }
-	String replace(char oldChar, char newChar) const {
-		if (oldChar != newChar) {
-			int len = (int)value.length();
-			int i = -1;
-			const std::string& val = value;
-			while (++i < len) {
-				if (val[(unsigned)i] == oldChar) {
-					break;
-				}
-			}
-			if (i < len) {
-				std::string buf((unsigned)len, ' ');
-				for (int j = 0; j < i; j++) {
-					buf[(unsigned)j] = val[(unsigned)j];
-				}
-				while (i < len) {
-					char c = val[(unsigned)i];
-					buf[(unsigned)i] = (c == oldChar) ? newChar : c;
-					i++;
-				}
-				return String(buf);
-			}
-		}
-		return String(*this);
-	}
+	String replace(char oldChar, char newChar) const;
 	int compareTo(const String& anotherString) const {
-		return value.compare(anotherString.value);
+		return compare(ptr, len, anotherString.ptr, anotherString.len);
 	}
 	int compareToIgnoreCase(const String& str) const {
 		return compareTo(str);
@@ -222,39 +292,37 @@ public:
 	boolean contains(const String& s) const {
 		return indexOf(s) > -1;
 	}
-	String toLowerCase(Locale locale) const {
-		std::string s(value);
-		std::transform(s.begin(), s.end(), s.begin(), ::tolower);
-		return s;
-   	}
+	String toLowerCase(Locale locale) const;
 	String toLowerCase() const {
 		return toLowerCase(Locale::getDefault());
 	}
-	String toUpperCase(Locale locale) const {
-		std::string s(value);
-		std::transform(s.begin(), s.end(), s.begin(), ::toupper);
-		return s;
-	}
+	String toUpperCase(Locale locale) const;
 	String toUpperCase() const {
 		return toUpperCase(Locale::getDefault());
 	}
-	String trim() const { return *this; }
+	String trim() const {
+		int b = 0, e = len;
+		while (b < e && (unsigned char)ptr[b] <= ' ') ++b;
+		while (e > b && (unsigned char)ptr[e-1] <= ' ') --e;
+		return (b > 0 || e < len) ? substring(b, e) : *this;
+	}
 	String toString() const {
 		return *this;
 	}
 
 	static String valueOf(boolean b) {return b ? "true" : "false"; }
-	static String valueOf(char n) {return std::string(1,n); }
-	static String valueOf(short n) {return std::to_string(n); }
-	static String valueOf(unsigned short n) {return std::to_string(n); }
-	static String valueOf(int n) {return std::to_string(n); }
-	static String valueOf(unsigned n) {return std::to_string(n); }
-	static String valueOf(long n) {return std::to_string(n); }
-	static String valueOf(unsigned long n) {return std::to_string(n); }
-	static String valueOf(jlong n) {return std::to_string(n); }
-	static String valueOf(float n) {return std::to_string(n); }
-	static String valueOf(double n) {return std::to_string(n); }
+	static String valueOf(char n) {return String(&n, 1); }
+	static String valueOf(short n) {return valueOf((long)n); }
+	static String valueOf(unsigned short n) {return valueOf((unsigned long)n); }
+	static String valueOf(int n) {return valueOf((long)n); }
+	static String valueOf(unsigned n) {return valueOf((unsigned long)n); }
+	static String valueOf(long n);
+	static String valueOf(unsigned long n);
+	static String valueOf(jlong n) {return valueOf((long)n); }
+	static String valueOf(float n);
+	static String valueOf(double n);
 
+	static String copyValueOf(const char *data, int offset, int count) {return String(data + offset, count);}
 	static String valueOf(const char *s) {return s;}
 	static String valueOf(char *s) {return valueOf((const char*)s);}
 	static String valueOf(const Object& obj) { return obj.toString(); }
@@ -267,54 +335,182 @@ public:
 	template<class T, class std::enable_if<!std::is_base_of<Object,T>::value,Object>::type* = nullptr>
 	static String valueOf(const T& t) {return className(typeid(t)) + "@" + valueHex((long)&t); }
 
-	static String format(String fmt, ...) {
-		va_list args;
-		va_start(args, fmt);
-		String s = format(fmt.cstr(), args);
-		va_end(args);
-		return s;
-	}
-	static String format(const char *fmt, ...) {
-		va_list args;
-		va_start(args, fmt);
-		String s = format(fmt, args);
-		va_end(args);
-		return s;
+	/**
+	 * printf style formatting, checked against the argument types:
+	 * a conversion that does not fit its argument throws IllegalFormatException,
+	 * an argument type that cannot be formatted does not compile.
+	 * Objects are formatted with %s through toString().
+	 */
+	template<class... Args>
+	static String format(const char *fmt, const Args&... args);
+	template<class... Args>
+	static String format(const String& fmt, const Args&... args) {
+		return format(fmt.cstr(), args...);
 	}
 	static String format(const char *fmt, va_list& args);
 };
 
+/**
+ * Mutable sequence of characters in a contiguous buffer.
+ * toString() shares the buffer with the returned String, the next modification
+ * of the builder copies it first.
+ */
 class StringBuilder : extends Object {
+	friend class String;
 private:
-	std::stringstream value;
+	String::Buffer *buf;
+	int len = 0;
+
+	void grow(int minCapacity);
+	void unshare(int keep);
+	char *reserve(int n) {
+		if (buf->refs.load(std::memory_order_acquire) != 1) unshare(len);
+		if (len + n > buf->capacity) grow(len + n);
+		return buf->data + len;
+	}
+	StringBuilder& appendChars(const char *s, int n) {
+		std::memcpy(reserve(n), s, (size_t)n);
+		len += n;
+		return *this;
+	}
+	StringBuilder& appendSigned(jlong v);
+	StringBuilder& appendUnsigned(unsigned long long v);
+	StringBuilder& appendFloat(float v);
+	StringBuilder& appendDouble(double v);
+
+	// argument types accepted by appendFormat
+	template<class T> struct Formattable {
+		static const bool value = std::is_arithmetic<T>::value || std::is_enum<T>::value ||
+			std::is_pointer<T>::value || std::is_array<T>::value ||
+			std::is_base_of<Object,T>::value || std::is_same<T,std::string>::value;
+	};
+	// expected formatted length of the arguments, to size the buffer once
+	static int sizeHint() { return 0; }
+	template<class T, class... Args>
+	static int sizeHint(const T& arg, const Args&... args) { return argSize(arg) + sizeHint(args...); }
+	template<class T>
+	static int argSize(const T&) { return 16; }
+	static int argSize(const String& s) { return s.len; }
+	static int argSize(const std::string& s) { return (int)s.length(); }
+	// appends fmt up to the next conversion, which is returned in spec without a length modifier
+	const char *nextConversion(const char *fmt, char *spec, char& conv);
+	void formatSigned(const char *spec, char conv, long long v);
+	void formatUnsigned(const char *spec, char conv, unsigned long long v);
+	void formatDouble(const char *spec, char conv, double v);
+	void formatBoolean(const char *spec, char conv, boolean v);
+	void formatString(const char *spec, char conv, const char *v, int n);
+	void formatPointer(const char *spec, char conv, const void *v);
+	void formatArg(const char *spec, char conv, boolean v) { formatBoolean(spec, conv, v); }
+	void formatArg(const char *spec, char conv, const char *v) {
+		if (v == null) v = "null";
+		formatString(spec, conv, v, (int)std::strlen(v));
+	}
+	void formatArg(const char *spec, char conv, const String& v) { formatString(spec, conv, v.ptr, v.len); }
+	void formatArg(const char *spec, char conv, const std::string& v) { formatString(spec, conv, v.data(), (int)v.length()); }
+	void formatArg(const char *spec, char conv, const Object& v) { formatArg(spec, conv, v.toString()); }
+	void formatArg(const char *spec, char conv, const void *v) { formatPointer(spec, conv, v); }
+	template<class T, typename std::enable_if<(std::is_integral<T>::value && std::is_signed<T>::value) || std::is_enum<T>::value>::type* = nullptr>
+	void formatArg(const char *spec, char conv, T v) {
+		// the unsigned conversions show the bits of the argument's own width
+		if (conv == 'o' || conv == 'u' || conv == 'x' || conv == 'X') formatUnsigned(spec, conv, (unsigned long long)(typename std::make_unsigned<T>::type)v);
+		else formatSigned(spec, conv, (long long)v);
+	}
+	template<class T, typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type* = nullptr>
+	void formatArg(const char *spec, char conv, T v) { formatUnsigned(spec, conv, (unsigned long long)v); }
+	template<class T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+	void formatArg(const char *spec, char conv, T v) { formatDouble(spec, conv, (double)v); }
 public:
-	StringBuilder() {}
-	StringBuilder(int capacity) {
+	StringBuilder(const StringBuilder& o) = delete;
+	StringBuilder& operator=(const StringBuilder& o) = delete;
+	StringBuilder(StringBuilder&& o) : buf(o.buf), len(o.len) {
+		o.buf = String::allocate(0); o.len = 0;
 	}
+	StringBuilder() : StringBuilder(16) {}
+	StringBuilder(int capacity) : buf(String::allocate(capacity < 0 ? 0 : capacity)) {}
+	StringBuilder(const String& str) : StringBuilder(str.length() + 16) {
+		append(str);
+	}
+	~StringBuilder() { String::release(buf); }
+
+	int length() const { return len; }
+	int capacity() const { return buf->capacity; }
+	void ensureCapacity(int minimumCapacity) {
+		if (minimumCapacity > buf->capacity) grow(minimumCapacity);
+	}
+	void setLength(int newLength);
+	char charAt(int index) const;
+	void setCharAt(int index, char ch);
+
 	StringBuilder& append(char v) {
-		value << v;
+		*reserve(1) = v;
+		++len;
 		return *this;
 	}
 	StringBuilder& append(const char *str) {
-		value << str;
-		return *this;
+		if (str == null) str = "null";
+		return appendChars(str, (int)std::strlen(str));
 	}
 	StringBuilder& append(const String& str) {
-		value << str.intern();
-		return *this;
+		return appendChars(str.ptr, str.len);
+	}
+	StringBuilder& append(boolean b) {
+		return b ? appendChars("true", 4) : appendChars("false", 5);
+	}
+	StringBuilder& append(int v) { return appendSigned(v); }
+	StringBuilder& append(long v) { return appendSigned(v); }
+	StringBuilder& append(jlong v) { return appendSigned(v); }
+	StringBuilder& append(unsigned v) { return appendUnsigned(v); }
+	StringBuilder& append(unsigned long v) { return appendUnsigned(v); }
+	StringBuilder& append(unsigned long long v) { return appendUnsigned(v); }
+	StringBuilder& append(float v) { return appendFloat(v); }
+	StringBuilder& append(double v) { return appendDouble(v); }
+	StringBuilder& append(const Object& obj) {
+		return append(obj.toString());
 	}
 	template<class T>
 	StringBuilder& append(const T& t) {
-		value << String::valueOf(t).intern();
-		return *this;
+		return append(String::valueOf(t));
 	}
-	String toString() const {
-		return value.str();
+
+	StringBuilder& insert(int offset, const String& str);
+	StringBuilder& insert(int offset, const char *str) {
+		return insert(offset, String(str == null ? "null" : str));
+	}
+	StringBuilder& insert(int offset, char c) {
+		return insert(offset, String::valueOf(c));
 	}
+	StringBuilder& reverse();
+
+	/**
+	 * Appends printf formatted text, with no length limit.
+	 */
+	StringBuilder& appendFormat(const char *fmt, va_list& args);
+	StringBuilder& appendFormat(const char *fmt);
+	/**
+	 * Appends formatted text, the conversions are checked against the argument types.
+	 * @see String::format
+	 */
+	template<class T, class... Args>
+	StringBuilder& appendFormat(const char *fmt, const T& arg, const Args&... args) {
+		static_assert(Formattable<T>::value, "argument type cannot be formatted");
+		char spec[32], conv;
+		fmt = nextConversion(fmt, spec, conv);
+		formatArg(spec, conv, arg);
+		return appendFormat(fmt, args...);
+	}
+
+	String toString() const;
 };
 
+template<class... Args>
+String String::format(const char *fmt, const Args&... args) {
+	StringBuilder sb((int)std::strlen(fmt) + StringBuilder::sizeHint(args...));
+	sb.appendFormat(fmt, args...);
+	return sb.toString();
+}
+
 inline String operator+(const char *a,const String& s) {
-	return a + s.intern();
+	return String(a) + s;
 }
 }
 
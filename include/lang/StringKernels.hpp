@@ -0,0 +1,70 @@
+#ifndef __LANG_STRINGKERNELS_HPP
+#define __LANG_STRINGKERNELS_HPP
+
+#include <lang/Object.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace lang {
+
+/**
+ * Byte string kernels used by String.
+ * The implementation is chosen on first use for the instruction set of the cpu
+ * (AVX2, SSE2 or portable scalar code), all of them give identical results.
+ */
+class StringKernels final {
+public:
+	struct Impl {
+		const char *name;
+		// Java compatible polynomial hash: s[0]*31^(n-1) + ... + s[n-1] in 32 bit arithmetic
+		jint (*hash)(const char *s, int n);
+		// ASCII case insensitive equality of n bytes
+		boolean (*equalsIgnoreCase)(const char *a, const char *b, int n);
+		// index of p[0..m) in s[0..n) or -1
+		int (*indexOf)(const char *s, int n, const char *p, int m);
+	};
+	static const Impl scalar;
+
+	/**
+	 * Fills impls with the implementations this cpu can run, best last.
+	 * @return the number of implementations
+	 */
+	static int getImplementations(const Impl *impls[], int max);
+	static const Impl& getActive() { return *impl(); }
+	/**
+	 * Selects the implementation by name, returns false if it is not supported.
+	 */
+	static boolean setActive(const char *name);
+
+	static jint hash(const char *s, int n) { return impl()->hash(s, n); }
+	static boolean equalsIgnoreCase(const char *a, const char *b, int n) { return impl()->equalsIgnoreCase(a, b, n); }
+	static int indexOf(const char *s, int n, const char *p, int m) { return impl()->indexOf(s, n, p, m); }
+
+	// equality of n bytes, short strings are compared with (overlapping) word loads
+	static boolean equals(const char *a, const char *b, int n) {
+		if (n >= 8) {
+			if (n > 16) return std::memcmp(a, b, (size_t)n) == 0;
+			return (load64(a) ^ load64(b)) == 0 && (load64(a + n - 8) ^ load64(b + n - 8)) == 0;
+		}
+		if (n >= 4) return (load32(a) ^ load32(b)) == 0 && (load32(a + n - 4) ^ load32(b + n - 4)) == 0;
+		for (int i=0; i < n; ++i) {
+			if (a[i] != b[i]) return false;
+		}
+		return true;
+	}
+
+private:
+	static std::atomic<const Impl*> active;
+	static const Impl *select();
+	static const Impl *impl() {
+		const Impl *i = active.load(std::memory_order_relaxed);
+		return i != null ? i : select();
+	}
+	static uint64_t load64(const char *p) { uint64_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+	static uint32_t load32(const char *p) { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+};
+
+}
+
+#endif
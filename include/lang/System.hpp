@@ -13,7 +13,6 @@ class System final : Interface {
 private:
 	static Properties props;
 	static String lineSep;
-	static void arraycopy(const void *src, int srcPos, void *dest, int destPos, int length);
 public:
 	System() = delete;
 
@@ -33,10 +32,14 @@ public:
 	 */
 	static jlong nanoTime();
 	static void arraycopy(const Object& src, int srcPos, Object& dest, int destPos, int length);
+	/**
+	 * Copies with memmove for trivially copyable elements, overlapping ranges
+	 * within the same array are copied as if through a temporary array.
+	 */
 	template<class T>
 	static void arraycopy(const Array<T>& src, int srcPos, Array<T>& dest, int destPos, int length) {
-		//arraycopy(&src.a, srcPos*sizeof(T), dest.a, destPos*sizeof(T), length*sizeof(T));
-		for (int i=0; i < length; ++i) dest[destPos + i] = src[srcPos + i];
+		Array<T>::checkArrayCopy(srcPos, src.length, destPos, dest.length, length);
+		Array<T>::copy(dest.a + destPos, src.a + srcPos, length);
 	}
 	static int identityHashCode(const Object& o) {
 		throw UnsupportedOperationException();
@@ -76,44 +79,180 @@ public:
 	}
 };
 
+#ifndef LOG_LEVEL
+// calls above this level are compiled out (0 errors only, 4 everything)
+#define LOG_LEVEL 4
+#endif
+
+/**
+ * Asynchronous logger.
+ * Each thread appends its records to its own lock-free ring buffer, a background
+ * writer thread drains the rings in time order and writes them in batches to stderr.
+ * Records are written synchronously when the writer is not running (after shutdown).
+ */
 class Logger : extends Object {
+public:
+	enum Level { ERROR, WARN, NOTICE, INFO, DEBUG };
+	// what a thread does when its ring buffer is full
+	enum Overflow {
+		DROP,   // the record is discarded
+		COUNT,  // the record is discarded, the number of discarded records is logged later
+		BLOCK,  // the thread waits for the writer
+	};
+
+	// call site of the binary log, written to the file on first use
+	struct Site {
+		const char *file;
+		unsigned line;
+		Level level;
+		std::atomic<const char*> format;     // published by the generation
+		std::atomic<int> id;
+		std::atomic<int> generation;  // of the file the id belongs to
+	};
+	// tagged raw arguments of a binary record
+	class Arguments {
+	public:
+		static const int MAX_SIZE = 4096;
+		char data[MAX_SIZE];
+		int length = 0;
+
+		void add() {}
+		template<class T, class... Args>
+		void add(T v, Args... args) { put(v); add(args...); }
+
+	private:
+		void put(char tag, const void *v, int n) {
+			if (length + 1 + n > MAX_SIZE) return;
+			data[length] = tag;
+			std::memcpy(data + length + 1, v, (size_t)n);
+			length += 1 + n;
+		}
+		// integers are sign or zero extended, the decoder narrows them again
+		template<class T>
+		typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type put(T v) {
+			jlong x = (jlong)v;
+			put('i', &x, sizeof(x));
+		}
+		template<class T>
+		typename std::enable_if<std::is_floating_point<T>::value>::type put(T v) {
+			double x = (double)v;
+			put('f', &x, sizeof(x));
+		}
+		void put(const char *s) {
+			if (s == null) s = "(null)";
+			int room = MAX_SIZE - length - 5;
+			if (room < 0) return;
+			int32_t n = (int32_t)strnlen(s, (size_t)room);
+			put('s', &n, sizeof(n));
+			std::memcpy(data + length, s, (size_t)n);
+			length += n;
+		}
+		void put(char *s) { put((const char *)s); }
+		void put(const void *p) {
+			uint64_t x = (uint64_t)p;
+			put('p', &x, sizeof(x));
+		}
+	};
+
 private:
 	static boolean release;
-	void format(const char *fn, unsigned ln, int level, const char *fmt, va_list& args) const;
+	static std::atomic<int> level;
+	static std::atomic<boolean> binaryMode;
+	void format(const char *fn, unsigned ln, Level level, const char *fmt, va_list& args) const;
+	void binaryRecord(Site& site, const char *fmt, const Arguments& args) const;
 
 public:
+	static boolean isLoggable(Level l) {
+		return l <= LOG_LEVEL && l <= level.load(std::memory_order_relaxed);
+	}
+	static void setLevel(Level l) { level.store(l, std::memory_order_relaxed); }
+	// release records carry the date but not the source position
+	static boolean isRelease() { return release; }
+	static void setRelease(boolean r) { release = r; }
+	static void setOverflow(Overflow policy);
+	// records go to this file descriptor, stderr by default
+	static void setOutput(int fd);
+	// number of records discarded so far
+	static jlong getDropped();
+	/**
+	 * Waits until all records logged before the call are written.
+	 */
+	static void flush();
+	/**
+	 * Writes out what the ring buffers hold, async-signal-safe.
+	 * Called by the fatal signal and terminate handlers.
+	 */
+	static void flushOnCrash();
+
+	/**
+	 * Binary mode: each call site is described once in the file, a record holds only
+	 * the site id, the time, the thread id and the raw arguments, appended to the
+	 * memory mapped file without formatting. Records beyond capacity are dropped.
+	 * The file is decoded offline to the text of the normal mode (build target logdecode).
+	 * @throws IOException
+	 */
+	static void openBinary(const String& path, jlong capacity = 1l << 30);
+	static void closeBinary();
+	static boolean isBinary() { return binaryMode.load(std::memory_order_relaxed); }
+	/**
+	 * Writes the text of the records in a binary log file to fd.
+	 * @throws IOException
+	 */
+	static void decodeBinary(const String& path, int fd);
+	/**
+	 * Formats one line as the text mode writes it (not terminated), returns the number of chars.
+	 */
+	static int formatLine(char *buf, int size, jlong millis, long gmtoff, Level level, const char *thread,
+			const char *file, unsigned line, const char *text, int length);
+
+	template<class... Args>
+	void binary(Site& site, const char *fmt, Args... args) const {
+		Arguments a;
+		a.add(args...);
+		binaryRecord(site, fmt, a);
+	}
+	void binary(Site& site, const String& s) const {
+		Arguments a;
+		a.add(s.cstr());
+		binaryRecord(site, "%s", a);
+	}
+
 	const Logger& error(const char *fn, unsigned ln, const String& s) const {
 		return error(fn, ln, "%s", s.cstr());
 	}
-	const Logger& error(const char *fn, unsigned ln, const char *fmt...) const;
+	const Logger& error(const char *fn, unsigned ln, const char *fmt...) const __attribute__((format(printf, 4, 5)));
 
 	const Logger& warn(const char *fn, unsigned ln, const String& s) const {
 		return warn(fn, ln, "%s", s.cstr());
 	}
-	const Logger& warn(const char *fn, unsigned ln, const char *fmt...) const;
+	const Logger& warn(const char *fn, unsigned ln, const char *fmt...) const __attribute__((format(printf, 4, 5)));
 
 	const Logger& debug(const char *fn, unsigned ln, const String& s) const {
 		return debug(fn, ln, "%s", s.cstr());
 	}
-	const Logger& debug(const char *fn, unsigned ln, const char *fmt...) const;
+	const Logger& debug(const char *fn, unsigned ln, const char *fmt...) const __attribute__((format(printf, 4, 5)));
 
 	const Logger& info(const char *fn, unsigned ln, const String& s) const {
 		return info(fn, ln, "%s", s.cstr());
 	}
-	const Logger& info(const char *fn, unsigned ln, const char *fmt...) const;
+	const Logger& info(const char *fn, unsigned ln, const char *fmt...) const __attribute__((format(printf, 4, 5)));
 
 	const Logger& notice(const char *fn, unsigned ln, const String& s) const {
 		return notice(fn, ln, "%s", s.cstr());
 	}
-	const Logger& notice(const char *fn, unsigned ln, const char *fmt...) const;
+	const Logger& notice(const char *fn, unsigned ln, const char *fmt...) const __attribute__((format(printf, 4, 5)));
 };
 extern const Logger SystemLog;
 
-#define LOGE(fmt...) SystemLog.error(__FILE__,__LINE__,fmt)
-#define LOGW(fmt...) SystemLog.warn(__FILE__,__LINE__,fmt)
-#define LOGD(fmt...) SystemLog.debug(__FILE__,__LINE__,fmt)
-#define LOGI(fmt...) SystemLog.info(__FILE__,__LINE__,fmt)
-#define LOGN(fmt...) SystemLog.notice(__FILE__,__LINE__,fmt)
+// the arguments are not evaluated when the level is disabled
+#define LOG_AT(lv, method, fmt, args...) (!Logger::isLoggable(lv) ? (void)0 : Logger::isBinary() ? \
+	({ static Logger::Site site = {__FILE__, __LINE__, lv}; SystemLog.binary(site, fmt, ##args); }) : \
+	(void)SystemLog.method(__FILE__, __LINE__, fmt, ##args))
+#define LOGE(fmt, args...) LOG_AT(Logger::ERROR, error, fmt, ##args)
+#define LOGW(fmt, args...) LOG_AT(Logger::WARN, warn, fmt, ##args)
+#define LOGD(fmt, args...) LOG_AT(Logger::DEBUG, debug, fmt, ##args)
+#define LOGI(fmt, args...) LOG_AT(Logger::INFO, info, fmt, ##args)
+#define LOGN(fmt, args...) LOG_AT(Logger::NOTICE, notice, fmt, ##args)
 
 #define LOGM(fmt...) SystemLog.method(__FILE__,__LINE__,__FUNCTION__,fmt)
 
@@ -1,6 +1,7 @@
 #ifndef __LANG_THREAD_HPP
 #define __LANG_THREAD_HPP
 
+#include <lang/Affinity.hpp>
 #include <lang/Class.hpp>
 #include <lang/String.hpp>
 #include <lang/Exception.hpp>
@@ -58,20 +59,15 @@ public:
 
 private:
 	std::thread *thread = null;
+	std::mutex joinLock;                 // one joiner calls std::thread::join at a time
 	boolean intr = false;
 	void selfupdate();
 
-#ifdef BACKTRACE
-	friend class CallTrace;
-	#define BACKTRACE_SIZE 2048
-	CallTrace *calltrace[BACKTRACE_SIZE];
-	unsigned calltrace_size = 0;
-	void tracePush(CallTrace *c);
-	CallTrace *tracePop();
-#endif
 	Thread *parent = null;
 	String  name;
-	int priority;
+	int priority = NORM_PRIORITY;
+	int realtimePriority = 0;
+	CpuSet affinity;                     // empty: not pinned
 	boolean daemon = false;
 	Runnable* target = null;
 	ThreadGroup *group = null;
@@ -97,6 +93,11 @@ private:
 	void start0();
 
 protected:
+	// the shadow stack pointer of the running thread, read by getStackTrace
+	std::atomic<CallTrace::Stack*> *callstack = null;
+	// kernel thread id while running, 0 before
+	int nativeId = 0;
+
 	Thread(const String& name, int status) : name(name), threadStatus(status) {}
 	Thread(ThreadGroup& group,const String& name, int status) : name(name), group(&group), threadStatus(status) {}
 	//void setId();
@@ -115,6 +116,7 @@ public:
 	Thread(Runnable& target, const String& name) : name(name), target(&target) {init();}
 	Thread(ThreadGroup& group, Runnable& target, const String& name) : name(name), target(&target), group(&group) {init();}
 	Thread(std::function<void()> f) : target(new RunnableFunction(f)) {init();}
+	Thread(ThreadGroup& group, std::function<void()> f) : target(new RunnableFunction(f)), group(&group) {init();}
 	~Thread();
 
 	virtual void start();
@@ -125,8 +127,29 @@ public:
 	virtual boolean isInterrupted() const final {return const_cast<Thread*>(this)->isInterrupted(false);}
 	virtual boolean isInterrupted(boolean ClearInterrupted);
 	virtual boolean isAlive() const final {return threadStatus != NEW && threadStatus != TERMINATED;}
+	/**
+	 * Sets the priority, at most the maximum of the group. On Linux the priorities
+	 * map to nice values 4..-5 of SCHED_OTHER (NORM_PRIORITY is nice 0); a priority
+	 * above NORM_PRIORITY needs CAP_SYS_NICE, without it the nice value stays.
+	 * @throws IllegalArgumentException when not in MIN_PRIORITY..MAX_PRIORITY
+	 */
 	virtual void setPriority(int newPriority);
 	virtual int getPriority() const final {return priority;}
+	/**
+	 * Runs the thread under SCHED_FIFO at priority 1..99, or back under SCHED_OTHER
+	 * when 0. Returns false when not permitted (CAP_SYS_NICE or RLIMIT_RTPRIO).
+	 * @throws IllegalArgumentException when not in 0..99
+	 */
+	boolean setRealtimePriority(int rtPriority);
+	int getRealtimePriority() const {return realtimePriority;}
+	/**
+	 * Pins the thread to the CPUs of cpus (applied when it starts, if not running yet),
+	 * an empty set unpins it.
+	 * @throws IllegalArgumentException when cpus has no CPU this process may run on
+	 */
+	void setAffinity(const CpuSet& cpus);
+	// the CPUs the thread may run on
+	CpuSet getAffinity() const;
 	void setName(const String& name);
 	const String& getName() const {return name;}
 	ThreadGroup& getThreadGroup() {return *group;}
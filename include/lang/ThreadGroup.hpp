@@ -11,20 +11,26 @@ using namespace io;
 
 class ThreadGroup : extends Object, implements Thread::UncaughtExceptionHandler {
 friend class Thread;
+public:
+	enum Placement { NONE, COMPACT, SCATTER, EXPLICIT };
 private:
 	ThreadGroup *parent;
 	String name;
 	int maxPriority;
-	boolean destroyed;
-	boolean daemon;
-	boolean vmAllowSuspension;
+	boolean destroyed = false;
+	boolean daemon = false;
+	boolean vmAllowSuspension = false;
 
 	int nUnstartedThreads = 0;
-	int nthreads;
+	int nthreads = 0;
 	Array<Thread*> threads;
-	int ngroups;
+	int ngroups = 0;
 	Array<ThreadGroup*> groups;
 
+	Placement placement = NONE;
+	Array<int> placementCpus;                // in the order given to the threads
+	int nplaced = 0;
+
 	ThreadGroup() : parent(null) {
 		name = "system";
 		maxPriority = Thread::MAX_PRIORITY;
@@ -86,17 +92,19 @@ private:
 		}
 	}
 	void remove(const ThreadGroup* g) {
-		if (destroyed) return ;
-		for (int i = 0 ; i < ngroups ; i++) {
-			if (groups[i] == g) {
-				ngroups -= 1;
-				System::arraycopy(groups, i + 1, groups, i, ngroups - i);
-				groups[ngroups] = null;
+		synchronized (*this) {
+			if (destroyed) return ;
+			for (int i = 0 ; i < ngroups ; i++) {
+				if (groups[i] == g) {
+					ngroups -= 1;
+					System::arraycopy(groups, i + 1, groups, i, ngroups - i);
+					groups[ngroups] = null;
+				}
 			}
+			if (nthreads == 0) notifyAll();
+			if (daemon && nthreads == 0 && nUnstartedThreads == 0 && ngroups == 0)
+				destroy();
 		}
-		if (nthreads == 0) notifyAll();
-		if (daemon && nthreads == 0 && nUnstartedThreads == 0 && ngroups == 0)
-			destroy();
 	}
 
 	void addUnstarted() {
@@ -126,7 +134,7 @@ private:
 protected:
 	ThreadGroup(const String& name, ThreadGroup *p) : parent(p) {
 		this->name = name;
-		maxPriority = 1;
+		maxPriority = Thread::MAX_PRIORITY;
 		vmAllowSuspension = false;
 	}
 
@@ -141,14 +149,37 @@ public:
 		parent->add(this);
 	}
 
+	~ThreadGroup() {
+		if (parent != null && !destroyed) parent->remove(this);
+	}
+
 	virtual const String& getName() const final { return name; }
 	virtual const ThreadGroup* getParent() const final { return parent; }
 	virtual int getMaxPriority() const final { return maxPriority; }
 	virtual boolean isDaemon() const final { return daemon; }
 	virtual boolean isDestroyed() const final { return destroyed; }
 	virtual void setDaemon(boolean daemon) final {this->daemon = daemon;}
+	// threads keep their priority, later setPriority calls are limited to pri
 	virtual void setMaxPriority(int pri) final {
-	}
+		if (pri < Thread::MIN_PRIORITY || pri > Thread::MAX_PRIORITY) return ;
+		maxPriority = parent != null && pri > parent->maxPriority ? parent->maxPriority : pri;
+		for (int i = 0 ; i < ngroups; ++i) {
+			groups[i]->setMaxPriority(pri);
+		}
+	}
+	/**
+	 * Pins each thread started in this group from now on to one CPU of cpus (all the
+	 * CPUs of the process when empty), taken round robin in the order of the policy:
+	 *   COMPACT  node by node, neighbouring CPUs first: threads sharing data share caches
+	 *   SCATTER  a CPU of each node in turn: threads use the memory of all nodes
+	 *   EXPLICIT the CPUs of cpus by number
+	 * NONE stops pinning. Threads with an affinity of their own keep it.
+	 * @throws IllegalArgumentException when cpus has no CPU this process may run on
+	 */
+	void setPlacement(Placement policy, const CpuSet& cpus = CpuSet());
+	Placement getPlacement() const { return placement; }
+	// the CPU the next thread started is pinned to, -1 when none
+	int nextCpu();
 	virtual boolean parentOf(const ThreadGroup* g) final {
 		for (; g != null ; g = g->parent) {
 			if (g == this) return true;
@@ -117,9 +117,9 @@ private:
 
 protected:
 	CharsetEncoder(Charset& cs, float averageBytesPerChar, float maxBytesPerChar, const Array<byte>& replacement) :
-   			chset(cs), averageBytesPerChar(averageBytesPerChar), maxBytesPerChar(maxBytesPerChar)	{
+   			chset(cs), averageBytesPerChar(averageBytesPerChar), maxBytesPerChar(maxBytesPerChar)	{TRACE;
 		replaceWith(replacement);
-	}TRACE;
+	}
 	CharsetEncoder(Charset& cs, float averageBytesPerChar, float maxBytesPerChar) :
 			CharsetEncoder(cs, averageBytesPerChar, maxBytesPerChar, Array<byte>((byte)'?')) {TRACE;
 	}
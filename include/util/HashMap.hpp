@@ -73,6 +73,9 @@ inline boolean is_equal(const Object& a, const Object& b) { return a.equals(b);
 template<class T, class std::enable_if<!std::is_base_of<Object,T>::value,Object>::type* = nullptr>
 inline boolean is_equal(const T& a, const T& b) {return a == b;}
 
+// counts a rehash in the util.HashMap.rehash metric, defined in Metrics.cpp
+void hashMapRehashed();
+
 template<class K,class V>
 class HashMap : extends Object, implements Map<K,V> {
 public:
@@ -92,12 +95,15 @@ private:
 	}
 	void rehash(unsigned ns) {TRACE;
 		if (ns == mapsize) return ;
+		hashMapRehashed();
 		ArrayList<MapEntry<K,V>> *nmap = new ArrayList<MapEntry<K,V>>[ns];
 		if (nmap == null) return ; //throw RuntimeException("Out of memory");
-		for (int i=0; i < _size; ++i) {
-			MapEntry<K,V>* e = const_cast<MapEntry<K,V>*>(entry(i));
-			unsigned hc = util::hash_code(e->getKey())%ns;
-			nmap[hc].add(std::move(*e));
+		for (unsigned i=0; i < mapsize; ++i) {
+			ArrayList<MapEntry<K,V>>& l = map[i];
+			for (int j=0; j < l.size(); ++j) {
+				unsigned hc = util::hash_code(l.get(j).getKey())%ns;
+				nmap[hc].add(std::move(l.get(j)));
+			}
 		}
 		delete [] map;
 		map = nmap;
@@ -176,6 +182,8 @@ public:
 		}
 		MapEntry<K,V> me(k,v);
 		l.add(me); ++_size;
+		// keeps the chains short, at most DEFAULT_LOAD_FACTOR entries per bucket on average
+		if ((double)_size > (double)mapsize * DEFAULT_LOAD_FACTOR && mapsize < (unsigned)MAXIMUM_CAPACITY) rehash(mapsize * 2);
 		return v;
 	}
 	V remove(const K& k) {TRACE;
@@ -0,0 +1,103 @@
+#ifndef __UTIL_METRICS_HPP
+#define __UTIL_METRICS_HPP
+
+#include <util/concurrent/LongAdder.hpp>
+#include <atomic>
+
+namespace util {
+
+/**
+ * Process wide registry of named counters, gauges and latency histograms.
+ * Metrics are created on first lookup and live until the process exits, the
+ * references stay valid: look a metric up once (e.g. into a static) and record
+ * into it lock-free. Every metric has a fixed size, the registry a fixed
+ * capacity. snapshot() renders all of them as text, one per line.
+ */
+class Metrics final {
+public:
+	static const int MAX_METRICS = 256;
+
+	// current value, e.g. a queue depth kept by increments and decrements
+	class Gauge final {
+	private:
+		util::concurrent::LongAdder value;
+	public:
+		void increment() { value.increment(); }
+		void decrement() { value.decrement(); }
+		void add(jlong x) { value.add(x); }
+		// not atomic with concurrent adds
+		void set(jlong x) { value.add(x - value.sum()); }
+		jlong get() const { return value.sum(); }
+	};
+
+	/**
+	 * Log-linear histogram (as HdrHistogram): values below 16 have their own
+	 * buckets, each power of two above is split into 16 buckets, so a value is
+	 * known within 1/16 of it. Covers 0 to Long::MAX_VALUE in 960 buckets.
+	 */
+	class Histogram final {
+	private:
+		static const int SUB_BITS = 4;
+		static const int SUB = 1 << SUB_BITS;
+	public:
+		static const int BUCKETS = (63 - SUB_BITS + 1) * SUB;
+	private:
+		std::atomic<jlong> counts[BUCKETS];
+		util::concurrent::LongAdder total;
+		std::atomic<jlong> max{0};
+	public:
+		Histogram() {
+			for (std::atomic<jlong>& c : counts) c.store(0, std::memory_order_relaxed);
+		}
+		static int bucketOf(jlong v) {
+			if (v < SUB) return v < 0 ? 0 : (int)v;
+			int e = 63 - __builtin_clzl((unsigned long)v);
+			return (e - SUB_BITS + 1) * SUB + (int)((v >> (e - SUB_BITS)) & (SUB - 1));
+		}
+		// the greatest value counted in bucket b
+		static jlong highestOf(int b) {
+			if (b < SUB) return b;
+			int shift = b / SUB - 1;
+			return ((jlong)(SUB + b % SUB) << shift) + ((jlong)1 << shift) - 1;
+		}
+
+		// negative values count as 0
+		void record(jlong v) {
+			if (v < 0) v = 0;
+			counts[bucketOf(v)].fetch_add(1, std::memory_order_relaxed);
+			total.add(v);
+			jlong m = max.load(std::memory_order_relaxed);
+			while (v > m && !max.compare_exchange_weak(m, v, std::memory_order_relaxed)) {}
+		}
+		jlong getCount() const;
+		jlong getSum() const { return total.sum(); }
+		jlong getMax() const { return max.load(std::memory_order_relaxed); }
+		double getMean() const;
+		// the value at quantile q (0..1), within the bucket resolution
+		jlong percentile(double q) const;
+		void reset();
+	};
+
+	Metrics() = delete;
+
+	/**
+	 * The metric registered as name, created when absent.
+	 * @throws IllegalArgumentException when name is a metric of another kind
+	 * @throws IllegalStateException when MAX_METRICS are registered
+	 */
+	static util::concurrent::LongAdder& counter(const String& name);
+	static Gauge& gauge(const String& name);
+	static Histogram& histogram(const String& name);
+
+	/**
+	 * Text export sorted by name:
+	 *   counter <name> <sum>
+	 *   gauge <name> <value>
+	 *   histogram <name> count=.. mean=.. p50=.. p90=.. p99=.. p999=.. max=..
+	 */
+	static String snapshot();
+};
+
+} //namespace util
+
+#endif
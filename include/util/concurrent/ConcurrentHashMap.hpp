@@ -0,0 +1,333 @@
+#ifndef __UTIL_CONCURRENT_CONCURRENTHASHMAP_HPP
+#define __UTIL_CONCURRENT_CONCURRENTHASHMAP_HPP
+
+#include <util/HashMap.hpp>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace util { namespace concurrent {
+
+/**
+ * Deferred deletion for structures with lock-free readers (two phase RCU on
+ * reader counters striped per thread). Readers never block: a read section
+ * only increments the counter of its stripe for the current phase. Memory
+ * unlinked by writers is retired and deleted once all the read sections that
+ * could still see it have ended.
+ * Writers must not retire or reclaim from inside a read section.
+ */
+class Reclaimer final {
+public:
+	static const int CACHE_LINE = 64;
+private:
+	static const int STRIPES = 16;
+	static const int BATCH = 64;             // retired objects per reclaim
+	struct Counter {
+		std::atomic<long> readers{0};
+		char pad[CACHE_LINE - sizeof(std::atomic<long>)];
+	};
+	struct Retired {
+		void *p;
+		void (*deleter)(void *);
+	};
+
+	Counter counters[2][STRIPES];
+	std::atomic<int> phase{0};
+	std::mutex retiredLock;
+	std::vector<Retired> retired;
+	std::mutex syncLock;                     // serializes grace periods
+
+	// the counter stripe of the calling thread
+	static int threadStripe();
+	// waits for the read sections of the other phase, twice
+	void synchronize();
+public:
+	Reclaimer(const Reclaimer&) = delete;
+	Reclaimer& operator=(const Reclaimer&) = delete;
+	Reclaimer() {}
+	~Reclaimer();
+
+	class ReadSection {
+	private:
+		std::atomic<long>& readers;
+	public:
+		ReadSection(const ReadSection&) = delete;
+		ReadSection(Reclaimer& r) : readers(r.counters[r.phase.load()][threadStripe()].readers) {
+			readers.fetch_add(1);
+			// pairs with the fence of synchronize(): either it sees this reader or we see the unlinking
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+		~ReadSection() { readers.fetch_sub(1, std::memory_order_release); }
+	};
+
+	template<class T>
+	void retire(T *p) {
+		std::lock_guard<std::mutex> lock(retiredLock);
+		retired.push_back(Retired{p, [](void *p) { delete (T *)p; }});
+	}
+	// deletes the retired objects when a batch is pending
+	void reclaimIfNeeded() {
+		std::unique_lock<std::mutex> lock(retiredLock);
+		if ((int)retired.size() < BATCH) return;
+		lock.unlock();
+		reclaim();
+	}
+	void reclaim();
+};
+
+/**
+ * Hash map for tables shared by many threads, reads are lock-free.
+ * Keys go to one of 16 segments, each an open addressed table of pointers to
+ * immutable nodes, changed under the segment mutex. Updates publish a new node,
+ * a resize publishes a new table, readers keep using what they found and the
+ * replaced memory is reclaimed once they are done. Readers are never blocked,
+ * not even by a resize.
+ * Lookups return copies of the values: a reference could outlive its node.
+ * Iteration (forEach) is weakly consistent.
+ */
+template<class K,class V>
+class ConcurrentHashMap : extends Object {
+private:
+	static const int SEGMENT_SHIFT = 28;
+	static const int SEGMENTS = 1 << (32 - SEGMENT_SHIFT);
+
+	struct Node {
+		const unsigned hash;
+		const K key;
+		const V value;
+		Node(unsigned hash, const K& key, const V& value) : hash(hash), key(key), value(value) {}
+	};
+	struct Table {
+		const unsigned mask;
+		std::atomic<Node*> *slots;
+		Table(unsigned capacity) : mask(capacity - 1), slots(new std::atomic<Node*>[capacity]) {
+			for (unsigned i = 0; i <= mask; ++i) slots[i].store(null, std::memory_order_relaxed);
+		}
+		~Table() { delete [] slots; }
+	};
+	struct Segment {
+		std::mutex lock;
+		std::atomic<Table*> table{null};
+		std::atomic<int> count{0};
+		unsigned used = 0;                   // live nodes and tombstones
+		char pad[Reclaimer::CACHE_LINE];
+	};
+
+	mutable Reclaimer reclaimer;
+	Segment segments[SEGMENTS];
+
+	// marks a removed slot, probing goes on past it
+	static Node *tombstone() {
+		static char marker;
+		return (Node *)&marker;
+	}
+	// murmur3 finalizer: the high bits choose the segment, the low bits the slot
+	static unsigned spread(unsigned h) {
+		h ^= h >> 16;
+		h *= 0x85ebca6b;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35;
+		return h ^ (h >> 16);
+	}
+	Segment& segmentFor(unsigned h) const {
+		return const_cast<Segment&>(segments[h >> SEGMENT_SHIFT]);
+	}
+	static unsigned roundUp(unsigned n) {
+		unsigned c = 4;
+		while (c < n) c <<= 1;
+		return c;
+	}
+
+	// the node of key, null when absent; in a read section or under the segment lock
+	static Node *find(const Table *t, unsigned h, const K& key) {
+		for (unsigned i = h & t->mask; ; i = (i + 1) & t->mask) {
+			Node *n = t->slots[i].load(std::memory_order_acquire);
+			if (n == null) return null;
+			if (n != tombstone() && n->hash == h && is_equal(n->key, key)) return n;
+		}
+	}
+	// slot of key, or the slot to insert it at; under the segment lock
+	static std::atomic<Node*>& slotFor(Table *t, unsigned h, const K& key) {
+		std::atomic<Node*> *free = null;
+		for (unsigned i = h & t->mask; ; i = (i + 1) & t->mask) {
+			Node *n = t->slots[i].load(std::memory_order_relaxed);
+			if (n == null) return free != null ? *free : t->slots[i];
+			if (n == tombstone()) { if (free == null) free = &t->slots[i]; }
+			else if (n->hash == h && is_equal(n->key, key)) return t->slots[i];
+		}
+	}
+	// room for one more node, rebuilding the table without tombstones when needed
+	void reserve(Segment& s) {
+		Table *t = s.table.load(std::memory_order_relaxed);
+		if ((s.used + 1) * 4 <= (t->mask + 1) * 3) return;
+		unsigned live = (unsigned)s.count.load(std::memory_order_relaxed);
+		Table *nt = new Table(roundUp((live + 1) * 2));
+		for (unsigned i = 0; i <= t->mask; ++i) {
+			Node *n = t->slots[i].load(std::memory_order_relaxed);
+			if (n == null || n == tombstone()) continue;
+			unsigned j = n->hash & nt->mask;
+			while (nt->slots[j].load(std::memory_order_relaxed) != null) j = (j + 1) & nt->mask;
+			nt->slots[j].store(n, std::memory_order_relaxed);
+		}
+		s.table.store(nt, std::memory_order_release);
+		s.used = live;
+		reclaimer.retire(t);
+	}
+	// under the segment lock
+	void insert(Segment& s, unsigned h, const K& key, const V& value) {
+		reserve(s);
+		std::atomic<Node*>& slot = slotFor(s.table.load(std::memory_order_relaxed), h, key);
+		Node *old = slot.load(std::memory_order_relaxed);
+		slot.store(new Node(h, key, value), std::memory_order_release);
+		if (old == null || old == tombstone()) {
+			if (old == null) ++s.used;
+			s.count.fetch_add(1, std::memory_order_relaxed);
+		}
+		else reclaimer.retire(old);
+	}
+
+public:
+	static const int DEFAULT_INITIAL_CAPACITY = 1 << 4;
+
+	ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+	ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+	ConcurrentHashMap(unsigned initialCapacity = DEFAULT_INITIAL_CAPACITY) {
+		unsigned c = roundUp(initialCapacity / SEGMENTS * 4 / 3 + 1);
+		for (Segment& s : segments) s.table.store(new Table(c), std::memory_order_relaxed);
+	}
+	~ConcurrentHashMap() {
+		for (Segment& s : segments) {
+			Table *t = s.table.load();
+			for (unsigned i = 0; i <= t->mask; ++i) {
+				Node *n = t->slots[i].load();
+				if (n != null && n != tombstone()) delete n;
+			}
+			delete t;
+		}
+	}
+
+	int size() const {
+		int n = 0;
+		for (const Segment& s : segments) n += s.count.load(std::memory_order_relaxed);
+		return n;
+	}
+	boolean isEmpty() const { return size() == 0; }
+
+	boolean containsKey(const K& key) const {
+		unsigned h = spread(hash_code(key));
+		Reclaimer::ReadSection rs(reclaimer);
+		return find(segmentFor(h).table.load(std::memory_order_acquire), h, key) != null;
+	}
+	// copies the value of key to value, false when absent
+	boolean get(const K& key, V& value) const {
+		unsigned h = spread(hash_code(key));
+		Reclaimer::ReadSection rs(reclaimer);
+		Node *n = find(segmentFor(h).table.load(std::memory_order_acquire), h, key);
+		if (n == null) return false;
+		value = n->value;
+		return true;
+	}
+	V getOrDefault(const K& key, const V& defaultValue) const {
+		unsigned h = spread(hash_code(key));
+		Reclaimer::ReadSection rs(reclaimer);
+		Node *n = find(segmentFor(h).table.load(std::memory_order_acquire), h, key);
+		return n != null ? n->value : defaultValue;
+	}
+
+	void put(const K& key, const V& value) {
+		unsigned h = spread(hash_code(key));
+		Segment& s = segmentFor(h);
+		{
+			std::lock_guard<std::mutex> lock(s.lock);
+			insert(s, h, key, value);
+		}
+		reclaimer.reclaimIfNeeded();
+	}
+	// returns the value mapped to key: the present one, else value which got mapped
+	V putIfAbsent(const K& key, const V& value) {
+		return computeIfAbsent(key, [&value](const K&) { return value; });
+	}
+	/**
+	 * Returns the value mapped to key, when absent maps the result of f(key).
+	 * f runs at most once per missing key, under the segment lock: it must be
+	 * short and must not use this map. When f throws nothing is mapped.
+	 */
+	template<class F>
+	V computeIfAbsent(const K& key, F f) {
+		V v;
+		if (get(key, v)) return v;
+		unsigned h = spread(hash_code(key));
+		Segment& s = segmentFor(h);
+		{
+			std::lock_guard<std::mutex> lock(s.lock);
+			Node *n = find(s.table.load(std::memory_order_relaxed), h, key);
+			if (n != null) return n->value;
+			v = f(key);
+			insert(s, h, key, v);
+		}
+		reclaimer.reclaimIfNeeded();
+		return v;
+	}
+	// false when key was absent
+	boolean remove(const K& key) {
+		unsigned h = spread(hash_code(key));
+		Segment& s = segmentFor(h);
+		{
+			std::lock_guard<std::mutex> lock(s.lock);
+			Table *t = s.table.load(std::memory_order_relaxed);
+			std::atomic<Node*>& slot = slotFor(t, h, key);
+			Node *n = slot.load(std::memory_order_relaxed);
+			if (n == null || n == tombstone()) return false;
+			slot.store(tombstone(), std::memory_order_release);
+			s.count.fetch_sub(1, std::memory_order_relaxed);
+			reclaimer.retire(n);
+		}
+		reclaimer.reclaimIfNeeded();
+		return true;
+	}
+	void clear() {
+		for (Segment& s : segments) {
+			std::lock_guard<std::mutex> lock(s.lock);
+			Table *t = s.table.load(std::memory_order_relaxed);
+			s.table.store(new Table(t->mask + 1), std::memory_order_release);
+			for (unsigned i = 0; i <= t->mask; ++i) {
+				Node *n = t->slots[i].load(std::memory_order_relaxed);
+				if (n != null && n != tombstone()) reclaimer.retire(n);
+			}
+			reclaimer.retire(t);
+			s.count.store(0, std::memory_order_relaxed);
+			s.used = 0;
+		}
+		reclaimer.reclaimIfNeeded();
+	}
+
+	// calls f(key, value) for the mappings, f must not update this map
+	template<class F>
+	void forEach(F f) const {
+		Reclaimer::ReadSection rs(reclaimer);
+		for (const Segment& s : segments) {
+			const Table *t = s.table.load(std::memory_order_acquire);
+			for (unsigned i = 0; i <= t->mask; ++i) {
+				Node *n = t->slots[i].load(std::memory_order_acquire);
+				if (n != null && n != tombstone()) f(n->key, n->value);
+			}
+		}
+	}
+
+	String toString() const {
+		StringBuilder sb;
+		sb.append("[" + String::valueOf(size()) + "] {");
+		boolean first = true;
+		forEach([&sb, &first](const K& k, const V& v) {
+			if (!first) sb.append(",");
+			first = false;
+			sb.append(String::valueOf(k) + ":" + String::valueOf(v));
+		});
+		return sb.append('}').toString();
+	}
+};
+
+}}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef __UTIL_CONCURRENT_FUTEX_HPP
+#define __UTIL_CONCURRENT_FUTEX_HPP
+
+#include <lang/Object.hpp>
+#include <atomic>
+#include <climits>
+
+namespace util { namespace concurrent {
+
+/**
+ * Address based wait queue (linux futex), the parking primitive of the
+ * lock-free structures. Other platforms use a striped condition variable table.
+ */
+class Futex final {
+public:
+	Futex() = delete;
+
+	/**
+	 * Blocks while word == expected, at most nanos nanoseconds (negative means no timeout).
+	 * Returns false on timeout. Spurious wakeups are possible, callers must recheck the word.
+	 */
+	static boolean wait(std::atomic<int>& word, int expected, jlong nanos=-1);
+	static void wake(std::atomic<int>& word, int count);
+	static void wakeAll(std::atomic<int>& word) { wake(word, INT_MAX); }
+};
+
+}}
+
+#endif
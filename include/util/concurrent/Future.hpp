@@ -0,0 +1,675 @@
+#ifndef __UTIL_CONCURRENT_FUTURE_HPP
+#define __UTIL_CONCURRENT_FUTURE_HPP
+
+#include <util/concurrent/TimeUnit.hpp>
+#include <ThreadPool.hpp>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace util { namespace concurrent {
+
+class TimeoutException : extends Exception {
+public:
+	using Exception::Exception;
+};
+
+template<class T> class Future;
+template<class T> class FutureValue;
+
+/**
+ * The completion core shared by a Future and its Promise, reference counted.
+ * Completion is lock-free: the completer claims the state by a CAS from PENDING,
+ * stores the value or the exception and publishes SUCCESS or FAILED. The
+ * continuations are a Treiber stack, swapped for a COMPLETED marker once done:
+ * a continuation added later runs at once. The completer runs them in their
+ * registration order, the states they complete inline are run in the same loop,
+ * so long chains do not recurse.
+ * The exception of a failed state is always a Throwable.
+ */
+class FutureState {
+public:
+	enum { PENDING, COMPLETING, SUCCESS, FAILED };
+
+	struct Continuation {
+		Continuation *next = null;
+		virtual ~Continuation() {}
+		/**
+		 * Called once source completed. Returns a state it completed, with a
+		 * reference to be released after its continuations ran, or null.
+		 */
+		virtual FutureState *run(FutureState *source) = 0;
+		// the source was destroyed pending, returns a state to release or null
+		virtual FutureState *drop() = 0;
+	};
+
+	std::atomic<int> refs{1};
+	std::atomic<int> status{PENDING};
+	std::atomic<Continuation*> stack{null};
+	FutureState *nextFire = null;            // link of the states being fired or destroyed
+	std::atomic<Continuation*> waiter{null}; // shared by the threads blocked in get, owned by the state
+	std::exception_ptr error;
+	const Throwable *thrown = null;          // the object held by error
+
+	FutureState() {}
+	FutureState(const FutureState&) = delete;
+	FutureState& operator=(const FutureState&) = delete;
+	virtual ~FutureState() {}
+
+	static Continuation *completed() { return reinterpret_cast<Continuation*>((uintptr_t)1); }
+	void addRef() { refs.fetch_add(1, std::memory_order_relaxed); }
+	void release() { if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) destroy(this); }
+	static void destroy(FutureState *s);
+
+	boolean isDone() const { return status.load(std::memory_order_acquire) >= SUCCESS; }
+	boolean isFailed() const { return status.load(std::memory_order_acquire) == FAILED; }
+	// the completer, which must write the outcome and publish
+	boolean claim() {
+		int s = PENDING;
+		return status.compare_exchange_strong(s, COMPLETING, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+	void publish(int s) { status.store(s, std::memory_order_release); }
+	boolean tryFail(const std::exception_ptr& e) {
+		if (!claim()) return false;
+		setError(e);
+		publish(FAILED);
+		return true;
+	}
+	// stores e, a Throwable, and takes the pointer to its object once
+	void setError(const std::exception_ptr& e);
+	// runs the continuations once completed, the caller holds a reference
+	void postComplete();
+	// runs c once completed, at once when completed already
+	void addContinuation(Continuation *c);
+	// as addContinuation, but a state c completed at once is returned for the caller to fire
+	FutureState *pushContinuation(Continuation *c);
+	// blocks the thread or parks the fiber until completed, false on timeout (nanos >= 0)
+	boolean await(jlong nanos);
+	// the exception of a failed state, null otherwise
+	const Throwable *getException() const;
+	// completes with TimeoutException after the delay, unless completed before
+	void failOnTimeout(jlong timeout, TimeUnit unit);
+	// runs task after the delay on the timer thread, unless completed before
+	void onTimeout(std::function<void()> task, jlong timeout, TimeUnit unit);
+
+	// the exception being handled as a Throwable: a std::exception becomes a RuntimeException
+	static std::exception_ptr currentThrowable();
+	static std::exception_ptr toThrowable(const std::exception_ptr& e);
+	template<class E> static std::exception_ptr wrap(E&& e) {
+		try { throw std::move(e); }
+		catch (...) { return std::current_exception(); }
+	}
+
+	// calls f with the value of s, without argument when void
+	template<class T> struct Call;
+	template<class T, class U> struct Call2;
+	// sets d to the result of g(), or to the exception it throws
+	template<class R> struct Settle;
+
+	// dependent future computed from its sources, inline or on a pool
+	template<class R> struct Stage;
+	template<class T, class R, class F> struct ApplyStage;
+	template<class T, class R, class F> struct ComposeStage;
+	template<class T, class U, class R, class F> struct CombineStage;
+	template<class T, class F> struct RecoverStage;
+	template<class R, class F> struct SupplyStage;
+	template<class T> struct AllStage;
+	template<class T> struct AnyStage;
+	template<class T> static Future<T> wrapState(FutureValue<T> *s) { return Future<T>(s); }
+	template<class T> static FutureValue<T> *stateOf(const Future<T>& f) { return f.state; }
+};
+
+template<class T>
+class FutureValue : public FutureState {
+public:
+	typedef const T& Get;
+	union { T value; };
+	FutureValue() {}
+	~FutureValue() { if (status.load(std::memory_order_relaxed) == SUCCESS) value.~T(); }
+	template<class... A> boolean trySucceed(A&&... a) {
+		if (!claim()) return false;
+		try {
+			new (&value) T(std::forward<A>(a)...);
+		} catch (...) {
+			setError(currentThrowable());
+			publish(FAILED);
+			return true;
+		}
+		publish(SUCCESS);
+		return true;
+	}
+	boolean tryCopy(FutureValue<T> *s) { return s->isFailed() ? tryFail(s->error) : trySucceed(s->value); }
+	Get get() const {
+		if (isFailed()) std::rethrow_exception(error);
+		return value;
+	}
+};
+template<>
+class FutureValue<void> : public FutureState {
+public:
+	typedef void Get;
+	boolean trySucceed() {
+		if (!claim()) return false;
+		publish(SUCCESS);
+		return true;
+	}
+	boolean tryCopy(FutureValue<void> *s) { return s->isFailed() ? tryFail(s->error) : trySucceed(); }
+	Get get() const { if (isFailed()) std::rethrow_exception(error); }
+};
+
+template<class T> struct FutureState::Call {
+	template<class F> static auto call(F& f, FutureValue<T> *s) -> decltype(f(std::declval<const T&>())) { return f(static_cast<const T&>(s->value)); }
+};
+template<> struct FutureState::Call<void> {
+	template<class F> static auto call(F& f, FutureValue<void> *) -> decltype(f()) { return f(); }
+};
+template<class T, class U> struct FutureState::Call2 {
+	template<class F> static auto call(F& f, FutureValue<T> *a, FutureValue<U> *b) -> decltype(f(std::declval<const T&>(), std::declval<const U&>())) {
+		return f(static_cast<const T&>(a->value), static_cast<const U&>(b->value));
+	}
+};
+template<class T> struct FutureState::Call2<T, void> {
+	template<class F> static auto call(F& f, FutureValue<T> *a, FutureValue<void> *) -> decltype(f(std::declval<const T&>())) { return f(static_cast<const T&>(a->value)); }
+};
+template<class U> struct FutureState::Call2<void, U> {
+	template<class F> static auto call(F& f, FutureValue<void> *, FutureValue<U> *b) -> decltype(f(std::declval<const U&>())) { return f(static_cast<const U&>(b->value)); }
+};
+template<> struct FutureState::Call2<void, void> {
+	template<class F> static auto call(F& f, FutureValue<void> *, FutureValue<void> *) -> decltype(f()) { return f(); }
+};
+
+// the value type of the future returned by thenApply(f) on a Future<T>
+template<class T, class F> using FutureResult = decltype(FutureState::Call<T>::call(std::declval<F&>(), (FutureValue<T> *)null));
+template<class T, class U, class F> using FutureResult2 = decltype(FutureState::Call2<T, U>::call(std::declval<F&>(), (FutureValue<T> *)null, (FutureValue<U> *)null));
+
+template<class R> struct FutureState::Settle {
+	template<class G> static void call(FutureValue<R> *d, G&& g) {
+		try { d->trySucceed(g()); }
+		catch (...) { d->tryFail(currentThrowable()); }
+	}
+};
+template<> struct FutureState::Settle<void> {
+	template<class G> static void call(FutureValue<void> *d, G&& g) {
+		try { g(); d->trySucceed(); }
+		catch (...) { d->tryFail(currentThrowable()); }
+	}
+};
+
+/**
+ * Result of an asynchronous computation, a reference counted handle: copies
+ * share the same state. The continuations run inline on the thread which
+ * completes the source (or at once on the calling thread when complete
+ * already), the Async variants on the given pool.
+ * A failure skips thenApply, thenCompose and thenCombine and is passed on to
+ * the futures they return, until an exceptionally stage recovers from it.
+ * Continuations of a future which can not complete any more (its promise and
+ * handles are gone) are dropped, their futures stay pending.
+ */
+template<class T>
+class Future {
+	friend class FutureState;
+	template<class> friend class Future;
+	template<class> friend class Promise;
+private:
+	FutureValue<T> *state;
+	// takes the reference
+	explicit Future(FutureValue<T> *s) : state(s) {}
+	// registers c, the continuation of the stage d, and returns d
+	template<class R> Future<R> then(FutureValue<R> *d, FutureState::Continuation *c) const {
+		d->addRef();
+		state->addContinuation(c);
+		return Future<R>(d);
+	}
+public:
+	typedef T value_type;
+
+	Future(const Future& o) : state(o.state) { state->addRef(); }
+	Future(Future&& o) : state(o.state) { o.state = null; }
+	Future& operator=(const Future& o) {
+		o.state->addRef();
+		if (state != null) state->release();
+		state = o.state;
+		return *this;
+	}
+	Future& operator=(Future&& o) {
+		std::swap(state, o.state);
+		return *this;
+	}
+	~Future() { if (state != null) state->release(); }
+
+	boolean isDone() const { return state->isDone(); }
+	boolean isCompletedExceptionally() const { return state->isFailed(); }
+	// the exception it failed with, null when not failed
+	const Throwable *getException() const { return state->getException(); }
+	/**
+	 * Waits for the completion (a fiber parks), returns the value.
+	 * The reference is valid as long as a handle of this future exists.
+	 * @throws the Throwable it failed with
+	 */
+	typename FutureValue<T>::Get get() const {
+		state->await(-1);
+		return state->get();
+	}
+	/**
+	 * get waiting at most timeout.
+	 * @throws TimeoutException when not completed in time
+	 */
+	typename FutureValue<T>::Get get(jlong timeout, TimeUnit unit) const {
+		if (!state->await(unit.toNanos(timeout))) throw TimeoutException("not completed in " + String::valueOf(timeout) + " " + unit.toString());
+		return state->get();
+	}
+
+	// the future of fn(value), void when fn returns void
+	template<class F> Future<FutureResult<T, F>> thenApply(F fn) const {
+		auto *d = new FutureState::ApplyStage<T, FutureResult<T, F>, F>(std::move(fn), null);
+		return then(d, d);
+	}
+	template<class F> Future<FutureResult<T, F>> thenApplyAsync(F fn, ThreadPool& pool) const {
+		auto *d = new FutureState::ApplyStage<T, FutureResult<T, F>, F>(std::move(fn), &pool);
+		return then(d, d);
+	}
+	// fn(value) returns a Future<R>, the future of its value
+	template<class F> Future<typename FutureResult<T, F>::value_type> thenCompose(F fn) const {
+		auto *d = new FutureState::ComposeStage<T, typename FutureResult<T, F>::value_type, F>(std::move(fn), null);
+		return then(d, d);
+	}
+	template<class F> Future<typename FutureResult<T, F>::value_type> thenComposeAsync(F fn, ThreadPool& pool) const {
+		auto *d = new FutureState::ComposeStage<T, typename FutureResult<T, F>::value_type, F>(std::move(fn), &pool);
+		return then(d, d);
+	}
+	// the future of fn(value, other's value) once both completed, failed as soon as one failed
+	template<class U, class F> Future<FutureResult2<T, U, F>> thenCombine(const Future<U>& other, F fn) const {
+		return combine(other, std::move(fn), null);
+	}
+	template<class U, class F> Future<FutureResult2<T, U, F>> thenCombineAsync(const Future<U>& other, F fn, ThreadPool& pool) const {
+		return combine(other, std::move(fn), &pool);
+	}
+	// the same value, or fn(exception) when failed
+	template<class F> Future<T> exceptionally(F fn) const {
+		auto *d = new FutureState::RecoverStage<T, F>(std::move(fn));
+		return then(d, d);
+	}
+	// fails this with a TimeoutException unless completed within timeout, returns this
+	Future<T> orTimeout(jlong timeout, TimeUnit unit) const {
+		state->failOnTimeout(timeout, unit);
+		return *this;
+	}
+	// completes this with value unless completed within timeout, returns this
+	template<class V> Future<T> completeOnTimeout(V value, jlong timeout, TimeUnit unit) const {
+		Future<T> self(*this);
+		state->onTimeout([self, value] {
+			if (self.state->trySucceed(value)) self.state->postComplete();
+		}, timeout, unit);
+		return *this;
+	}
+
+private:
+	template<class U, class F> Future<FutureResult2<T, U, F>> combine(const Future<U>& other, F&& fn, ThreadPool *pool) const {
+		auto *d = new FutureState::CombineStage<T, U, FutureResult2<T, U, F>, F>(std::move(fn), pool);
+		d->refs.fetch_add(2, std::memory_order_relaxed);
+		state->addContinuation(&d->first);
+		other.state->addContinuation(&d->second);
+		return Future<FutureResult2<T, U, F>>(d);
+	}
+};
+
+/**
+ * The completing side of a Future, a handle as Future. Only the first
+ * completion counts, the complete calls return false after it.
+ */
+template<class T>
+class Promise {
+private:
+	FutureValue<T> *state;
+public:
+	Promise() : state(new FutureValue<T>()) {}
+	Promise(const Promise& o) : state(o.state) { state->addRef(); }
+	Promise(Promise&& o) : state(o.state) { o.state = null; }
+	Promise& operator=(const Promise& o) {
+		o.state->addRef();
+		if (state != null) state->release();
+		state = o.state;
+		return *this;
+	}
+	Promise& operator=(Promise&& o) {
+		std::swap(state, o.state);
+		return *this;
+	}
+	~Promise() { if (state != null) state->release(); }
+
+	Future<T> getFuture() const {
+		state->addRef();
+		return Future<T>(state);
+	}
+	// completes with the value constructed of a (no argument for void), runs the continuations
+	template<class... A> boolean complete(A&&... a) {
+		if (!state->trySucceed(std::forward<A>(a)...)) return false;
+		state->postComplete();
+		return true;
+	}
+	// completes with the exception e (moved from), a Throwable
+	template<class E, class = typename std::enable_if<std::is_base_of<Throwable, typename std::decay<E>::type>::value>::type>
+	boolean completeExceptionally(E&& e) {
+		return completeExceptionally(FutureState::wrap(std::forward<E>(e)));
+	}
+	// a std::exception is converted to a RuntimeException
+	boolean completeExceptionally(const std::exception_ptr& e) {
+		if (!state->tryFail(FutureState::toThrowable(e))) return false;
+		state->postComplete();
+		return true;
+	}
+	boolean isDone() const { return state->isDone(); }
+};
+
+template<class R> struct FutureState::Stage : FutureValue<R> {
+	ThreadPool *pool;
+	explicit Stage(ThreadPool *pool) : pool(pool) {}
+	// completes this from source (null when several), false when it completes later
+	virtual boolean invoke(FutureState *source) = 0;
+
+	// the task of the pool, holds a reference of both
+	struct Async {
+		Stage *stage;
+		FutureState *source;
+		Async(Stage *stage, FutureState *source) : stage(stage), source(source) { if (source != null) source->addRef(); }
+		Async(Async&& o) : stage(o.stage), source(o.source) { o.stage = null; }
+		~Async() {
+			if (stage == null) return;
+			// dropped by a pool shut down
+			if (stage->tryFail(wrap(RejectedExecutionException()))) stage->postComplete();
+			finish();
+		}
+		void operator()() {
+			if (stage->invoke(source)) stage->postComplete();
+			finish();
+		}
+		void finish() {
+			if (source != null) source->release();
+			stage->release();
+			stage = null;
+		}
+	};
+	// runs invoke inline or on the pool, takes the reference of the caller
+	FutureState *dispatch(FutureState *source) {
+		if (pool == null) {
+			if (invoke(source)) return this;
+			this->release();
+			return null;
+		}
+		try { pool->execute(Async(this, source)); }
+		catch (...) {} // the task was dropped, ~Async failed this
+		return null;
+	}
+};
+
+template<class T, class R, class F> struct FutureState::ApplyStage : Stage<R>, Continuation {
+	union { F fn; };
+	boolean armed = true;
+	ApplyStage(F&& f, ThreadPool *pool) : Stage<R>(pool) { new (&fn) F(std::move(f)); }
+	~ApplyStage() { if (armed) fn.~F(); }
+	FutureState *run(FutureState *source) {
+		if (source->isFailed()) {
+			this->tryFail(source->error);
+			return this;
+		}
+		return this->dispatch(source);
+	}
+	FutureState *drop() { return this; }
+	boolean invoke(FutureState *source) {
+		FutureValue<T> *s = static_cast<FutureValue<T>*>(source);
+		Settle<R>::call(this, [this, s] { return Call<T>::call(fn, s); });
+		fn.~F();
+		armed = false;
+		return true;
+	}
+};
+
+template<class T, class R, class F> struct FutureState::ComposeStage : Stage<R>, Continuation {
+	union { F fn; };
+	boolean armed = true;
+	boolean relaying = false;                // registered on the future fn returned
+	ComposeStage(F&& f, ThreadPool *pool) : Stage<R>(pool) { new (&fn) F(std::move(f)); }
+	~ComposeStage() { if (armed) fn.~F(); }
+	FutureState *run(FutureState *source) {
+		if (relaying) {
+			this->tryCopy(static_cast<FutureValue<R>*>(source));
+			return this;
+		}
+		if (source->isFailed()) {
+			this->tryFail(source->error);
+			return this;
+		}
+		return this->dispatch(source);
+	}
+	FutureState *drop() { return this; }
+	boolean invoke(FutureState *source) {
+		FutureValue<T> *s = static_cast<FutureValue<T>*>(source);
+		FutureValue<R> *inner = null;
+		try {
+			Future<R> f = Call<T>::call(fn, s);
+			inner = stateOf(f);
+			inner->addRef();
+		} catch (...) {
+			this->tryFail(currentThrowable());
+		}
+		fn.~F();
+		armed = false;
+		if (inner == null) return true;
+		relaying = true;
+		this->addRef();
+		// inner completed already: this is fired by the caller's loop, not nested in it
+		FutureState *d = inner->pushContinuation(this);
+		inner->release();
+		if (d == null) return false;
+		// the reference of the relay, the caller's one goes with this to its loop
+		this->release();
+		return true;
+	}
+};
+
+template<class T, class U, class R, class F> struct FutureState::CombineStage : Stage<R> {
+	// a continuation on one of the sources, holds a reference of the stage
+	struct Arm : Continuation {
+		CombineStage *owner;
+		FutureState *source = null;          // referenced once arrived
+		FutureState *run(FutureState *s) { return owner->arrive(this, s); }
+		FutureState *drop() { return owner; }
+	};
+	union { F fn; };
+	boolean armed = true;
+	Arm first, second;
+	std::atomic<int> waiting{2};
+	CombineStage(F&& f, ThreadPool *pool) : Stage<R>(pool) {
+		new (&fn) F(std::move(f));
+		first.owner = second.owner = this;
+	}
+	~CombineStage() {
+		if (armed) fn.~F();
+		if (first.source != null) first.source->release();
+		if (second.source != null) second.source->release();
+	}
+	FutureState *arrive(Arm *arm, FutureState *s) {
+		s->addRef();
+		arm->source = s;
+		boolean failed = s->isFailed() && this->tryFail(s->error);
+		boolean last = waiting.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		if (failed) return this;
+		if (!last || this->isDone()) {
+			this->release();
+			return null;
+		}
+		return this->dispatch(null);
+	}
+	boolean invoke(FutureState *) {
+		FutureValue<T> *a = static_cast<FutureValue<T>*>(first.source);
+		FutureValue<U> *b = static_cast<FutureValue<U>*>(second.source);
+		Settle<R>::call(this, [this, a, b] { return Call2<T, U>::call(fn, a, b); });
+		fn.~F();
+		armed = false;
+		return true;
+	}
+};
+
+template<class T, class F> struct FutureState::RecoverStage : FutureValue<T>, Continuation {
+	union { F fn; };
+	boolean armed = true;
+	RecoverStage(F&& f) { new (&fn) F(std::move(f)); }
+	~RecoverStage() { if (armed) fn.~F(); }
+	FutureState *run(FutureState *source) {
+		FutureValue<T> *s = static_cast<FutureValue<T>*>(source);
+		if (s->isFailed()) {
+			const Throwable *e = s->getException();
+			Settle<T>::call(this, [this, e] { return fn(*e); });
+		}
+		else this->tryCopy(s);
+		fn.~F();
+		armed = false;
+		return this;
+	}
+	FutureState *drop() { return this; }
+};
+
+template<class R, class F> struct FutureState::SupplyStage : Stage<R> {
+	F fn;
+	SupplyStage(F&& f, ThreadPool *pool) : Stage<R>(pool), fn(std::move(f)) {}
+	boolean invoke(FutureState *) {
+		Settle<R>::call(this, [this] { return fn(); });
+		return true;
+	}
+};
+
+template<class T> struct FutureState::AllStage : FutureValue<std::vector<T>> {
+	struct Arm : Continuation {
+		AllStage *owner;
+		FutureState *source = null;
+		FutureState *run(FutureState *s) { return owner->arrive(this, s); }
+		FutureState *drop() { return owner; }
+	};
+	std::vector<Arm> arms;
+	std::atomic<int> waiting;
+	AllStage(size_t n) : arms(n), waiting((int)n) { for (Arm& a : arms) a.owner = this; }
+	~AllStage() { for (Arm& a : arms) if (a.source != null) a.source->release(); }
+	FutureState *arrive(Arm *arm, FutureState *s) {
+		s->addRef();
+		arm->source = s;
+		boolean failed = s->isFailed() && this->tryFail(s->error);
+		boolean last = waiting.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		if (failed) return this;
+		if (!last || this->isDone()) {
+			this->release();
+			return null;
+		}
+		Settle<std::vector<T>>::call(this, [this] {
+			std::vector<T> values;
+			values.reserve(arms.size());
+			for (Arm& a : arms) values.push_back(static_cast<FutureValue<T>*>(a.source)->value);
+			return values;
+		});
+		return this;
+	}
+};
+template<> struct FutureState::AllStage<void> : FutureValue<void> {
+	struct Arm : Continuation {
+		AllStage *owner;
+		FutureState *run(FutureState *s) { return owner->arrive(s); }
+		FutureState *drop() { return owner; }
+	};
+	std::vector<Arm> arms;
+	std::atomic<int> waiting;
+	AllStage(size_t n) : arms(n), waiting((int)n) { for (Arm& a : arms) a.owner = this; }
+	FutureState *arrive(FutureState *s) {
+		boolean failed = s->isFailed() && tryFail(s->error);
+		boolean last = waiting.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		if (failed || (last && trySucceed())) return this;
+		release();
+		return null;
+	}
+};
+
+template<class T> struct FutureState::AnyStage : FutureValue<T> {
+	struct Arm : Continuation {
+		AnyStage *owner;
+		FutureState *run(FutureState *s) {
+			if (owner->tryCopy(static_cast<FutureValue<T>*>(s))) return owner;
+			owner->release();
+			return null;
+		}
+		FutureState *drop() { return owner; }
+	};
+	std::vector<Arm> arms;
+	AnyStage(size_t n) : arms(n) { for (Arm& a : arms) a.owner = this; }
+};
+
+// a future completed with the value constructed of a
+template<class T, class... A> Future<T> completedFuture(A&&... a) {
+	FutureValue<T> *s = new FutureValue<T>();
+	s->trySucceed(std::forward<A>(a)...);
+	s->postComplete();
+	return FutureState::wrapState(s);
+}
+// a future failed with the Throwable e (moved from)
+template<class T, class E, class = typename std::enable_if<std::is_base_of<Throwable, typename std::decay<E>::type>::value>::type>
+Future<T> failedFuture(E&& e) {
+	FutureValue<T> *s = new FutureValue<T>();
+	s->tryFail(FutureState::wrap(std::forward<E>(e)));
+	s->postComplete();
+	return FutureState::wrapState(s);
+}
+/**
+ * The future of fn() run on pool.
+ * It fails with RejectedExecutionException when the pool is shut down.
+ */
+template<class F> Future<decltype(std::declval<F&>()())> supplyAsync(F fn, ThreadPool& pool) {
+	typedef decltype(fn()) R;
+	auto *d = new FutureState::SupplyStage<R, F>(std::move(fn), &pool);
+	d->addRef();
+	d->dispatch(null);
+	return FutureState::wrapState<R>(d);
+}
+/**
+ * The future of the values of all futures in their order, failed as soon as
+ * one of them failed. Completed at once when futures is empty.
+ */
+template<class T> Future<std::vector<T>> allOf(const std::vector<Future<T>>& futures) {
+	auto *d = new FutureState::AllStage<T>(futures.size());
+	if (futures.empty() && d->trySucceed()) d->postComplete();
+	d->refs.fetch_add((int)futures.size(), std::memory_order_relaxed);
+	for (size_t i = 0; i < futures.size(); ++i) FutureState::stateOf(futures[i])->addContinuation(&d->arms[i]);
+	return FutureState::wrapState<std::vector<T>>(d);
+}
+// completed when all futures completed, failed as soon as one of them failed
+inline Future<void> allOf(const std::vector<Future<void>>& futures) {
+	auto *d = new FutureState::AllStage<void>(futures.size());
+	if (futures.empty() && d->trySucceed()) d->postComplete();
+	d->refs.fetch_add((int)futures.size(), std::memory_order_relaxed);
+	for (size_t i = 0; i < futures.size(); ++i) FutureState::stateOf(futures[i])->addContinuation(&d->arms[i]);
+	return FutureState::wrapState<void>(d);
+}
+// completed as the first of futures to complete, never when futures is empty
+template<class T> Future<T> anyOf(const std::vector<Future<T>>& futures) {
+	auto *d = new FutureState::AnyStage<T>(futures.size());
+	d->refs.fetch_add((int)futures.size(), std::memory_order_relaxed);
+	for (size_t i = 0; i < futures.size(); ++i) FutureState::stateOf(futures[i])->addContinuation(&d->arms[i]);
+	return FutureState::wrapState<T>(d);
+}
+
+}}
+
+template<class F> auto ThreadPool::submit(F&& f) -> util::concurrent::Future<decltype(f())> {
+	using namespace util::concurrent;
+	typedef decltype(f()) R;
+	typedef typename std::decay<F>::type Fn;
+	auto *d = new FutureState::SupplyStage<R, Fn>(Fn(std::forward<F>(f)), this);
+	Future<R> r = FutureState::wrapState<R>(d);
+	// the task's reference, a rejected task fails d and releases it
+	d->addRef();
+	execute(typename FutureState::Stage<R>::Async(d, null));
+	return r;
+}
+
+#endif
@@ -2,29 +2,146 @@
 #define __UTIL_CONCURRENT_LOCK_HPP
 
 #include <lang/Object.hpp>
+#include <util/concurrent/TimeUnit.hpp>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 namespace util { namespace concurrent {
 
-class TimeUnit {
+interface Condition : Interface {
+public:
+	/**
+	 * Releases the lock (all holds of it), waits for a signal, reacquires the lock.
+	 * Spurious wakeups are possible, callers recheck their predicate.
+	 */
+	virtual void await() = 0;
+	// returns false when the time elapsed
+	virtual boolean await(long time, TimeUnit unit) = 0;
+	// returns an estimate of the nanoseconds left, <= 0 when elapsed
+	virtual jlong awaitNanos(jlong nanos) = 0;
+	virtual void signal() = 0;
+	virtual void signalAll() = 0;
 };
 
 interface Lock : Interface {
 public:
 	virtual void lock() = 0;
+	/**
+	 * @throws InterruptedException when the current Thread is interrupted
+	 */
 	virtual void lockInterruptibly() = 0;
 	virtual boolean tryLock() = 0;
 	virtual boolean tryLock(long time, TimeUnit unit) = 0;
 	virtual void unlock() = 0;
-	//Condition newCondition() = 0;
+	/**
+	 * Condition bound to this lock, owned by the lock.
+	 * @throws UnsupportedOperationException when the lock has no conditions
+	 */
+	virtual Condition& newCondition() = 0;
 };
 
+class ConditionObject;
+
+/**
+ * Mutual exclusion lock held by one thread, recursively.
+ * Non-fair mode: a futex word (0 free, 1 locked, 2 locked with waiters) which an
+ * arriving thread may take before parked ones, after a short spin.
+ * Fair mode: parked threads queue up and unlock hands the lock to the first one.
+ */
 class ReentrantLock : implements Lock {
+private:
+	friend class ConditionObject;
+	struct Waiter;
+
+	const boolean fair;
+	std::atomic<int> word{0};
+	std::atomic<const void*> owner{null};
+	int holds = 0;
+	std::mutex queueLock;                    // fair mode: guards the queue
+	Waiter *head = null, *tail = null;
+	std::vector<Condition*> conditions;
+
+	boolean acquire(jlong nanos);            // nanos < 0 without timeout
+	boolean acquireFair(jlong nanos);
+	void release();
+	void releaseFair();
 public:
+	ReentrantLock(const ReentrantLock&) = delete;
+	ReentrantLock& operator=(const ReentrantLock&) = delete;
+	ReentrantLock(boolean fair=false) : fair(fair) {}
+	~ReentrantLock();
+
 	void lock();
 	void lockInterruptibly();
 	boolean tryLock();
 	boolean tryLock(long time, TimeUnit unit);
+	/**
+	 * @throws IllegalMonitorStateException when not held by the current thread
+	 */
 	void unlock();
+	Condition& newCondition();
+
+	boolean isFair() const { return fair; }
+	boolean isLocked() const { return word.load() != 0; }
+	boolean isHeldByCurrentThread() const;
+	// holds by the current thread
+	int getHoldCount() const { return isHeldByCurrentThread() ? holds : 0; }
+};
+
+interface ReadWriteLock : Interface {
+public:
+	virtual Lock& readLock() = 0;
+	virtual Lock& writeLock() = 0;
+};
+
+/**
+ * Shared read lock and exclusive write lock, both reentrant.
+ * Writer preferring: readers do not enter while a writer waits (except the ones
+ * already holding the read lock), so a stream of readers can not starve writers.
+ */
+class ReentrantReadWriteLock : implements ReadWriteLock {
+private:
+	class ReadLock;
+	class WriteLock;
+	friend class ReadLock;
+	friend class WriteLock;
+	friend class ConditionObject;
+
+	static const int WRITER = 1 << 30;
+	std::atomic<int> state{0};               // WRITER | readers
+	std::atomic<int> writersWaiting{0};
+	std::atomic<int> parked{0};
+	std::atomic<int> seq{0};                 // futex word, bumped on releases with parked threads
+	std::atomic<const void*> writer{null};
+	int writeHolds = 0;
+	std::mutex conditionsLock;
+	std::vector<Condition*> conditions;
+	ReadLock *rl;
+	WriteLock *wl;
+
+	boolean acquireRead(jlong nanos);
+	void releaseRead();
+	boolean acquireWrite(jlong nanos);
+	void releaseWrite();
+	void wakeParked();
+	// parks until a release, unless ready() meanwhile; false on timeout
+	template<class Ready>
+	boolean park(Ready ready, jlong deadline);
+public:
+	ReentrantReadWriteLock(const ReentrantReadWriteLock&) = delete;
+	ReentrantReadWriteLock& operator=(const ReentrantReadWriteLock&) = delete;
+	ReentrantReadWriteLock();
+	~ReentrantReadWriteLock();
+
+	Lock& readLock();
+	Lock& writeLock();
+
+	int getReadLockCount() const { return state.load() & (WRITER - 1); }
+	boolean isWriteLocked() const { return (state.load() & WRITER) != 0; }
+	boolean isWriteLockedByCurrentThread() const;
+	// read holds of the current thread
+	int getReadHoldCount() const;
 };
 
 }}
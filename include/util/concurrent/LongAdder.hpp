@@ -0,0 +1,62 @@
+#ifndef __UTIL_CONCURRENT_LONGADDER_HPP
+#define __UTIL_CONCURRENT_LONGADDER_HPP
+
+#include <lang/String.hpp>
+#include <atomic>
+
+namespace util { namespace concurrent {
+
+/**
+ * Sum updated by many threads: each thread adds to its own cache line sized
+ * cell (threads spread over CELLS cells), sum() adds the cells up.
+ * Updates do not contend where a single atomic would, reads are slower and
+ * not a snapshot while updates go on.
+ */
+class LongAdder final {
+private:
+	static const int CELLS = 16;
+	static const int CACHE_LINE = 64;
+	struct Cell {
+		std::atomic<jlong> value{0};
+		char pad[CACHE_LINE - sizeof(std::atomic<jlong>)];
+	};
+	Cell cells[CELLS];
+
+	// the cell of the calling thread, threads take the cells round robin
+	static int probe() {
+		static std::atomic<int> next{0};
+		static thread_local int cell = -1;
+		if (cell < 0) cell = next.fetch_add(1, std::memory_order_relaxed) & (CELLS - 1);
+		return cell;
+	}
+public:
+	LongAdder(const LongAdder&) = delete;
+	LongAdder& operator=(const LongAdder&) = delete;
+	LongAdder() {}
+
+	void add(jlong x) { cells[probe()].value.fetch_add(x, std::memory_order_relaxed); }
+	void increment() { add(1); }
+	void decrement() { add(-1); }
+
+	jlong sum() const {
+		jlong s = 0;
+		for (const Cell& c : cells) s += c.value.load(std::memory_order_relaxed);
+		return s;
+	}
+	// exact only without concurrent updates
+	void reset() {
+		for (Cell& c : cells) c.value.store(0, std::memory_order_relaxed);
+	}
+	// the sum, leaving 0 behind; updates racing with it count for the next sum
+	jlong sumThenReset() {
+		jlong s = 0;
+		for (Cell& c : cells) s += c.value.exchange(0, std::memory_order_relaxed);
+		return s;
+	}
+	jlong longValue() const { return sum(); }
+	String toString() const { return String::valueOf(sum()); }
+};
+
+}}
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef __UTIL_CONCURRENT_MPMCQUEUE_HPP
+#define __UTIL_CONCURRENT_MPMCQUEUE_HPP
+
+#include <util/concurrent/Futex.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace util { namespace concurrent {
+
+/**
+ * Bounded lock-free multi producer multi consumer queue (D. Vyukov's ring with a
+ * sequence number per slot). The capacity is rounded up to a power of two.
+ * Blocking operations spin, then yield, then park on a futex while the queue is
+ * empty (full). After close() enqueueing fails and dequeueing fails once empty.
+ */
+template<class T>
+class MPMCQueue {
+private:
+	static const int CACHE_LINE = 64;
+	struct Slot {
+		std::atomic<unsigned long> seq;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+		T *item() { return (T *)&storage; }
+	};
+
+	Slot *slots;
+	const unsigned long mask;
+	char pad0[CACHE_LINE];
+	std::atomic<unsigned long> tail{0};          // next enqueue position
+	char pad1[CACHE_LINE];
+	std::atomic<unsigned long> head{0};          // next dequeue position
+	char pad2[CACHE_LINE];
+	std::atomic<boolean> closed{false};
+	std::atomic<boolean> sealed{false};          // closed and no enqueue still in progress
+	std::atomic<int> producing{0};               // threads inside tryEnqueueN
+	std::atomic<int> notEmpty{0}, notFull{0};    // futex words, bumped when waiters may proceed
+	std::atomic<int> consumersWaiting{0}, producersWaiting{0};
+	char pad3[CACHE_LINE];
+
+	static unsigned long roundUp(unsigned long n) {
+		unsigned long c = 2;
+		while (c < n) c <<= 1;
+		return c;
+	}
+	static unsigned spinLimit() {
+		// spinning only helps when the other side can run meanwhile
+		static const unsigned limit = std::thread::hardware_concurrency() > 1 ? 100 : 0;
+		return limit;
+	}
+	static void cpuRelax() {
+#if defined(__i386__) || defined(__x86_64__)
+		__builtin_ia32_pause();
+#endif
+	}
+
+	// claims up to n consecutive free slots at the tail, returns the first position
+	int claimTail(int n, unsigned long& pos) {
+		pos = tail.load(std::memory_order_relaxed);
+		for (;;) {
+			int k = 0;
+			while (k < n && slots[(pos + (unsigned long)k) & mask].seq.load(std::memory_order_acquire) == pos + (unsigned long)k) ++k;
+			if (k == 0) {
+				long diff = (long)(slots[pos & mask].seq.load(std::memory_order_acquire) - pos);
+				if (diff < 0) return 0;  // full
+				pos = tail.load(std::memory_order_relaxed);
+			}
+			else if (tail.compare_exchange_weak(pos, pos + (unsigned long)k, std::memory_order_relaxed)) return k;
+		}
+	}
+	// claims up to n consecutive filled slots at the head
+	int claimHead(int n, unsigned long& pos) {
+		pos = head.load(std::memory_order_relaxed);
+		for (;;) {
+			int k = 0;
+			while (k < n && slots[(pos + (unsigned long)k) & mask].seq.load(std::memory_order_acquire) == pos + (unsigned long)k + 1) ++k;
+			if (k == 0) {
+				long diff = (long)(slots[pos & mask].seq.load(std::memory_order_acquire) - (pos + 1));
+				if (diff < 0) return 0;  // empty
+				pos = head.load(std::memory_order_relaxed);
+			}
+			else if (head.compare_exchange_weak(pos, pos + (unsigned long)k, std::memory_order_relaxed)) return k;
+		}
+	}
+	static jlong nanoTime() {
+		return (jlong)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	void wakeWaiters(std::atomic<int>& word, std::atomic<int>& waiting, int count) {
+		// pairs with the waiting increment of a parking thread: it sees the slot or we see it waiting
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (waiting.load(std::memory_order_relaxed) > 0) {
+			word.fetch_add(1);
+			Futex::wake(word, count);
+		}
+	}
+	// retries op until it succeeds, stop is set (and op can not succeed) or nanos elapse
+	template<class Op>
+	boolean await(Op op, const std::atomic<boolean>& stop, std::atomic<int>& word, std::atomic<int>& waiting, jlong nanos) {
+		if (op()) return true;
+		if (nanos == 0) return false;
+		for (unsigned i = 0; i < spinLimit(); ++i) {
+			cpuRelax();
+			if (op()) return true;
+		}
+		for (int i = 0; i < 10; ++i) {
+			if (stop.load()) return op();
+			std::this_thread::yield();
+			if (op()) return true;
+		}
+		jlong deadline = nanos > 0 ? nanoTime() + nanos : 0;
+		for (;;) {
+			int s = word.load();
+			waiting.fetch_add(1);
+			boolean done = op();
+			if (!done && !stop.load()) {
+				jlong left = nanos > 0 ? deadline - nanoTime() : -1;
+				if (nanos > 0 && left <= 0) {
+					waiting.fetch_sub(1);
+					return false;
+				}
+				Futex::wait(word, s, left);
+			}
+			waiting.fetch_sub(1);
+			if (done) return true;
+			if (stop.load()) return op();
+		}
+	}
+
+public:
+	MPMCQueue(const MPMCQueue& other) = delete;
+	MPMCQueue& operator=(const MPMCQueue& other) = delete;
+
+	MPMCQueue(unsigned long capacity) : slots(new Slot[roundUp(capacity)]), mask(roundUp(capacity) - 1) {
+		for (unsigned long i = 0; i <= mask; ++i) slots[i].seq.store(i, std::memory_order_relaxed);
+	}
+	~MPMCQueue() {
+		for (unsigned long pos = head.load(); slots[pos & mask].seq.load() == pos + 1; ++pos) slots[pos & mask].item()->~T();
+		delete [] slots;
+	}
+
+	unsigned long capacity() const { return mask + 1; }
+	// approximate while other threads operate on the queue
+	unsigned long size() const {
+		unsigned long h = head.load(), t = tail.load();
+		return t > h ? t - h : 0;
+	}
+	boolean isEmpty() const { return size() == 0; }
+
+	// enqueue fails, dequeue fails once empty, the blocked threads return
+	void close() {
+		closed.store(true);
+		// an enqueue that passed the closed check still publishes its items,
+		// consumers give up on an empty queue only after that
+		while (producing.load() != 0) std::this_thread::yield();
+		sealed.store(true);
+		notEmpty.fetch_add(1);
+		Futex::wakeAll(notEmpty);
+		notFull.fetch_add(1);
+		Futex::wakeAll(notFull);
+	}
+	boolean isClosed() const { return closed.load(); }
+
+	/**
+	 * Moves up to n items from items into the queue, without blocking.
+	 * Returns the number moved, 0 when full or closed.
+	 */
+	int tryEnqueueN(T *items, int n) {
+		if (closed.load(std::memory_order_relaxed)) return 0;
+		// pairs with close(): it sees this producer or the producer sees it closed
+		producing.fetch_add(1);
+		if (closed.load()) {
+			producing.fetch_sub(1);
+			return 0;
+		}
+		unsigned long pos;
+		int k = claimTail(n, pos);
+		for (int i = 0; i < k; ++i) {
+			Slot& s = slots[(pos + (unsigned long)i) & mask];
+			new (s.item()) T(std::move(items[i]));
+			s.seq.store(pos + (unsigned long)i + 1, std::memory_order_release);
+		}
+		producing.fetch_sub(1, std::memory_order_release);
+		if (k > 0) wakeWaiters(notEmpty, consumersWaiting, k);
+		return k;
+	}
+	/**
+	 * Moves up to n items from the queue to out, without blocking.
+	 * Returns the number moved, 0 when empty.
+	 */
+	int tryDequeueN(T *out, int n) {
+		unsigned long pos;
+		int k = claimHead(n, pos);
+		for (int i = 0; i < k; ++i) {
+			Slot& s = slots[(pos + (unsigned long)i) & mask];
+			out[i] = std::move(*s.item());
+			s.item()->~T();
+			s.seq.store(pos + (unsigned long)i + mask + 1, std::memory_order_release);
+		}
+		if (k > 0) wakeWaiters(notFull, producersWaiting, k);
+		return k;
+	}
+
+	/**
+	 * Move-constructs the head item in the uninitialized memory at raw, without blocking.
+	 * Returns false when empty.
+	 */
+	boolean tryDequeueRaw(void *raw) {
+		unsigned long pos;
+		if (claimHead(1, pos) == 0) return false;
+		Slot& s = slots[pos & mask];
+		new (raw) T(std::move(*s.item()));
+		s.item()->~T();
+		s.seq.store(pos + mask + 1, std::memory_order_release);
+		wakeWaiters(notFull, producersWaiting, 1);
+		return true;
+	}
+
+	boolean tryEnqueue(T&& item) { return tryEnqueueN(&item, 1) == 1; }
+	boolean tryEnqueue(const T& item) { T t(item); return tryEnqueue(std::move(t)); }
+	boolean tryDequeue(T& out) { return tryDequeueN(&out, 1) == 1; }
+
+	/**
+	 * Waits while full, at most millis (negative for no limit).
+	 * Returns false on timeout or when closed.
+	 */
+	boolean enqueue(T&& item, long millis=-1) {
+		return await([&] { return !closed.load(std::memory_order_relaxed) && tryEnqueueN(&item, 1) == 1; },
+				closed, notFull, producersWaiting, millis < 0 ? -1 : millis * 1000000l);
+	}
+	boolean enqueue(const T& item, long millis=-1) { T t(item); return enqueue(std::move(t), millis); }
+	/**
+	 * Waits while empty, at most millis (negative for no limit).
+	 * Returns false on timeout or when closed and empty.
+	 */
+	boolean dequeue(T& out, long millis=-1) {
+		return await([&] { return tryDequeueN(&out, 1) == 1; },
+				sealed, notEmpty, consumersWaiting, millis < 0 ? -1 : millis * 1000000l);
+	}
+	/**
+	 * As dequeue, for a T with no default constructor: the item is constructed at raw.
+	 */
+	boolean dequeueRaw(void *raw, long millis=-1) {
+		return await([&] { return tryDequeueRaw(raw); },
+				sealed, notEmpty, consumersWaiting, millis < 0 ? -1 : millis * 1000000l);
+	}
+	/**
+	 * Moves all n items, waiting for room. Returns the number moved, less than n when closed.
+	 */
+	int enqueueN(T *items, int n) {
+		int done = 0;
+		while (done < n && await([&] { int k = closed.load() ? 0 : tryEnqueueN(items + done, n - done); done += k; return k > 0; },
+				closed, notFull, producersWaiting, -1)) {}
+		return done;
+	}
+	/**
+	 * Moves 1 to n items, waiting while empty. Returns 0 when closed and empty.
+	 */
+	int dequeueN(T *out, int n) {
+		int k = 0;
+		await([&] { return (k = tryDequeueN(out, n)) > 0; }, sealed, notEmpty, consumersWaiting, -1);
+		return k;
+	}
+};
+
+}}
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef __UTIL_CONCURRENT_SCHEDULEDEXECUTORSERVICE_HPP
+#define __UTIL_CONCURRENT_SCHEDULEDEXECUTORSERVICE_HPP
+
+#include <util/concurrent/TimeUnit.hpp>
+#include <ThreadPool.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace util { namespace concurrent {
+
+class ScheduledExecutorService;
+
+/**
+ * Handle of a scheduled task, a value which may be copied around.
+ * It may outlive its ScheduledExecutorService, the task is done then.
+ */
+class ScheduledFuture {
+	friend class ScheduledExecutorService;
+private:
+	// shared by the executor and its handles, service is cleared when it is destroyed
+	struct Owner {
+		std::mutex lock;
+		ScheduledExecutorService *service;
+		Owner(ScheduledExecutorService *service) : service(service) {}
+	};
+	std::shared_ptr<Owner> owner;
+	void *node = null;
+	jlong id = 0;
+	ScheduledFuture(const std::shared_ptr<Owner>& owner, void *node, jlong id) : owner(owner), node(node), id(id) {}
+public:
+	ScheduledFuture() {}
+	/**
+	 * Removes the task from the timer, a periodic task running now is not run again.
+	 * Returns false when the task already ran (one-shot), was cancelled or dropped.
+	 */
+	boolean cancel();
+	// true when the task will not run (again)
+	boolean isDone() const;
+	// time left until the next run, 0 when done or running
+	jlong getDelay(TimeUnit unit) const;
+};
+
+/**
+ * Timer facility: delayed and periodic tasks run on a ThreadPool.
+ * Timers are kept in a hierarchical timing wheel (as the Linux kernel timers):
+ * 256 slots of one tick, then four levels of 64 slots, each slot of a level
+ * spanning a whole lap of the level below. Scheduling and cancelling are O(1),
+ * once per lap of a level its next slot is cascaded into the levels below.
+ * A timer runs at the first tick after its delay elapsed, never earlier.
+ * Delays over 2^32 ticks are parked in the last level and re-inserted.
+ *
+ * The timer nodes come from a slab which is reused, memory grows with the peak
+ * number of pending timers only. A "timer-N" thread sleeps until the next
+ * occupied tick and hands the expired tasks to the pool, so a long task delays
+ * the timers only when the pool is busy.
+ */
+class ScheduledExecutorService {
+private:
+	struct Link {
+		Link *prev, *next;
+	};
+	struct Node;
+	static const int ROOT_BITS = 8;
+	static const int LEVEL_BITS = 6;
+	static const int ROOT_SIZE = 1 << ROOT_BITS;
+	static const int LEVEL_SIZE = 1 << LEVEL_BITS;
+	static const int LEVELS = 4;
+	static const int CHUNK = 256;            // nodes allocated at once
+
+	ThreadPool *pool;
+	const boolean ownPool;
+	const jlong tickNanos;
+	const jlong origin;                      // nanoTime of tick 0
+	lang::Thread *ticker;
+	std::shared_ptr<ScheduledFuture::Owner> self;
+
+	std::mutex lock;                         // guards all below
+	std::condition_variable idle;
+	Link root[ROOT_SIZE];
+	Link levels[LEVELS][LEVEL_SIZE];
+	jlong jiffies = 0;                       // next tick to expire
+	jlong sleepUntil = -1;                   // tick the ticker sleeps until, -1 when awake
+	jlong nextId = 0;
+	long pending = 0;
+	int running = 0;                         // periodic tasks on the pool
+	boolean shut = false, stopped = false;
+	Node *freeNodes = null;
+	std::vector<Node*> chunks;
+	std::atomic<int> wakeups{0};             // futex word of the ticker
+
+	ScheduledExecutorService(ThreadPool *pool, boolean ownPool, jlong tickNanos);
+	Node *allocNode();
+	void freeNode(Node *n);
+	void add(Node *n);
+	void cascade(int level, int index);
+	// moves the timers of the ticks up to until out of the wheel
+	void expire(jlong until, std::vector<std::function<void()>>& once, std::vector<Node*>& periodic);
+	jlong nextTick();
+	jlong currentTick() const;
+	jlong ticksOf(jlong nanos) const;
+	// the tick at which delay nanoseconds from now elapsed
+	jlong deadline(jlong delay) const;
+	void wakeTicker();
+	void tickerLoop();
+	class Periodic;
+	void runPeriodic(Node *n);
+	// reinserts a periodic timer after a run, or frees it
+	void finish(Node *n, boolean again);
+	boolean finishLocked(Node *n, boolean again);
+	ScheduledFuture insert(std::function<void()>&& task, jlong delay, jlong period);
+	template<class F> void drain(F f);
+
+	boolean cancel(void *node, jlong id);
+	boolean isDone(void *node, jlong id);
+	jlong getDelay(void *node, jlong id, TimeUnit unit);
+	friend class ScheduledFuture;
+public:
+	ScheduledExecutorService(const ScheduledExecutorService&) = delete;
+	ScheduledExecutorService& operator=(const ScheduledExecutorService&) = delete;
+	/**
+	 * Runs the tasks on an own pool of threads workers, tick is the timer resolution.
+	 * @throws IllegalArgumentException when tick <= 0
+	 */
+	ScheduledExecutorService(int threads=1, long tick=1, TimeUnit unit=TimeUnit::MILLISECONDS);
+	// runs the tasks on pool, which must outlive this
+	ScheduledExecutorService(ThreadPool& pool, long tick=1, TimeUnit unit=TimeUnit::MILLISECONDS);
+	// shutdownNow, waits for the periodic tasks running now
+	~ScheduledExecutorService();
+
+	/**
+	 * Runs task once after delay.
+	 * @throws RejectedExecutionException after shutdown
+	 */
+	ScheduledFuture schedule(std::function<void()> task, jlong delay, TimeUnit unit);
+	/**
+	 * Runs task after initialDelay, then every period after the start of the first
+	 * run: the runs catch up when late, never overlap. An exception thrown by the
+	 * task is printed and ends the repetition.
+	 * @throws IllegalArgumentException when period <= 0
+	 * @throws RejectedExecutionException after shutdown
+	 */
+	ScheduledFuture scheduleAtFixedRate(std::function<void()> task, jlong initialDelay, jlong period, TimeUnit unit);
+	// as scheduleAtFixedRate, the delay counts from the end of a run to the next start
+	ScheduledFuture scheduleWithFixedDelay(std::function<void()> task, jlong initialDelay, jlong delay, TimeUnit unit);
+	// runs task now on the pool
+	template<class F> void execute(F&& f) { pool->execute(std::forward<F>(f)); }
+
+	// no new tasks, periodic tasks stop, the delayed ones still run
+	void shutdown();
+	// no new tasks, the pending ones are dropped, returns their number
+	int shutdownNow();
+	boolean isShutdown();
+	// timers pending (periodic ones between runs included)
+	long size();
+};
+
+}}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef __UTIL_CONCURRENT_STAMPEDLOCK_HPP
+#define __UTIL_CONCURRENT_STAMPEDLOCK_HPP
+
+#include <lang/Object.hpp>
+#include <util/concurrent/TimeUnit.hpp>
+#include <atomic>
+
+namespace util { namespace concurrent {
+
+/**
+ * Capability based lock with optimistic reads, not reentrant.
+ * The state holds a version (bumped by every write unlock), a writer bit and
+ * the reader count. An optimistic read copies the data and then validates that
+ * no write happened meanwhile, without writing shared memory:
+ *
+ *   jlong stamp = lock.tryOptimisticRead();
+ *   T copy = data;
+ *   if (!lock.validate(stamp)) {
+ *       stamp = lock.readLock();
+ *       copy = data;
+ *       lock.unlockRead(stamp);
+ *   }
+ *
+ * Data read optimistically may be inconsistent until validated, so it must be
+ * plain values (no pointers followed, no containers that could be resized).
+ */
+class StampedLock final {
+private:
+	static const jlong RBITS = 0x7f;         // reader count
+	static const jlong WBIT = 0x80;
+	static const jlong SBITS = ~RBITS;       // version and writer bit
+	static const jlong ORIGIN = WBIT << 1;
+
+	std::atomic<jlong> state{ORIGIN};
+	std::atomic<int> writersWaiting{0};
+	std::atomic<int> waiters{0};
+	std::atomic<int> seq{0};                 // futex word, bumped on unlocks with waiters
+
+	void wakeWaiters();
+	// waits while the state is s, false on timeout
+	boolean park(jlong s, jlong deadline);
+	// nanos < 0 without timeout
+	jlong acquireWrite(jlong nanos);
+	jlong acquireRead(jlong nanos);
+	static jlong timeout(long time, TimeUnit unit) {
+		jlong nanos = unit.toNanos(time);
+		return nanos > 0 ? nanos : 0;
+	}
+public:
+	StampedLock(const StampedLock&) = delete;
+	StampedLock& operator=(const StampedLock&) = delete;
+	StampedLock() {}
+
+	// stamps are never 0, 0 means the lock was not acquired
+	jlong writeLock() { return acquireWrite(-1); }
+	jlong tryWriteLock();
+	jlong tryWriteLock(long time, TimeUnit unit) { return acquireWrite(timeout(time, unit)); }
+	jlong readLock() { return acquireRead(-1); }
+	jlong tryReadLock();
+	jlong tryReadLock(long time, TimeUnit unit) { return acquireRead(timeout(time, unit)); }
+	// 0 while write locked
+	jlong tryOptimisticRead() const {
+		jlong s = state.load(std::memory_order_acquire);
+		return (s & WBIT) == 0 ? s & SBITS : 0;
+	}
+	// true when no write lock was taken since the stamp was issued
+	boolean validate(jlong stamp) const {
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return stamp != 0 && (stamp & SBITS) == (state.load(std::memory_order_relaxed) & SBITS);
+	}
+	/**
+	 * @throws IllegalMonitorStateException when the stamp does not match
+	 */
+	void unlockWrite(jlong stamp);
+	void unlockRead(jlong stamp);
+	void unlock(jlong stamp);
+	// a write stamp from a read or optimistic stamp when possible at once, else 0
+	jlong tryConvertToWriteLock(jlong stamp);
+
+	boolean isWriteLocked() const { return (state.load() & WBIT) != 0; }
+	boolean isReadLocked() const { return (state.load() & RBITS) != 0; }
+	int getReadLockCount() const { return (int)(state.load() & RBITS); }
+};
+
+}}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef __UTIL_CONCURRENT_TIMEUNIT_HPP
+#define __UTIL_CONCURRENT_TIMEUNIT_HPP
+
+#include <lang/String.hpp>
+
+namespace util { namespace concurrent {
+
+/**
+ * Time durations at a given unit of granularity. Conversions to a finer unit
+ * saturate at Long::MIN_VALUE/MAX_VALUE, to a coarser unit they truncate.
+ */
+class TimeUnit final {
+private:
+	jlong scale;                 // nanoseconds per unit
+	const char *name;
+	constexpr TimeUnit(jlong scale, const char *name) : scale(scale), name(name) {}
+	static jlong cvt(jlong d, jlong dst, jlong src);
+public:
+	static const TimeUnit NANOSECONDS;
+	static const TimeUnit MICROSECONDS;
+	static const TimeUnit MILLISECONDS;
+	static const TimeUnit SECONDS;
+	static const TimeUnit MINUTES;
+	static const TimeUnit HOURS;
+	static const TimeUnit DAYS;
+
+	// d of sourceUnit in this unit
+	jlong convert(jlong d, const TimeUnit& sourceUnit) const { return cvt(d, scale, sourceUnit.scale); }
+	jlong toNanos(jlong d) const { return cvt(d, 1l, scale); }
+	jlong toMicros(jlong d) const { return cvt(d, 1000l, scale); }
+	jlong toMillis(jlong d) const { return cvt(d, 1000000l, scale); }
+	jlong toSeconds(jlong d) const { return cvt(d, 1000000000l, scale); }
+	jlong toMinutes(jlong d) const { return cvt(d, 60000000000l, scale); }
+	jlong toHours(jlong d) const { return cvt(d, 3600000000000l, scale); }
+	jlong toDays(jlong d) const { return cvt(d, 86400000000000l, scale); }
+
+	// Thread::sleep for timeout of this unit
+	void sleep(jlong timeout) const;
+
+	boolean operator==(const TimeUnit& o) const { return scale == o.scale; }
+	boolean operator!=(const TimeUnit& o) const { return scale != o.scale; }
+	String toString() const { return name; }
+};
+
+}}
+
+#endif
@@ -0,0 +1,371 @@
+#include <lang/Class.hpp>
+#include <lang/System.hpp>
+#include <lang/Thread.hpp>
+#include <util/concurrent/Futex.hpp>
+#include <util/Metrics.hpp>
+#include <ThreadPool.hpp>
+#include <chrono>
+
+using util::concurrent::Futex;
+
+/**
+ * Chase-Lev deque (the C11 version of Le, Pop, Cohen, Zappa Nardelli).
+ * The owner pushes and pops at the bottom, other threads steal at the top.
+ */
+class ThreadPool::Deque {
+private:
+	struct Array {
+		long mask;
+		std::atomic<Task*> *slots;
+		Array(long size) : mask(size - 1), slots(new std::atomic<Task*>[size]) {}
+		~Array() { delete [] slots; }
+		Task *get(long i) { return slots[i & mask].load(std::memory_order_relaxed); }
+		void put(long i, Task *t) { slots[i & mask].store(t, std::memory_order_relaxed); }
+	};
+	std::atomic<long> top{0};
+	char pad[64];
+	std::atomic<long> bottom{0};
+	std::atomic<Array*> array;
+	// stealers may still read an old array, freed with the deque
+	std::vector<Array*> retired;
+
+	Array *grow(Array *a, long b, long t) {
+		Array *n = new Array(2 * (a->mask + 1));
+		for (long i = t; i < b; ++i) n->put(i, a->get(i));
+		retired.push_back(a);
+		array.store(n, std::memory_order_release);
+		return n;
+	}
+public:
+	Deque() : array(new Array(256)) {}
+	~Deque() {
+		delete array.load();
+		for (Array *a : retired) delete a;
+	}
+	void push(Task *t) {
+		long b = bottom.load(std::memory_order_relaxed);
+		long tp = top.load(std::memory_order_acquire);
+		Array *a = array.load(std::memory_order_relaxed);
+		if (b - tp > a->mask) a = grow(a, b, tp);
+		a->put(b, t);
+		bottom.store(b + 1, std::memory_order_release);
+	}
+	Task *pop() {
+		long b = bottom.load(std::memory_order_relaxed) - 1;
+		Array *a = array.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		long t = top.load(std::memory_order_relaxed);
+		if (t > b) {
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return null;
+		}
+		Task *x = a->get(b);
+		if (t == b) {
+			// the last one, race with the stealers
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) x = null;
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return x;
+	}
+	// null when empty or lost a race
+	Task *steal() {
+		long t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		long b = bottom.load(std::memory_order_acquire);
+		if (t >= b) return null;
+		Array *a = array.load(std::memory_order_acquire);
+		Task *x = a->get(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return null;
+		return x;
+	}
+	boolean isEmpty() const {
+		return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+	}
+};
+
+struct ThreadPool::Worker {
+	ThreadPool *pool;
+	Deque deque;
+	lang::Thread *thread = null;
+	unsigned seed;
+	char pad[64];
+	Worker(ThreadPool *pool, unsigned seed) : pool(pool), seed(seed) {}
+};
+
+struct ThreadPool::ChunkJob {
+	std::atomic<long> next{0};
+	std::atomic<long> done{0};
+	std::atomic<int> finished{0};            // futex word of the caller
+	long chunks;
+	void (*body)(void *ctx, long chunk);
+	void *ctx;
+	std::mutex errorLock;
+	std::exception_ptr error;
+
+	ChunkJob(long chunks, void (*body)(void *, long), void *ctx) : chunks(chunks), body(body), ctx(ctx) {}
+	void complete(long n) {
+		if (done.fetch_add(n) + n == chunks) {
+			finished.store(1);
+			Futex::wakeAll(finished);
+		}
+	}
+	// ctx is used only for claimed chunks, the caller waits for them
+	void work() {
+		long c;
+		while ((c = next.fetch_add(1)) < chunks) {
+			try {
+				body(ctx, c);
+			} catch (...) {
+				{
+					std::lock_guard<std::mutex> lock(errorLock);
+					if (!error) error = std::current_exception();
+				}
+				long k = next.exchange(chunks);
+				if (k < chunks) complete(chunks - k);
+			}
+			complete(1);
+		}
+	}
+};
+
+namespace {
+const int MAX_CACHED_TASKS = 256;
+const int SPINS = 64;
+const unsigned SAMPLE_MASK = 15;         // times one in 16 tasks
+std::atomic<int> poolNumber{0};
+
+struct PoolMetrics {
+	util::Metrics::Gauge& queued = util::Metrics::gauge("ThreadPool.queued");
+	util::Metrics::Histogram& wait = util::Metrics::histogram("ThreadPool.task.wait.ns");
+	util::Metrics::Histogram& latency = util::Metrics::histogram("ThreadPool.task.latency.ns");
+};
+PoolMetrics& metrics() {
+	static PoolMetrics m;
+	return m;
+}
+}
+
+// task nodes freed by a thread are reused by its next submits
+struct ThreadPool::TaskCache {
+	Task *free = null;
+	int count = 0;
+	unsigned pushes = 0;
+	~TaskCache() {
+		while (free != null) {
+			Task *t = free;
+			free = (Task *)t->callable;
+			delete t;
+		}
+	}
+};
+__attribute__((tls_model("initial-exec"))) thread_local ThreadPool::Worker *ThreadPool::currentWorker = null;
+thread_local ThreadPool::TaskCache ThreadPool::taskCache;
+
+ThreadPool::Task *ThreadPool::allocTask() {
+	TaskCache& c = taskCache;
+	Task *t = c.free;
+	if (t == null) return new Task();
+	c.free = (Task *)t->callable;
+	--c.count;
+	return t;
+}
+void ThreadPool::freeTask(Task *t) {
+	TaskCache& c = taskCache;
+	if (c.count >= MAX_CACHED_TASKS) { delete t; return; }
+	t->callable = c.free;
+	c.free = t;
+	++c.count;
+}
+void ThreadPool::run(Task *t) {
+	PoolMetrics& m = metrics();
+	m.queued.decrement();
+	jlong queued = t->queued;
+	if (queued != 0) m.wait.record(System::nanoTime() - queued);
+	try {
+		t->invoke(t, true);
+	} catch(const Throwable& e) {
+		e.printStackTrace();
+	} catch (const std::exception& e) {
+		Throwable th(Object::getClass(typeid(e)).getName() + ":" + e.what());
+		th.fillInStackTrace().printStackTrace();
+	} catch (...) {
+		Throwable().fillInStackTrace().printStackTrace();
+	}
+	if (queued != 0) m.latency.record(System::nanoTime() - queued);
+	freeTask(t);
+}
+void ThreadPool::drop(Task *t) {
+	metrics().queued.decrement();
+	t->invoke(t, false);
+	freeTask(t);
+}
+
+ThreadPool::ThreadPool(int threads) {
+	start(threads, null);
+}
+ThreadPool::ThreadPool(int threads, lang::ThreadGroup& group) {
+	start(threads, &group);
+}
+void ThreadPool::start(int threads, lang::ThreadGroup *group) {
+	if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+	if (threads <= 0) threads = 1;
+	int pool = ++poolNumber;
+	live.store(threads);
+	for (int i = 0; i < threads; ++i) workers.push_back(new Worker(this, 2654435761u * (unsigned)(i + 1)));
+	for (int i = 0; i < threads; ++i) {
+		Worker *w = workers[(size_t)i];
+		if (group != null) w->thread = new lang::Thread(*group, [this, w] { workerLoop(w); });
+		else w->thread = new lang::Thread([this, w] { workerLoop(w); });
+		w->thread->setName("pool-" + String::valueOf(pool) + "-thread-" + String::valueOf(i + 1));
+		w->thread->start();
+	}
+}
+ThreadPool::~ThreadPool() {
+	shutdown();
+	awaitTermination();
+	for (Worker *w : workers) {
+		w->thread->join();
+		delete w->thread;
+		delete w;
+	}
+}
+
+void ThreadPool::push(Task *t) {
+	t->queued = (++taskCache.pushes & SAMPLE_MASK) == 0 ? System::nanoTime() : 0;
+	metrics().queued.increment();
+	Worker *w = currentWorker;
+	if (w != null && w->pool == this && state.load() == RUNNING) {
+		w->deque.push(t);
+	}
+	else {
+		std::unique_lock<std::mutex> lock(injectLock);
+		if (state.load() != RUNNING) {
+			lock.unlock();
+			drop(t);
+			throw RejectedExecutionException();
+		}
+		injected.push_back(t);
+		injectedCount.fetch_add(1);
+	}
+	wakeWorker();
+}
+void ThreadPool::wakeWorker() {
+	// pairs with the idle increment of a parking worker: it sees the task or we see it idle
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (idle.load() > 0) {
+		signal.fetch_add(1);
+		Futex::wake(signal, 1);
+	}
+}
+
+ThreadPool::Task *ThreadPool::find(Worker *w) {
+	if (state.load(std::memory_order_relaxed) == STOP) return null;
+	Task *t = w->deque.pop();
+	if (t != null) return t;
+	if (injectedCount.load() > 0) {
+		std::lock_guard<std::mutex> lock(injectLock);
+		if (!injected.empty()) {
+			t = injected.front();
+			injected.pop_front();
+			injectedCount.fetch_sub(1);
+			return t;
+		}
+	}
+	size_t n = workers.size();
+	w->seed ^= w->seed << 13; w->seed ^= w->seed >> 17; w->seed ^= w->seed << 5;
+	for (size_t i = 0, s = w->seed % n; i < n; ++i) {
+		Worker *v = workers[(s + i) % n];
+		if (v == w) continue;
+		if ((t = v->deque.steal()) != null) return t;
+	}
+	return null;
+}
+
+void ThreadPool::workerLoop(Worker *w) {
+	currentWorker = w;
+	for (;;) {
+		Task *t = find(w);
+		for (int i = 0; t == null && i < SPINS && state.load() == RUNNING; ++i) {
+			std::this_thread::yield();
+			t = find(w);
+		}
+		if (t == null) {
+			int s = signal.load();
+			idle.fetch_add(1);
+			t = find(w);
+			if (t == null && state.load() == RUNNING) Futex::wait(signal, s);
+			idle.fetch_sub(1);
+			if (t == null && state.load() != RUNNING && (t = find(w)) == null) break;
+		}
+		if (t != null) run(t);
+	}
+	// a push that raced with shutdownNow
+	for (Task *t; (t = w->deque.pop()) != null; ) drop(t);
+	currentWorker = null;
+	live.fetch_sub(1);
+	Futex::wakeAll(live);
+}
+
+void ThreadPool::shutdown() {
+	{
+		std::lock_guard<std::mutex> lock(injectLock);
+		int s = RUNNING;
+		state.compare_exchange_strong(s, SHUTDOWN);
+	}
+	signal.fetch_add(1);
+	Futex::wakeAll(signal);
+}
+int ThreadPool::shutdownNow() {
+	std::deque<Task*> dropped;
+	{
+		std::lock_guard<std::mutex> lock(injectLock);
+		state.store(STOP);
+		dropped.swap(injected);
+		injectedCount.store(0);
+	}
+	signal.fetch_add(1);
+	Futex::wakeAll(signal);
+	for (Worker *w : workers) {
+		while (!w->deque.isEmpty()) {
+			Task *t = w->deque.steal();
+			if (t != null) dropped.push_back(t);
+		}
+	}
+	for (Task *t : dropped) drop(t);
+	return (int)dropped.size();
+}
+boolean ThreadPool::awaitTermination(long millis) {
+	jlong deadline = System::nanoTime() + millis * 1000000l;
+	for (int n; (n = live.load()) != 0; ) {
+		if (millis <= 0) Futex::wait(live, n);
+		else {
+			jlong left = deadline - System::nanoTime();
+			if (left <= 0) return false;
+			Futex::wait(live, n, left);
+		}
+	}
+	return true;
+}
+
+long ThreadPool::chunkCount(long n, long& grain, int workers) {
+	// a few chunks per thread balance uneven work
+	if (grain <= 0) grain = (n + 8l * (workers + 1) - 1) / (8l * (workers + 1));
+	return (n + grain - 1) / grain;
+}
+void ThreadPool::runChunks(long chunks, void (*body)(void *ctx, long chunk), void *ctx) {
+	long helpers = (long)workers.size() < chunks - 1 ? (long)workers.size() : chunks - 1;
+	if (helpers == 0 || isShutdown()) {
+		for (long c = 0; c < chunks; ++c) body(ctx, c);
+		return;
+	}
+	std::shared_ptr<ChunkJob> job = std::make_shared<ChunkJob>(chunks, body, ctx);
+	try {
+		for (long i = 0; i < helpers; ++i) execute([job] { job->work(); });
+	} catch (const RejectedExecutionException& e) {
+		// the calling thread does the rest
+	}
+	job->work();
+	while (job->finished.load() == 0) Futex::wait(job->finished, 0);
+	if (job->error) std::rethrow_exception(job->error);
+}
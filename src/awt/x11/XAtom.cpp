@@ -3,18 +3,12 @@
 #include "XConstants.hpp"
 #include "XToolkit.hpp"
 #include "XlibWrapper.hpp"
+#include <util/concurrent/ConcurrentHashMap.hpp>
 
 namespace {
-static util::HashMap<long, awt::x11::XAtom> atomToAtom;
-static util::HashMap<String, awt::x11::XAtom> nameToAtom;
-
-const awt::x11::XAtom& lookup(long atom) {
-	return atomToAtom.get(atom);
-}
-const awt::x11::XAtom& lookup(const String& name) {
-	if (!nameToAtom.containsKey(name)) return (const awt::x11::XAtom&)Object::null_obj;
-	return nameToAtom.get(name);
-}
+// shared by the toolkit and event threads
+static util::concurrent::ConcurrentHashMap<long, awt::x11::XAtom> atomToAtom;
+static util::concurrent::ConcurrentHashMap<String, awt::x11::XAtom> nameToAtom;
 }
 
 namespace awt { namespace x11 {
@@ -28,22 +22,22 @@ long XAtom::getAtom(long ptr) {
 	return *(long*)ptr;
 }
 XAtom XAtom::get(long atom) {
-	const XAtom& xatom = lookup(atom);
-	if (xatom == null) return XAtom(atom);
-	return xatom;
+	XAtom xatom;
+	if (atomToAtom.get(atom, xatom)) return xatom;
+	return XAtom(atom);
 }
 XAtom XAtom::get(const String& name) {
-	const XAtom& xatom = lookup(name);
-	if (xatom == null) return XAtom(name, true);
-	return xatom;
+	XAtom xatom;
+	if (nameToAtom.get(name, xatom)) return xatom;
+	return XAtom(name, true);
 }
 
 XAtom::XAtom(const String& name, boolean autoIntern) : name(name) {
 	this->display = XToolkit::getDisplay();
 	if (autoIntern) {
 		XToolkit::awtLock();
+		Finalize(XToolkit::awtUnlock(););
 		this->atom = XlibWrapper::InternAtom(display,name,0);
-		XToolkit::awtUnlock();
 	}
 	registerAtom(*this);
 }
@@ -55,44 +49,43 @@ XAtom::XAtom(long atom) : atom(atom) {
 String XAtom::getName() const {
 	if (name.isEmpty()) {
 		XToolkit::awtLock();
+		Finalize(XToolkit::awtUnlock(););
 		const_cast<XAtom*>(this)->name = XlibWrapper::XGetAtomName(display, atom);
-		XToolkit::awtUnlock();
 	}
 	return name;
 }
 void XAtom::setProperty(long window, const String& str) {
 	if (atom == 0) throw IllegalStateException("Atom should be initialized");
 	XToolkit::awtLock();
+	Finalize(XToolkit::awtUnlock(););
 	XlibWrapper::SetProperty(display,window,atom,str);
-	XToolkit::awtUnlock();
 }
 String XAtom::getProperty(long window) {
 	if (atom == 0) throw IllegalStateException("Atom should be initialized");
 	XToolkit::awtLock();
-	String prop = XlibWrapper::GetProperty(display,window,atom);
-	XToolkit::awtUnlock();
-	return prop;
+	Finalize(XToolkit::awtUnlock(););
+	return XlibWrapper::GetProperty(display,window,atom);
 }
 
 void XAtom::setCard32Property(long window, long value) {
 	if (atom == 0) throw IllegalStateException("Atom should be initialized");
 	XToolkit::awtLock();
+	Finalize(XToolkit::awtUnlock(););
 	XlibWrapper::XChangeProperty(display,window,atom,XA_CARDINAL,32,XConstants::PropModeReplace,&value,1);
-	XToolkit::awtUnlock();
 }
 long XAtom::getCard32Property(long window) {
 	if (atom == 0) throw IllegalStateException("Atom should be initialized");
 	XToolkit::awtLock();
+	Finalize(XToolkit::awtUnlock(););
 	long prop = 0;
-	XToolkit::awtUnlock();
 	return prop;
 }
 
 void XAtom::deleteProperty(long window) {
 	if (atom == 0) throw IllegalStateException("Atom should be initialized");
 	XToolkit::awtLock();
+	Finalize(XToolkit::awtUnlock(););
 	XlibWrapper::XDeleteProperty(display,window,atom);
-	XToolkit::awtUnlock();
 }
 
 void XAtom::setAtomListProperty(long window, const Array<XAtom>& atoms) {
@@ -189,7 +189,7 @@ void XBaseWindow::preInit(XCreateWindowParams& params) {
 	else {
 		Long& parentWindowID = params.get<Long>(PARENT_WINDOW);
 		if (parentWindowID != null) {
-			LOGD("  parentWindow is id=%d", parentWindowID.longValue());
+			LOGD("  parentWindow is id=%ld", parentWindowID.longValue());
 			parentWindow = XToolkit::windowToXWindow(parentWindowID);
 		}
 		else {
@@ -348,7 +348,7 @@ void XBaseWindow::xSetBounds(int x, int y, int width, int height) {
 	XlibWrapper::XMoveResizeWindow(XToolkit::getDisplay(), getWindow(),x,y,width,height);
 }
 void XBaseWindow::setSizeHints(long flags, int x, int y, int width, int height) {
-	LOGD("%s(f=%X, %d,%d,%d,%d)",__FUNCTION__, flags,x,y,width,height);
+	LOGD("%s(f=%lX, %d,%d,%d,%d)",__FUNCTION__, flags,x,y,width,height);
 	XSizeHints hints;
 
 	if ((flags & XUtilConstants::PPosition) != 0) {
@@ -1,6 +1,7 @@
 #include <awt/EventQueue.hpp>
 #include <lang/System.hpp>
 #include <util/concurrent/Lock.hpp>
+#include <util/concurrent/ScheduledExecutorService.hpp>
 
 #include "XAtom.hpp"
 #include "XConstants.hpp"
@@ -177,10 +178,12 @@ void awt_toolkit_init() {
 }
 
 
-HashMap<Long,void*> timeoutTasks() {
-	static HashMap<Long,void*> *map = null;
-	if (map == null) map = new HashMap<Long,void*>();
-	return *map;
+// tasks of XToolkit::schedule, the timer queues them here as they expire and wakes the poll
+std::mutex timeoutTasksLock;
+std::vector<std::function<void()>> timeoutTasks;
+util::concurrent::ScheduledExecutorService& timeoutTimer() {
+	static util::concurrent::ScheduledExecutorService *timer = new util::concurrent::ScheduledExecutorService();
+	return *timer;
 }
 HashMap<Long,awt::x11::XBaseWindow*>& winMap() {
 	static HashMap<Long,awt::x11::XBaseWindow*> *map = null;
@@ -205,6 +208,18 @@ int getDefaultScreenNum() {
 }
 
 void callTimeoutTasks() {
+	std::vector<std::function<void()>> due;
+	{
+		std::lock_guard<std::mutex> g(timeoutTasksLock);
+		due.swap(timeoutTasks);
+	}
+	for (std::function<void()>& task : due) {
+		try {
+			task();
+		} catch (const Throwable& e) {
+			e.printStackTrace();
+		}
+	}
 }
 
 void performPoll(long nextTaskTime) {
@@ -224,9 +239,13 @@ void performPoll(long nextTaskTime) {
 		pollFds[0].revents = 0;
 		pollFds[1].revents = 0;
 	}
+	// the caller holds AWT_LOCK, possibly more than once,
+	// other threads may use the display while waiting (AWT_NOFLUSH_UNLOCK)
+	int holds = AWT_LOCK.getHoldCount();
+	for (int i=0; i < holds; ++i) AWT_LOCK.unlock();
 	if (timeout == 0) Thread::yield();
-
 	int result = ::poll(pollFds, 2, timeout);
+	for (int i=0; i < holds; ++i) AWT_LOCK.lock();
 	if (result == 0) return ;
 
 	if (pollFds[1].revents) {
@@ -479,7 +498,7 @@ protected:
 	void preInit(XCreateWindowParams& params) override {
 		target = (Component*)params.get<Long>(TARGET).longValue();
 		windowType = ((Window*)target)->getType();
-		LOGN("XWindowPeer::%s type = %d, overRedir=%s", __FUNCTION__, windowType, String::valueOf(isOverrideRedirect()).cstr());
+		LOGN("XWindowPeer::%s type = %d, overRedir=%s", __FUNCTION__, (int)windowType, String::valueOf(isOverrideRedirect()).cstr());
 		params.put<Boolean>(REPARENTED, Boolean::valueOf(isOverrideRedirect() || isSimpleWindow()));
 		XPanelPeer::preInit(params);
 
@@ -680,12 +699,17 @@ void XToolkit::awtUnlock() {
 long XToolkit::getNextTaskTime() {
 	awtLock();
 	Finalize(awtUnlock(););
-	if (timeoutTasks().isEmpty()) {
-		return -1L;
-	}
-	//return (Long)timeoutTasks.firstKey();
-	LOGD("XToolkit::getNextTaskTime ret t0+100");
-	return System::currentTimeMillis() + 100;
+	// expired tasks wake the poll through the pipe, until then wait for events
+	std::lock_guard<std::mutex> g(timeoutTasksLock);
+	return timeoutTasks.empty() ? -1L : System::currentTimeMillis();
+}
+
+util::concurrent::ScheduledFuture XToolkit::schedule(std::function<void()> task, long interval) {
+	return timeoutTimer().schedule([task] {
+		std::lock_guard<std::mutex> g(timeoutTasksLock);
+		timeoutTasks.push_back(task);
+		if (awt_pipe_inited && ::write(AWT_WRITEPIPE, "t", 1) < 0) {}
+	}, interval, util::concurrent::TimeUnit::MILLISECONDS);
 }
 
 long XToolkit::getDisplay() {
@@ -5,6 +5,7 @@
 #include <lang/Number.hpp>
 #include <lang/Thread.hpp>
 #include <nio/ByteBuffer.hpp>
+#include <util/concurrent/ScheduledExecutorService.hpp>
 
 namespace awt { namespace x11 {
 
@@ -117,6 +118,11 @@ public:
 	//static void addEventDispatcher(long window, XEventDispatcher dispatcher);
 	static String getCorrectXIDString(const String& val);
 	static String getEnv(const String& key);
+	/**
+	 * Runs task on the toolkit thread after interval milliseconds,
+	 * the returned future cancels it.
+	 */
+	static util::concurrent::ScheduledFuture schedule(std::function<void()> task, long interval);
 
 	XToolkit();
 	awt::ButtonPeer* createButton(awt::Button* target);
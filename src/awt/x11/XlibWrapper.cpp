@@ -41,7 +41,7 @@ int XlibWrapper::XDefaultScreen(long display) {
 //long XlibWrapper::DisplayHeightMM(long display, long screen);
 long XlibWrapper::XRootWindow(long display, long screen) {
 	long r = ::XRootWindow((Display *)display, (int)screen);
-	LOGD("XlibWrapper::%s(%lX,%ld) = %d", __FUNCTION__, display, screen, r);
+	LOGD("XlibWrapper::%s(%lX,%ld) = %ld", __FUNCTION__, display, screen, r);
 	return r;
 }
 //int XlibWrapper::ScreenCount(long display);
@@ -294,11 +294,11 @@ void XlibWrapper::XSetWMNormalHints(long display, long window, long hints) {
 	for (int i=0; i < s; ++i) sprintf(buf+2*i, "%02X", ((char*)hints)[i]);
 	LOGD("XlibWrapper::%s(hints=%s)",__FUNCTION__, buf);*/
 	XSizeHints *xh = (XSizeHints *)hints;
-	LOGD("XlibWrapper::%s(f=%X, x=%d,y=%d,w=%d,h=%d)",__FUNCTION__, xh->flags, xh->x, xh->y, xh->width, xh->height);
+	LOGD("XlibWrapper::%s(f=%lX, x=%d,y=%d,w=%d,h=%d)",__FUNCTION__, xh->flags, xh->x, xh->y, xh->width, xh->height);
 	::XSetWMNormalHints((Display*)display, window, (XSizeHints*)hints);
 }
 void XlibWrapper::XSetMinMaxHints(long display, long window, int x, int y, int width, int height, long flags) {
-	LOGD("XlibWrapper::%s(f=%X, x=%d,y=%d,w=%d,h=%d)",__FUNCTION__,flags, x,y,width,height);
+	LOGD("XlibWrapper::%s(f=%lX, x=%d,y=%d,w=%d,h=%d)",__FUNCTION__,flags, x,y,width,height);
     XSizeHints hints;
     hints.flags = flags;
     hints.width = width;
@@ -312,7 +312,7 @@ void XlibWrapper::XSetMinMaxHints(long display, long window, int x, int y, int w
     ::XSetWMNormalHints((Display*)display, window, &hints);
 }
 long XlibWrapper::XAllocSizeHints() {
-	return (long)XAllocSizeHints();
+	return (long)::XAllocSizeHints();
 }
 
 //int XlibWrapper::XSendEvent(long display, long window, boolean propagate, long event_mask, long event);
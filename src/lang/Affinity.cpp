@@ -0,0 +1,208 @@
+#include <lang/Affinity.hpp>
+#include <lang/Exception.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <dirent.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+using lang::CpuSet;
+
+// the cpu list of the sysfs file path, empty when it can not be read
+CpuSet readCpuList(const char *path) {
+	char buf[4096];
+	FILE *f = std::fopen(path, "r");
+	if (f == null) return CpuSet();
+	size_t n = std::fread(buf, 1, sizeof(buf) - 1, f);
+	std::fclose(f);
+	while (n > 0 && (buf[n - 1] == '\n' || buf[n - 1] == ' ')) --n;
+	buf[n] = 0;
+	try {
+		return CpuSet::parse(buf);
+	} catch (const IllegalArgumentException& e) {
+		return CpuSet();
+	}
+}
+
+// read once, the nodes do not change while running
+struct Topology {
+	std::vector<CpuSet> nodes;
+	std::vector<int> nodeOf;
+
+	Topology() : nodeOf(CpuSet::MAX_CPUS, 0) {
+		DIR *d = ::opendir("/sys/devices/system/node");
+		if (d != null) {
+			struct dirent *e;
+			while ((e = ::readdir(d)) != null) {
+				int id;
+				char tail;
+				if (std::sscanf(e->d_name, "node%d%c", &id, &tail) != 1 || id < 0 || id >= CpuSet::MAX_CPUS) continue;
+				if ((size_t)id >= nodes.size()) nodes.resize((size_t)id + 1);
+				char path[64];
+				std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", id);
+				nodes[(size_t)id] = readCpuList(path);
+			}
+			::closedir(d);
+		}
+		if (nodes.empty()) {
+			nodes.push_back(readCpuList("/sys/devices/system/cpu/online"));
+			if (nodes[0].isEmpty()) nodes[0] = CpuSet::online();
+		}
+		for (size_t n = 0; n < nodes.size(); ++n) {
+			for (int c = nodes[n].nextSetBit(0); c >= 0; c = nodes[n].nextSetBit(c + 1)) nodeOf[(size_t)c] = (int)n;
+		}
+	}
+};
+Topology& topology() {
+	static Topology t;
+	return t;
+}
+
+#ifdef __linux__
+void toNative(const CpuSet& s, cpu_set_t& cs) {
+	CPU_ZERO(&cs);
+	for (int c = s.nextSetBit(0); c >= 0; c = s.nextSetBit(c + 1)) CPU_SET((size_t)c, &cs);
+}
+CpuSet fromNative(const cpu_set_t& cs) {
+	CpuSet s;
+	for (int c = 0; c < CpuSet::MAX_CPUS && c < CPU_SETSIZE; ++c) {
+		if (CPU_ISSET((size_t)c, &cs)) s.set(c);
+	}
+	return s;
+}
+#endif
+}
+
+namespace lang {
+
+CpuSet::CpuSet(std::initializer_list<int> cpus) {
+	clear();
+	for (int c : cpus) set(c);
+}
+void CpuSet::check(int cpu) {
+	if (cpu < 0 || cpu >= MAX_CPUS) throw IndexOutOfBoundsException("cpu " + String::valueOf(cpu));
+}
+CpuSet CpuSet::parse(const String& list) {
+	CpuSet s;
+	const char *p = list.cstr();
+	while (*p != 0) {
+		char *end;
+		long lo = std::strtol(p, &end, 10), hi = lo;
+		if (end == p) throw IllegalArgumentException("bad cpu list: " + list);
+		p = end;
+		if (*p == '-') {
+			hi = std::strtol(++p, &end, 10);
+			if (end == p) throw IllegalArgumentException("bad cpu list: " + list);
+			p = end;
+		}
+		if (lo < 0 || hi < lo || hi >= MAX_CPUS) throw IllegalArgumentException("bad cpu list: " + list);
+		for (long c = lo; c <= hi; ++c) s.set((int)c);
+		if (*p == ',') ++p;
+		else if (*p != 0) throw IllegalArgumentException("bad cpu list: " + list);
+	}
+	return s;
+}
+CpuSet CpuSet::online() {
+	#ifdef __linux__
+	cpu_set_t cs;
+	if (::sched_getaffinity(0, sizeof(cs), &cs) == 0) return fromNative(cs);
+	#endif
+	CpuSet s;
+	long n = ::sysconf(_SC_NPROCESSORS_ONLN);
+	for (int c = 0; c < n && c < MAX_CPUS; ++c) s.set(c);
+	return s;
+}
+int CpuSet::nextSetBit(int from) const {
+	if (from < 0) from = 0;
+	for (int i = from >> 6; i < WORDS; ++i) {
+		uint64_t w = bits[i];
+		if (i == from >> 6) w &= ~(uint64_t)0 << (from & 63);
+		if (w != 0) return (i << 6) + __builtin_ctzll(w);
+	}
+	return -1;
+}
+int CpuSet::cardinality() const {
+	int n = 0;
+	for (uint64_t w : bits) n += __builtin_popcountll(w);
+	return n;
+}
+boolean CpuSet::equals(const CpuSet& o) const {
+	for (int i = 0; i < WORDS; ++i) {
+		if (bits[i] != o.bits[i]) return false;
+	}
+	return true;
+}
+String CpuSet::toString() const {
+	StringBuilder sb;
+	for (int c = nextSetBit(0); c >= 0; ) {
+		int hi = c;
+		while (get(hi + 1)) ++hi;
+		if (sb.length() > 0) sb.append(',');
+		sb.append(String::valueOf(c));
+		if (hi > c) sb.append('-').append(String::valueOf(hi));
+		c = nextSetBit(hi + 1);
+	}
+	return sb.toString();
+}
+
+int Numa::nodeCount() {
+	return (int)topology().nodes.size();
+}
+CpuSet Numa::cpusOfNode(int node) {
+	Topology& t = topology();
+	return node >= 0 && node < (int)t.nodes.size() ? t.nodes[(size_t)node] : CpuSet();
+}
+int Numa::nodeOfCpu(int cpu) {
+	return cpu >= 0 && cpu < CpuSet::MAX_CPUS ? topology().nodeOf[(size_t)cpu] : 0;
+}
+int Numa::currentCpu() {
+	#ifdef __linux__
+	int cpu = ::sched_getcpu();
+	return cpu < 0 ? 0 : cpu;
+	#else
+	return 0;
+	#endif
+}
+int Numa::currentNode() {
+	return nodeOfCpu(currentCpu());
+}
+
+void *Numa::allocate(size_t size) {
+	void *p = ::mmap(null, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED) throw OutOfMemoryError("mmap of " + String::valueOf((jlong)size) + " bytes failed");
+	return p;
+}
+void *Numa::allocateLocal(size_t size) {
+	void *p = allocate(size);
+	touch(p, size);
+	return p;
+}
+void *Numa::allocateOnNode(size_t size, int node) {
+	CpuSet cpus = cpusOfNode(node);
+	if (cpus.isEmpty()) throw IllegalArgumentException("no CPUs on node " + String::valueOf(node));
+	void *p = allocate(size);
+	#ifdef __linux__
+	cpu_set_t saved, pinned;
+	boolean restore = ::sched_getaffinity(0, sizeof(saved), &saved) == 0;
+	toNative(cpus, pinned);
+	if (restore) restore = ::sched_setaffinity(0, sizeof(pinned), &pinned) == 0;
+	touch(p, size);
+	if (restore) ::sched_setaffinity(0, sizeof(saved), &saved);
+	#else
+	touch(p, size);
+	#endif
+	return p;
+}
+void Numa::touch(void *p, size_t size) {
+	size_t page = (size_t)::sysconf(_SC_PAGESIZE);
+	volatile char *b = (volatile char *)p;
+	for (size_t i = 0; i < size; i += page) b[i] = 0;
+}
+void Numa::free(void *p, size_t size) {
+	if (p != null) ::munmap(p, size);
+}
+
+} //namespace lang
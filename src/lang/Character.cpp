@@ -1,135 +1,131 @@
 #include <lang/Character.hpp>
-#include <lang/System.hpp>
-
-#include <ctype.h>
+#include <lang/String.hpp>
 
 namespace lang {
 
 namespace {
-class CharacterDataLatin1 : extends CharacterData {
-    /* The character properties are currently encoded into 32 bits in the following manner:
-        1 bit   mirrored property
-        4 bits  directionality property
-        9 bits  signed offset used for converting case
-        1 bit   if 1, adding the signed offset converts the character to lowercase
-        1 bit   if 1, subtracting the signed offset converts the character to uppercase
-        1 bit   if 1, this character has a titlecase equivalent (possibly itself)
-        3 bits  0  may not be part of an identifier
-                1  ignorable control; may continue a Unicode identifier or Java identifier
-                2  may continue a Java identifier but not a Unicode identifier (unused)
-                3  may continue a Unicode identifier or Java identifier
-                4  is a Java whitespace character
-                5  may start or continue a Java identifier;
-                   may continue but not start a Unicode identifier (underscores)
-                6  may start or continue a Java identifier but not a Unicode identifier ($)
-                7  may start or continue a Unicode identifier or Java identifier
-                Thus:
-                   5, 6, 7 may start a Java identifier
-                   1, 2, 3, 5, 6, 7 may continue a Java identifier
-                   7 may start a Unicode identifier
-                   1, 3, 5, 7 may continue a Unicode identifier
-                   1 is ignorable within an identifier
-                   4 is Java whitespace
-        2 bits  0  this character has no numeric property
-                1  adding the digit offset to the character code and then
-                   masking with 0x1F will produce the desired numeric value
-                2  this character has a "strange" numeric value
-                3  a Java supradecimal digit: adding the digit offset to the
-                   character code, then masking with 0x1F, then adding 10
-                   will produce the desired numeric value
-        5 bits  digit offset
-        5 bits  character type
+typedef CharacterData::Properties Properties;
 
-        The encoding of character properties is subject to change at any time.
-     */
-private:
-	int A[256];
-	CharacterDataLatin1() {
-		for (int i=0; i < 256; ++i) {
-			A[i] = 0;
-			if (isdigit(i)) A[i] = (('0' << 5)&0x3E0) + Character::DECIMAL_DIGIT_NUMBER;
-		}
-	}
-public:
-	static CharacterDataLatin1 instance;
+// general categories of Latin-1 as consecutive ranges
+struct Range { int last; byte type; };
+constexpr Range ranges[] = {
+	{0x1F, Character::CONTROL}, {0x20, Character::SPACE_SEPARATOR},
+	{0x23, Character::OTHER_PUNCTUATION}, {0x24, Character::CURRENCY_SYMBOL},
+	{0x27, Character::OTHER_PUNCTUATION}, {0x28, Character::START_PUNCTUATION},
+	{0x29, Character::END_PUNCTUATION}, {0x2A, Character::OTHER_PUNCTUATION},
+	{0x2B, Character::MATH_SYMBOL}, {0x2C, Character::OTHER_PUNCTUATION},
+	{0x2D, Character::DASH_PUNCTUATION}, {0x2F, Character::OTHER_PUNCTUATION},
+	{0x39, Character::DECIMAL_DIGIT_NUMBER}, {0x3B, Character::OTHER_PUNCTUATION},
+	{0x3E, Character::MATH_SYMBOL}, {0x40, Character::OTHER_PUNCTUATION},
+	{0x5A, Character::UPPERCASE_LETTER}, {0x5B, Character::START_PUNCTUATION},
+	{0x5C, Character::OTHER_PUNCTUATION}, {0x5D, Character::END_PUNCTUATION},
+	{0x5E, Character::MODIFIER_SYMBOL}, {0x5F, Character::CONNECTOR_PUNCTUATION},
+	{0x60, Character::MODIFIER_SYMBOL}, {0x7A, Character::LOWERCASE_LETTER},
+	{0x7B, Character::START_PUNCTUATION}, {0x7C, Character::MATH_SYMBOL},
+	{0x7D, Character::END_PUNCTUATION}, {0x7E, Character::MATH_SYMBOL},
+	{0x9F, Character::CONTROL}, {0xA0, Character::SPACE_SEPARATOR},
+	{0xA1, Character::OTHER_PUNCTUATION}, {0xA5, Character::CURRENCY_SYMBOL},
+	{0xA6, Character::OTHER_SYMBOL}, {0xA7, Character::OTHER_PUNCTUATION},
+	{0xA8, Character::MODIFIER_SYMBOL}, {0xA9, Character::OTHER_SYMBOL},
+	{0xAA, Character::OTHER_LETTER}, {0xAB, Character::INITIAL_QUOTE_PUNCTUATION},
+	{0xAC, Character::MATH_SYMBOL}, {0xAD, Character::FORMAT},
+	{0xAE, Character::OTHER_SYMBOL}, {0xAF, Character::MODIFIER_SYMBOL},
+	{0xB0, Character::OTHER_SYMBOL}, {0xB1, Character::MATH_SYMBOL},
+	{0xB3, Character::OTHER_NUMBER}, {0xB4, Character::MODIFIER_SYMBOL},
+	{0xB5, Character::LOWERCASE_LETTER}, {0xB7, Character::OTHER_PUNCTUATION},
+	{0xB8, Character::MODIFIER_SYMBOL}, {0xB9, Character::OTHER_NUMBER},
+	{0xBA, Character::OTHER_LETTER}, {0xBB, Character::FINAL_QUOTE_PUNCTUATION},
+	{0xBE, Character::OTHER_NUMBER}, {0xBF, Character::OTHER_PUNCTUATION},
+	{0xD6, Character::UPPERCASE_LETTER}, {0xD7, Character::MATH_SYMBOL},
+	{0xDE, Character::UPPERCASE_LETTER}, {0xF6, Character::LOWERCASE_LETTER},
+	{0xF7, Character::MATH_SYMBOL}, {0xFF, Character::LOWERCASE_LETTER},
+};
+constexpr byte typeOf(int c, int i = 0) {
+	return c <= ranges[i].last ? ranges[i].type : typeOf(c, i + 1);
+}
+constexpr byte digitOf(int c) {
+	return c >= '0' && c <= '9' ? (byte)(c - '0') :
+		c >= 'A' && c <= 'Z' ? (byte)(c - 'A' + 10) :
+		c >= 'a' && c <= 'z' ? (byte)(c - 'a' + 10) : 0xFF;
+}
+constexpr boolean whitespaceOf(int c) {
+	return (c >= 0x09 && c <= 0x0D) || (c >= 0x1C && c <= 0x20);
+}
+// Latin-1 upper case letters map to lower case 32 above, lower case letters
+// 32 below except sharp s (none), micro sign (U+039C) and y diaeresis (U+0178)
+constexpr int upperOf(int c) {
+	return typeOf(c) != Character::LOWERCASE_LETTER || c == 0xDF ? c : c == 0xB5 ? 0x39C : c == 0xFF ? 0x178 : c - 32;
+}
+constexpr int lowerOf(int c) {
+	return typeOf(c) == Character::UPPERCASE_LETTER ? c + 32 : c;
+}
+constexpr Properties propertiesOf(int c) {
+	return {typeOf(c), digitOf(c), whitespaceOf(c), (unsigned short)(upperOf(c) - c), (unsigned short)(lowerOf(c) - c)};
+}
+// a case mapping leaving Latin-1 keeps the char
+constexpr char mapOf(int c, int m) { return (char)(m < 256 ? m : c); }
 
-	int getProperties(int ch) {
-		return A[ch&0xff];
-	}
-	int getType(int ch) {
-		int props = getProperties(ch);
-		return (props & 0x1F);
-	}
-	int toLowerCase(int ch) {
-		int mapChar = ch;
-		int val = getProperties(ch);
-		if (((val & 0x00020000) != 0) && ((val & 0x07FC0000) != 0x07FC0000)) {
-			int offset = val << 5 >> (5+18);
-			mapChar = ch + offset;
-		}
-		return mapChar;
-	}
-	int toUpperCase(int ch) {
-		int mapChar = ch;
-		int val = getProperties(ch);
+template<int... I> struct Indices {};
+template<int N, int... I> struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+template<int... I> struct MakeIndices<0, I...> { typedef Indices<I...> type; };
 
-		if ((val & 0x00010000) != 0) {
-			if ((val & 0x07FC0000) != 0x07FC0000) {
-				int offset = val  << 5 >> (5+18);
-				mapChar =  ch - offset;
-			} else if (ch == 0x00B5) {
-				mapChar = 0x039C;
-			}
-		}
-		return mapChar;
-	}
-	int toTitleCase(int ch) { return toUpperCase(ch); }
-	int digit(int ch, int radix) {
-		int value = -1;
-		if (radix >= Character::MIN_RADIX && radix <= Character::MAX_RADIX) {
-			int val = getProperties(ch);
-			int kind = val & 0x1F;
-			if (kind == Character::DECIMAL_DIGIT_NUMBER) {
-				value = (ch + ((val & 0x3E0) >> 5)) & 0x1F;
-			}
-			else if ((val & 0xC00) == 0x00000C00) { // Java supradecimal digit
-				value = ((ch + ((val & 0x3E0) >> 5)) & 0x1F) + 10;
-			}
-		}
-		return (value < radix) ? value : -1;
-	}
+template<int... I>
+constexpr CharacterData::Latin1 makeLatin1(Indices<I...>) {
+	return {
+		{propertiesOf(I)...},
+		{mapOf(I, upperOf(I))...},
+		{mapOf(I, lowerOf(I))...},
+	};
+}
 
-	boolean isWhitespace(int ch) {
-		int props = getProperties(ch);
-		return ((props & 0x00007000) == 0x00004000);
-	}
-};
-CharacterDataLatin1 CharacterDataLatin1::instance;
+void checkRange(int offset, int count, int length) {
+	if (offset < 0 || count < 0 || offset > length - count)
+		throw IndexOutOfBoundsException("Range [" + String::valueOf(offset) + ", " + String::valueOf(offset) +
+				" + " + String::valueOf(count) + ") out of bounds for length " + String::valueOf(length));
+}
 }
 
-CharacterData& CharacterData::of(int ch) {
-	return CharacterDataLatin1::instance;
-/*
-	if (ch >>> 8 == 0) {	 // fast-path
-		return CharacterDataLatin1.instance;
-	} else {
-		switch(ch >>> 16) {  //plane 00-16
-		case(0):
-			return CharacterData00.instance;
-		case(1):
-			return CharacterData01.instance;
-		case(2):
-			return CharacterData02.instance;
-		case(14):
-			return CharacterData0E.instance;
-		case(15):   // Private Use
-		case(16):   // Private Use
-			return CharacterDataPrivateUse.instance;
-		default:
-			return CharacterDataUndefined.instance;
-		}
-	}
-*/
+const CharacterData::Latin1 CharacterData::latin1 = makeLatin1(MakeIndices<256>::type());
+const CharacterData::Properties CharacterData::unassigned = {Character::UNASSIGNED, 0xFF, false, 0, 0};
+
+void Character::getType(const char *src, int count, byte dst[]) {
+	const Properties *p = CharacterData::latin1.properties;
+	for (int i = 0; i < count; ++i) dst[i] = p[(byte)src[i]].type;
+}
+void Character::toUpperCase(const char *src, int count, char dst[]) {
+	const char *m = CharacterData::latin1.upper;
+	for (int i = 0; i < count; ++i) dst[i] = m[(byte)src[i]];
+}
+void Character::toLowerCase(const char *src, int count, char dst[]) {
+	const char *m = CharacterData::latin1.lower;
+	for (int i = 0; i < count; ++i) dst[i] = m[(byte)src[i]];
+}
+
+void Character::getType(const Array<char>& a, int offset, int count, Array<byte>& types) {
+	checkRange(offset, count, a.length);
+	checkRange(0, count, types.length);
+	if (count > 0) getType(&a[offset], count, &types[0]);
+}
+void Character::toUpperCase(Array<char>& a, int offset, int count) {
+	checkRange(offset, count, a.length);
+	if (count > 0) toUpperCase(&a[offset], count, &a[offset]);
+}
+void Character::toLowerCase(Array<char>& a, int offset, int count) {
+	checkRange(offset, count, a.length);
+	if (count > 0) toLowerCase(&a[offset], count, &a[offset]);
+}
+
+void Character::getType(const String& s, int beginIndex, int endIndex, byte dst[]) {
+	if (beginIndex < 0 || endIndex > s.len || beginIndex > endIndex) String::outOfBounds(beginIndex, endIndex);
+	getType(s.ptr + beginIndex, endIndex - beginIndex, dst);
+}
+void Character::toUpperCase(const String& s, int beginIndex, int endIndex, char dst[]) {
+	if (beginIndex < 0 || endIndex > s.len || beginIndex > endIndex) String::outOfBounds(beginIndex, endIndex);
+	toUpperCase(s.ptr + beginIndex, endIndex - beginIndex, dst);
+}
+void Character::toLowerCase(const String& s, int beginIndex, int endIndex, char dst[]) {
+	if (beginIndex < 0 || endIndex > s.len || beginIndex > endIndex) String::outOfBounds(beginIndex, endIndex);
+	toLowerCase(s.ptr + beginIndex, endIndex - beginIndex, dst);
 }
 
 }
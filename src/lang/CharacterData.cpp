@@ -0,0 +1,1106 @@
+// Generated by tools/GenerateCharacter.pl from Unicode 14.0.0, do not edit.
+#include <lang/Character.hpp>
+
+namespace lang {
+
+const CharacterData::Properties CharacterData::records[265] = {
+	{15, 255, false, 0x0000, 0x0000}, {15, 255, true, 0x0000, 0x0000},
+	{12, 255, true, 0x0000, 0x0000}, {24, 255, false, 0x0000, 0x0000},
+	{26, 255, false, 0x0000, 0x0000}, {21, 255, false, 0x0000, 0x0000},
+	{22, 255, false, 0x0000, 0x0000}, {25, 255, false, 0x0000, 0x0000},
+	{20, 255, false, 0x0000, 0x0000}, {9, 0, false, 0x0000, 0x0000},
+	{9, 1, false, 0x0000, 0x0000}, {9, 2, false, 0x0000, 0x0000},
+	{9, 3, false, 0x0000, 0x0000}, {9, 4, false, 0x0000, 0x0000},
+	{9, 5, false, 0x0000, 0x0000}, {9, 6, false, 0x0000, 0x0000},
+	{9, 7, false, 0x0000, 0x0000}, {9, 8, false, 0x0000, 0x0000},
+	{9, 9, false, 0x0000, 0x0000}, {1, 10, false, 0x0000, 0x0020},
+	{1, 11, false, 0x0000, 0x0020}, {1, 12, false, 0x0000, 0x0020},
+	{1, 13, false, 0x0000, 0x0020}, {1, 14, false, 0x0000, 0x0020},
+	{1, 15, false, 0x0000, 0x0020}, {1, 16, false, 0x0000, 0x0020},
+	{1, 17, false, 0x0000, 0x0020}, {1, 18, false, 0x0000, 0x0020},
+	{1, 19, false, 0x0000, 0x0020}, {1, 20, false, 0x0000, 0x0020},
+	{1, 21, false, 0x0000, 0x0020}, {1, 22, false, 0x0000, 0x0020},
+	{1, 23, false, 0x0000, 0x0020}, {1, 24, false, 0x0000, 0x0020},
+	{1, 25, false, 0x0000, 0x0020}, {1, 26, false, 0x0000, 0x0020},
+	{1, 27, false, 0x0000, 0x0020}, {1, 28, false, 0x0000, 0x0020},
+	{1, 29, false, 0x0000, 0x0020}, {1, 30, false, 0x0000, 0x0020},
+	{1, 31, false, 0x0000, 0x0020}, {1, 32, false, 0x0000, 0x0020},
+	{1, 33, false, 0x0000, 0x0020}, {1, 34, false, 0x0000, 0x0020},
+	{1, 35, false, 0x0000, 0x0020}, {27, 255, false, 0x0000, 0x0000},
+	{23, 255, false, 0x0000, 0x0000}, {2, 10, false, 0xFFE0, 0x0000},
+	{2, 11, false, 0xFFE0, 0x0000}, {2, 12, false, 0xFFE0, 0x0000},
+	{2, 13, false, 0xFFE0, 0x0000}, {2, 14, false, 0xFFE0, 0x0000},
+	{2, 15, false, 0xFFE0, 0x0000}, {2, 16, false, 0xFFE0, 0x0000},
+	{2, 17, false, 0xFFE0, 0x0000}, {2, 18, false, 0xFFE0, 0x0000},
+	{2, 19, false, 0xFFE0, 0x0000}, {2, 20, false, 0xFFE0, 0x0000},
+	{2, 21, false, 0xFFE0, 0x0000}, {2, 22, false, 0xFFE0, 0x0000},
+	{2, 23, false, 0xFFE0, 0x0000}, {2, 24, false, 0xFFE0, 0x0000},
+	{2, 25, false, 0xFFE0, 0x0000}, {2, 26, false, 0xFFE0, 0x0000},
+	{2, 27, false, 0xFFE0, 0x0000}, {2, 28, false, 0xFFE0, 0x0000},
+	{2, 29, false, 0xFFE0, 0x0000}, {2, 30, false, 0xFFE0, 0x0000},
+	{2, 31, false, 0xFFE0, 0x0000}, {2, 32, false, 0xFFE0, 0x0000},
+	{2, 33, false, 0xFFE0, 0x0000}, {2, 34, false, 0xFFE0, 0x0000},
+	{2, 35, false, 0xFFE0, 0x0000}, {12, 255, false, 0x0000, 0x0000},
+	{28, 255, false, 0x0000, 0x0000}, {5, 255, false, 0x0000, 0x0000},
+	{29, 255, false, 0x0000, 0x0000}, {16, 255, false, 0x0000, 0x0000},
+	{11, 255, false, 0x0000, 0x0000}, {2, 255, false, 0x02E7, 0x0000},
+	{30, 255, false, 0x0000, 0x0000}, {1, 255, false, 0x0000, 0x0020},
+	{2, 255, false, 0x0000, 0x0000}, {2, 255, false, 0xFFE0, 0x0000},
+	{2, 255, false, 0x0079, 0x0000}, {1, 255, false, 0x0000, 0x0001},
+	{2, 255, false, 0xFFFF, 0x0000}, {1, 255, false, 0x0000, 0xFF39},
+	{2, 255, false, 0xFF18, 0x0000}, {1, 255, false, 0x0000, 0xFF87},
+	{2, 255, false, 0xFED4, 0x0000}, {2, 255, false, 0x00C3, 0x0000},
+	{1, 255, false, 0x0000, 0x00D2}, {1, 255, false, 0x0000, 0x00CE},
+	{1, 255, false, 0x0000, 0x00CD}, {1, 255, false, 0x0000, 0x004F},
+	{1, 255, false, 0x0000, 0x00CA}, {1, 255, false, 0x0000, 0x00CB},
+	{1, 255, false, 0x0000, 0x00CF}, {2, 255, false, 0x0061, 0x0000},
+	{1, 255, false, 0x0000, 0x00D3}, {1, 255, false, 0x0000, 0x00D1},
+	{2, 255, false, 0x00A3, 0x0000}, {1, 255, false, 0x0000, 0x00D5},
+	{2, 255, false, 0x0082, 0x0000}, {1, 255, false, 0x0000, 0x00D6},
+	{1, 255, false, 0x0000, 0x00DA}, {1, 255, false, 0x0000, 0x00D9},
+	{1, 255, false, 0x0000, 0x00DB}, {2, 255, false, 0x0038, 0x0000},
+	{1, 255, false, 0x0000, 0x0002}, {3, 255, false, 0xFFFF, 0x0001},
+	{2, 255, false, 0xFFFE, 0x0000}, {2, 255, false, 0xFFB1, 0x0000},
+	{1, 255, false, 0x0000, 0xFF9F}, {1, 255, false, 0x0000, 0xFFC8},
+	{1, 255, false, 0x0000, 0xFF7E}, {1, 255, false, 0x0000, 0x2A2B},
+	{1, 255, false, 0x0000, 0xFF5D}, {1, 255, false, 0x0000, 0x2A28},
+	{2, 255, false, 0x2A3F, 0x0000}, {1, 255, false, 0x0000, 0xFF3D},
+	{1, 255, false, 0x0000, 0x0045}, {1, 255, false, 0x0000, 0x0047},
+	{2, 255, false, 0x2A1F, 0x0000}, {2, 255, false, 0x2A1C, 0x0000},
+	{2, 255, false, 0x2A1E, 0x0000}, {2, 255, false, 0xFF2E, 0x0000},
+	{2, 255, false, 0xFF32, 0x0000}, {2, 255, false, 0xFF33, 0x0000},
+	{2, 255, false, 0xFF36, 0x0000}, {2, 255, false, 0xFF35, 0x0000},
+	{2, 255, false, 0xA54F, 0x0000}, {2, 255, false, 0xA54B, 0x0000},
+	{2, 255, false, 0xFF31, 0x0000}, {2, 255, false, 0xA528, 0x0000},
+	{2, 255, false, 0xA544, 0x0000}, {2, 255, false, 0xFF2F, 0x0000},
+	{2, 255, false, 0xFF2D, 0x0000}, {2, 255, false, 0x29F7, 0x0000},
+	{2, 255, false, 0xA541, 0x0000}, {2, 255, false, 0x29FD, 0x0000},
+	{2, 255, false, 0xFF2B, 0x0000}, {2, 255, false, 0xFF2A, 0x0000},
+	{2, 255, false, 0x29E7, 0x0000}, {2, 255, false, 0xFF26, 0x0000},
+	{2, 255, false, 0xA543, 0x0000}, {2, 255, false, 0xA52A, 0x0000},
+	{2, 255, false, 0xFFBB, 0x0000}, {2, 255, false, 0xFF27, 0x0000},
+	{2, 255, false, 0xFFB9, 0x0000}, {2, 255, false, 0xFF25, 0x0000},
+	{2, 255, false, 0xA515, 0x0000}, {2, 255, false, 0xA512, 0x0000},
+	{4, 255, false, 0x0000, 0x0000}, {6, 255, false, 0x0000, 0x0000},
+	{6, 255, false, 0x0054, 0x0000}, {0, 255, false, 0x0000, 0x0000},
+	{1, 255, false, 0x0000, 0x0074}, {1, 255, false, 0x0000, 0x0026},
+	{1, 255, false, 0x0000, 0x0025}, {1, 255, false, 0x0000, 0x0040},
+	{1, 255, false, 0x0000, 0x003F}, {2, 255, false, 0xFFDA, 0x0000},
+	{2, 255, false, 0xFFDB, 0x0000}, {2, 255, false, 0xFFE1, 0x0000},
+	{2, 255, false, 0xFFC0, 0x0000}, {2, 255, false, 0xFFC1, 0x0000},
+	{1, 255, false, 0x0000, 0x0008}, {2, 255, false, 0xFFC2, 0x0000},
+	{2, 255, false, 0xFFC7, 0x0000}, {1, 255, false, 0x0000, 0x0000},
+	{2, 255, false, 0xFFD1, 0x0000}, {2, 255, false, 0xFFCA, 0x0000},
+	{2, 255, false, 0xFFF8, 0x0000}, {2, 255, false, 0xFFAA, 0x0000},
+	{2, 255, false, 0xFFB0, 0x0000}, {2, 255, false, 0x0007, 0x0000},
+	{2, 255, false, 0xFF8C, 0x0000}, {1, 255, false, 0x0000, 0xFFC4},
+	{2, 255, false, 0xFFA0, 0x0000}, {1, 255, false, 0x0000, 0xFFF9},
+	{1, 255, false, 0x0000, 0x0050}, {7, 255, false, 0x0000, 0x0000},
+	{1, 255, false, 0x0000, 0x000F}, {2, 255, false, 0xFFF1, 0x0000},
+	{1, 255, false, 0x0000, 0x0030}, {2, 255, false, 0xFFD0, 0x0000},
+	{8, 255, false, 0x0000, 0x0000}, {1, 255, false, 0x0000, 0x1C60},
+	{2, 255, false, 0x0BC0, 0x0000}, {1, 255, false, 0x0000, 0x97D0},
+	{10, 255, false, 0x0000, 0x0000}, {2, 255, false, 0xE792, 0x0000},
+	{2, 255, false, 0xE793, 0x0000}, {2, 255, false, 0xE79C, 0x0000},
+	{2, 255, false, 0xE79E, 0x0000}, {2, 255, false, 0xE79D, 0x0000},
+	{2, 255, false, 0xE7A4, 0x0000}, {2, 255, false, 0xE7DB, 0x0000},
+	{2, 255, false, 0x89C2, 0x0000}, {1, 255, false, 0x0000, 0xF440},
+	{2, 255, false, 0x8A04, 0x0000}, {2, 255, false, 0x0EE6, 0x0000},
+	{2, 255, false, 0x8A38, 0x0000}, {2, 255, false, 0xFFC5, 0x0000},
+	{1, 255, false, 0x0000, 0xE241}, {2, 255, false, 0x0008, 0x0000},
+	{1, 255, false, 0x0000, 0xFFF8}, {2, 255, false, 0x004A, 0x0000},
+	{2, 255, false, 0x0056, 0x0000}, {2, 255, false, 0x0064, 0x0000},
+	{2, 255, false, 0x0080, 0x0000}, {2, 255, false, 0x0070, 0x0000},
+	{2, 255, false, 0x007E, 0x0000}, {3, 255, false, 0x0000, 0xFFF8},
+	{2, 255, false, 0x0009, 0x0000}, {1, 255, false, 0x0000, 0xFFB6},
+	{3, 255, false, 0x0000, 0xFFF7}, {2, 255, false, 0xE3DB, 0x0000},
+	{1, 255, false, 0x0000, 0xFFAA}, {1, 255, false, 0x0000, 0xFF9C},
+	{1, 255, false, 0x0000, 0xFF90}, {1, 255, false, 0x0000, 0xFF80},
+	{1, 255, false, 0x0000, 0xFF82}, {13, 255, true, 0x0000, 0x0000},
+	{14, 255, true, 0x0000, 0x0000}, {1, 255, false, 0x0000, 0xE2A3},
+	{1, 255, false, 0x0000, 0xDF41}, {1, 255, false, 0x0000, 0xDFBA},
+	{1, 255, false, 0x0000, 0x001C}, {2, 255, false, 0xFFE4, 0x0000},
+	{10, 255, false, 0x0000, 0x0010}, {10, 255, false, 0xFFF0, 0x0000},
+	{28, 255, false, 0x0000, 0x001A}, {28, 255, false, 0xFFE6, 0x0000},
+	{1, 255, false, 0x0000, 0xD609}, {1, 255, false, 0x0000, 0xF11A},
+	{1, 255, false, 0x0000, 0xD619}, {2, 255, false, 0xD5D5, 0x0000},
+	{2, 255, false, 0xD5D8, 0x0000}, {1, 255, false, 0x0000, 0xD5E4},
+	{1, 255, false, 0x0000, 0xD603}, {1, 255, false, 0x0000, 0xD5E1},
+	{1, 255, false, 0x0000, 0xD5E2}, {1, 255, false, 0x0000, 0xD5C1},
+	{2, 255, false, 0xE3A0, 0x0000}, {1, 255, false, 0x0000, 0x75FC},
+	{1, 255, false, 0x0000, 0x5AD8}, {2, 255, false, 0x0030, 0x0000},
+	{1, 255, false, 0x0000, 0x5ABC}, {1, 255, false, 0x0000, 0x5AB1},
+	{1, 255, false, 0x0000, 0x5AB5}, {1, 255, false, 0x0000, 0x5ABF},
+	{1, 255, false, 0x0000, 0x5AEE}, {1, 255, false, 0x0000, 0x5AD6},
+	{1, 255, false, 0x0000, 0x5AEB}, {1, 255, false, 0x0000, 0x03A0},
+	{1, 255, false, 0x0000, 0xFFD0}, {1, 255, false, 0x0000, 0x5ABD},
+	{1, 255, false, 0x0000, 0x75C8}, {2, 255, false, 0xFC60, 0x0000},
+	{2, 255, false, 0x6830, 0x0000}, {19, 255, false, 0x0000, 0x0000},
+	{18, 255, false, 0x0000, 0x0000},
+};
+const unsigned short CharacterData::blocks[15104] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1,
+	2, 3, 3, 3, 4, 3, 3, 3, 5, 6, 3, 7, 3, 8, 3, 3,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 3, 3, 7, 7, 7, 3,
+	3, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33,
+	34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 5, 3, 6, 45, 46,
+	45, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61,
+	62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 5, 7, 6, 7, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	73, 3, 4, 4, 4, 4, 74, 3, 45, 74, 75, 76, 7, 77, 74, 45,
+	74, 7, 78, 78, 45, 79, 3, 3, 45, 78, 75, 80, 78, 78, 78, 3,
+	81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81,
+	81, 81, 81, 81, 81, 81, 81, 7, 81, 81, 81, 81, 81, 81, 81, 82,
+	83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
+	83, 83, 83, 83, 83, 83, 83, 7, 83, 83, 83, 83, 83, 83, 83, 84,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	87, 88, 85, 86, 85, 86, 85, 86, 82, 85, 86, 85, 86, 85, 86, 85,
+	86, 85, 86, 85, 86, 85, 86, 85, 86, 82, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 89, 85, 86, 85, 86, 85, 86, 90,
+	91, 92, 85, 86, 85, 86, 93, 85, 86, 94, 94, 85, 86, 82, 95, 96,
+	97, 85, 86, 94, 98, 99, 100, 101, 85, 86, 102, 82, 100, 103, 104, 105,
+	85, 86, 85, 86, 85, 86, 106, 85, 86, 106, 82, 82, 85, 86, 106, 85,
+	86, 107, 107, 85, 86, 85, 86, 108, 85, 86, 82, 75, 85, 86, 82, 109,
+	75, 75, 75, 75, 110, 111, 112, 110, 111, 112, 110, 111, 112, 85, 86, 85,
+	86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 113, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	82, 110, 111, 112, 85, 86, 114, 115, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	116, 82, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 82, 82, 82, 82, 82, 82, 117, 85, 86, 118, 119, 120,
+	120, 85, 86, 121, 122, 123, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	124, 125, 126, 127, 128, 82, 129, 129, 82, 130, 82, 131, 132, 82, 82, 82,
+	129, 133, 82, 134, 82, 135, 136, 82, 137, 138, 136, 139, 140, 82, 82, 138,
+	82, 141, 142, 82, 82, 143, 82, 82, 82, 82, 82, 82, 82, 144, 82, 82,
+	145, 82, 146, 145, 82, 82, 82, 147, 145, 148, 149, 149, 150, 82, 82, 82,
+	82, 82, 151, 82, 75, 82, 82, 82, 82, 82, 82, 82, 82, 152, 153, 82,
+	82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82,
+	154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+	154, 154, 45, 45, 45, 45, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+	154, 154, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45,
+	154, 154, 154, 154, 154, 45, 45, 45, 45, 45, 45, 45, 154, 45, 154, 45,
+	45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 156, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	85, 86, 85, 86, 154, 45, 85, 86, 157, 157, 154, 104, 104, 104, 3, 158,
+	157, 157, 157, 157, 45, 45, 159, 3, 160, 160, 160, 157, 161, 157, 162, 162,
+	82, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81,
+	81, 81, 157, 81, 81, 81, 81, 81, 81, 81, 81, 81, 163, 164, 164, 164,
+	82, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
+	83, 83, 165, 83, 83, 83, 83, 83, 83, 83, 83, 83, 166, 167, 167, 168,
+	169, 170, 171, 171, 171, 172, 173, 174, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	175, 176, 177, 178, 179, 180, 7, 85, 86, 181, 85, 86, 82, 116, 116, 116,
+	182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182,
+	81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81,
+	81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81, 81,
+	83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
+	83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
+	176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 74, 155, 155, 155, 155, 155, 183, 183, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	184, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 185,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	157, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186,
+	186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186,
+	186, 186, 186, 186, 186, 186, 186, 157, 157, 154, 3, 3, 3, 3, 3, 3,
+	82, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+	187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+	187, 187, 187, 187, 187, 187, 187, 82, 82, 3, 8, 157, 157, 74, 74, 4,
+	157, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 8, 155,
+	3, 155, 155, 3, 155, 155, 3, 155, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 75,
+	75, 75, 75, 3, 3, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	77, 77, 77, 77, 77, 77, 7, 7, 7, 3, 3, 4, 3, 3, 74, 74,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 3, 77, 3, 3, 3,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	154, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 3, 3, 3, 3, 75, 75,
+	155, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 3, 75, 155, 155, 155, 155, 155, 155, 155, 77, 74, 155,
+	155, 155, 155, 155, 155, 154, 154, 155, 155, 74, 155, 155, 155, 155, 75, 75,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 75, 75, 75, 74, 74, 75,
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 157, 77,
+	75, 155, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 157, 157, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 75, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 154, 154, 74, 3, 3, 3, 154, 157, 157, 155, 4, 4,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 155, 155, 155, 155, 154, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 154, 155, 155, 155, 154, 155, 155, 155, 155, 155, 157, 157,
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 155, 155, 155, 157, 157, 3, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 45, 75, 75, 75, 75, 75, 75, 157,
+	77, 77, 157, 157, 157, 157, 157, 157, 155, 155, 155, 155, 155, 155, 155, 155,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 154, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 77, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 188, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 155, 188, 155, 75, 188, 188,
+	188, 155, 155, 155, 155, 155, 155, 155, 155, 188, 188, 188, 188, 155, 188, 188,
+	75, 155, 155, 155, 155, 155, 155, 155, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 155, 155, 3, 3, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	3, 154, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 155, 188, 188, 157, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 75,
+	75, 157, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75,
+	75, 157, 75, 157, 157, 157, 75, 75, 75, 75, 157, 157, 155, 75, 188, 188,
+	188, 155, 155, 155, 155, 157, 157, 188, 188, 157, 157, 188, 188, 155, 75, 157,
+	157, 157, 157, 157, 157, 157, 157, 188, 157, 157, 157, 157, 75, 75, 157, 75,
+	75, 75, 155, 155, 157, 157, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	75, 75, 4, 4, 78, 78, 78, 78, 78, 78, 74, 4, 75, 3, 155, 157,
+	157, 155, 155, 188, 157, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 75,
+	75, 157, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75,
+	75, 157, 75, 75, 157, 75, 75, 157, 75, 75, 157, 157, 155, 157, 188, 188,
+	188, 155, 155, 157, 157, 157, 157, 155, 155, 157, 157, 155, 155, 155, 157, 157,
+	157, 155, 157, 157, 157, 157, 157, 157, 157, 75, 75, 75, 75, 157, 75, 157,
+	157, 157, 157, 157, 157, 157, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	155, 155, 75, 75, 75, 155, 3, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 155, 155, 188, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75,
+	75, 75, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75,
+	75, 157, 75, 75, 157, 75, 75, 75, 75, 75, 157, 157, 155, 75, 188, 188,
+	188, 155, 155, 155, 155, 155, 157, 155, 155, 188, 157, 188, 188, 155, 157, 157,
+	75, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 155, 155, 157, 157, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	3, 4, 157, 157, 157, 157, 157, 157, 157, 75, 155, 155, 155, 155, 155, 155,
+	157, 155, 188, 188, 157, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 75,
+	75, 157, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75,
+	75, 157, 75, 75, 157, 75, 75, 75, 75, 75, 157, 157, 155, 75, 188, 155,
+	188, 155, 155, 155, 155, 157, 157, 188, 188, 157, 157, 188, 188, 155, 157, 157,
+	157, 157, 157, 157, 157, 155, 155, 188, 157, 157, 157, 157, 75, 75, 157, 75,
+	75, 75, 155, 155, 157, 157, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	74, 75, 78, 78, 78, 78, 78, 78, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 155, 75, 157, 75, 75, 75, 75, 75, 75, 157, 157, 157, 75, 75,
+	75, 157, 75, 75, 75, 75, 157, 157, 157, 75, 75, 157, 75, 157, 75, 75,
+	157, 157, 157, 75, 75, 157, 157, 157, 75, 75, 75, 157, 157, 157, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 188, 188,
+	155, 188, 188, 157, 157, 157, 188, 188, 188, 157, 188, 188, 188, 155, 157, 157,
+	75, 157, 157, 157, 157, 157, 157, 188, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	78, 78, 78, 74, 74, 74, 74, 74, 74, 4, 74, 157, 157, 157, 157, 157,
+	155, 188, 188, 188, 155, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75,
+	75, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 155, 75, 155, 155,
+	155, 188, 188, 188, 188, 157, 155, 155, 155, 157, 155, 155, 155, 155, 157, 157,
+	157, 157, 157, 157, 157, 155, 155, 157, 75, 75, 75, 157, 157, 75, 157, 157,
+	75, 75, 155, 155, 157, 157, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	157, 157, 157, 157, 157, 157, 157, 3, 78, 78, 78, 78, 78, 78, 78, 74,
+	75, 155, 188, 188, 3, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75,
+	75, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 157, 157, 155, 75, 188, 155,
+	188, 188, 188, 188, 188, 157, 155, 188, 188, 157, 188, 188, 155, 155, 157, 157,
+	157, 157, 157, 157, 157, 188, 188, 157, 157, 157, 157, 157, 157, 75, 75, 157,
+	75, 75, 155, 155, 157, 157, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	157, 75, 75, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	155, 155, 188, 188, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75,
+	75, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 155, 155, 75, 188, 188,
+	188, 155, 155, 155, 155, 157, 188, 188, 188, 157, 188, 188, 188, 155, 75, 74,
+	157, 157, 157, 157, 75, 75, 75, 188, 78, 78, 78, 78, 78, 78, 78, 75,
+	75, 75, 155, 155, 157, 157, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 74, 75, 75, 75, 75, 75, 75,
+	157, 155, 188, 188, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 155, 157, 157, 157, 157, 188,
+	188, 188, 155, 155, 155, 157, 155, 157, 188, 188, 188, 188, 188, 188, 188, 188,
+	157, 157, 157, 157, 157, 157, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	157, 157, 188, 188, 3, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 155, 75, 75, 155, 155, 155, 155, 155, 155, 155, 157, 157, 157, 157, 4,
+	75, 75, 75, 75, 75, 75, 154, 155, 155, 155, 155, 155, 155, 155, 155, 3,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 3, 3, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 75, 75, 157, 75, 157, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 157, 75, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 155, 75, 75, 155, 155, 155, 155, 155, 155, 155, 155, 155, 75, 157, 157,
+	75, 75, 75, 75, 75, 157, 154, 157, 155, 155, 155, 155, 155, 155, 157, 157,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 157, 157, 75, 75, 75, 75,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 74, 74, 74, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+	3, 3, 3, 74, 3, 74, 74, 74, 155, 155, 74, 74, 74, 74, 74, 74,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 78, 78, 78, 78, 78, 78,
+	78, 78, 78, 78, 74, 155, 74, 155, 74, 155, 5, 6, 5, 6, 188, 188,
+	75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157,
+	157, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 188,
+	155, 155, 155, 155, 155, 3, 155, 155, 75, 75, 75, 75, 75, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 157, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 157, 74, 74,
+	74, 74, 74, 74, 74, 74, 155, 74, 74, 74, 74, 74, 74, 157, 74, 74,
+	3, 3, 3, 3, 3, 74, 74, 74, 74, 3, 3, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 188, 188, 155, 155, 155,
+	155, 188, 155, 155, 155, 155, 155, 155, 188, 155, 155, 188, 188, 155, 155, 75,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 3, 3, 3, 3, 3, 3,
+	75, 75, 75, 75, 75, 75, 188, 188, 155, 155, 75, 75, 75, 75, 155, 155,
+	155, 75, 188, 188, 188, 75, 75, 188, 188, 188, 188, 188, 188, 188, 75, 75,
+	75, 155, 155, 155, 155, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 155, 188, 188, 155, 155, 188, 188, 188, 188, 188, 188, 155, 75, 188,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 188, 188, 188, 155, 74, 74,
+	189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189,
+	189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189,
+	189, 189, 189, 189, 189, 189, 157, 189, 157, 157, 157, 157, 157, 189, 157, 157,
+	190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190,
+	190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190,
+	190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 3, 154, 190, 190, 190,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 157, 75, 157, 75, 75, 75, 75, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 157, 75, 75, 75, 75, 157, 157, 75, 75, 75, 75, 75, 75, 75, 157,
+	75, 157, 75, 75, 75, 75, 157, 157, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 157, 75, 75, 75, 75, 157, 157, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 155, 155, 155,
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 78, 78, 78, 78, 78, 78, 78,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 157, 157, 157, 157, 157, 157,
+	191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191,
+	191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191,
+	191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191,
+	191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191,
+	191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191,
+	168, 168, 168, 168, 168, 168, 157, 157, 174, 174, 174, 174, 174, 174, 157, 157,
+	8, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 74, 3, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	2, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 5, 6, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 3, 3, 3, 192, 192,
+	192, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 155, 155, 155, 188, 157, 157, 157, 157, 157, 157, 157, 157, 157, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 155, 155, 188, 3, 3, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 155, 155, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 75, 75,
+	75, 157, 155, 155, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 155, 155, 188, 155, 155, 155, 155, 155, 155, 155, 188, 188,
+	188, 188, 188, 188, 188, 188, 155, 188, 188, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 3, 3, 3, 154, 3, 3, 3, 4, 75, 155, 157, 157,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 157, 157, 157, 157, 157, 157,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 157, 157, 157, 157, 157, 157,
+	3, 3, 3, 3, 3, 3, 8, 3, 3, 3, 3, 155, 155, 155, 77, 155,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 154, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 155, 155, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 155, 75, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157,
+	155, 155, 155, 188, 188, 188, 188, 155, 155, 188, 188, 188, 157, 157, 157, 157,
+	188, 188, 155, 188, 188, 188, 188, 188, 188, 155, 155, 155, 157, 157, 157, 157,
+	74, 157, 157, 157, 3, 3, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157,
+	75, 75, 75, 75, 75, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 157, 157,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 78, 157, 157, 157, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 155, 155, 188, 188, 155, 157, 157, 3, 3,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 188, 155, 188, 155, 155, 155, 155, 155, 155, 155, 157,
+	155, 188, 155, 188, 188, 155, 155, 155, 155, 155, 155, 155, 155, 188, 188, 188,
+	188, 188, 188, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 157, 157, 155,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 157, 157, 157, 157, 157, 157,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 157, 157, 157, 157, 157, 157,
+	3, 3, 3, 3, 3, 3, 3, 154, 3, 3, 3, 3, 3, 3, 157, 157,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 183, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	155, 155, 155, 155, 188, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 155, 188, 155, 155, 155, 155, 155, 188, 155, 188, 188, 188,
+	188, 188, 155, 188, 188, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 3, 3, 3, 3, 3, 3,
+	3, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 74, 74, 74, 74, 74, 74, 74, 74, 74, 3, 3, 157,
+	155, 155, 188, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 188, 155, 155, 155, 155, 188, 188, 155, 155, 188, 155, 155, 155, 75, 75,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 155, 188, 155, 155, 188, 188, 188, 155, 188, 155,
+	155, 155, 188, 188, 157, 157, 157, 157, 157, 157, 157, 157, 3, 3, 3, 3,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 188, 188, 188, 188, 188, 188, 188, 188, 155, 155, 155, 155,
+	155, 155, 155, 155, 188, 188, 155, 155, 157, 157, 157, 3, 3, 3, 3, 3,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 157, 157, 157, 75, 75, 75,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 154, 154, 154, 154, 154, 154, 3, 3,
+	193, 194, 195, 196, 196, 197, 198, 199, 200, 157, 157, 157, 157, 157, 157, 157,
+	201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201,
+	201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201,
+	201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 157, 157, 201, 201, 201,
+	3, 3, 3, 3, 3, 3, 3, 3, 157, 157, 157, 157, 157, 157, 157, 157,
+	155, 155, 155, 3, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 188, 155, 155, 155, 155, 155, 155, 155, 75, 75, 75, 75, 155, 75, 75,
+	75, 75, 75, 75, 155, 75, 75, 188, 155, 155, 75, 157, 157, 157, 157, 157,
+	82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82,
+	82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82,
+	82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 154, 154, 154, 154,
+	154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+	154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+	154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+	154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 82, 82, 82, 82, 82,
+	82, 82, 82, 82, 82, 82, 82, 82, 154, 202, 82, 82, 82, 203, 82, 82,
+	82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 204, 82,
+	82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 154, 154, 154, 154, 154,
+	154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+	154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 82, 82, 82, 82, 82, 205, 82, 82, 206, 82,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	207, 207, 207, 207, 207, 207, 207, 207, 208, 208, 208, 208, 208, 208, 208, 208,
+	207, 207, 207, 207, 207, 207, 157, 157, 208, 208, 208, 208, 208, 208, 157, 157,
+	207, 207, 207, 207, 207, 207, 207, 207, 208, 208, 208, 208, 208, 208, 208, 208,
+	207, 207, 207, 207, 207, 207, 207, 207, 208, 208, 208, 208, 208, 208, 208, 208,
+	207, 207, 207, 207, 207, 207, 157, 157, 208, 208, 208, 208, 208, 208, 157, 157,
+	82, 207, 82, 207, 82, 207, 82, 207, 157, 208, 157, 208, 157, 208, 157, 208,
+	207, 207, 207, 207, 207, 207, 207, 207, 208, 208, 208, 208, 208, 208, 208, 208,
+	209, 209, 210, 210, 210, 210, 211, 211, 212, 212, 213, 213, 214, 214, 157, 157,
+	207, 207, 207, 207, 207, 207, 207, 207, 215, 215, 215, 215, 215, 215, 215, 215,
+	207, 207, 207, 207, 207, 207, 207, 207, 215, 215, 215, 215, 215, 215, 215, 215,
+	207, 207, 207, 207, 207, 207, 207, 207, 215, 215, 215, 215, 215, 215, 215, 215,
+	207, 207, 82, 216, 82, 157, 82, 82, 208, 208, 217, 217, 218, 45, 219, 45,
+	45, 45, 82, 216, 82, 157, 82, 82, 220, 220, 220, 220, 218, 45, 45, 45,
+	207, 207, 82, 82, 157, 157, 82, 82, 208, 208, 221, 221, 157, 45, 45, 45,
+	207, 207, 82, 82, 82, 177, 82, 82, 208, 208, 222, 222, 181, 45, 45, 45,
+	157, 157, 82, 216, 82, 157, 82, 82, 223, 223, 224, 224, 218, 45, 45, 157,
+	2, 2, 2, 2, 2, 2, 2, 73, 2, 2, 2, 77, 77, 77, 77, 77,
+	8, 8, 8, 8, 8, 8, 3, 3, 76, 80, 5, 76, 76, 80, 5, 76,
+	3, 3, 3, 3, 3, 3, 3, 3, 225, 226, 77, 77, 77, 77, 77, 73,
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 76, 80, 3, 3, 3, 3, 46,
+	46, 3, 3, 3, 7, 5, 6, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+	3, 3, 7, 3, 46, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 2,
+	77, 77, 77, 77, 77, 157, 77, 77, 77, 77, 77, 77, 77, 77, 77, 77,
+	78, 154, 157, 157, 78, 78, 78, 78, 78, 78, 7, 7, 7, 5, 6, 154,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 7, 7, 7, 5, 6, 157,
+	154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 157, 157, 157,
+	4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+	4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+	4, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 183, 183, 183,
+	183, 155, 183, 183, 183, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	74, 74, 171, 74, 74, 74, 74, 171, 74, 74, 82, 171, 171, 171, 82, 82,
+	171, 171, 171, 82, 74, 171, 74, 74, 7, 171, 171, 171, 171, 171, 74, 74,
+	74, 74, 74, 74, 171, 74, 227, 74, 171, 74, 228, 229, 171, 171, 74, 82,
+	171, 171, 230, 171, 82, 75, 75, 75, 75, 82, 74, 74, 82, 82, 171, 171,
+	7, 7, 7, 7, 7, 171, 82, 82, 82, 82, 74, 7, 74, 74, 231, 74,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78,
+	232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232,
+	233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+	192, 192, 192, 85, 86, 192, 192, 192, 192, 78, 74, 74, 157, 157, 157, 157,
+	7, 7, 7, 7, 7, 74, 74, 74, 74, 74, 7, 7, 74, 74, 74, 74,
+	7, 74, 74, 7, 74, 74, 7, 74, 74, 74, 74, 74, 74, 74, 7, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 7, 7,
+	74, 74, 7, 74, 7, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	74, 74, 74, 74, 74, 74, 74, 74, 5, 6, 5, 6, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	7, 7, 74, 74, 74, 74, 74, 74, 74, 5, 6, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 7, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 7, 7, 7, 7,
+	7, 7, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234,
+	234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234,
+	235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235,
+	235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 78, 78, 78, 78, 78, 78,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 7, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 7, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 7, 7, 7, 7, 7, 7, 7, 7,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 7,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 5, 6, 5, 6, 5, 6, 5, 6,
+	5, 6, 5, 6, 5, 6, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78,
+	78, 78, 78, 78, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	7, 7, 7, 7, 7, 5, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 5, 6, 5, 6, 5, 6, 5, 6, 5, 6,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 5, 6, 5, 6, 5, 6, 5, 6, 5, 6, 5, 6, 5,
+	6, 5, 6, 5, 6, 5, 6, 5, 6, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 5, 6, 5, 6, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 5, 6, 7, 7,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+	7, 7, 7, 7, 7, 74, 74, 7, 7, 7, 7, 7, 7, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 157, 157, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 157, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186,
+	186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186,
+	186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186,
+	187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+	187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+	187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+	85, 86, 236, 237, 238, 239, 240, 85, 86, 85, 86, 85, 86, 241, 242, 243,
+	244, 82, 85, 86, 82, 85, 86, 82, 82, 82, 82, 82, 154, 154, 245, 245,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 82, 74, 74, 74, 74, 74, 74, 85, 86, 85, 86, 155,
+	155, 155, 85, 86, 157, 157, 157, 157, 157, 3, 3, 3, 3, 78, 3, 3,
+	246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+	246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+	246, 246, 246, 246, 246, 246, 157, 246, 157, 157, 157, 157, 157, 246, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 157, 157, 157, 154,
+	3, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 155,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75, 75, 157,
+	75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75, 75, 157,
+	75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75, 75, 157,
+	75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75, 75, 157,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	3, 3, 76, 80, 76, 80, 3, 3, 3, 76, 80, 3, 76, 80, 3, 3,
+	3, 3, 3, 3, 3, 3, 3, 8, 3, 3, 8, 3, 76, 80, 3, 3,
+	76, 80, 5, 6, 5, 6, 5, 6, 5, 6, 3, 3, 3, 3, 3, 154,
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 8, 8, 3, 3, 3, 3,
+	8, 3, 5, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+	74, 74, 3, 3, 3, 5, 6, 5, 6, 5, 6, 5, 6, 8, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 157, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 157, 157, 157, 157,
+	2, 3, 3, 3, 74, 154, 75, 192, 5, 6, 5, 6, 5, 6, 5, 6,
+	5, 6, 74, 74, 5, 6, 5, 6, 5, 6, 5, 6, 8, 5, 6, 6,
+	74, 192, 192, 192, 192, 192, 192, 192, 192, 192, 155, 155, 155, 155, 188, 188,
+	8, 154, 154, 154, 154, 154, 74, 74, 192, 192, 192, 154, 75, 3, 74, 74,
+	157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 157, 157, 155, 155, 45, 45, 154, 154, 75,
+	8, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 3, 154, 154, 154, 75,
+	157, 157, 157, 157, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157,
+	74, 74, 78, 78, 78, 78, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 157,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 78, 78, 78, 78, 78, 78, 78, 78,
+	74, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78, 78,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 154, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	74, 74, 74, 74, 74, 74, 74, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 154, 154, 154, 154, 154, 154, 3, 3,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 154, 3, 3, 3,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 75, 75, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 75, 155,
+	183, 183, 183, 3, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 3, 154,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 154, 154, 155, 155,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+	155, 155, 3, 3, 3, 3, 3, 3, 157, 157, 157, 157, 157, 157, 157, 157,
+	45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45,
+	45, 45, 45, 45, 45, 45, 45, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+	45, 45, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	82, 82, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	154, 82, 82, 82, 82, 82, 82, 82, 82, 85, 86, 85, 86, 247, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 154, 45, 45, 85, 86, 248, 82, 75,
+	85, 86, 85, 86, 249, 82, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 250, 251, 252, 253, 250, 82,
+	254, 255, 256, 257, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86, 85, 86,
+	85, 86, 85, 86, 258, 259, 260, 85, 86, 85, 86, 157, 157, 157, 157, 157,
+	85, 86, 157, 82, 157, 82, 85, 86, 85, 86, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 154, 154, 154, 85, 86, 75, 154, 154, 82, 75, 75, 75, 75, 75,
+	75, 75, 155, 75, 75, 75, 155, 75, 75, 75, 75, 155, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 188, 188, 155, 155, 188, 74, 74, 74, 74, 155, 157, 157, 157,
+	78, 78, 78, 78, 78, 78, 74, 74, 4, 74, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 3, 3, 3, 3, 157, 157, 157, 157, 157, 157, 157, 157,
+	188, 188, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188,
+	188, 188, 188, 188, 155, 155, 157, 157, 157, 157, 157, 157, 157, 157, 3, 3,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 157, 157, 157, 157, 157, 157,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 75, 75, 75, 75, 75, 75, 3, 3, 3, 75, 3, 75, 75, 155,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 155, 155, 155, 155, 155, 155, 155, 155, 3, 3,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	155, 155, 188, 188, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 3,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157,
+	155, 155, 155, 188, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 155, 188, 188, 155, 155, 155, 155, 188, 188, 155, 155, 188, 188,
+	188, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 157, 154,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 157, 157, 157, 157, 3, 3,
+	75, 75, 75, 75, 75, 155, 154, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 75, 75, 75, 75, 75, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 155, 155, 155, 155, 155, 155, 188,
+	188, 155, 155, 188, 188, 155, 155, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 155, 75, 75, 75, 75, 75, 75, 75, 75, 155, 188, 157, 157,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 157, 157, 3, 3, 3, 3,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	154, 75, 75, 75, 75, 75, 75, 74, 74, 74, 75, 188, 155, 188, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	155, 75, 155, 155, 155, 75, 75, 155, 155, 75, 75, 75, 75, 75, 155, 155,
+	75, 155, 75, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 75, 75, 154, 3, 3,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 188, 155, 155, 188, 188,
+	3, 3, 75, 154, 154, 188, 155, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 75, 75, 75, 75, 75, 75, 157, 157, 75, 75, 75, 75, 75, 75, 157,
+	157, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75, 75, 157,
+	82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82,
+	82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82, 82,
+	82, 82, 82, 261, 82, 82, 82, 82, 82, 82, 82, 45, 154, 154, 154, 154,
+	82, 82, 82, 82, 82, 82, 82, 82, 82, 154, 45, 45, 157, 157, 157, 157,
+	262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262,
+	262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262,
+	262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262,
+	262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262,
+	262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262, 262,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 188, 188, 155, 188, 188, 155, 188, 188, 3, 188, 155, 157, 157,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157,
+	263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263,
+	263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263,
+	263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263,
+	263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263,
+	263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263,
+	263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263,
+	263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263,
+	263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263, 263,
+	264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264,
+	264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264,
+	264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264,
+	264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264,
+	264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264,
+	264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264,
+	264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264,
+	264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264, 264,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	82, 82, 82, 82, 82, 82, 82, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 82, 82, 82, 82, 82, 157, 157, 157, 157, 157, 75, 155, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 7, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 157, 75, 157,
+	75, 75, 157, 75, 75, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45,
+	45, 45, 45, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 6, 5,
+	74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74, 74,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	157, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 157, 157, 157, 157, 157, 74,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 4, 74, 74, 74,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	3, 3, 3, 3, 3, 3, 3, 5, 6, 3, 157, 157, 157, 157, 157, 157,
+	155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155,
+	3, 8, 8, 46, 46, 5, 6, 5, 6, 5, 6, 5, 6, 5, 6, 5,
+	6, 5, 6, 5, 6, 3, 3, 5, 6, 3, 3, 3, 3, 46, 46, 46,
+	3, 3, 3, 157, 3, 3, 3, 3, 8, 5, 6, 5, 6, 5, 6, 3,
+	3, 3, 7, 8, 7, 7, 7, 157, 3, 4, 3, 3, 157, 157, 157, 157,
+	75, 75, 75, 75, 75, 157, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157, 157, 77,
+	157, 3, 3, 3, 4, 3, 3, 3, 5, 6, 3, 7, 3, 8, 3, 3,
+	9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 3, 3, 7, 7, 7, 3,
+	3, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33,
+	34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 5, 3, 6, 45, 46,
+	45, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61,
+	62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 5, 7, 6, 7, 5,
+	6, 3, 5, 6, 3, 3, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	154, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 154, 154,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75,
+	75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 75, 157,
+	157, 157, 75, 75, 75, 75, 75, 75, 157, 157, 75, 75, 75, 75, 75, 75,
+	157, 157, 75, 75, 75, 75, 75, 75, 157, 157, 75, 75, 75, 157, 157, 157,
+	4, 4, 7, 45, 74, 4, 4, 157, 74, 7, 7, 7, 7, 74, 74, 157,
+	157, 157, 157, 157, 157, 157, 157, 157, 157, 77, 77, 77, 74, 74, 157, 157,
+};
+const unsigned char CharacterData::index[512] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+	32, 33, 34, 34, 35, 36, 37, 38, 39, 34, 34, 34, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59,
+	60, 61, 62, 63, 64, 64, 65, 66, 67, 68, 69, 70, 71, 69, 72, 73, 69, 69, 64, 74, 64, 64, 75, 76, 77, 78, 79, 80, 81, 82, 69, 83,
+	84, 85, 86, 87, 88, 89, 69, 69, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34,
+	34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 90, 34, 34, 34, 34,
+	34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34,
+	34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34,
+	34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34,
+	34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34,
+	34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34,
+	91, 34, 34, 34, 34, 34, 34, 34, 34, 92, 34, 34, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 34, 34, 34, 34, 34, 34, 34, 34,
+	34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34,
+	34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34,
+	34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 105, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106,
+	107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+	107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 34, 34, 108, 109, 110, 111, 34, 34, 112, 113, 114, 115, 116, 117,
+};
+
+}
@@ -0,0 +1,570 @@
+#include <lang/Fiber.hpp>
+#include <lang/Runtime.hpp>
+#include <lang/System.hpp>
+#include <util/concurrent/Futex.hpp>
+#include <util/concurrent/ScheduledExecutorService.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <cxxabi.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+#if !defined(__x86_64__) && !defined(FIBER_UCONTEXT)
+#define FIBER_UCONTEXT
+#endif
+#ifdef FIBER_UCONTEXT
+#include <ucontext.h>
+#endif
+
+#ifndef MADV_GUARD_INSTALL
+#define MADV_GUARD_INSTALL 102
+#endif
+
+namespace {
+using lang::Fiber;
+using util::concurrent::Futex;
+
+#ifndef FIBER_UCONTEXT
+/*
+ * Saves the callee saved registers, the SSE and x87 control words on the stack,
+ * its pointer to *from, and resumes the stack at to: a switch is a call which
+ * returns on the other stack. A new stack returns into lang_fiber_start, which calls r13.
+ */
+extern "C" void lang_fiber_switch(void **from, void *to);
+extern "C" void lang_fiber_start();
+asm(R"(
+	.text
+	.p2align 4
+	.globl lang_fiber_switch
+	.hidden lang_fiber_switch
+	.type lang_fiber_switch, @function
+lang_fiber_switch:
+	pushq %rbp
+	pushq %rbx
+	pushq %r12
+	pushq %r13
+	pushq %r14
+	pushq %r15
+	subq $8, %rsp
+	stmxcsr (%rsp)
+	fnstcw 4(%rsp)
+	movq %rsp, (%rdi)
+	movq %rsi, %rsp
+	ldmxcsr (%rsp)
+	fldcw 4(%rsp)
+	addq $8, %rsp
+	popq %r15
+	popq %r14
+	popq %r13
+	popq %r12
+	popq %rbx
+	popq %rbp
+	ret
+	.size lang_fiber_switch, .-lang_fiber_switch
+
+	.p2align 4
+	.globl lang_fiber_start
+	.hidden lang_fiber_start
+	.type lang_fiber_start, @function
+lang_fiber_start:
+	.cfi_startproc
+	.cfi_undefined rip
+	callq *%r13
+	ud2
+	.cfi_endproc
+	.size lang_fiber_start, .-lang_fiber_start
+)");
+
+// the stack pointer of a new context running entry on [lo, hi)
+void *makeContext(char *lo, char *hi, void (*entry)()) {
+	(void)lo;
+	void **sp = (void **)((uintptr_t)hi & ~(uintptr_t)15) - 10;
+	sp[0] = (void *)0x0000037f00001f80;  // default mxcsr, x87 control word
+	for (int i = 1; i < 7; ++i) sp[i] = null;
+	sp[3] = (void *)entry;               // r13
+	sp[7] = (void *)&lang_fiber_start;   // the return address, the call in it sees an aligned stack
+	sp[8] = sp[9] = null;
+	return sp;
+}
+inline void switchContext(void **from, void *to) {
+	lang_fiber_switch(from, to);
+}
+#else
+// the context is a ucontext_t at the top of the stack, *from points to the caller's
+void *makeContext(char *lo, char *hi, void (*entry)()) {
+	ucontext_t *uc = (ucontext_t *)((uintptr_t)(hi - sizeof(ucontext_t)) & ~(uintptr_t)15);
+	if (::getcontext(uc) != 0) throw lang::OutOfMemoryError("getcontext failed");
+	uc->uc_stack.ss_sp = lo;
+	uc->uc_stack.ss_size = (size_t)((char *)uc - lo);
+	uc->uc_link = null;
+	::makecontext(uc, entry, 0);
+	return uc;
+}
+inline void switchContext(void **from, void *to) {
+	::swapcontext((ucontext_t *)*from, (ucontext_t *)to);
+}
+#endif
+
+// the per thread exception stack of the C++ runtime (Itanium ABI)
+struct EhGlobals {
+	void *caughtExceptions;
+	unsigned int uncaughtExceptions;
+};
+inline EhGlobals *ehGlobals() { return (EhGlobals *)abi::__cxa_get_globals(); }
+
+/*
+ * The stacks, a guard page below each. Those of the default size are mapped
+ * SLAB at once and kept when freed, with their pages (giving them back costs more
+ * than the fiber): the memory follows the peak number of fibers.
+ */
+class Stacks {
+private:
+	static const size_t SLAB = 64;
+	const size_t page = (size_t)::sysconf(_SC_PAGESIZE);
+	std::mutex lock;
+	std::vector<char *> spare;
+	std::atomic<boolean> guardMarkers{true}; // MADV_GUARD_INSTALL works, stacks are guarded outside the lock
+
+	static char *map(size_t size) {
+		void *p = ::mmap(null, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (p == MAP_FAILED) throw OutOfMemoryError("mmap of a fiber stack failed");
+		return (char *)p;
+	}
+	void guard(char *p) {
+		if (guardMarkers.load(std::memory_order_relaxed) && ::madvise(p, page, MADV_GUARD_INSTALL) == 0) return;
+		guardMarkers.store(false, std::memory_order_relaxed);
+		if (::mprotect(p, page, PROT_NONE) != 0) throw OutOfMemoryError("guard page of a fiber stack failed");
+	}
+public:
+	size_t span(size_t stackSize) const { return stackSize + page; }
+	size_t guardSize() const { return page; }
+	size_t roundUp(size_t size) const { return (size + page - 1) & ~(page - 1); }
+
+	char *allocate(size_t stackSize) {
+		if (stackSize != (size_t)Fiber::DEFAULT_STACK_SIZE) {
+			char *p = map(span(stackSize));
+			try { guard(p); } catch (...) { ::munmap(p, span(stackSize)); throw; }
+			return p;
+		}
+		std::lock_guard<std::mutex> g(lock);
+		if (spare.empty()) {
+			spare.reserve(SLAB);
+			char *slab = map(SLAB * span(stackSize));
+			try {
+				for (size_t i = 0; i < SLAB; ++i) guard(slab + i * span(stackSize));
+			} catch (...) { ::munmap(slab, SLAB * span(stackSize)); throw; }
+			for (size_t i = SLAB; i-- > 0; ) spare.push_back(slab + i * span(stackSize));
+		}
+		char *p = spare.back();
+		spare.pop_back();
+		return p;
+	}
+	void release(char *p, size_t stackSize) {
+		if (stackSize != (size_t)Fiber::DEFAULT_STACK_SIZE) {
+			::munmap(p, span(stackSize));
+			return ;
+		}
+		std::lock_guard<std::mutex> g(lock);
+		spare.push_back(p);
+	}
+};
+Stacks& stacks() {
+	static Stacks s;
+	return s;
+}
+
+// timer of the parked fibers with a timeout, never destroyed
+util::concurrent::ScheduledExecutorService& parkTimer() {
+	static util::concurrent::ScheduledExecutorService *timer = new util::concurrent::ScheduledExecutorService(1);
+	return *timer;
+}
+// unparks the fiber unless it was disarmed (the fiber returned and may be gone)
+struct Alarm {
+	std::mutex lock;
+	Fiber *fiber;
+	Alarm(Fiber *f) : fiber(f) {}
+	void ring() {
+		std::lock_guard<std::mutex> g(lock);
+		if (fiber != null) Fiber::unpark(*fiber);
+	}
+	void disarm() {
+		std::lock_guard<std::mutex> g(lock);
+		fiber = null;
+	}
+};
+
+#ifdef __linux__
+/*
+ * Readiness of the descriptors fibers read: one shot epoll registrations, the
+ * "fiber-poller" thread unparks all the fibers waiting on a descriptor that got
+ * ready. The registrations are looked up under the lock, a fiber gone is never unparked.
+ */
+class Poller {
+private:
+	int epfd;
+	std::mutex lock;
+	std::unordered_map<int, std::vector<Fiber*>> waiting;
+	lang::Thread *thread;
+
+	void loop() {
+		struct epoll_event events[64];
+		for (;;) {
+			int n = ::epoll_wait(epfd, events, 64, -1);
+			if (n < 0 && errno != EINTR) break;
+			std::lock_guard<std::mutex> g(lock);
+			for (int i = 0; i < n; ++i) {
+				auto it = waiting.find(events[i].data.fd);
+				if (it == waiting.end()) continue;
+				for (Fiber *f : it->second) Fiber::unpark(*f);
+				waiting.erase(it);
+			}
+		}
+	}
+public:
+	Poller() {
+		epfd = ::epoll_create1(EPOLL_CLOEXEC);
+		if (epfd < 0) throw OutOfMemoryError("epoll_create failed");
+		thread = new lang::Thread([this] { loop(); });
+		thread->setName("fiber-poller");
+		thread->start();
+	}
+	// false when fd can not be polled
+	boolean arm(int fd, Fiber *f) {
+		struct epoll_event e;
+		e.events = EPOLLIN | EPOLLONESHOT;
+		e.data.u64 = 0;
+		e.data.fd = fd;
+		std::lock_guard<std::mutex> g(lock);
+		if (::epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &e) != 0 && (errno != ENOENT || ::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &e) != 0))
+			return false;
+		waiting[fd].push_back(f);
+		return true;
+	}
+	void disarm(int fd, Fiber *f) {
+		std::lock_guard<std::mutex> g(lock);
+		auto it = waiting.find(fd);
+		if (it == waiting.end()) return ;
+		std::vector<Fiber*>& fibers = it->second;
+		fibers.erase(std::remove(fibers.begin(), fibers.end(), f), fibers.end());
+		if (fibers.empty()) waiting.erase(it);
+	}
+};
+Poller& poller() {
+	static Poller *p = new Poller();
+	return *p;
+}
+#endif
+
+std::atomic<long> lastFiberId{0};
+std::atomic<int> carrierNumber{0};
+}
+
+namespace lang {
+
+void Fiber::WaitQueue::unlink(Node *n) {
+	if (n->prev == null) head = n->next; else n->prev->next = n->next;
+	if (n->next == null) tail = n->prev; else n->next->prev = n->prev;
+	n->queued = false;
+	size.store(size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+}
+boolean Fiber::WaitQueue::wait(std::atomic<int>& word, int expected, jlong nanos) {
+	Fiber *f = running();
+	if (f == null) throw IllegalStateException("not on a fiber");
+	jlong deadline = nanos < 0 ? 0 : System::nanoTime() + nanos;
+	Node n = {f, null, null, true};
+	{
+		std::lock_guard<std::mutex> g(lock);
+		n.prev = tail;
+		if (tail == null) head = &n; else tail->next = &n;
+		tail = &n;
+		size.store(size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+	// pairs with the fence of wake: either the waker sees this node or this the new word
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (word.load(std::memory_order_relaxed) == expected) {
+		if (nanos < 0) park();
+		else parkNanos(nanos);
+	}
+	std::lock_guard<std::mutex> g(lock);
+	if (!n.queued) return true;
+	unlink(&n);
+	return nanos < 0 || System::nanoTime() < deadline;
+}
+void Fiber::WaitQueue::wake(int count) {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (size.load(std::memory_order_relaxed) == 0) return ;
+	std::lock_guard<std::mutex> g(lock);
+	// unparked under the lock, which the fiber takes before it returns
+	for (; count > 0 && head != null; --count) {
+		Node *n = head;
+		unlink(n);
+		unpark(*n->fiber);
+	}
+}
+
+void Fiber::init(FiberScheduler *s, long stackSize) {
+	if (stackSize < 0) throw IllegalArgumentException("negative stack size");
+	scheduler = s;
+	this->stackSize = stackSize == 0 ? (size_t)DEFAULT_STACK_SIZE : stacks().roundUp((size_t)stackSize);
+	fid = lastFiberId.fetch_add(1) + 1;
+	name = "Fiber-" + String::valueOf(fid);
+}
+Fiber::~Fiber() {
+	if (getState() == NEW) return ;
+	join();
+	// terminated, the carrier may still be waking the joiners
+	while (!released.load(std::memory_order_acquire)) {
+		if (running() != null) yield();
+		else std::this_thread::yield();
+	}
+}
+void Fiber::start() {TRACE;
+	if (getState() != NEW || stack != null) throw IllegalThreadStateException();
+	if (scheduler == null) scheduler = &FiberScheduler::getDefault();
+	{
+		std::lock_guard<std::mutex> g(scheduler->lock);
+		if (scheduler->shut) throw RejectedExecutionException();
+		scheduler->alive.fetch_add(1, std::memory_order_relaxed);
+	}
+	try {
+		stack = stacks().allocate(stackSize);
+	} catch (...) {
+		scheduler->alive.fetch_sub(1, std::memory_order_relaxed);
+		throw;
+	}
+	char *lo = (char *)stack + stacks().guardSize();
+	context.sp = makeContext(lo, lo + stackSize, &Fiber::main);
+	state.store(RUNNABLE, std::memory_order_release);
+	scheduler->enqueue(this);
+}
+void Fiber::join() {TRACE;
+	for (;;) {
+		int s = state.load(std::memory_order_acquire);
+		if (s == NEW || s == TERMINATED) return ;
+		if (running() != null) joiners.wait(state, s);
+		else Futex::wait(state, s);
+	}
+}
+
+void Fiber::main() {
+	Fiber *f = running();
+	try {
+		f->run();
+	} catch(const Throwable& e) {
+		e.printStackTrace();
+	} catch (const std::exception& e) {
+		Throwable t(Object::getClass(typeid(e)).getName() + ":" + e.what());
+		t.fillInStackTrace().printStackTrace();
+	} catch (...) {
+		Throwable().fillInStackTrace().printStackTrace();
+	}
+	f->switchOut(EXIT);
+	std::abort(); // never resumed
+}
+void Fiber::switchOut(Action a) {
+	action = a;
+	switchContext(&context.sp, carrier->sp);
+}
+
+void Fiber::yield() {
+	Fiber *f = running();
+	if (f == null) std::this_thread::yield();
+	else f->switchOut(YIELD);
+}
+void Fiber::sleep(long millis) {TRACE;
+	if (millis < 0) throw IllegalArgumentException("timeout value is negative");
+	if (running() == null) {
+		Thread::sleep(millis);
+		return ;
+	}
+	jlong deadline = System::nanoTime() + (jlong)millis * 1000000;
+	for (jlong left = (jlong)millis * 1000000; left > 0; left = deadline - System::nanoTime()) parkNanos(left);
+}
+void Fiber::park() {
+	Fiber *f = running();
+	if (f == null) throw IllegalStateException("not on a fiber");
+	int p = PERMIT;
+	if (f->permit.compare_exchange_strong(p, 0, std::memory_order_acquire, std::memory_order_relaxed)) return ;
+	f->switchOut(PARK);
+}
+void Fiber::parkNanos(jlong nanos) {
+	Fiber *f = running();
+	if (f == null) throw IllegalStateException("not on a fiber");
+	int p = PERMIT;
+	if (nanos <= 0 || f->permit.compare_exchange_strong(p, 0, std::memory_order_acquire, std::memory_order_relaxed)) return ;
+	// the alarm outlives this call when the timer already handed it to its pool
+	std::shared_ptr<Alarm> alarm = std::make_shared<Alarm>(f);
+	util::concurrent::ScheduledFuture t = parkTimer().schedule([alarm] { alarm->ring(); }, nanos, util::concurrent::TimeUnit::NANOSECONDS);
+	f->switchOut(PARK);
+	if (!t.cancel()) alarm->disarm();
+}
+void Fiber::unpark(Fiber& f) {
+	int p = f.permit.load(std::memory_order_relaxed);
+	for (;;) {
+		if (p == PERMIT) return ;
+		if (p == PARKED) {
+			if (!f.permit.compare_exchange_weak(p, 0, std::memory_order_acquire, std::memory_order_relaxed)) continue;
+			f.state.store(RUNNABLE, std::memory_order_relaxed);
+			f.scheduler->enqueue(&f);
+			return ;
+		}
+		if (f.permit.compare_exchange_weak(p, PERMIT, std::memory_order_release, std::memory_order_relaxed)) return ;
+	}
+}
+void Fiber::awaitReadable(int fd) {
+	Fiber *f = running();
+	#ifdef __linux__
+	if (f != null) {
+		if (!poller().arm(fd, f)) return ;
+		park();
+		poller().disarm(fd, f);
+		return ;
+	}
+	#endif
+	struct pollfd p = {fd, POLLIN, 0};
+	while (::poll(&p, 1, -1) < 0 && errno == EINTR) ;
+}
+
+FiberScheduler::FiberScheduler(int n) {
+	if (n <= 0) n = Runtime::getRuntime().availableProcessors();
+	for (int i = 0; i < n; ++i) {
+		Thread *t = new Thread([this] { carrierLoop(); });
+		t->setName("fiber-" + String::valueOf(carrierNumber.fetch_add(1) + 1));
+		carriers.push_back(t);
+		t->start();
+	}
+}
+FiberScheduler::~FiberScheduler() {
+	for (int n; (n = alive.load(std::memory_order_acquire)) != 0; ) Futex::wait(alive, n);
+	{
+		std::lock_guard<std::mutex> g(lock);
+		shut = true;
+		wakeups.fetch_add(1, std::memory_order_relaxed);
+	}
+	Futex::wakeAll(wakeups);
+	for (Thread *t : carriers) {
+		t->join();
+		delete t;
+	}
+}
+FiberScheduler& FiberScheduler::getDefault() {
+	static FiberScheduler *s = new FiberScheduler();
+	return *s;
+}
+
+void FiberScheduler::enqueue(Fiber *f) {
+	boolean wake;
+	{
+		std::lock_guard<std::mutex> g(lock);
+		f->next = null;
+		if (tail == null) head = f; else tail->next = f;
+		tail = f;
+		wake = idle > 0;
+		if (wake) wakeups.fetch_add(1, std::memory_order_relaxed);
+	}
+	if (wake) Futex::wake(wakeups, 1);
+}
+Fiber *FiberScheduler::take() {
+	std::unique_lock<std::mutex> g(lock);
+	while (head == null) {
+		if (shut) return null;
+		int seq = wakeups.load(std::memory_order_relaxed);
+		++idle;
+		g.unlock();
+		Futex::wait(wakeups, seq);
+		g.lock();
+		--idle;
+	}
+	Fiber *f = head;
+	head = f->next;
+	if (head == null) tail = null;
+	return f;
+}
+void FiberScheduler::carrierLoop() {TRACE;
+	Fiber::Context self;
+	#ifdef FIBER_UCONTEXT
+	ucontext_t uc;
+	self.sp = &uc;
+	#endif
+	for (Fiber *f; (f = take()) != null; ) resume(self, f);
+}
+
+void FiberScheduler::resume(Fiber::Context& self, Fiber *f) {
+	// the fiber's TRACE frames go on top of the carrier's while it runs
+	CallTrace::Stack *cs = f->traceDepth != 0 ? &CallTrace::stack() : CallTrace::current().load(std::memory_order_relaxed);
+	unsigned base = 0;
+	if (cs != null) {
+		uint64_t t = cs->top.load(std::memory_order_relaxed);
+		base = (unsigned)t;
+		if (!f->frames.empty()) {
+			t = cs->beginWrite(t);
+			for (unsigned i = 0; i < f->frames.size() && base + i < CallTrace::MAX_DEPTH; ++i) cs->set(base + i, f->frames[i]);
+			t += 1ull << 32;
+		}
+		cs->top.store(t + f->traceDepth, std::memory_order_release);
+	}
+	EhGlobals *eh = ehGlobals();
+	EhGlobals own = *eh;
+	eh->caughtExceptions = f->caughtExceptions;
+	eh->uncaughtExceptions = f->uncaughtExceptions;
+
+	f->carrier = &self;
+	Fiber::running() = f;
+	switchContext(&self.sp, f->context.sp);
+	Fiber::running() = null;
+
+	f->caughtExceptions = eh->caughtExceptions;
+	f->uncaughtExceptions = eh->uncaughtExceptions;
+	*eh = own;
+	// allocated by the fiber's first push if the carrier had none
+	cs = CallTrace::current().load(std::memory_order_relaxed);
+	if (cs != null) {
+		uint64_t t = cs->top.load(std::memory_order_relaxed);
+		f->traceDepth = (unsigned)t - base;
+		unsigned kept = (unsigned)t < CallTrace::MAX_DEPTH ? (unsigned)t : CallTrace::MAX_DEPTH;
+		f->frames.clear();
+		for (unsigned i = base; i < kept; ++i) f->frames.push_back(cs->get(i));
+		cs->top.store((t & ~(uint64_t)0xffffffff) | base, std::memory_order_release);
+	}
+
+	switch (f->action) {
+		case Fiber::YIELD:
+			enqueue(f);
+			break;
+		case Fiber::PARK: {
+			f->state.store(Fiber::WAITING, std::memory_order_relaxed);
+			// from PARKED on an unpark may queue it, it is not touched then
+			int none = 0;
+			if (f->permit.compare_exchange_strong(none, Fiber::PARKED, std::memory_order_acq_rel, std::memory_order_relaxed)) break;
+			f->permit.store(0, std::memory_order_relaxed);
+			f->state.store(Fiber::RUNNABLE, std::memory_order_relaxed);
+			enqueue(f);
+			break;
+		}
+		case Fiber::EXIT:
+			terminated(f);
+			break;
+		default:
+			break;
+	}
+}
+void FiberScheduler::terminated(Fiber *f) {
+	stacks().release((char *)f->stack, f->stackSize);
+	f->stack = null;
+	f->state.store(Fiber::TERMINATED, std::memory_order_release);
+	f->joiners.wakeAll();
+	Futex::wakeAll(f->state);
+	f->released.store(true, std::memory_order_release);
+	if (alive.fetch_sub(1, std::memory_order_acq_rel) == 1) Futex::wakeAll(alive);
+}
+
+} //namespace lang
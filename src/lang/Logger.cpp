@@ -0,0 +1,863 @@
+#include <lang/System.hpp>
+#include <lang/Thread.hpp>
+#include <io/IOException.hpp>
+#include <util/concurrent/Futex.hpp>
+#include <cerrno>
+#include <csignal>
+#include <cstdarg>
+#include <cstdio>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+using util::concurrent::Futex;
+
+namespace {
+#define CSI "\x1b["
+
+#define SGR_RESET        CSI "m"
+
+#define SGR_RED          CSI "0;31m"
+#define SGR_GREEN        CSI "0;32m"
+#define SGR_YELLOW       CSI "0;33m"
+#define SGR_BLUE         CSI "0;34m"
+
+const char levelName[] = "EWNID";
+const char *levelColor[] = {SGR_RED, SGR_YELLOW, SGR_GREEN, "", SGR_BLUE};
+
+const int RING_SIZE = 64*1024;     // bytes per thread, a power of 2
+const int MAX_TEXT = RING_SIZE/4;  // longer messages are truncated
+const int MAX_RINGS = 256;         // threads beyond log synchronously
+const int MAX_NAME = 256;          // longer thread names are truncated
+const int BATCH_SIZE = 64*1024;
+
+// the header of a record, followed by the thread name and the text
+struct Record {
+	int size;      // bytes taken in the ring, a multiple of 8; negative for padding up to the end
+	int length;    // of the text
+	jlong time;    // milliseconds since the epoch
+	const char *file;
+	unsigned line;
+	int level;
+	int nameLength;
+	const char *name() const { return (const char *)(this + 1); }
+	const char *text() const { return name() + nameLength; }
+};
+
+// single producer (the owning thread), single consumer (the draining thread)
+struct Ring {
+	std::atomic<unsigned long> head{0};
+	char pad1[64];
+	std::atomic<unsigned long> tail{0};
+	char pad2[64];
+	std::atomic<long> dropped{0};
+	long reported = 0;
+	std::atomic<boolean> closed{false};
+	alignas(8) char data[RING_SIZE];
+
+	Record *at(unsigned long pos) { return (Record *)(data + (pos & (RING_SIZE - 1))); }
+};
+
+std::mutex registryLock;                      // guards adding and removing rings
+std::atomic<Ring*> rings[MAX_RINGS];
+std::atomic<int> ringCount{0};
+
+std::atomic<int> overflow{Logger::COUNT};
+std::atomic<int> output{STDERR_FILENO};
+std::atomic<long> gmtoff{0};                  // of the local time zone, seconds
+
+std::atomic<boolean> running{false};
+std::atomic<boolean> draining{false};         // one drain at a time: writer, flush or crash
+std::atomic<int> wakeups{0};                  // futex word of the writer
+std::atomic<int> drains{0};                   // futex word of blocked producers
+std::atomic<int> blocked{0};
+std::once_flag started;
+std::thread *writer = null;
+
+// async-signal-safe text building
+class Line {
+	char *p;
+	char *end;
+public:
+	Line(char *buf, int cap) : p(buf), end(buf + cap) {}
+	char *ptr() const { return p; }
+	Line& put(const char *s, int n) {
+		if (n > end - p) n = (int)(end - p);
+		std::memcpy(p, s, (size_t)n);
+		p += n;
+		return *this;
+	}
+	Line& put(const char *s) { return put(s, (int)std::strlen(s)); }
+	Line& put(char c) { if (p < end) *p++ = c; return *this; }
+	Line& digits(unsigned long v, int width) {
+		char b[24];
+		int n = 0;
+		do { b[n++] = (char)('0' + v % 10); v /= 10; } while (v != 0 || n < width);
+		while (n > 0) put(b[--n]);
+		return *this;
+	}
+};
+
+void putTime(Line& l, jlong millis, long zone, boolean date) {
+	long t = (long)(millis / 1000) + zone;
+	long days = t / 86400, secs = t % 86400;
+	if (secs < 0) { secs += 86400; --days; }
+	if (date) {
+		// civil date from days since the epoch
+		long z = days + 719468;
+		long era = (z >= 0 ? z : z - 146096) / 146097;
+		long doe = z - era * 146097;
+		long yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+		long doy = doe - (365*yoe + yoe/4 - yoe/100);
+		long mp = (5*doy + 2) / 153;
+		long d = doy - (153*mp + 2)/5 + 1;
+		long m = mp < 10 ? mp + 3 : mp - 9;
+		long y = yoe + era * 400 + (m <= 2);
+		l.digits((unsigned long)y, 4).put('-').digits((unsigned long)m, 2).put('-').digits((unsigned long)d, 2).put(' ');
+	}
+	l.digits((unsigned long)(secs / 3600), 2).put(':').digits((unsigned long)(secs / 60 % 60), 2).put(':').digits((unsigned long)(secs % 60), 2);
+	l.put('.').digits((unsigned long)(millis % 1000 + 1000) % 1000, 3);
+}
+
+void putLine(Line& l, jlong millis, long zone, int level, const char *name, int nameLength, const char *file, unsigned line,
+		const char *text, int length, boolean release) {
+	putTime(l, millis, zone, release);
+	l.put(' ').put(levelColor[level]).put('[').put(levelName[level]).put("] ").put(name, nameLength);
+	if (!release) l.put(' ').put(file).put('(').digits(line, 0).put(')');
+	l.put(": ").put(text, length).put(SGR_RESET "\n");
+}
+void putRecord(Line& l, const Record& r, boolean release) {
+	putLine(l, r.time, gmtoff.load(std::memory_order_relaxed), r.level, r.name(), r.nameLength, r.file, r.line, r.text(), r.length, release);
+}
+
+void writeFully(const char *p, long n) {
+	int fd = output.load(std::memory_order_relaxed);
+	while (n > 0) {
+		ssize_t w = ::write(fd, p, (size_t)n);
+		if (w < 0 && errno == EINTR) continue;
+		if (w <= 0) return;
+		p += w; n -= w;
+	}
+}
+
+void updateZone() {
+	time_t t = ::time(null);
+	struct tm tm;
+	if (localtime_r(&t, &tm) != null) gmtoff.store(tm.tm_gmtoff, std::memory_order_relaxed);
+}
+
+// the name of the calling thread's Thread, taken per record as it may be renamed
+const String& threadName() {
+	return Thread::currentThread().getName();
+}
+int nameLength(const String& name) {
+	return std::min(name.length(), MAX_NAME);
+}
+
+// batch of formatted records, used by the draining thread only
+char batch[BATCH_SIZE];
+int batchLength = 0;
+
+void emit(const Record& r, boolean release) {
+	if (BATCH_SIZE - batchLength < (int)sizeof(Record) + r.nameLength + r.length + 256 + (int)std::strlen(r.file)) {
+		writeFully(batch, batchLength);
+		batchLength = 0;
+	}
+	Line l(batch + batchLength, BATCH_SIZE - batchLength);
+	putRecord(l, r, release);
+	batchLength = (int)(l.ptr() - batch);
+}
+
+// skips padding, returns the next record or null
+Record *peek(Ring *r, unsigned long& cursor, unsigned long head) {
+	if (cursor == head) return null;
+	Record *rec = r->at(cursor);
+	if (rec->size < 0) {
+		cursor -= (unsigned long)rec->size;
+		if (cursor == head) return null;
+		rec = r->at(cursor);
+	}
+	return rec;
+}
+
+// merges the records of all rings by time, must hold the draining flag
+void drainLocked(boolean release) {
+	Ring *rs[MAX_RINGS];
+	unsigned long cursor[MAX_RINGS], head[MAX_RINGS];
+	int n = ringCount.load(std::memory_order_acquire);
+	for (int i = 0; i < n; ++i) {
+		rs[i] = rings[i].load(std::memory_order_acquire);
+		cursor[i] = rs[i]->tail.load(std::memory_order_relaxed);
+		head[i] = rs[i]->head.load(std::memory_order_acquire);
+	}
+	for (;;) {
+		int next = -1;
+		Record *min = null;
+		for (int i = 0; i < n; ++i) {
+			Record *rec = peek(rs[i], cursor[i], head[i]);
+			if (rec != null && (min == null || rec->time < min->time)) { min = rec; next = i; }
+		}
+		if (next < 0) break;
+		emit(*min, release);
+		cursor[next] += (unsigned long)min->size;
+	}
+	for (int i = 0; i < n; ++i) {
+		rs[i]->tail.store(cursor[i], std::memory_order_release);
+		long d = rs[i]->dropped.load(std::memory_order_relaxed);
+		if (d != rs[i]->reported && overflow.load(std::memory_order_relaxed) == Logger::COUNT) {
+			char text[64];
+			Line l(text, sizeof(text));
+			l.digits((unsigned long)(d - rs[i]->reported), 0).put(" log records dropped");
+			Record rec = {0, (int)(l.ptr() - text), System::currentTimeMillis(), __FILE__, __LINE__, Logger::WARN, 0};
+			alignas(Record) char buf[sizeof(Record) + sizeof(text)];
+			std::memcpy(buf, &rec, sizeof(rec));
+			std::memcpy(buf + sizeof(rec), text, (size_t)rec.length);
+			emit(*(const Record *)buf, release);
+		}
+		rs[i]->reported = d;
+	}
+	writeFully(batch, batchLength);
+	batchLength = 0;
+}
+
+void lockDrain() {
+	while (draining.exchange(true, std::memory_order_acquire)) std::this_thread::yield();
+}
+void unlockDrain() {
+	draining.store(false, std::memory_order_release);
+}
+
+// rings of finished threads are freed once empty
+void reclaim() {
+	std::lock_guard<std::mutex> lock(registryLock);
+	int n = ringCount.load(std::memory_order_relaxed);
+	for (int i = 0; i < n; ) {
+		Ring *r = rings[i].load(std::memory_order_relaxed);
+		if (r->closed.load(std::memory_order_acquire) && r->tail.load(std::memory_order_relaxed) == r->head.load(std::memory_order_acquire)) {
+			rings[i].store(rings[--n].load(std::memory_order_relaxed), std::memory_order_release);
+			ringCount.store(n, std::memory_order_release);
+			delete r;
+		}
+		else ++i;
+	}
+}
+
+void drain(boolean release) {
+	lockDrain();
+	drainLocked(release);
+	reclaim();
+	unlockDrain();
+	drains.fetch_add(1, std::memory_order_release);
+	if (blocked.load(std::memory_order_relaxed) > 0) Futex::wakeAll(drains);
+}
+
+void crashHandler(int signum) {
+	Logger::flushOnCrash();
+	::raise(signum);
+}
+void installCrashHandlers() {
+	for (int signum : {SIGSEGV, SIGBUS, SIGILL}) {
+		struct sigaction old, sa;
+		if (sigaction(signum, null, &old) != 0 || old.sa_handler != SIG_DFL) continue;
+		std::memset(&sa, 0, sizeof(sa));
+		sa.sa_handler = crashHandler;
+		sa.sa_flags = SA_RESETHAND | SA_NODEFER;
+		sigaction(signum, &sa, null);
+	}
+}
+
+void wakeWriter() {
+	wakeups.fetch_add(1, std::memory_order_release);
+	Futex::wake(wakeups, 1);
+}
+
+// drains every 10ms, or when a ring fills up
+struct Writer {
+	Writer() {
+		updateZone();
+		installCrashHandlers();
+		running.store(true, std::memory_order_release);
+		writer = new std::thread([] {
+			long zone = 0;
+			while (running.load(std::memory_order_acquire)) {
+				int w = wakeups.load(std::memory_order_acquire);
+				long hour = (long)::time(null) / 3600;
+				if (hour != zone) { updateZone(); zone = hour; }
+				drain(Logger::isRelease());
+				Futex::wait(wakeups, w, 10000000);
+			}
+		});
+	}
+	~Writer() {
+		running.store(false, std::memory_order_release);
+		wakeWriter();
+		writer->join();
+		delete writer;
+		writer = null;
+		drain(Logger::isRelease());
+	}
+};
+void startWriter() {
+	static Writer instance;
+}
+
+// the ring of the calling thread, marked closed when the thread ends
+struct RingHolder {
+	Ring *ring = null;
+	boolean failed = false;
+	~RingHolder() {
+		if (ring != null) ring->closed.store(true, std::memory_order_release);
+		ring = null;
+		failed = true;
+	}
+};
+thread_local RingHolder holder;
+
+Ring *currentRing() {
+	if (holder.ring != null || holder.failed) return holder.ring;
+	std::lock_guard<std::mutex> lock(registryLock);
+	int n = ringCount.load(std::memory_order_relaxed);
+	if (n == MAX_RINGS) {
+		holder.failed = true;
+		return null;
+	}
+	Ring *r = new Ring();
+	rings[n].store(r, std::memory_order_release);
+	ringCount.store(n + 1, std::memory_order_release);
+	return holder.ring = r;
+}
+
+void writeNow(Logger::Level level, const char *fn, unsigned ln, const char *text, int len) {
+	char buf[MAX_TEXT + MAX_NAME + 1024];
+	const String& name = threadName();
+	Line l(buf, sizeof(buf));
+	putLine(l, System::currentTimeMillis(), gmtoff.load(std::memory_order_relaxed), level, name.cstr(), nameLength(name), fn, ln, text, len, Logger::isRelease());
+	writeFully(buf, l.ptr() - buf);
+}
+
+boolean append(Ring *r, Logger::Level level, const char *fn, unsigned ln, const char *text, int len) {
+	const String& name = threadName();
+	const int nl = nameLength(name);
+	const unsigned long need = ((unsigned long)sizeof(Record) + (unsigned long)nl + (unsigned long)len + 7) & ~7ul;
+	unsigned long h = r->head.load(std::memory_order_relaxed), used;
+	for (;;) {
+		unsigned long contiguous = RING_SIZE - (h & (RING_SIZE - 1));
+		unsigned long total = need <= contiguous ? need : contiguous + need;
+		used = h - r->tail.load(std::memory_order_acquire);
+		if (RING_SIZE - used >= total) break;
+		if (overflow.load(std::memory_order_relaxed) != Logger::BLOCK || !running.load(std::memory_order_acquire)) {
+			r->dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		blocked.fetch_add(1, std::memory_order_relaxed);
+		int d = drains.load(std::memory_order_acquire);
+		wakeWriter();
+		Futex::wait(drains, d, 1000000);
+		blocked.fetch_sub(1, std::memory_order_relaxed);
+	}
+	unsigned long contiguous = RING_SIZE - (h & (RING_SIZE - 1));
+	if (need > contiguous) {
+		r->at(h)->size = -(int)contiguous;
+		h += contiguous;
+	}
+	Record *rec = r->at(h);
+	*rec = {(int)need, len, System::currentTimeMillis(), fn, ln, level, nl};
+	std::memcpy(rec + 1, name.cstr(), (size_t)nl);
+	std::memcpy((char *)(rec + 1) + nl, text, (size_t)len);
+	r->head.store(h + need, std::memory_order_release);
+	if (used < RING_SIZE/2 && used + need >= RING_SIZE/2) wakeWriter();
+	return true;
+}
+
+void deliver(Logger::Level level, const char *fn, unsigned ln, const char *text, int len) {
+	std::call_once(started, startWriter);
+	Ring *r = running.load(std::memory_order_acquire) ? currentRing() : null;
+	if (r == null) {
+		writeNow(level, fn, ln, text, len);
+		return;
+	}
+	append(r, level, fn, ln, text, len);
+	// the writer ended while the record was appended
+	if (!running.load(std::memory_order_acquire)) drain(Logger::isRelease());
+}
+
+// binary log file: a header followed by entries, each 8 byte aligned and starting with
+// its size and kind; the kind is stored last, 0 marks an entry reserved but not written
+struct FileHeader {
+	char magic[8];
+	uint32_t version;
+	int32_t gmtoff;
+	uint32_t release;
+	uint32_t pad;
+	jlong created;
+};
+const char MAGIC[8] = "JLOGBIN";
+const uint32_t VERSION = 1;
+enum { SITE = 1, THREAD = 2, RECORD = 3, RECORD_FORMAT = 4 };
+struct SiteEntry { uint32_t size, kind, id, level, line; };  // file\0 format\0
+struct ThreadEntry { uint32_t size, kind, id; };             // name\0
+struct RecordEntry { uint32_t size, kind, site, thread; jlong time; };  // arguments
+// a call site with varying formats writes RECORD_FORMAT, the format is its first argument
+
+std::mutex binaryLock;                        // guards open and close, which wait for the users
+std::mutex siteLock;                          // guards site registration, taken by users
+int binaryFd = -1;
+char *binaryMap = null;
+jlong binaryCapacity = 0;
+std::atomic<jlong> binaryUsed{0};
+std::atomic<int> binaryUsers{0};              // threads writing to the mapping
+std::atomic<int> binaryGeneration{0};         // of the open file
+std::atomic<int> siteIds{0};
+std::atomic<int> threadIds{0};
+std::atomic<long> binaryDropped{0};
+
+struct BinaryThread {
+	uint32_t id = 0;
+	int generation = 0;
+};
+thread_local BinaryThread binaryThread;
+
+// space for an entry, null if the file is full; the size is set
+char *reserve(uint32_t& size) {
+	size = (size + 7) & ~7u;
+	jlong off = binaryUsed.fetch_add(size, std::memory_order_relaxed);
+	if (off + size > binaryCapacity) {
+		binaryDropped.fetch_add(1, std::memory_order_relaxed);
+		return null;
+	}
+	char *p = binaryMap + off;
+	std::memcpy(p, &size, sizeof(size));
+	return p;
+}
+void publish(char *p, uint32_t kind) {
+	__atomic_store_n((uint32_t *)(p + sizeof(uint32_t)), kind, __ATOMIC_RELEASE);
+}
+
+uint32_t writeSite(const char *file, unsigned line, int level, const char *fmt) {
+	uint32_t id = (uint32_t)siteIds.fetch_add(1, std::memory_order_relaxed) + 1;
+	size_t fl = std::strlen(file) + 1, ml = std::strlen(fmt) + 1;
+	uint32_t size = (uint32_t)(sizeof(SiteEntry) + fl + ml);
+	char *p = reserve(size);
+	if (p != null) {
+		SiteEntry e = {size, 0, id, (uint32_t)level, line};
+		std::memcpy(p, &e, sizeof(e));
+		std::memcpy(p + sizeof(e), file, fl);
+		std::memcpy(p + sizeof(e) + fl, fmt, ml);
+		publish(p, SITE);
+	}
+	return id;
+}
+void writeThread(uint32_t id) {
+	const String& t = threadName();
+	char name[MAX_NAME + 1];
+	size_t nl = (size_t)nameLength(t);
+	std::memcpy(name, t.cstr(), nl);
+	name[nl++] = 0;
+	uint32_t size = (uint32_t)(sizeof(ThreadEntry) + nl);
+	char *p = reserve(size);
+	if (p == null) return;
+	ThreadEntry e = {size, 0, id};
+	std::memcpy(p, &e, sizeof(e));
+	std::memcpy(p + sizeof(e), name, nl);
+	publish(p, THREAD);
+}
+
+// must hold binaryLock
+void closeBinaryLocked() {
+	if (binaryMap == null) return;
+	while (binaryUsers.load() != 0) std::this_thread::yield();
+	jlong used = binaryUsed.load();
+	if (used > binaryCapacity) used = binaryCapacity;
+	::munmap(binaryMap, (size_t)binaryCapacity);
+	if (::ftruncate(binaryFd, used) != 0) {}
+	::close(binaryFd);
+	binaryMap = null;
+	binaryFd = -1;
+}
+
+struct BinaryCloser {
+	~BinaryCloser() { Logger::closeBinary(); }
+} binaryCloser;
+
+// decoding
+
+struct Value {
+	char tag = 0;
+	jlong i = 0;
+	double f = 0;
+	std::string s;
+};
+class ArgumentReader {
+	const char *p, *end;
+	template<class T> boolean take(T& v) {
+		if (end - p < (long)sizeof(T)) return false;
+		std::memcpy(&v, p, sizeof(T));
+		p += sizeof(T);
+		return true;
+	}
+public:
+	ArgumentReader(const char *p, const char *end) : p(p), end(end) {}
+	boolean next(Value& v) {
+		v = Value();
+		if (p >= end) return false;
+		v.tag = *p++;
+		switch (v.tag) {
+		case 'i': return take(v.i);
+		case 'p': { uint64_t x; if (!take(x)) return false; v.i = (jlong)x; return true; }
+		case 'f': return take(v.f);
+		case 's': {
+			int32_t n;
+			if (!take(n) || n < 0 || end - p < n) return false;
+			v.s.assign(p, (size_t)n);
+			p += n;
+			return true;
+		}
+		}
+		p = end;
+		return false;
+	}
+};
+
+template<class T>
+void appendFormatted(std::string& out, const std::string& spec, T v) {
+	char buf[256];
+	int n = snprintf(buf, sizeof(buf), spec.c_str(), v);
+	if (n < 0) return;
+	if (n < (int)sizeof(buf)) {
+		out.append(buf, (size_t)n);
+		return;
+	}
+	std::vector<char> big((size_t)n + 1);
+	snprintf(big.data(), big.size(), spec.c_str(), v);
+	out.append(big.data(), (size_t)n);
+}
+
+// the printf format applied to the recorded arguments, converted back to the types
+// the conversion and its length modifier expect
+void expand(const char *fmt, ArgumentReader& args, std::string& out) {
+	Value v;
+	for (const char *p = fmt; *p != 0; ) {
+		if (*p != '%') { out += *p++; continue; }
+		if (p[1] == '%') { out += '%'; p += 2; continue; }
+		std::string spec(1, *p++);
+		while (*p != 0 && std::strchr("-+ #0'", *p) != null) spec += *p++;
+		for (int part = 0; part < 2; ++part) {
+			if (part == 1) {
+				if (*p != '.') break;
+				spec += *p++;
+			}
+			if (*p == '*') {
+				++p;
+				args.next(v);
+				spec += std::to_string(v.tag == 'f' ? (jlong)v.f : v.i);
+			}
+			else while (*p >= '0' && *p <= '9') spec += *p++;
+		}
+		std::string mod;
+		while (*p != 0 && std::strchr("hlLqjzt", *p) != null) mod += *p++;
+		char conv = *p;
+		if (conv == 0) { out += spec + mod; break; }
+		++p;
+		spec += conv;
+		if (std::strchr("diouxXc", conv) != null) {
+			args.next(v);
+			jlong x = v.tag == 'f' ? (jlong)v.f : v.i;
+			if (conv == 'c') appendFormatted(out, spec, (int)x);
+			else if (conv == 'd' || conv == 'i') {
+				spec.insert(spec.size() - 1, "ll");
+				if (mod == "hh") x = (signed char)x;
+				else if (mod == "h") x = (short)x;
+				else if (mod.empty()) x = (int)x;
+				appendFormatted(out, spec, (long long)x);
+			}
+			else {
+				spec.insert(spec.size() - 1, "ll");
+				unsigned long long u = (unsigned long long)x;
+				if (mod == "hh") u = (unsigned char)u;
+				else if (mod == "h") u = (unsigned short)u;
+				else if (mod.empty()) u = (unsigned)u;
+				appendFormatted(out, spec, u);
+			}
+		}
+		else if (std::strchr("eEfFgGaA", conv) != null) {
+			args.next(v);
+			appendFormatted(out, spec, v.tag == 'f' ? v.f : (double)v.i);
+		}
+		else if (conv == 's') {
+			args.next(v);
+			appendFormatted(out, spec, v.tag == 's' ? v.s.c_str() : "(?)");
+		}
+		else if (conv == 'p') {
+			args.next(v);
+			appendFormatted(out, spec, (const void *)(uintptr_t)v.i);
+		}
+		else if (conv == 'n') args.next(v);
+		else out += spec.insert(spec.size() - 1, mod);
+	}
+}
+}
+
+namespace lang {
+
+boolean Logger::release = false;
+std::atomic<int> Logger::level(LOG_LEVEL);
+std::atomic<boolean> Logger::binaryMode(false);
+
+void Logger::setOverflow(Overflow policy) {
+	overflow.store(policy, std::memory_order_relaxed);
+}
+void Logger::setOutput(int fd) {
+	flush();
+	output.store(fd, std::memory_order_relaxed);
+}
+jlong Logger::getDropped() {
+	jlong n = 0;
+	std::lock_guard<std::mutex> lock(registryLock);
+	for (int i = 0; i < ringCount.load(std::memory_order_relaxed); ++i)
+		n += rings[i].load(std::memory_order_relaxed)->dropped.load(std::memory_order_relaxed);
+	return n + binaryDropped.load(std::memory_order_relaxed);
+}
+void Logger::flush() {
+	drain(release);
+}
+void Logger::flushOnCrash() {
+	// the crash may have hit a drain in progress, which is given some time to finish
+	for (int i = 0; i < 1000 && draining.exchange(true, std::memory_order_acquire); ++i) {
+		struct timespec ts = {0, 1000000};
+		::nanosleep(&ts, null);
+	}
+	drainLocked(release);
+	draining.store(false, std::memory_order_release);
+}
+
+void Logger::format(const char *fn, unsigned ln, Level level, const char *fmt, va_list& args) const {
+	char buf[512];
+	va_list copy;
+	va_copy(copy, args);
+	int n = vsnprintf(buf, sizeof(buf), fmt, args);
+	const char *text = buf;
+	std::unique_ptr<char[]> big;
+	if (n >= (int)sizeof(buf)) {
+		if (n > MAX_TEXT) n = MAX_TEXT;
+		big.reset(new char[n + 1]);
+		vsnprintf(big.get(), (size_t)n + 1, fmt, copy);
+		text = big.get();
+	}
+	va_end(copy);
+	if (n < 0) n = 0;
+	deliver(level, fn, ln, text, n);
+}
+
+const Logger& Logger::error(const char *fn, unsigned ln, const char *fmt...) const {
+	va_list args;
+	va_start(args, fmt);
+	format(fn, ln, ERROR, fmt, args);
+	va_end(args);
+	return *this;
+}
+const Logger& Logger::warn(const char *fn, unsigned ln, const char *fmt...) const {
+	va_list args;
+	va_start(args, fmt);
+	format(fn, ln, WARN, fmt, args);
+	va_end(args);
+	return *this;
+}
+const Logger& Logger::debug(const char *fn, unsigned ln, const char *fmt...) const {
+	va_list args;
+	va_start(args, fmt);
+	format(fn, ln, DEBUG, fmt, args);
+	va_end(args);
+	return *this;
+}
+const Logger& Logger::info(const char *fn, unsigned ln, const char *fmt...) const {
+	va_list args;
+	va_start(args, fmt);
+	format(fn, ln, INFO, fmt, args);
+	va_end(args);
+	return *this;
+}
+const Logger& Logger::notice(const char *fn, unsigned ln, const char *fmt...) const {
+	va_list args;
+	va_start(args, fmt);
+	format(fn, ln, NOTICE, fmt, args);
+	va_end(args);
+	return *this;
+}
+
+void Logger::binaryRecord(Site& site, const char *fmt, const Arguments& args) const {
+	binaryUsers.fetch_add(1);
+	if (!binaryMode.load()) {
+		binaryUsers.fetch_sub(1, std::memory_order_release);
+		// closed meanwhile, the record goes to the text log
+		ArgumentReader reader(args.data, args.data + args.length);
+		std::string text;
+		expand(fmt, reader, text);
+		deliver(site.level, site.file, site.line, text.data(), (int)std::min(text.size(), (size_t)MAX_TEXT));
+		return;
+	}
+	int gen = binaryGeneration.load(std::memory_order_relaxed);
+	// not binaryLock: close holds it while it waits for the users to leave
+	if (site.generation.load(std::memory_order_acquire) != gen) {
+		std::lock_guard<std::mutex> lock(siteLock);
+		if (site.generation.load(std::memory_order_relaxed) != gen) {
+			site.format.store(fmt, std::memory_order_relaxed);
+			site.id.store((int)writeSite(site.file, site.line, site.level, fmt), std::memory_order_relaxed);
+			site.generation.store(gen, std::memory_order_release);
+		}
+	}
+	if (binaryThread.generation != gen) {
+		binaryThread.id = (uint32_t)threadIds.fetch_add(1, std::memory_order_relaxed) + 1;
+		binaryThread.generation = gen;
+		writeThread(binaryThread.id);
+	}
+	boolean same = fmt == site.format.load(std::memory_order_relaxed);
+	Arguments withFormat;
+	const Arguments *a = &args;
+	if (!same) {
+		withFormat.add(fmt);
+		std::memcpy(withFormat.data + withFormat.length, args.data,
+				(size_t)std::min(args.length, Arguments::MAX_SIZE - withFormat.length));
+		withFormat.length = std::min(withFormat.length + args.length, (int)Arguments::MAX_SIZE);
+		a = &withFormat;
+	}
+	uint32_t size = (uint32_t)(sizeof(RecordEntry) + (size_t)a->length);
+	char *p = reserve(size);
+	if (p != null) {
+		struct timespec ts;
+		clock_gettime(CLOCK_REALTIME, &ts);
+		RecordEntry e = {size, 0, (uint32_t)site.id.load(std::memory_order_relaxed), binaryThread.id,
+				(jlong)ts.tv_sec * 1000000000l + ts.tv_nsec};
+		std::memcpy(p, &e, sizeof(e));
+		std::memcpy(p + sizeof(e), a->data, (size_t)a->length);
+		publish(p, same ? RECORD : RECORD_FORMAT);
+	}
+	binaryUsers.fetch_sub(1, std::memory_order_release);
+}
+
+void Logger::openBinary(const String& path, jlong capacity) {
+	std::lock_guard<std::mutex> lock(binaryLock);
+	binaryMode.store(false);
+	closeBinaryLocked();
+	if (capacity < (jlong)sizeof(FileHeader)) throw io::IOException("capacity too small: " + String::valueOf(capacity));
+	int fd = ::open(path.cstr(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) throw io::IOException(path + ": " + std::strerror(errno));
+	void *m = ::ftruncate(fd, capacity) == 0 ? ::mmap(null, (size_t)capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+	if (m == MAP_FAILED) {
+		int e = errno;
+		::close(fd);
+		throw io::IOException(path + ": " + std::strerror(e));
+	}
+	updateZone();
+	FileHeader h = {{0}, VERSION, (int32_t)gmtoff.load(std::memory_order_relaxed), release, 0, System::currentTimeMillis()};
+	std::memcpy(h.magic, MAGIC, sizeof(h.magic));
+	std::memcpy(m, &h, sizeof(h));
+	binaryFd = fd;
+	binaryMap = (char *)m;
+	binaryCapacity = capacity;
+	binaryUsed.store(sizeof(FileHeader), std::memory_order_relaxed);
+	siteIds.store(0, std::memory_order_relaxed);
+	threadIds.store(0, std::memory_order_relaxed);
+	binaryGeneration.fetch_add(1, std::memory_order_relaxed);
+	binaryMode.store(true);
+}
+void Logger::closeBinary() {
+	std::lock_guard<std::mutex> lock(binaryLock);
+	binaryMode.store(false);
+	closeBinaryLocked();
+}
+
+int Logger::formatLine(char *buf, int size, jlong millis, long zone, Level level, const char *thread,
+		const char *file, unsigned line, const char *text, int length) {
+	Line l(buf, size);
+	putLine(l, millis, zone, level, thread, (int)std::strlen(thread), file, line, text, length, release);
+	return (int)(l.ptr() - buf);
+}
+
+void Logger::decodeBinary(const String& path, int fd) {
+	int in = ::open(path.cstr(), O_RDONLY | O_CLOEXEC);
+	if (in < 0) throw io::IOException(path + ": " + std::strerror(errno));
+	std::vector<char> file;
+	struct stat st;
+	if (::fstat(in, &st) == 0) file.resize((size_t)st.st_size);
+	size_t n = 0;
+	while (n < file.size()) {
+		ssize_t r = ::read(in, file.data() + n, file.size() - n);
+		if (r < 0 && errno == EINTR) continue;
+		if (r <= 0) break;
+		n += (size_t)r;
+	}
+	::close(in);
+	FileHeader h;
+	if (n < sizeof(h) || (std::memcpy(&h, file.data(), sizeof(h)), std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0))
+		throw io::IOException(path + ": not a binary log");
+	if (h.version != VERSION) throw io::IOException(path + ": unsupported version " + String::valueOf((jint)h.version));
+
+	struct SiteInfo { const char *file; unsigned line; Level level; const char *format; };
+	std::map<uint32_t, SiteInfo> sites;
+	std::map<uint32_t, const char *> threads;
+	const boolean rel = h.release != 0;
+	std::string text;
+	std::vector<char> out;
+	for (size_t pos = sizeof(h); pos + 8 <= n; ) {
+		uint32_t size, kind;
+		std::memcpy(&size, file.data() + pos, sizeof(size));
+		std::memcpy(&kind, file.data() + pos + 4, sizeof(kind));
+		if (size == 0 || size > n - pos) break;
+		const char *p = file.data() + pos, *end = p + size;
+		pos += size;
+		if (kind == SITE && size > sizeof(SiteEntry)) {
+			SiteEntry e;
+			std::memcpy(&e, p, sizeof(e));
+			const char *f = p + sizeof(e);
+			const char *fmt = f + strnlen(f, (size_t)(end - f)) + 1;
+			if (fmt < end && strnlen(fmt, (size_t)(end - fmt)) < (size_t)(end - fmt))
+				sites[e.id] = {f, e.line, (Level)(e.level <= DEBUG ? e.level : DEBUG), fmt};
+		}
+		else if (kind == THREAD && size > sizeof(ThreadEntry)) {
+			ThreadEntry e;
+			std::memcpy(&e, p, sizeof(e));
+			const char *name = p + sizeof(e);
+			if (strnlen(name, (size_t)(end - name)) < (size_t)(end - name)) threads[e.id] = name;
+		}
+		else if ((kind == RECORD || kind == RECORD_FORMAT) && size >= sizeof(RecordEntry)) {
+			RecordEntry e;
+			std::memcpy(&e, p, sizeof(e));
+			ArgumentReader args(p + sizeof(e), end);
+			auto s = sites.find(e.site);
+			if (s == sites.end()) continue;
+			SiteInfo site = s->second;
+			Value dynamic;
+			if (kind == RECORD_FORMAT) {
+				args.next(dynamic);
+				site.format = dynamic.s.c_str();
+			}
+			auto t = threads.find(e.thread);
+			text.clear();
+			expand(site.format, args, text);
+			int length = (int)std::min(text.size(), (size_t)MAX_TEXT);
+			out.resize((size_t)length + 1024 + std::strlen(site.file));
+			Line l(out.data(), (int)out.size());
+			const char *name = t != threads.end() ? t->second : "?";
+			putLine(l, e.time / 1000000, h.gmtoff, site.level, name, (int)std::strlen(name),
+					site.file, site.line, text.data(), length, rel);
+			const char *b = out.data();
+			for (long w, left = l.ptr() - b; left > 0; b += w, left -= w) {
+				w = ::write(fd, b, (size_t)left);
+				if (w < 0 && errno == EINTR) w = 0;
+				else if (w <= 0) throw io::IOException(String("write: ") + std::strerror(errno));
+			}
+		}
+	}
+}
+
+}
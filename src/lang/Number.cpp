@@ -1,37 +1,127 @@
-#include <lang/Character.hpp>
+#include <lang/FloatingDecimal.hpp>
 #include <lang/Number.hpp>
 #include <lang/System.hpp>
 
 namespace {
-char digit[] = "0123456789ABCDEFGHIJKLMNOPRSTUVWXYZ";
-char getDigit(byte d) { return digit[d]; }
-struct base {
-   mutable std::ostream *_out;
-   unsigned _base;
+const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+const char digitPairs[] =
+	"00010203040506070809" "10111213141516171819" "20212223242526272829" "30313233343536373839" "40414243444546474849"
+	"50515253545556575859" "60616263646566676869" "70717273747576777879" "80818283848586878889" "90919293949596979899";
+const unsigned long powersOf10[] = {
+	1ul, 10ul, 100ul, 1000ul, 10000ul, 100000ul, 1000000ul, 10000000ul, 100000000ul, 1000000000ul,
+	10000000000ul, 100000000000ul, 1000000000000ul, 10000000000000ul, 100000000000000ul,
+	1000000000000000ul, 10000000000000000ul, 100000000000000000ul, 1000000000000000000ul, 10000000000000000000ul
+};
+
+// number of decimal digits from the bit length, log10(2) ~ 1233/4096
+int decimalLength(unsigned long v) {
+	v |= 1;
+	int t = ((64 - __builtin_clzl(v)) * 1233) >> 12;
+	return t - (v < powersOf10[t]) + 1;
+}
+int checkRadix(int radix) {
+	if (radix < 2 || radix > 36) throw NumberFormatException("radix " + String::valueOf(radix) + " out of range");
+	return radix;
+}
+// value of a digit in radix 36, or 36 if c is not a digit
+inline unsigned digitOf(char c) {
+	unsigned d = (unsigned)(c - '0');
+	if (d < 10) return d;
+	d = (unsigned)((c | 0x20) - 'a');
+	return d < 26 ? d + 10 : 36;
+}
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// SWAR: eight ASCII digits in one 64 bit word
+inline boolean isEightDigits(uint64_t v) {
+	return ((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+inline uint32_t parseEightDigits(uint64_t v) {
+	v -= 0x3030303030303030ull;
+	v = v * 10 + (v >> 8);
+	v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+		(((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+	return (uint32_t)v;
+}
+#endif
+
+NumberFormatException invalid(const char *s, int n, int radix) {
+	return NumberFormatException("For input string: \"" + String::copyValueOf(s, 0, n) + "\"" + (radix == 10 ? String() : " under radix " + String::valueOf(radix)));
+}
 
-   base(unsigned value=10) : _base(value) {}
+// digits of an unsigned value not above limit
+unsigned long parseDigits(const char *s, int n, int radix, unsigned long limit, const char *in, int inlen) {
+	if (n == 0) throw invalid(in, inlen, radix);
+	unsigned long r = 0;
+	if (radix == 10) {
+		while (n > 1 && *s == '0') { ++s; --n; }
+		if (n > 20) throw invalid(in, inlen, radix);
+		int i = 0;
+		// 19 digits do not overflow, the 20th is checked
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		for (; i + 8 <= n && i + 8 <= 19; i += 8) {
+			uint64_t v;
+			std::memcpy(&v, s + i, sizeof(v));
+			if (!isEightDigits(v)) break;
+			r = r * 100000000ul + parseEightDigits(v);
+		}
+#endif
+		for (; i < n; ++i) {
+			unsigned d = (unsigned)(s[i] - '0');
+			if (d > 9) throw invalid(in, inlen, radix);
+			if (i == 19) {
+				if (__builtin_mul_overflow(r, 10ul, &r) || __builtin_add_overflow(r, (unsigned long)d, &r))
+					throw invalid(in, inlen, radix);
+			}
+			else r = r * 10 + d;
+		}
+	}
+	else {
+		const unsigned long max = limit / (unsigned)radix;
+		for (int i = 0; i < n; ++i) {
+			unsigned d = digitOf(s[i]);
+			if (d >= (unsigned)radix || r > max) throw invalid(in, inlen, radix);
+			r *= (unsigned)radix;
+			if (r > limit - d) throw invalid(in, inlen, radix);
+			r += d;
+		}
+	}
+	if (r > limit) throw invalid(in, inlen, radix);
+	return r;
+}
+long parseSigned(const char *s, int n, int radix, unsigned long max) {
+	checkRadix(radix);
+	if (n == 0) throw NumberFormatException("Empty input");
+	int i = 0;
+	boolean negative = false;
+	if (s[0] == '-') { negative = true; ++i; }
+	else if (s[0] == '+') ++i;
+	unsigned long r = parseDigits(s + i, n - i, radix, negative ? max + 1 : max, s, n);
+	return negative ? (long)(0 - r) : (long)r;
+}
+unsigned long parseUnsigned(const char *s, int n, int radix, unsigned long max) {
+	checkRadix(radix);
+	if (n == 0) throw NumberFormatException("Empty input");
+	if (s[0] == '-') throw NumberFormatException("Illegal leading minus sign on unsigned string " + String::copyValueOf(s, 0, n));
+	int i = s[0] == '+' ? 1 : 0;
+	return parseDigits(s + i, n - i, radix, max, s, n);
+}
 
-   const base& operator << (const unsigned long & data) const {
-        switch(_base) {
-            case 8: *_out << std::oct << data; break;
-            case 10: *_out << std::dec << data; break;
-            //case 16: *_out << std::hex << data; break;
-            default: print(data); break;
-        }
-        return *this;
-   }
-   void print(unsigned long data) const {
-        byte digits[8 * sizeof(data)], i = 0;
-        while(data) {
-             digits[i++] = (byte)(data % _base);
-             data /= _base;
-        }
-        while(i) *_out << getDigit(digits[--i]);
-   }
-   friend const base& operator <<(std::ostream& out, const base& b)   {
-       b._out = &out;
-       return b;
-   }
+// chars of a String without terminating a substring copy
+class Chars {
+	char small[64];
+	const char *p;
+	int n;
+public:
+	Chars(const String& s) : n(s.length()) {
+		if (n <= (int)sizeof(small)) {
+			s.getChars(0, n, small, 0);
+			p = small;
+		}
+		else p = s.cstr();
+	}
+	const char *ptr() const { return p; }
+	int length() const { return n; }
 };
 }
 
@@ -50,53 +140,93 @@ String Boolean::toString(boolean v) {
 	return v ? "true" : "false";
 }
 
+int Long::toUnsignedChars(unsigned long v, char *buf, int radix) {
+	if (radix == 10) {
+		int n = decimalLength(v);
+		char *d = buf + n;
+		while (v >= 100) {
+			std::memcpy(d -= 2, digitPairs + 2 * (v % 100), 2);
+			v /= 100;
+		}
+		if (v >= 10) std::memcpy(d - 2, digitPairs + 2 * v, 2);
+		else d[-1] = (char)('0' + v);
+		return n;
+	}
+	checkRadix(radix);
+	int n = 0;
+	if ((radix & (radix - 1)) == 0) {
+		const int shift = __builtin_ctz((unsigned)radix);
+		const unsigned long mask = (unsigned long)radix - 1;
+		n = ((64 - __builtin_clzl(v | 1)) + shift - 1) / shift;
+		for (int i = n - 1; i >= 0; --i, v >>= shift) buf[i] = digits[v & mask];
+		return n;
+	}
+	for (unsigned long t = v; t >= (unsigned)radix; t /= (unsigned)radix) ++n;
+	for (int i = n++; i >= 0; --i, v /= (unsigned)radix) buf[i] = digits[v % (unsigned)radix];
+	return n;
+}
+int Long::toChars(long v, char *buf, int radix) {
+	if (v >= 0) return toUnsignedChars((unsigned long)v, buf, radix);
+	*buf = '-';
+	return 1 + toUnsignedChars(0 - (unsigned long)v, buf + 1, radix);
+}
+
 String Integer::toString(jint v, int radix) {
-	if (radix <= 0) throw ArithmeticException();
-	int s = 0;
-	if (v < 0) {s=1;v=-v;}
-	std::stringstream stream;
-	stream << base((unsigned)radix) << (unsigned long)v;
-	return s ? "-" + stream.str() : stream.str();
+	char buf[MAX_CHARS];
+	return String::copyValueOf(buf, 0, Long::toChars(v, buf, radix));
 }
 String Integer::toUnsignedString(jint v, int radix) {
-	if (radix <= 0) throw ArithmeticException();
-	std::stringstream stream;
-	stream << base((unsigned)radix) << (unsigned long)v;
-	return stream.str();
+	char buf[MAX_CHARS];
+	return String::copyValueOf(buf, 0, Long::toUnsignedChars((uint32_t)v, buf, radix));
+}
+int Integer::parseInt(const char *s, int beginIndex, int endIndex, int radix) {
+	return (int)parseSigned(s + beginIndex, endIndex - beginIndex, radix, (unsigned long)MAX_VALUE);
 }
-
 int Integer::parseInt(const String& s, int radix) {
-	int result = 0;
-	if (s.length() == 0) throw NumberFormatException("Empty input");
-	boolean negative = false;
-	int i=0;
-	char c = s.charAt(0);
-	if (c == '-') {negative=true; ++i;}
-	else if (c == '+') {++i;}
-	if (i == s.length()) throw NumberFormatException("Invalid input, no digits");
-	for (; i < s.length(); ++i) {
-		c = s.charAt(i);
-		int digit = Character::digit(c, radix);
-		if (digit < 0) throw NumberFormatException("Invalid input, wrong digit "+String::valueOf(c)+" in radix "+String::valueOf(radix));
-		result *= radix;
-		result -= digit;
-	}
-	return negative ? result : -result;
+	Chars c(s);
+	return parseInt(c.ptr(), 0, c.length(), radix);
+}
+int Integer::parseUnsignedInt(const String& s, int radix) {
+	Chars c(s);
+	return (int)parseUnsigned(c.ptr(), c.length(), radix, 0xffffffffu);
 }
 
 String Long::toString(long v, int radix) {
-	if (radix <= 0) throw ArithmeticException();
-	int s = 0;
-	if (v < 0) {s=1;v=-v;}
-	std::stringstream stream;
-	stream << base((unsigned)radix) << (unsigned long)v;
-	return s ? "-" + stream.str() : stream.str();
+	char buf[MAX_CHARS];
+	return String::copyValueOf(buf, 0, toChars(v, buf, radix));
 }
 String Long::toUnsignedString(long v, int radix) {
-	if (radix <= 0) throw ArithmeticException();
-	std::stringstream stream;
-	stream << base((unsigned)radix) << (unsigned long)v;
-	return stream.str();
+	char buf[MAX_CHARS];
+	return String::copyValueOf(buf, 0, toUnsignedChars((unsigned long)v, buf, radix));
+}
+long Long::parseLong(const char *s, int beginIndex, int endIndex, int radix) {
+	return parseSigned(s + beginIndex, endIndex - beginIndex, radix, (unsigned long)MAX_VALUE);
+}
+long Long::parseLong(const String& s, int radix) {
+	Chars c(s);
+	return parseLong(c.ptr(), 0, c.length(), radix);
+}
+long Long::parseUnsignedLong(const String& s, int radix) {
+	Chars c(s);
+	return (long)parseUnsigned(c.ptr(), c.length(), radix, ~0ul);
+}
+
+String Float::toString(float v) {
+	char buf[FloatingDecimal::MAX_CHARS];
+	return String::copyValueOf(buf, 0, FloatingDecimal::toChars(v, buf));
+}
+float Float::parseFloat(const String& s) {
+	Chars c(s);
+	return FloatingDecimal::parseFloat(c.ptr(), c.length());
+}
+
+String Double::toString(double v) {
+	char buf[FloatingDecimal::MAX_CHARS];
+	return String::copyValueOf(buf, 0, FloatingDecimal::toChars(v, buf));
+}
+double Double::parseDouble(const String& s) {
+	Chars c(s);
+	return FloatingDecimal::parseDouble(c.ptr(), c.length());
 }
 
 } //namespace lang
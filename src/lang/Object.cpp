@@ -1,11 +1,16 @@
 #include <lang/Object.hpp>
 #include <lang/Class.hpp>
+#include <lang/Fiber.hpp>
 #include <lang/Number.hpp>
 #include <lang/System.hpp>
 #include <lang/Thread.hpp>
+#include <util/concurrent/Futex.hpp>
+#include <util/Metrics.hpp>
 
+#include <atomic>
 #include <exception>
 #include <stdexcept> //std::exception_ptr
+#include <thread>
 
 #include <unistd.h> // write
 #include <signal.h> // signal, SIGxxx
@@ -13,6 +18,7 @@
 #include <dlfcn.h> //dladdr
 #ifdef __GNUG__ // gnu C++ compiler
 #include <memory>
+#include <unordered_map>
 #include <cxxabi.h>
 #endif
 
@@ -24,6 +30,16 @@
 // http://blog.bigpixel.ro/2010/09/stack-unwinding-stack-trace-with-gcc/
 // readelf --debug-dump=decodedline  a.out
 
+namespace {
+// classes thrown without capturing a stack trace
+const int MAX_UNTRACED = 32;
+std::mutex untracedLock;
+std::atomic<const Class*> untraced[MAX_UNTRACED];
+std::atomic<int> untracedCount{0};
+// symbolizes the frames of a Throwable once, getStackTrace may be called by several threads
+std::mutex symbolizeLock;
+}
+
 extern "C" {
 void __cxa_pure_virtual() {
 	throw Error("Pure virtual method called");
@@ -39,7 +55,8 @@ void __cxa_throw(void* thrown_exception, void* _tinfo, void (*dest)(void*)) {
 	if (instanceof<Throwable>(o)) {
 		Throwable* ex = (Throwable*)o;
 		//std::cerr << __FILE__ << "(" << __LINE__<< "): thrown " << ex->getClass().getName().cstr() << std::endl;
-		if (ex->getStackTrace().length == 0)
+		if (!ex->hasStackTrace() && (untracedCount.load(std::memory_order_relaxed) == 0 ||
+				Throwable::isStackTraceEnabled(ex->getClass())))
 			ex->fillInStackTrace();
 	}
 	else if (instanceof<std::exception>(o)) {
@@ -56,16 +73,238 @@ void __cxa_throw(void* thrown_exception, void* _tinfo, void (*dest)(void*)) {
 }
 
 namespace {
-ArrayList<Class*>& classmap() {
-	static ArrayList<Class*> *a = null;
-	if (!a) a = new ArrayList<Class*>(5);
-	return *a;
+/*
+ * Class registry: a fixed table of insert-only chains keyed by type_info::hash_code().
+ * Entries are published with a release CAS and never unlinked, so a lookup is
+ * a plain walk with acquire loads - no lock and no retry.
+ * Zero-initialized storage, so it is usable before any static constructor runs.
+ */
+class ClassRegistry {
+private:
+	struct Entry {
+		const std::type_info& type;
+		const std::size_t hash;
+		std::atomic<Class*> cls;
+		Entry *next;
+		Entry(const std::type_info& t, std::size_t h, Class *c) : type(t), hash(h), cls(c), next(null) {}
+	};
+	static const unsigned BUCKETS = 1024; // power of 2
+	std::atomic<Entry*> bucket[BUCKETS];
+
+	static Entry *find(Entry *e, const std::type_info& type, std::size_t h) {
+		for (; e != null; e = e->next) {
+			if (e->hash == h && e->type == type) return e;
+		}
+		return null;
+	}
+public:
+	Class *find(const std::type_info& type) const {
+		std::size_t h = type.hash_code();
+		Entry *e = find(bucket[h & (BUCKETS-1)].load(std::memory_order_acquire), type, h);
+		return e == null ? null : e->cls.load(std::memory_order_acquire);
+	}
+	/*
+	 * Returns the class registered for type after the call.
+	 * Unless replace is set, a class registered concurrently by another thread wins.
+	 */
+	Class *insert(const std::type_info& type, Class *c, boolean replace) {
+		std::size_t h = type.hash_code();
+		std::atomic<Entry*>& head = bucket[h & (BUCKETS-1)];
+		Entry *first = head.load(std::memory_order_acquire);
+		Entry *n = null;
+		for (;;) {
+			Entry *e = find(first, type, h);
+			if (e != null) {
+				delete n;
+				if (!replace) return e->cls.load(std::memory_order_acquire);
+				e->cls.store(c, std::memory_order_release);
+				return c;
+			}
+			if (n == null) n = new Entry(type, h, c);
+			n->next = first;
+			if (head.compare_exchange_weak(first, n, std::memory_order_release, std::memory_order_acquire))
+				return c;
+		}
+	}
+};
+ClassRegistry registry;
+
+Class *lookupOrRegister(const std::type_info& type, Class *(*create)(const std::type_info&)) {
+	Class *c = registry.find(type);
+	if (c == null) {
+		Class *n = create(type);
+		c = registry.insert(type, n, false);
+		if (c != n) delete n;
+	}
+	return c;
+}
+
+/*
+ * Object monitors.
+ * An uncontended synchronized is a single CAS on the object's lock word (thin lock).
+ * A contending thread, or the owner calling wait(), inflates the lock word to a
+ * monitor taken from a table of preallocated chunks with striped free lists; the
+ * monitor is returned (deflated) by the owner releasing it when nobody else uses it.
+ * Since a monitor can be reassigned right after deflation, refs counts threads
+ * entering, owning or waiting on it and carries DEFLATED, so a thread racing with
+ * deflation backs off and rereads the lock word.
+ */
+const uintptr_t INFLATED = 1;
+const uintptr_t DEPTH_ONE = 2;
+const uintptr_t DEPTH_MASK = 0xfe;
+const uintptr_t OWNER_MASK = ~(uintptr_t)0xff;
+const unsigned SPIN_LIMIT = 100;
+// spinning only helps when the owner can run meanwhile
+const unsigned spinLimit = std::thread::hardware_concurrency() > 1 ? SPIN_LIMIT : 0;
+
+std::atomic<jlong> inflations{0}, deflations{0}, waits{0};
+// the blocking path only, registered on first contention
+struct ContentionMetrics {
+	util::concurrent::LongAdder& contended = util::Metrics::counter("lang.Object.monitor.contended");
+	util::Metrics::Histogram& blocked = util::Metrics::histogram("lang.Object.monitor.blocked.ns");
+};
+ContentionMetrics& contentionMetrics() {
+	static ContentionMetrics m;
+	return m;
+}
+
+std::atomic<uintptr_t> lastThreadId{0};
+thread_local uintptr_t selfId = 0;
+// a fiber owns the monitors it entered on whichever carrier, its ids have the top bit set
+const uintptr_t FIBER_OWNER = (uintptr_t)1 << (sizeof(uintptr_t) * 8 - 1);
+inline uintptr_t currentOwnerId() {
+	const Fiber *f = Fiber::current();
+	if (f != null) return FIBER_OWNER | (uintptr_t)f->getId() << 8;
+	uintptr_t id = selfId;
+	if (id == 0) selfId = id = (lastThreadId.fetch_add(1) + 1) << 8;
+	return id;
+}
+inline void cpuRelax() {
+#if defined(__i386__) || defined(__x86_64__)
+	__builtin_ia32_pause();
+#endif
+}
+
+struct Monitor {
+	static const unsigned DEFLATED = 0x80000000U;
+	std::atomic<int> mutex{0};  // 0 free, 1 locked, 2 locked and contended
+	std::atomic<int> seq{0};    // notify sequence, waiters sleep on it
+	std::atomic<unsigned> refs{DEFLATED};
+	std::atomic<uintptr_t> owner{0};
+	unsigned count = 0;         // recursion depth of the owner
+	int waiters = 0;
+	Monitor *next = null;       // free list link
+	// fibers park here instead of blocking their carrier on the futex words
+	Fiber::WaitQueue fiberLockers, fiberWaiters;
+
+	void lock() {
+		int c = 0;
+		if (mutex.compare_exchange_strong(c, 1, std::memory_order_acquire)) return ;
+		// short critical sections are usually over before a futex round trip
+		for (unsigned spins = 0; spins < spinLimit; ++spins) {
+			cpuRelax();
+			c = mutex.load(std::memory_order_relaxed);
+			if (c == 0 && mutex.compare_exchange_weak(c, 1, std::memory_order_acquire)) return ;
+		}
+		ContentionMetrics& metrics = contentionMetrics();
+		metrics.contended.increment();
+		jlong t0 = System::nanoTime();
+		const boolean fiber = Fiber::current() != null;
+		if (c != 2) c = mutex.exchange(2, std::memory_order_acquire);
+		while (c != 0) {
+			if (fiber) fiberLockers.wait(mutex, 2);
+			else util::concurrent::Futex::wait(mutex, 2);
+			c = mutex.exchange(2, std::memory_order_acquire);
+		}
+		metrics.blocked.record(System::nanoTime() - t0);
+	}
+	void unlock() {
+		if (mutex.fetch_sub(1, std::memory_order_release) != 1) {
+			mutex.store(0, std::memory_order_release);
+			util::concurrent::Futex::wake(mutex, 1);
+			fiberLockers.wake(1);
+		}
+	}
+};
+
+class MonitorTable {
+private:
+	static const unsigned STRIPES = 16;
+	static const unsigned CHUNK = 64;
+	struct Stripe {
+		std::mutex mtx;
+		Monitor *free = null;
+	};
+	Stripe stripes[STRIPES];
+	Stripe& stripeOf(const Object& o) { return stripes[((uintptr_t)&o >> 4) % STRIPES]; }
+public:
+	Monitor *alloc(const Object& o) {
+		Stripe& s = stripeOf(o);
+		Monitor *m;
+		{
+			std::lock_guard<std::mutex> lock(s.mtx);
+			if (s.free == null) {
+				Monitor *chunk = new Monitor[CHUNK];
+				for (unsigned i=0; i < CHUNK-1; ++i) chunk[i].next = &chunk[i+1];
+				s.free = chunk;
+			}
+			m = s.free;
+			s.free = m->next;
+		}
+		// keep the counts of racing threads, they drop them when they back off
+		m->refs.fetch_sub(Monitor::DEFLATED, std::memory_order_relaxed);
+		return m;
+	}
+	// m->refs must have DEFLATED set
+	void release(const Object& o, Monitor *m) {
+		Stripe& s = stripeOf(o);
+		std::lock_guard<std::mutex> lock(s.mtx);
+		m->next = s.free;
+		s.free = m;
+	}
+};
+MonitorTable monitors;
+
+inline Monitor *monitorOf(uintptr_t w) { return (Monitor*)(w & ~INFLATED); }
+
+// turns thin lock w into a monitor owned by the thin lock owner
+void inflate(const Object& o, std::atomic<uintptr_t>& lw, uintptr_t w) {
+	Monitor *m = monitors.alloc(o);
+	m->refs.fetch_add(1, std::memory_order_relaxed); // the owner's reference
+	m->owner.store(w & OWNER_MASK, std::memory_order_relaxed);
+	m->count = (unsigned)((w & DEPTH_MASK) >> 1);
+	m->mutex.store(1, std::memory_order_relaxed);
+	if (lw.compare_exchange_strong(w, (uintptr_t)m | INFLATED, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+		++inflations;
+		return ;
+	}
+	m->owner.store(0, std::memory_order_relaxed);
+	m->count = 0;
+	m->mutex.store(0, std::memory_order_relaxed);
+	m->refs.fetch_add(Monitor::DEFLATED - 1, std::memory_order_release);
+	monitors.release(o, m);
+}
+
+// inflated monitor of lock word owned by the current thread
+Monitor *ownedMonitor(const Object& o, std::atomic<uintptr_t>& lw) {
+	const uintptr_t me = currentOwnerId();
+	uintptr_t w = lw.load(std::memory_order_acquire);
+	if ((w & INFLATED) == 0) {
+		if (w == 0 || (w & OWNER_MASK) != me)
+			throw IllegalMonitorStateException("current thread is not owner");
+		inflate(o, lw, w);
+		w = lw.load(std::memory_order_acquire);
+	}
+	Monitor *m = monitorOf(w);
+	if (m->owner.load(std::memory_order_relaxed) != me)
+		throw IllegalMonitorStateException("current thread is not owner");
+	return m;
 }
 
 boolean initialize();
 static const boolean SET_TERMINATE = initialize();
 
-void terminate_hook();
+[[noreturn]] void terminate_hook();
 void signal_handle(int signum);
 boolean initialize() {
 	(void)SET_TERMINATE;
@@ -93,48 +332,67 @@ String getSimpleBinaryName() { return ""; }
 //TODO https://github.com/CyberGrandChallenge/binutils/blob/master/binutils/addr2line.c
 //     osx(atos): sprintf(addr2line_cmd,"atos -o %.256s %p", program_name, addr);
 //     linux:     sprintf(addr2line_cmd,"addr2line -f -p -e %.256s %p", program_name, addr);
+String symbolize(void *addr) {
+	Dl_info info;
+	std::string saddr = "[0x"+Long::toHexString((long)addr).intern()+"]";
+	if (dladdr(addr, &info) == 0) return saddr;
+	//dli_fname - path of shared object (exe or so)
+	//dli_fbase - Base adress of shared object
+	//dli_sname - Name of nearest symbol
+	//dli_saddr - Exact address of symbol
+	std::string path = info.dli_fname;
+	if (path.rfind('/') != std::string::npos) path = path.substr(path.rfind('/')+1);
+	if (info.dli_sname == null) info.dli_sname="";
+	std::string func = demangle(info.dli_sname);
+	std::string offs;
+	if (info.dli_saddr != 0)
+		offs = "+" + std::to_string((long)addr - (long)info.dli_saddr);
+	return func+offs+" "+path+saddr;
+}
+
+// return address -> symbol, shared by all threads; code addresses are few
+class SymbolCache {
+private:
+	std::mutex mtx;
+	std::unordered_map<void*,String> symbols;
+public:
+	String lookup(void *addr) {
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			auto i = symbols.find(addr);
+			if (i != symbols.end()) return i->second;
+		}
+		String sym = symbolize(addr);
+		std::lock_guard<std::mutex> lock(mtx);
+		symbols.emplace(addr, sym);
+		return sym;
+	}
+};
+SymbolCache symbols;
+
+// skip counts this function as the first frame
+__attribute__((noinline))
+int captureFrames(void **frames, int max, int skip) {
+	int got = ::backtrace(frames, max);
+	if (got <= skip) return 0;
+	got -= skip;
+	std::memmove(frames, frames + skip, (size_t)got * sizeof(void*));
+	return got;
+}
+
 Array<StackTraceElement>& captureStackTrace(Array<StackTraceElement>& stackTrace, const int skip) {
 	const int depth = 50;
 	void *trace[depth];
-	int got = ::backtrace(trace, depth);
-	if (got <= skip) {
+	int got = captureFrames(trace, depth, skip + 1);
+	if (got == 0) {
 		return stackTrace;
 	}
-
-	got -= skip;
 	stackTrace = Array<StackTraceElement>(got);
 	for (int i = 0; i < got; ++i) {
-		Dl_info info;
-		//std::cerr << "addr 0x" << std::hex << (long)trace[i+skip] << std::endl;
-		std::string addr = "[0x"+Long::toHexString((long)trace[i+skip]).intern()+"]";
-		if (dladdr(trace[i+skip], &info) != 0) {
-			//dli_fname - path of shared object (exe or so)
-			//dli_fbase - Base adress of shared object
-			//dli_sname - Name of nearest symbol
-			//dli_saddr - Exact address of symbol
-			std::string path = info.dli_fname;
-			if (path.rfind('/') != std::string::npos) path = path.substr(path.rfind('/')+1);
-			if (info.dli_sname == null) info.dli_sname="";
-			std::string func = demangle(info.dli_sname);
-			std::string offs;
-			if (info.dli_saddr != 0)
-				offs = "+" + std::to_string((long)trace[i+skip] - (long)info.dli_saddr);
-			else
-				offs = "";
-			stackTrace[i] = StackTraceElement(func+offs+" "+path+addr, "", 0);
-		}
-		else {
-			stackTrace[i] = StackTraceElement(addr, "", 0);
-		}
+		stackTrace[i] = StackTraceElement(symbols.lookup(trace[i]), "", 0);
 	}
 	return stackTrace;
 }
-#ifdef BACKTRACE
-void captureStack2(Array<StackTraceElement>& stackTrace) {
-	Thread& t = Thread::currentThread();
-	stackTrace = t.getStackTrace();
-}
-#endif
 //FIXME do not call any c lib function from a handler (only async-safe can be used)
 //      also don't throw exception
 //  read SIGNAL-SAFETY(7) for list of async-safe-functions
@@ -158,6 +416,7 @@ void signal_handle(int signum) {
 		throw ex;
 	}
 
+	Logger::flushOnCrash();
 	Throwable t("Signal " + String::valueOf(signum));
 	t.setStackTrace(st);
 	t.printStackTrace();
@@ -167,6 +426,7 @@ void signal_handle(int signum) {
 [[noreturn]]
 void terminate_hook() {
 	std::set_terminate(null); // avoid loop
+	Logger::flushOnCrash();
 	std::exception_ptr ep = std::current_exception();
 	if (ep != null) {
 		System::err.println("Uncatched exception received");
@@ -199,12 +459,28 @@ public:
 	boolean isArray() const {return true;}
 };
 
+String simpleNameOf(const String& name) {
+	String simpleName = getSimpleBinaryName();
+	if (simpleName.isEmpty()) { // top level class
+		int i = name.lastIndexOf(":");
+		if (i >= 0) return name.substring(i+1); // strip the package name
+		return name;
+	}
+	return simpleName;
+}
+
 }
 
 namespace lang {
 
 long Object::null_val = 0;
 
+String StackTraceElement::functionName(const void *addr) {
+	Dl_info info;
+	if (dladdr(addr, &info) == 0 || info.dli_sname == null) return "??";
+	return demangle(info.dli_sname);
+}
+
 Throwable::Throwable(const String& msg, Throwable *c) : detailMessage(msg), cause(c) {
 	threadInfo = Thread::currentThread().getName();
 }
@@ -222,14 +498,52 @@ String Throwable::toString() const {
 	return (message != null) ? (s + ": " + message) : (s + ": null msg");
 }
 Throwable& Throwable::fillInStackTrace() {
-	(void)captureStackTrace;
-#ifdef BACKTRACE
-	captureStack2(stackTrace);
-#else
-	captureStackTrace(stackTrace, 3);
-#endif
+	// functions annotated with TRACE are on the shadow stack, with file and line
+	const CallTrace::Stack *shadow = CallTrace::current().load(std::memory_order_relaxed);
+	if (shadow != null && (unsigned)shadow->top.load(std::memory_order_relaxed) != 0) {
+		depth = 0;
+		stackTrace = CallTrace::getStackTrace(*shadow);
+		return *this;
+	}
+	depth = captureFrames(frames, MAX_FRAMES, 3);
+	stackTrace = Array<StackTraceElement>();
+	symbolized.store(false, std::memory_order_relaxed);
 	return *this;
 }
+const Array<StackTraceElement>& Throwable::getStackTrace() const {
+	if (depth > 0 && !symbolized.load(std::memory_order_acquire)) {
+		std::lock_guard<std::mutex> lock(symbolizeLock);
+		if (!symbolized.load(std::memory_order_relaxed)) {
+			Array<StackTraceElement> st(depth);
+			for (int i=0; i < depth; ++i) st[i] = StackTraceElement(symbols.lookup(frames[i]), "", 0);
+			stackTrace = std::move(st);
+			symbolized.store(true, std::memory_order_release);
+		}
+	}
+	return stackTrace;
+}
+void Throwable::setStackTraceEnabled(const Class& type, boolean enabled) {
+	std::lock_guard<std::mutex> lock(untracedLock);
+	int n = untracedCount.load();
+	for (int i=0; i < n; ++i) {
+		if (untraced[i].load() != &type) continue;
+		if (!enabled) return ;
+		untraced[i].store(untraced[n-1].load());
+		untracedCount.store(n-1);
+		return ;
+	}
+	if (enabled) return ;
+	if (n == MAX_UNTRACED) throw IllegalStateException("too many classes without stack trace");
+	untraced[n].store(&type);
+	untracedCount.store(n+1);
+}
+boolean Throwable::isStackTraceEnabled(const Class& type) {
+	int n = untracedCount.load(std::memory_order_acquire);
+	for (int i=0; i < n; ++i) {
+		if (untraced[i].load(std::memory_order_relaxed) == &type) return false;
+	}
+	return true;
+}
 void Throwable::printStackTrace() const {TRACE;
 	io::PrintStream& s = System::err;
 	s.print("\x1b[0;31m");
@@ -239,9 +553,10 @@ void Throwable::printStackTrace() const {TRACE;
 void Throwable::printStackTrace(io::PrintStream& s) const {TRACE;
 	synchronized(s) {
 	s.println("[T]Exception in thread \"" + threadInfo + "\" " + this->toString());
-	for (int i=0; i < stackTrace.length; ++i) {
+	const Array<StackTraceElement>& trace = getStackTrace();
+	for (int i=0; i < trace.length; ++i) {
 		s.print("\tat ");
-		s.println(stackTrace[i].toString());
+		s.println(trace[i].toString());
 	}
 	const Throwable *ourCause = getCause();
 	if (ourCause != null) {
@@ -257,73 +572,121 @@ String Class::toString() const {
 	return c + getName();
 }
 String Class::toGenericString() const {return toString();}
-String Class::getSimpleName() const {TRACE;
-	String simpleName = getSimpleBinaryName();
-	if (simpleName.isEmpty()) { // top level class
-		simpleName = getName();
-		int i = simpleName.lastIndexOf(":");
-		if (i >= 0) return simpleName.substring(i+1); // strip the package name
-	}
-	return simpleName;
-}
-String Class::getName() const {TRACE;return demangle(type.name());}
+Class::Class(const std::type_info& t) : type(t), name(demangle(t.name())), simpleName(simpleNameOf(name)) {}
 String Class::getCanonicalName() const {TRACE;return getName();}
 
 
 Class *Object::findClass(const std::type_info& type) {
-	ArrayList<Class*>& cm = classmap();
-	synchronized(cm) {
-	for (SharedIterator<Class*> i = cm.iterator(); i->hasNext(); ) {
-		Class *c = i->next();
-		if (c->type == type) return c;
-	}
-	}
-	return null;
+	return registry.find(type);
 }
 void Object::registerClass(Class *c) {
-	ArrayList<Class*>& cm = classmap();
-	synchronized(cm) {
-		Class *o = Object::findClass(c->type);
-		if (o == c) return ;
-		if (o) cm.remove(o);
-		cm.add(c);
-	}
+	registry.insert(c->type, c, true);
 }
 const Class& Object::getClass() const {TRACE;
 	return getClass(typeid(*this));
 }
 const Class& Object::getClass(const std::type_info& type) {
-	Class *c = null;
-	ArrayList<Class*>& cm = classmap();
-	synchronized(cm) {
-		c = Object::findClass(type);
-		if (!c) Object::registerClass(c=new Class(type));
-	}
-	return *c;
+	return *lookupOrRegister(type, [](const std::type_info& t) -> Class* { return new Class(t); });
 }
 
-class CondMonitor {
-private:
-	const Object *obj;
-	std::condition_variable cond;
-public:
-	CondMonitor(const Object *o) : obj(o) {}
-	void wait(long t);
-	void notify();
-	void notifyAll();
-};
+void Object::monitorEnter(const Object& o) {
+	const uintptr_t me = currentOwnerId();
+	std::atomic<uintptr_t>& lw = o.lockword;
+	uintptr_t w = 0;
+	if (lw.compare_exchange_strong(w, me | DEPTH_ONE, std::memory_order_acquire, std::memory_order_relaxed))
+		return ;
+	for (unsigned spins = 0; ; ) {
+		if (w == 0) {
+			if (lw.compare_exchange_weak(w, me | DEPTH_ONE, std::memory_order_acquire, std::memory_order_relaxed))
+				return ;
+			continue;
+		}
+		if ((w & INFLATED) == 0) {
+			if ((w & OWNER_MASK) == me) {
+				if ((w & DEPTH_MASK) != DEPTH_MASK) {
+					if (lw.compare_exchange_weak(w, w + DEPTH_ONE, std::memory_order_relaxed, std::memory_order_relaxed))
+						return ;
+					continue;
+				}
+			}
+			else if (++spins < spinLimit) {
+				cpuRelax();
+				w = lw.load(std::memory_order_relaxed);
+				continue;
+			}
+			inflate(o, lw, w);
+			w = lw.load(std::memory_order_acquire);
+			continue;
+		}
 
-void CondMonitor::wait(long t) {
-	//cond.wait_for(lock, std::chrono::milliseconds(millis));
+		Monitor *m = monitorOf(w);
+		if (m->owner.load(std::memory_order_relaxed) == me && lw.load(std::memory_order_relaxed) == w) {
+			++m->count;
+			return ;
+		}
+		unsigned r = m->refs.fetch_add(1, std::memory_order_acquire);
+		if ((r & Monitor::DEFLATED) != 0 || lw.load(std::memory_order_acquire) != w) {
+			m->refs.fetch_sub(1, std::memory_order_release);
+			w = lw.load(std::memory_order_acquire);
+			continue;
+		}
+		m->lock();
+		m->owner.store(me, std::memory_order_relaxed);
+		m->count = 1;
+		return ;
+	}
 }
-void CondMonitor::notify() {
-	cond.notify_one();
+void Object::monitorExit(const Object& o) {
+	const uintptr_t me = currentOwnerId();
+	std::atomic<uintptr_t>& lw = o.lockword;
+	uintptr_t w = me | DEPTH_ONE;
+	if (lw.compare_exchange_strong(w, 0, std::memory_order_release, std::memory_order_acquire))
+		return ;
+	while ((w & INFLATED) == 0) {
+		if (w == 0 || (w & OWNER_MASK) != me) return ; // not owner
+		uintptr_t n = (w & DEPTH_MASK) == DEPTH_ONE ? 0 : w - DEPTH_ONE;
+		if (lw.compare_exchange_weak(w, n, std::memory_order_release, std::memory_order_acquire))
+			return ;
+	}
+	Monitor *m = monitorOf(w);
+	if (m->owner.load(std::memory_order_relaxed) != me) return ; // not owner
+	if (--m->count > 0) return ;
+	m->owner.store(0, std::memory_order_relaxed);
+	unsigned self = 1;
+	if (m->refs.compare_exchange_strong(self, Monitor::DEFLATED, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+		lw.store(0, std::memory_order_release);
+		m->unlock();
+		monitors.release(o, m);
+		++deflations;
+		return ;
+	}
+	m->unlock();
+	m->refs.fetch_sub(1, std::memory_order_release);
 }
-void CondMonitor::notifyAll() {
-	cond.notify_all();
+Object::MonitorStatistics Object::getMonitorStatistics() {
+	MonitorStatistics s;
+	s.inflations = inflations.load();
+	s.deflations = deflations.load();
+	s.contended = contentionMetrics().contended.sum();
+	s.waits = waits.load();
+	return s;
 }
 
-Object::~Object() { delete mtx; delete cond; }
+Object::~Object() {
+	uintptr_t w = lockword.load(std::memory_order_acquire);
+	if ((w & INFLATED) == 0) return ;
+	// left inflated by a thread which raced with deflation, take it back
+	Monitor *m = monitorOf(w);
+	for (unsigned spins = 0; spins < SPIN_LIMIT; ++spins) {
+		unsigned none = 0;
+		if (m->refs.compare_exchange_weak(none, Monitor::DEFLATED, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+			monitors.release(*this, m);
+			++deflations;
+			return ;
+		}
+		std::this_thread::yield();
+	}
+}
 Object& Object::clone() const {TRACE;
 	throw CloneNotSupportedException();
 }
@@ -333,15 +696,50 @@ String Object::toString() const {
 }
 
 void Object::notify() {
-	if (cond) cond->notify();
+	const uintptr_t me = currentOwnerId();
+	uintptr_t w = lockword.load(std::memory_order_acquire);
+	if ((w & INFLATED) == 0) { // no waiters without a monitor
+		if (w == 0 || (w & OWNER_MASK) != me)
+			throw IllegalMonitorStateException("current thread is not owner");
+		return ;
+	}
+	Monitor *m = ownedMonitor(*this, lockword);
+	if (m->waiters == 0) return ;
+	m->seq.fetch_add(1, std::memory_order_release);
+	util::concurrent::Futex::wake(m->seq, 1);
+	m->fiberWaiters.wake(1);
 }
 void Object::notifyAll() {
-	if (cond) cond->notifyAll();
+	const uintptr_t me = currentOwnerId();
+	uintptr_t w = lockword.load(std::memory_order_acquire);
+	if ((w & INFLATED) == 0) {
+		if (w == 0 || (w & OWNER_MASK) != me)
+			throw IllegalMonitorStateException("current thread is not owner");
+		return ;
+	}
+	Monitor *m = ownedMonitor(*this, lockword);
+	if (m->waiters == 0) return ;
+	m->seq.fetch_add(1, std::memory_order_release);
+	util::concurrent::Futex::wakeAll(m->seq);
+	m->fiberWaiters.wakeAll();
 }
 void Object::wait(long timeout) {
 	if (timeout < 0) throw IllegalArgumentException("timeout value is negative");
-	if (cond == null) cond = new CondMonitor(this);
-	cond->wait(timeout);
+	Monitor *m = ownedMonitor(*this, lockword);
+	const uintptr_t me = m->owner.load(std::memory_order_relaxed);
+	unsigned depth = m->count;
+	int seq = m->seq.load(std::memory_order_relaxed);
+	++m->waiters;
+	m->count = 0;
+	m->owner.store(0, std::memory_order_relaxed);
+	m->unlock();
+	++waits;
+	if (Fiber::current() != null) m->fiberWaiters.wait(m->seq, seq, timeout > 0 ? (jlong)timeout * 1000000 : -1);
+	else util::concurrent::Futex::wait(m->seq, seq, timeout > 0 ? (jlong)timeout * 1000000 : -1);
+	m->lock();
+	m->owner.store(me, std::memory_order_relaxed);
+	m->count = depth;
+	--m->waiters;
 }
 
 void Object::wait(long timeout, int nanos) {
@@ -351,15 +749,20 @@ void Object::wait(long timeout, int nanos) {
 	wait(timeout);
 }
 
-void AbstractArray::registerArrayClass(const std::type_info& type) {
-	ArrayList<Class*>& cm = classmap();
-	synchronized(cm) {
-		Class *c = Object::findClass(type);
-		if (!c) Object::registerClass(new ArrayClass(type));
-	}
+const Class& AbstractArray::registerArrayClass(const std::type_info& type) {
+	return *lookupOrRegister(type, [](const std::type_info& t) -> Class* { return new ArrayClass(t); });
 }
 void AbstractArray::checkArrayBounds(int i, int l) {
 	if (i < 0 || i >= l) throw IndexOutOfBoundsException(i);
 }
+void AbstractArray::checkArrayCopy(int srcPos, int srcLength, int destPos, int destLength, int length) {
+	if (srcPos < 0 || destPos < 0 || length < 0 || srcPos > srcLength - length || destPos > destLength - length)
+		throw IndexOutOfBoundsException("arraycopy: last source index " + String::valueOf(srcPos + length) +
+				" out of bounds for length " + String::valueOf(srcLength) + ", last destination index " +
+				String::valueOf(destPos + length) + " out of bounds for length " + String::valueOf(destLength));
+}
+void AbstractArray::checkArrayStore(const AbstractArray *dest) {
+	if (dest == null) throw ArrayStoreException("arraycopy: type mismatch");
+}
 
 } //namespace lang
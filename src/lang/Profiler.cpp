@@ -0,0 +1,441 @@
+#include <lang/Profiler.hpp>
+#include <lang/Exception.hpp>
+#include <io/IOException.hpp>
+#include <util/concurrent/Futex.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// the recording path must not call instrumented code, not even inline std members
+#define NO_INSTRUMENT __attribute__((no_instrument_function))
+
+using util::concurrent::Futex;
+
+namespace {
+const unsigned long RING_EVENTS = 1 << 15;  // per thread, a power of 2
+const jlong LEAVE = 1ll << 62;              // set in the time of an exit event
+const int NAME_SIZE = 16;
+
+struct Event {
+	jlong time;       // now()
+	const void *fn;
+};
+// as written to the events file
+struct FileEvent {
+	uint32_t thread;  // index of the ring
+	uint32_t pad;
+	jlong time;
+	const void *fn;
+};
+
+// single producer (the owning thread), single consumer (the writer);
+// the counters are accessed with __atomic builtins
+struct Ring {
+	unsigned long head = 0;
+	char pad1[64];
+	unsigned long tail = 0;
+	char pad2[64];
+	unsigned long dropped = 0;
+	boolean closed = false;
+	uint32_t index = 0;
+	long tid = 0;
+	char name[NAME_SIZE];
+	Event events[RING_EVENTS];
+};
+
+std::mutex registryLock;                    // guards rings
+std::vector<Ring*> rings;
+std::mutex controlLock;                     // guards start and stop
+std::mutex drainLock;
+
+boolean recording = false;
+uintptr_t rangeBegin = 0;
+uintptr_t rangeSize = ~(uintptr_t)0;
+std::vector<std::string> prefixes;
+
+__attribute__((tls_model("initial-exec"))) thread_local Ring *ring = null;
+// set while the profiler itself runs on the thread, its calls are not recorded
+__attribute__((tls_model("initial-exec"))) thread_local boolean busy = false;
+
+// marks the ring closed when the thread ends
+struct RingCloser {
+	~RingCloser() {
+		if (ring != null) __atomic_store_n(&ring->closed, true, __ATOMIC_RELEASE);
+		ring = null;
+		busy = true;
+	}
+};
+thread_local RingCloser closer;
+
+Ring *newRing() {
+	Ring *r = new Ring();
+	r->tid = (long)::syscall(SYS_gettid);
+	if (r->tid == (long)::getpid()) std::strcpy(r->name, "main");
+	else if (pthread_getname_np(pthread_self(), r->name, NAME_SIZE) != 0) r->name[0] = 0;
+	(void)&closer;
+	std::lock_guard<std::mutex> lock(registryLock);
+	r->index = (uint32_t)rings.size();
+	rings.push_back(r);
+	return r;
+}
+
+jlong monotonicNanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (jlong)ts.tv_sec * 1000000000ll + ts.tv_nsec;
+}
+// event time: the time stamp counter where there is one, mapped to ns by the report
+NO_INSTRUMENT inline jlong now() {
+#if defined(__x86_64__) || defined(__i386__)
+	return (jlong)__rdtsc();
+#else
+	return monotonicNanos();
+#endif
+}
+
+NO_INSTRUMENT inline void record(const void *fn, jlong kind) {
+	if (busy || !__atomic_load_n(&recording, __ATOMIC_RELAXED)) return;
+	if ((uintptr_t)fn - __atomic_load_n(&rangeBegin, __ATOMIC_RELAXED) >= __atomic_load_n(&rangeSize, __ATOMIC_RELAXED)) return;
+	busy = true;
+	Ring *r = ring;
+	if (r == null) r = ring = newRing();
+	unsigned long h = r->head;
+	if (h - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE) == RING_EVENTS) {
+		__atomic_store_n(&r->dropped, r->dropped + 1, __ATOMIC_RELAXED);
+	}
+	else {
+		Event& e = r->events[h & (RING_EVENTS - 1)];
+		e.time = now() | kind;
+		e.fn = fn;
+		__atomic_store_n(&r->head, h + 1, __ATOMIC_RELEASE);
+	}
+	busy = false;
+}
+
+// the writer appends the events of all rings to the file every 10ms
+int eventsFd = -1;
+jlong startTicks = 0, startNanos = 0;    // now() and monotonicNanos() at start and stop
+jlong stopTicks = 0, stopNanos = 0;
+std::string basePath;
+std::atomic<boolean> running{false};
+std::atomic<int> wakeups{0};
+std::thread *writer = null;
+
+void writeFully(const char *p, size_t n) {
+	while (n > 0) {
+		ssize_t w = ::write(eventsFd, p, n);
+		if (w < 0 && errno == EINTR) continue;
+		if (w <= 0) return;
+		p += w; n -= (size_t)w;
+	}
+}
+
+void drain() {
+	std::lock_guard<std::mutex> lock(drainLock);
+	std::vector<Ring*> rs;
+	{
+		std::lock_guard<std::mutex> lock(registryLock);
+		rs = rings;
+	}
+	static FileEvent batch[4096];
+	size_t n = 0;
+	for (Ring *r : rs) {
+		unsigned long h = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+		unsigned long t = r->tail;
+		for (; t != h; ++t) {
+			const Event& e = r->events[t & (RING_EVENTS - 1)];
+			batch[n++] = {r->index, 0, e.time, e.fn};
+			if (n == sizeof(batch)/sizeof(batch[0])) {
+				writeFully((const char *)batch, n * sizeof(FileEvent));
+				n = 0;
+			}
+		}
+		__atomic_store_n(&r->tail, t, __ATOMIC_RELEASE);
+	}
+	writeFully((const char *)batch, n * sizeof(FileEvent));
+}
+
+void writerLoop() {
+	busy = true;
+	while (running.load(std::memory_order_acquire)) {
+		int w = wakeups.load(std::memory_order_acquire);
+		drain();
+		Futex::wait(wakeups, w, 10000000);
+	}
+}
+
+// report
+
+struct Function {
+	std::string name;
+	boolean kept = false;
+	jlong calls = 0, inclusive = 0, exclusive = 0;
+	int active = 0;   // activations on the stack, recursive calls add to inclusive once
+};
+struct Frame {
+	const void *fn;
+	Function *f;
+	jlong start;
+	jlong children;
+};
+struct ThreadState {
+	std::vector<Frame> stack;
+	jlong last = 0;
+};
+
+class Report {
+	std::unordered_map<const void*, Function> functions;
+	std::vector<ThreadState> threads;
+	std::vector<Ring*> rs;
+	FILE *json;
+	int pid;
+	jlong events = 0;
+
+	Function& lookup(const void *fn) {
+		auto i = functions.find(fn);
+		if (i != functions.end()) return i->second;
+		Function& f = functions[fn];
+		f.name = StackTraceElement::functionName(fn).cstr();
+		if (f.name == "??") {
+			char buf[32];
+			snprintf(buf, sizeof(buf), "%p", fn);
+			f.name = buf;
+		}
+		f.kept = prefixes.empty();
+		for (const std::string& p : prefixes) {
+			if (f.name.compare(0, p.size(), p) == 0) f.kept = true;
+		}
+		return f;
+	}
+	void escaped(const std::string& s) {
+		for (char c : s) {
+			if (c == '"' || c == '\\') { fputc('\\', json); fputc(c, json); }
+			else if ((unsigned char)c < 0x20) fprintf(json, "\\u%04x", c);
+			else fputc(c, json);
+		}
+	}
+	// ns since start
+	jlong nanos(jlong ticks) const {
+		if (stopTicks == startTicks) return 0;
+		return (jlong)((double)(ticks - startTicks) * (double)(stopNanos - startNanos) / (double)(stopTicks - startTicks));
+	}
+	void traceEvent(const Function& f, char phase, uint32_t thread, jlong time) {
+		fprintf(json, events++ == 0 ? "\n" : ",\n");
+		fputs("{\"name\":\"", json);
+		escaped(f.name);
+		fprintf(json, "\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%ld}", phase, (double)time / 1000.0, pid, rs[thread]->tid);
+	}
+	void pop(uint32_t thread, jlong time) {
+		std::vector<Frame>& stack = threads[thread].stack;
+		Frame fr = stack.back();
+		stack.pop_back();
+		jlong inclusive = time - fr.start;
+		Function& f = *fr.f;
+		++f.calls;
+		f.exclusive += inclusive - fr.children;
+		if (--f.active == 0) f.inclusive += inclusive;
+		if (!stack.empty()) stack.back().children += inclusive;
+		traceEvent(f, 'E', thread, time);
+	}
+	void replay(const FileEvent& e) {
+		if (e.thread >= threads.size()) return;
+		jlong time = nanos(e.time & ~LEAVE);
+		ThreadState& ts = threads[e.thread];
+		ts.last = time;
+		Function& f = lookup(e.fn);
+		if (!f.kept) return;
+		if ((e.time & LEAVE) == 0) {
+			ts.stack.push_back({e.fn, &f, time, 0});
+			++f.active;
+			traceEvent(f, 'B', e.thread, time);
+			return;
+		}
+		// exits without their entry (recording started inside) are ignored,
+		// callees that missed their exit end with the caller
+		size_t i = ts.stack.size();
+		while (i > 0 && ts.stack[i-1].fn != e.fn) --i;
+		if (i == 0) return;
+		while (ts.stack.size() >= i) pop(e.thread, time);
+	}
+
+public:
+	void write(int fd, const std::string& path) {
+		{
+			std::lock_guard<std::mutex> lock(registryLock);
+			rs = rings;
+		}
+		threads.resize(rs.size());
+		pid = (int)::getpid();
+		json = std::fopen((path + ".json").c_str(), "w");
+		if (json == null) throw io::IOException(String(path.c_str()) + ".json: " + std::strerror(errno));
+		fputs("{\"traceEvents\":[", json);
+		for (Ring *r : rs) {
+			fprintf(json, events++ == 0 ? "\n" : ",\n");
+			fprintf(json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%ld,\"args\":{\"name\":\"", pid, r->tid);
+			escaped(r->name);
+			fputs("\"}}", json);
+		}
+		static FileEvent batch[4096];
+		::lseek(fd, 0, SEEK_SET);
+		for (ssize_t n; (n = ::read(fd, batch, sizeof(batch))) > 0; ) {
+			for (ssize_t i = 0; i < n / (ssize_t)sizeof(FileEvent); ++i) replay(batch[i]);
+		}
+		for (uint32_t t = 0; t < threads.size(); ++t) {
+			while (!threads[t].stack.empty()) pop(t, threads[t].last);
+		}
+		fputs("\n],\"displayTimeUnit\":\"ns\"}\n", json);
+		boolean failed = std::ferror(json) != 0;
+		if (std::fclose(json) != 0 || failed) throw io::IOException(String(path.c_str()) + ".json: write failed");
+
+		std::vector<const Function*> sorted;
+		for (auto& i : functions) {
+			if (i.second.calls > 0) sorted.push_back(&i.second);
+		}
+		std::sort(sorted.begin(), sorted.end(), [](const Function *a, const Function *b) { return a->exclusive > b->exclusive; });
+		FILE *txt = std::fopen((path + ".txt").c_str(), "w");
+		if (txt == null) throw io::IOException(String(path.c_str()) + ".txt: " + std::strerror(errno));
+		jlong dropped = 0;
+		for (Ring *r : rs) dropped += (jlong)__atomic_load_n(&r->dropped, __ATOMIC_RELAXED);
+		fprintf(txt, "# %zu functions, %zu threads, %lld events dropped\n", sorted.size(), rs.size(), dropped);
+		fprintf(txt, "%10s %14s %14s  %s\n", "calls", "inclusive ms", "exclusive ms", "function");
+		for (const Function *f : sorted) {
+			fprintf(txt, "%10lld %14.3f %14.3f  %s\n", f->calls, (double)f->inclusive / 1e6, (double)f->exclusive / 1e6, f->name.c_str());
+		}
+		failed = std::ferror(txt) != 0;
+		if (std::fclose(txt) != 0 || failed) throw io::IOException(String(path.c_str()) + ".txt: write failed");
+	}
+};
+
+// rings of finished threads are freed once drained, the others are numbered again
+void reclaim() {
+	std::lock_guard<std::mutex> lock(registryLock);
+	std::vector<Ring*> live;
+	for (Ring *r : rings) {
+		if (__atomic_load_n(&r->closed, __ATOMIC_ACQUIRE) && r->tail == __atomic_load_n(&r->head, __ATOMIC_ACQUIRE)) delete r;
+		else {
+			r->index = (uint32_t)live.size();
+			live.push_back(r);
+		}
+	}
+	rings.swap(live);
+}
+}
+
+namespace lang {
+
+NO_INSTRUMENT void Profiler::enter(const void *fn) {
+	record(fn, 0);
+}
+NO_INSTRUMENT void Profiler::leave(const void *fn) {
+	record(fn, LEAVE);
+}
+
+void Profiler::setAddressRange(const void *begin, const void *end) {
+	uintptr_t b = (uintptr_t)begin, e = (uintptr_t)end;
+	__atomic_store_n(&rangeBegin, b, __ATOMIC_RELAXED);
+	__atomic_store_n(&rangeSize, b == e ? ~(uintptr_t)0 : e - b, __ATOMIC_RELAXED);
+}
+void Profiler::addSymbolPrefix(const String& prefix) {
+	std::lock_guard<std::mutex> lock(controlLock);
+	prefixes.push_back(prefix.cstr());
+}
+void Profiler::clearSymbolPrefixes() {
+	std::lock_guard<std::mutex> lock(controlLock);
+	prefixes.clear();
+}
+boolean Profiler::isRecording() {
+	return __atomic_load_n(&recording, __ATOMIC_RELAXED);
+}
+jlong Profiler::getDropped() {
+	std::lock_guard<std::mutex> lock(registryLock);
+	jlong n = 0;
+	for (Ring *r : rings) n += (jlong)__atomic_load_n(&r->dropped, __ATOMIC_RELAXED);
+	return n;
+}
+
+void Profiler::start(const String& path) {
+	std::lock_guard<std::mutex> lock(controlLock);
+	if (isRecording()) throw IllegalStateException("profiler is recording");
+	busy = true;
+	std::string p = path.cstr();
+	int fd = ::open((p + ".events").c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		busy = false;
+		throw io::IOException(path + ".events: " + std::strerror(errno));
+	}
+	{
+		std::lock_guard<std::mutex> lock(registryLock);
+		for (Ring *r : rings) {
+			__atomic_store_n(&r->tail, __atomic_load_n(&r->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+			__atomic_store_n(&r->dropped, 0ul, __ATOMIC_RELAXED);
+		}
+	}
+	eventsFd = fd;
+	basePath = p;
+	startNanos = monotonicNanos();
+	startTicks = now();
+	running.store(true, std::memory_order_release);
+	writer = new std::thread(writerLoop);
+	__atomic_store_n(&recording, true, __ATOMIC_RELEASE);
+	busy = false;
+}
+
+void Profiler::stop() {
+	std::lock_guard<std::mutex> lock(controlLock);
+	if (!isRecording()) return;
+	busy = true;
+	__atomic_store_n(&recording, false, __ATOMIC_RELEASE);
+	stopTicks = now();
+	stopNanos = monotonicNanos();
+	running.store(false, std::memory_order_release);
+	wakeups.fetch_add(1, std::memory_order_release);
+	Futex::wake(wakeups, 1);
+	writer->join();
+	delete writer;
+	writer = null;
+	drain();
+	try {
+		Report().write(eventsFd, basePath);
+	}
+	catch (...) {
+		::close(eventsFd);
+		busy = false;
+		throw;
+	}
+	::close(eventsFd);
+	::unlink((basePath + ".events").c_str());
+	eventsFd = -1;
+	reclaim();
+	busy = false;
+}
+
+}
+
+#ifdef INSTRUMENTATION
+/*
+ * Instrumentation
+ * compile with gcc '-finstrument-functions' flag
+ */
+extern "C" {
+NO_INSTRUMENT void __cyg_profile_func_enter(void *this_fn, void *call_site) {
+	lang::Profiler::enter(this_fn);
+}
+NO_INSTRUMENT void __cyg_profile_func_exit(void *this_fn, void *call_site) {
+	lang::Profiler::leave(this_fn);
+}
+}
+#endif
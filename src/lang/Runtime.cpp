@@ -1,6 +1,23 @@
+#include <lang/Affinity.hpp>
+#include <lang/Number.hpp>
 #include <lang/Process.hpp>
 #include <lang/Runtime.hpp>
+#include <io/PrintStream.hpp>
+#include <util/concurrent/Futex.hpp>
+#include <cerrno>
+#include <csignal>
+#include <map>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
+#include <execinfo.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+using util::concurrent::Futex;
 
 namespace {
 const int MAX_SYSTEM_HOOKS = 10;
@@ -12,6 +29,155 @@ void runHooks() {
 		if (hook != null) hook->run();
 	}
 }
+
+const int MAX_FRAMES = 64;
+const unsigned long SAMPLES = 256;   // per thread, drained every 100ms
+const int SKIP_FRAMES = 2;           // the handler and the signal trampoline
+const int NAME_SIZE = 16;
+
+struct Sample {
+	int depth;
+	void *frames[MAX_FRAMES];
+};
+// single producer (the signal handler on the thread), single consumer (the drain)
+struct SampleRing {
+	std::atomic<unsigned long> head{0};
+	std::atomic<unsigned long> tail{0};
+	std::atomic<long> dropped{0};
+	char name[NAME_SIZE];
+	int idle = 0;                    // drains since the thread finished
+	Sample samples[SAMPLES];
+};
+struct SampledThread {
+	pid_t tid;
+	pthread_t thread;
+	SampleRing *ring;
+	timer_t timer;
+};
+
+std::mutex samplerLock;                      // guards all below, except the handler's view
+std::vector<SampledThread> sampledThreads;   // running
+std::vector<SampleRing*> finishedRings;      // of finished threads, freed once drained
+std::map<std::string, std::map<std::vector<void*>, long>> stacks;  // per thread name
+long finishedDropped = 0;
+long sampleInterval = 0;                     // ns, 0 when not profiling
+std::atomic<boolean> sampling{false};
+std::atomic<int> inHandler{0};
+std::atomic<int> wakeups{0};
+std::thread *drainer = null;
+
+void onSample(int, siginfo_t *si, void *) {
+	inHandler.fetch_add(1);
+	int saved = errno;
+	SampleRing *r = si->si_code == SI_TIMER ? (SampleRing *)si->si_value.sival_ptr : null;
+	if (r != null && sampling.load()) {
+		unsigned long h = r->head.load(std::memory_order_relaxed);
+		if (h - r->tail.load(std::memory_order_acquire) >= SAMPLES) r->dropped.fetch_add(1, std::memory_order_relaxed);
+		else {
+			Sample& s = r->samples[h % SAMPLES];
+			s.depth = ::backtrace(s.frames, MAX_FRAMES);
+			r->head.store(h + 1, std::memory_order_release);
+		}
+	}
+	errno = saved;
+	inHandler.fetch_sub(1);
+}
+
+// must hold samplerLock
+void arm(SampledThread& t) {
+	t.ring = new SampleRing();
+	if (pthread_getname_np(t.thread, t.ring->name, NAME_SIZE) != 0 || t.ring->name[0] == 0)
+		std::snprintf(t.ring->name, NAME_SIZE, "%d", (int)t.tid);
+	clockid_t clock;
+	struct sigevent sev;
+	std::memset(&sev, 0, sizeof(sev));
+	sev.sigev_notify = SIGEV_THREAD_ID;
+	sev._sigev_un._tid = t.tid;
+	sev.sigev_signo = SIGPROF;
+	sev.sigev_value.sival_ptr = t.ring;
+	if (pthread_getcpuclockid(t.thread, &clock) != 0 || timer_create(clock, &sev, &t.timer) != 0) {
+		t.timer = null;
+		return;
+	}
+	struct itimerspec its;
+	its.it_interval.tv_sec = sampleInterval / 1000000000l;
+	its.it_interval.tv_nsec = sampleInterval % 1000000000l;
+	its.it_value = its.it_interval;
+	timer_settime(t.timer, 0, &its, null);
+}
+void disarm(SampledThread& t) {
+	if (t.timer != null) timer_delete(t.timer);
+	t.timer = null;
+}
+
+// must hold samplerLock
+void drainRing(SampleRing *r) {
+	unsigned long h = r->head.load(std::memory_order_acquire);
+	unsigned long i = r->tail.load(std::memory_order_relaxed);
+	if (i == h) return;
+	std::map<std::vector<void*>, long>& folded = stacks[r->name];
+	for (; i != h; ++i) {
+		const Sample& s = r->samples[i % SAMPLES];
+		if (s.depth <= SKIP_FRAMES) continue;
+		++folded[std::vector<void*>(s.frames + SKIP_FRAMES, s.frames + s.depth)];
+	}
+	r->tail.store(h, std::memory_order_release);
+}
+void drainLocked() {
+	for (SampledThread& t : sampledThreads) {
+		if (t.ring != null) drainRing(t.ring);
+	}
+	// a signal sent before the timer was deleted may still come, the ring is kept for a while
+	for (size_t i = 0; i < finishedRings.size(); ) {
+		SampleRing *r = finishedRings[i];
+		drainRing(r);
+		if (++r->idle < 3) { ++i; continue; }
+		finishedDropped += r->dropped.load(std::memory_order_relaxed);
+		delete r;
+		finishedRings[i] = finishedRings.back();
+		finishedRings.pop_back();
+	}
+}
+
+void registerThread() {
+	std::lock_guard<std::mutex> lock(samplerLock);
+	SampledThread t;
+	t.tid = (pid_t)syscall(SYS_gettid);
+	t.thread = pthread_self();
+	t.ring = null;
+	t.timer = null;
+	if (sampleInterval > 0) arm(t);
+	sampledThreads.push_back(t);
+}
+void unregisterThread() {
+	std::lock_guard<std::mutex> lock(samplerLock);
+	pid_t tid = (pid_t)syscall(SYS_gettid);
+	for (size_t i = 0; i < sampledThreads.size(); ++i) {
+		SampledThread& t = sampledThreads[i];
+		if (t.tid != tid) continue;
+		disarm(t);
+		if (t.ring != null) finishedRings.push_back(t.ring);
+		sampledThreads[i] = sampledThreads.back();
+		sampledThreads.pop_back();
+		break;
+	}
+}
+
+void drainLoop() {
+	while (sampling.load(std::memory_order_acquire)) {
+		// stopProfiling bumps the word, which is not reset between sessions
+		int w = wakeups.load(std::memory_order_acquire);
+		if (!sampling.load(std::memory_order_acquire)) break;
+		Futex::wait(wakeups, w, 100000000l);
+		std::lock_guard<std::mutex> lock(samplerLock);
+		drainLocked();
+	}
+}
+
+// static initialization runs on the main thread
+struct MainThreadSampling {
+	MainThreadSampling() { registerThread(); }
+} mainThreadSampling;
 }
 
 namespace lang {
@@ -26,7 +192,112 @@ void Shutdown::halt(int status) {
 
 Runtime Runtime::currentRuntime;
 int Runtime::availableProcessors() {
-	return (int)std::thread::hardware_concurrency();
+	// the CPUs of the affinity mask, as taskset or a cpuset limits them
+	return CpuSet::online().cardinality();
+}
+
+void Runtime::threadStarted() {
+	registerThread();
+}
+void Runtime::threadFinished() {
+	unregisterThread();
+}
+
+void Runtime::startProfiling(int frequency) {
+	if (frequency <= 0) throw IllegalArgumentException("frequency " + String::valueOf(frequency));
+	std::lock_guard<std::mutex> lock(samplerLock);
+	if (sampleInterval > 0) throw IllegalStateException("already profiling");
+	// backtrace loads libgcc on first use, which is not safe in the handler
+	void *warmup[1];
+	::backtrace(warmup, 1);
+	struct sigaction sa;
+	std::memset(&sa, 0, sizeof(sa));
+	sa.sa_sigaction = onSample;
+	sa.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGPROF, &sa, null);
+
+	stacks.clear();
+	finishedDropped = 0;
+	sampleInterval = 1000000000l / frequency;
+	sampling.store(true, std::memory_order_release);
+	for (SampledThread& t : sampledThreads) arm(t);
+	drainer = new std::thread(drainLoop);
+}
+void Runtime::stopProfiling() {
+	std::thread *d;
+	{
+		std::lock_guard<std::mutex> lock(samplerLock);
+		if (sampleInterval == 0) return;
+		sampling.store(false);
+		sampleInterval = 0;
+		for (SampledThread& t : sampledThreads) disarm(t);
+		d = drainer;
+		drainer = null;
+	}
+	wakeups.fetch_add(1);
+	Futex::wakeAll(wakeups);
+	d->join();
+	delete d;
+
+	std::lock_guard<std::mutex> lock(samplerLock);
+	// pending signals find sampling off, let the running handlers leave the rings
+	signal(SIGPROF, SIG_IGN);
+	while (inHandler.load() != 0) std::this_thread::yield();
+	drainLocked();
+	for (SampledThread& t : sampledThreads) {
+		if (t.ring == null) continue;
+		finishedDropped += t.ring->dropped.load(std::memory_order_relaxed);
+		delete t.ring;
+		t.ring = null;
+	}
+	for (SampleRing *r : finishedRings) {
+		finishedDropped += r->dropped.load(std::memory_order_relaxed);
+		delete r;
+	}
+	finishedRings.clear();
+}
+boolean Runtime::isProfiling() {
+	return sampling.load(std::memory_order_acquire);
+}
+void Runtime::dumpProfile(io::PrintStream& out) {
+	std::map<std::string, std::map<std::vector<void*>, long>> folded;
+	{
+		std::lock_guard<std::mutex> lock(samplerLock);
+		drainLocked();
+		folded = stacks;
+	}
+	// stacks differing only in return addresses within the same functions fold together
+	std::unordered_map<void*, String> names;
+	std::map<std::string, long> lines;
+	for (const auto& thr : folded) {
+		for (const auto& st : thr.second) {
+			StringBuilder line(thr.first.c_str());
+			for (auto f = st.first.rbegin(); f != st.first.rend(); ++f) {
+				auto it = names.find(*f);
+				if (it == names.end()) {
+					// return addresses point past the call
+					String n = StackTraceElement::functionName((const char *)*f - 1);
+					if (n.equals("??")) n = "0x" + Long::toHexString((long)*f);
+					it = names.emplace(*f, n).first;
+				}
+				line.append(";").append(it->second);
+			}
+			lines[line.toString().cstr()] += st.second;
+		}
+	}
+	for (const auto& l : lines) {
+		out.println(String(l.first.c_str()) + " " + String::valueOf(l.second));
+	}
+}
+jlong Runtime::getProfileDropped() {
+	std::lock_guard<std::mutex> lock(samplerLock);
+	jlong n = finishedDropped;
+	for (SampledThread& t : sampledThreads) {
+		if (t.ring != null) n += t.ring->dropped.load(std::memory_order_relaxed);
+	}
+	for (SampleRing *r : finishedRings) n += r->dropped.load(std::memory_order_relaxed);
+	return n;
 }
 
 Process& ProcessBuilder::start() {
@@ -1,5 +1,6 @@
 #include <lang/Class.hpp>
 #include <lang/Exception.hpp>
+#include <lang/FloatingDecimal.hpp>
 #include <lang/Number.hpp>
 #include <lang/System.hpp>
 
@@ -13,69 +14,425 @@ Locale Locale::getDefault() {
 	return defaultLocale;
 }
 
-const char *String::emptystr="";
+String::Buffer *String::allocate(int capacity) {
+	Buffer *b = (Buffer *)::operator new(sizeof(Buffer) + (size_t)capacity);
+	b->refs.store(1, std::memory_order_relaxed);
+	b->hash.store(0, std::memory_order_relaxed);
+	b->length = 0;
+	b->capacity = capacity;
+	return b;
+}
+void String::release(Buffer *b) {
+	if (b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) ::operator delete(b);
+}
+String::String(Buffer *b, int n) {
+	hash = 0;
+	if (n <= SSO_MAX) {
+		assign(b->data, n);
+		release(b);
+		return ;
+	}
+	buf = b;
+	ptr = b->data;
+	len = n;
+	zbuf.store(null, std::memory_order_relaxed);
+}
+void String::nullPointer() {
+	throw NullPointerException();
+}
 
-void String::copystr(String *d, const char *s) {TRACE;
-	if (s == null || d == null) throw NullPointerException();
-	d->value = s;
-	d->hash = 0;
+void String::assign(const char *s, int n) {
+	hash = 0;
+	len = n;
+	if (n <= SSO_MAX) {
+		buf = null;
+		if (n > 0) std::memcpy(sso, s, (size_t)n);
+		sso[n] = 0;
+		ptr = sso;
+		return ;
+	}
+	buf = allocate(n);
+	std::memcpy(buf->data, s, (size_t)n);
+	buf->data[n] = 0;
+	buf->length = n;
+	ptr = buf->data;
+	zbuf.store(null, std::memory_order_relaxed);
 }
-void String::copy(String *d, const String *s) {TRACE;
-	if (s == null || d == null) throw NullPointerException();
-	d->value = s->value;
-	d->hash = s->hash;
+void String::shareBuffer(const String& o, int offset, int n) {
+	hash = 0;
+	o.buf->refs.fetch_add(1, std::memory_order_relaxed);
+	buf = o.buf;
+	ptr = o.ptr + offset;
+	len = n;
+	zbuf.store(null, std::memory_order_relaxed);
 }
-void String::move(String *d, const String *s) {TRACE;
-	if (s == null || d == null) throw NullPointerException();
-	if (s->intern().empty()) d->value=emptystr;
-	else d->value = std::move(s->value);
-	d->hash = s->hash;
+// this must be unset (constructed or cleared)
+void String::move(String& o) {
+	hash = o.hash;
+	len = o.len;
+	buf = o.buf;
+	if (buf == null) {
+		std::memcpy(sso, o.sso, (size_t)len + 1);
+		ptr = sso;
+	}
+	else {
+		ptr = o.ptr;
+		zbuf.store(o.zbuf.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+	o.assign(null, 0);
+}
+String String::concat(const char *a, int alen, const char *b, int blen) {
+	String r;
+	int n = alen + blen;
+	if (n <= SSO_MAX) {
+		std::memcpy(r.sso, a, (size_t)alen);
+		std::memcpy(r.sso + alen, b, (size_t)blen);
+		r.sso[n] = 0;
+		r.len = n;
+		return r;
+	}
+	Buffer *buf = allocate(n);
+	std::memcpy(buf->data, a, (size_t)alen);
+	std::memcpy(buf->data + alen, b, (size_t)blen);
+	buf->data[n] = 0;
+	buf->length = n;
+	r.buf = buf;
+	r.ptr = buf->data;
+	r.len = n;
+	r.zbuf.store(null, std::memory_order_relaxed);
+	return r;
+}
+// in place when this is the only user of a buffer with room left, otherwise grows by half
+void String::append(const char *s, int n) {
+	if (n == 0) return ;
+	hash = 0;
+	if (buf != null && buf->refs.load(std::memory_order_acquire) == 1 &&
+			ptr + len == buf->data + buf->length && buf->length + n <= buf->capacity) {
+		std::memcpy(buf->data + buf->length, s, (size_t)n);
+		buf->length += n;
+		buf->data[buf->length] = 0;
+		buf->hash.store(0, std::memory_order_relaxed);
+		len += n;
+		return ;
+	}
+	int total = len + n;
+	if (total <= SSO_MAX) {
+		// only inline strings are this short
+		std::memcpy(sso + len, s, (size_t)n);
+		sso[total] = 0;
+		len = total;
+		return ;
+	}
+	Buffer *b = allocate(total + total / 2);
+	std::memcpy(b->data, ptr, (size_t)len);
+	std::memcpy(b->data + len, s, (size_t)n);
+	b->data[total] = 0;
+	b->length = total;
+	clear();
+	buf = b;
+	ptr = b->data;
+	len = total;
+	zbuf.store(null, std::memory_order_relaxed);
+}
+const char *String::terminated() const {
+	Buffer *z = zbuf.load(std::memory_order_acquire);
+	if (z == null) {
+		Buffer *n = allocate(len);
+		std::memcpy(n->data, ptr, (size_t)len);
+		n->data[len] = 0;
+		n->length = len;
+		if (zbuf.compare_exchange_strong(z, n, std::memory_order_acq_rel)) z = n;
+		else release(n);
+	}
+	return z->data;
 }
 
 void String::init(const byte* value, int vlen, int offset, int count) {
 	if (offset < 0) throw IndexOutOfBoundsException(offset);
 	if (count < 0) throw IndexOutOfBoundsException(count);
 	if (vlen - count < offset) throw IndexOutOfBoundsException(offset + count);
-	this->value = std::string((const char *)value, (unsigned)offset, (unsigned)count);
+	assign((const char *)value + offset, count);
 }
 String::String(const Array<char>& value, int offset, int count) {TRACE;
-	if (value == null || this == null) throw NullPointerException();
-	init((const byte*)&value[0], value.length, offset, count);
+	if (value == null) throw NullPointerException();
+	init(value.length > 0 ? (const byte*)&value[0] : null, value.length, offset, count);
 }
 String::String(const Array<byte>& value, int offset, int count) {TRACE;
-	if (value == null || this == null) throw NullPointerException();
-	init(&value[0], value.length, offset, count);
+	if (value == null) throw NullPointerException();
+	init(value.length > 0 ? &value[0] : null, value.length, offset, count);
 }
 
 char String::charAt(int index) const {TRACE;
 	if ((index < 0) || (index >= length())) {
 		throw IndexOutOfBoundsException(index);
 	}
-	return value[(unsigned)index];
+	return ptr[index];
 }
 
 void String::getChars(int srcBegin, int srcEnd, char *dst, int dstBegin) const {
 	if (srcBegin < 0) throw IndexOutOfBoundsException(srcBegin);
-	if ((unsigned)srcEnd > value.length()) throw IndexOutOfBoundsException(srcEnd);
+	if (srcEnd > len) throw IndexOutOfBoundsException(srcEnd);
 	if (srcBegin > srcEnd) throw IndexOutOfBoundsException(srcEnd - srcBegin);
-	memcpy(dst + dstBegin, value.c_str() + srcBegin, srcEnd - srcBegin);
+	std::memcpy(dst + dstBegin, ptr + srcBegin, (size_t)(srcEnd - srcBegin));
+}
+
+int String::indexOf(const String& str, int fromIndex) const {
+	if (fromIndex < 0) fromIndex = 0;
+	if (fromIndex > len) fromIndex = len;
+	// as Java: the empty string is found at fromIndex, clamped to the length
+	if (str.len == 0) return fromIndex;
+	int i = StringKernels::indexOf(ptr + fromIndex, len - fromIndex, str.ptr, str.len);
+	return i < 0 ? i : fromIndex + i;
+}
+int String::lastIndexOf(const String& str, int fromIndex) const {
+	int i = len - str.len;
+	if (fromIndex >= 0 && fromIndex < i) i = fromIndex;
+	for (; i >= 0; --i) {
+		if (std::memcmp(ptr + i, str.ptr, (size_t)str.len) == 0) return i;
+	}
+	return -1;
+}
+
+void String::outOfBounds(int beginIndex, int endIndex) {
+	if (beginIndex < 0) throw StringIndexOutOfBoundsException(beginIndex);
+	if (beginIndex > endIndex) throw StringIndexOutOfBoundsException(endIndex - beginIndex);
+	throw StringIndexOutOfBoundsException(endIndex);
+}
+
+String String::replace(char oldChar, char newChar) const {
+	if (oldChar == newChar) return *this;
+	int i = indexOf(oldChar);
+	if (i < 0) return *this;
+	String r(ptr, len);
+	char *d = const_cast<char *>(r.ptr);
+	for (; i < len; ++i) {
+		if (d[i] == oldChar) d[i] = newChar;
+	}
+	return r;
+}
+String String::toLowerCase(Locale locale) const {
+	int i = 0;
+	while (i < len && ptr[i] == (char)::tolower(ptr[i])) ++i;
+	if (i == len) return *this;
+	String r(ptr, len);
+	char *d = const_cast<char *>(r.ptr);
+	for (; i < len; ++i) d[i] = (char)::tolower(d[i]);
+	return r;
+}
+String String::toUpperCase(Locale locale) const {
+	int i = 0;
+	while (i < len && ptr[i] == (char)::toupper(ptr[i])) ++i;
+	if (i == len) return *this;
+	String r(ptr, len);
+	char *d = const_cast<char *>(r.ptr);
+	for (; i < len; ++i) d[i] = (char)::toupper(d[i]);
+	return r;
 }
 
 String String::valueHex(long l) {TRACE; return Long::toHexString(l); }
+String String::valueOf(long n) {
+	char buf[Long::MAX_CHARS];
+	return String(buf, Long::toChars(n, buf));
+}
+String String::valueOf(unsigned long n) {
+	char buf[Long::MAX_CHARS];
+	return String(buf, Long::toUnsignedChars(n, buf));
+}
+String String::valueOf(float n) { return Float::toString(n); }
+String String::valueOf(double n) { return Double::toString(n); }
 
 String String::format(const char *fmt, va_list& args) {TRACE;
-	char buffer[1023];
-	String s;
-	if ((unsigned)vsnprintf(buffer,sizeof(buffer),fmt,args) > sizeof(buffer))
-		strcpy(buffer+1023-5,"...");
-	s = buffer;
-	//FILE *stream;
-	//vfprintf(stream, fmt, args);
-	return s;
+	StringBuilder sb((int)std::strlen(fmt) + 64);
+	sb.appendFormat(fmt, args);
+	return sb.toString();
 }
 
 String String::className(const std::type_info& type) {
 	return class(type).getName();
 }
 
+void StringBuilder::grow(int minCapacity) {
+	int capacity = buf->capacity * 2 + 2;
+	if (capacity < minCapacity) capacity = minCapacity;
+	String::Buffer *b = String::allocate(capacity);
+	std::memcpy(b->data, buf->data, (size_t)len);
+	String::release(buf);
+	buf = b;
+}
+// a String returned by toString() still uses the buffer
+void StringBuilder::unshare(int keep) {
+	String::Buffer *b = String::allocate(buf->capacity);
+	std::memcpy(b->data, buf->data, (size_t)keep);
+	String::release(buf);
+	buf = b;
+}
+StringBuilder& StringBuilder::appendSigned(jlong v) {
+	len += Long::toChars((long)v, reserve(Long::MAX_CHARS));
+	return *this;
+}
+StringBuilder& StringBuilder::appendUnsigned(unsigned long long v) {
+	len += Long::toUnsignedChars((unsigned long)v, reserve(Long::MAX_CHARS));
+	return *this;
+}
+// same text as String::valueOf
+StringBuilder& StringBuilder::appendFloat(float v) {
+	len += FloatingDecimal::toChars(v, reserve(FloatingDecimal::MAX_CHARS));
+	return *this;
+}
+StringBuilder& StringBuilder::appendDouble(double v) {
+	len += FloatingDecimal::toChars(v, reserve(FloatingDecimal::MAX_CHARS));
+	return *this;
+}
+void StringBuilder::setLength(int newLength) {
+	if (newLength < 0) throw StringIndexOutOfBoundsException(newLength);
+	if (newLength > len) std::memset(reserve(newLength - len), 0, (size_t)(newLength - len));
+	else if (buf->refs.load(std::memory_order_acquire) != 1) unshare(newLength);
+	len = newLength;
+}
+char StringBuilder::charAt(int index) const {
+	if (index < 0 || index >= len) throw StringIndexOutOfBoundsException(index);
+	return buf->data[index];
+}
+void StringBuilder::setCharAt(int index, char ch) {
+	if (index < 0 || index >= len) throw StringIndexOutOfBoundsException(index);
+	reserve(0);
+	buf->data[index] = ch;
+}
+StringBuilder& StringBuilder::insert(int offset, const String& str) {
+	if (offset < 0 || offset > len) throw StringIndexOutOfBoundsException(offset);
+	reserve(str.len);
+	std::memmove(buf->data + offset + str.len, buf->data + offset, (size_t)(len - offset));
+	std::memcpy(buf->data + offset, str.ptr, (size_t)str.len);
+	len += str.len;
+	return *this;
+}
+StringBuilder& StringBuilder::reverse() {
+	reserve(0);
+	std::reverse(buf->data, buf->data + len);
+	return *this;
+}
+StringBuilder& StringBuilder::appendFormat(const char *fmt, va_list& args) {
+	va_list copy;
+	va_copy(copy, args);
+	int room = buf->capacity - len;
+	int n = std::vsnprintf(reserve(0), (size_t)room + 1, fmt, copy);
+	va_end(copy);
+	if (n > room) n = std::vsnprintf(reserve(n), (size_t)n + 1, fmt, args);
+	if (n > 0) len += n;
+	return *this;
+}
+
+const char *StringBuilder::nextConversion(const char *fmt, char *spec, char& conv) {
+	const char *p = fmt;
+	for (;;) {
+		const char *pc = std::strchr(p, '%');
+		if (pc == null) {
+			appendChars(fmt, (int)std::strlen(fmt));
+			throw IllegalFormatException("too many arguments for the format");
+		}
+		if (pc[1] != '%') {
+			appendChars(fmt, (int)(pc - fmt));
+			fmt = pc;
+			break;
+		}
+		appendChars(fmt, (int)(pc - fmt) + 1);
+		fmt = p = pc + 2;
+	}
+	// %[flags][width][.precision][length]conversion
+	int i = 0;
+	spec[i++] = *fmt++;
+	while (std::strchr("-+ #0123456789.", *fmt) != null && *fmt != 0) {
+		if (i >= 24) throw IllegalFormatException("format specifier too long");
+		spec[i++] = *fmt++;
+	}
+	while (std::strchr("hlLqjzt", *fmt) != null && *fmt != 0) ++fmt;
+	conv = *fmt;
+	if (conv == 0 || std::strchr("diouxXcbseEfFgGaAp", conv) == null)
+		throw IllegalFormatException(String("unknown conversion in ") + String(spec, i) + String(fmt, conv == 0 ? 0 : 1));
+	spec[i] = 0;
+	return fmt + 1;
+}
+StringBuilder& StringBuilder::appendFormat(const char *fmt) {
+	for (const char *p; (p = std::strchr(fmt, '%')) != null; fmt = p + 2) {
+		if (p[1] != '%') throw IllegalFormatException("missing argument for " + String(p));
+		appendChars(fmt, (int)(p - fmt) + 1);
+	}
+	return appendChars(fmt, (int)std::strlen(fmt));
+}
+namespace {
+void mismatch(char conv, const char *type) {
+	throw IllegalFormatException(String("%") + conv + " != " + type);
+}
+}
+// formats one value with a full printf spec built from spec, the length modifier and conv
+#define FORMAT_WITH(modifier, value) do { \
+	char f[40]; \
+	size_t sl = std::strlen(spec); \
+	std::memcpy(f, spec, sl); \
+	std::memcpy(f + sl, modifier, sizeof(modifier) - 1); \
+	f[sl + sizeof(modifier) - 1] = conv; \
+	f[sl + sizeof(modifier)] = 0; \
+	int room = buf->capacity - len; \
+	int n = std::snprintf(reserve(0), (size_t)room + 1, f, value); \
+	if (n > room) n = std::snprintf(reserve(n), (size_t)n + 1, f, value); \
+	len += n; \
+} while (0)
+
+void StringBuilder::formatSigned(const char *spec, char conv, long long v) {
+	if (spec[1] == 0 && (conv == 'd' || conv == 'i')) { appendSigned(v); return ; }
+	if (conv == 'c') { char c = (char)v; FORMAT_WITH("", c); return ; }
+	if (std::strchr("diouxX", conv) == null) mismatch(conv, "integer");
+	FORMAT_WITH("ll", v);
+}
+void StringBuilder::formatUnsigned(const char *spec, char conv, unsigned long long v) {
+	if (spec[1] == 0 && conv == 'u') { appendUnsigned(v); return ; }
+	if (conv == 'c') { char c = (char)v; FORMAT_WITH("", c); return ; }
+	if (std::strchr("diouxX", conv) == null) mismatch(conv, "unsigned integer");
+	FORMAT_WITH("ll", v);
+}
+void StringBuilder::formatDouble(const char *spec, char conv, double v) {
+	if (std::strchr("eEfFgGaA", conv) == null) mismatch(conv, "floating point");
+	FORMAT_WITH("", v);
+}
+void StringBuilder::formatBoolean(const char *spec, char conv, boolean v) {
+	if (conv == 'b' || conv == 's') formatString(spec, 's', v ? "true" : "false", v ? 4 : 5);
+	else formatSigned(spec, conv, v ? 1 : 0);
+}
+void StringBuilder::formatString(const char *spec, char conv, const char *v, int n) {
+	if (conv != 's') mismatch(conv, "string");
+	// %[-][width][.precision]s, padded here as v need not be 0 terminated
+	const char *p = spec + 1;
+	boolean left = *p == '-';
+	if (left) ++p;
+	int width = 0, precision = -1;
+	while (*p >= '0' && *p <= '9') width = width * 10 + (*p++ - '0');
+	if (*p == '.') for (precision = 0, ++p; *p >= '0' && *p <= '9'; ) precision = precision * 10 + (*p++ - '0');
+	if (*p != 0) throw IllegalFormatException(String("unsupported flags for %s in ") + spec);
+	if (precision >= 0 && precision < n) n = precision;
+	int pad = width > n ? width - n : 0;
+	char *d = reserve(n + pad);
+	if (!left) { std::memset(d, ' ', (size_t)pad); d += pad; }
+	std::memcpy(d, v, (size_t)n);
+	if (left) std::memset(d + n, ' ', (size_t)pad);
+	len += n + pad;
+}
+void StringBuilder::formatPointer(const char *spec, char conv, const void *v) {
+	if (conv != 'p') mismatch(conv, "pointer");
+	FORMAT_WITH("", v);
+}
+#undef FORMAT_WITH
+
+String StringBuilder::toString() const {
+	if (len <= String::SSO_MAX) return String(buf->data, len);
+	// finalized once, when the buffer becomes shared: a shared buffer is copied
+	// before any modification, so it still holds exactly these len characters
+	if (buf->refs.load(std::memory_order_acquire) == 1) {
+		buf->data[len] = 0;
+		buf->length = len;
+		buf->hash.store(0, std::memory_order_relaxed);
+	}
+	buf->refs.fetch_add(1, std::memory_order_release);
+	return String(buf, len);
+}
+
 } //namespace lang
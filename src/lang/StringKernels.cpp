@@ -0,0 +1,207 @@
+#include <lang/StringKernels.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS 1
+#endif
+
+namespace lang {
+
+namespace {
+
+// powers of 31 modulo 2^32
+constexpr uint32_t pow31(int k) { return k == 0 ? 1u : 31u * pow31(k - 1); }
+constexpr uint32_t P4 = pow31(4);
+
+inline uint32_t hashTail(uint32_t h, const char *s, int n) {
+	for (int i = 0; i < n; ++i) h = 31u * h + (uint32_t)(int)s[i];
+	return h;
+}
+inline char foldCase(char c) {
+	return (unsigned)(c - 'A') < 26u ? (char)(c | 0x20) : c;
+}
+inline boolean equalsIgnoreCaseTail(const char *a, const char *b, int n) {
+	for (int i = 0; i < n; ++i) {
+		if (a[i] != b[i] && foldCase(a[i]) != foldCase(b[i])) return false;
+	}
+	return true;
+}
+// candidates are found with memchr on the first byte
+int indexOfTail(const char *s, int n, const char *p, int m, int from) {
+	const char first = p[0];
+	for (int i = from; i <= n - m; ++i) {
+		const char *c = (const char *)std::memchr(s + i, first, (size_t)(n - m - i + 1));
+		if (c == null) return -1;
+		i = (int)(c - s);
+		if (std::memcmp(c + 1, p + 1, (size_t)m - 1) == 0) return i;
+	}
+	return -1;
+}
+
+// four independent multiply chains instead of one
+jint hashScalar(const char *s, int n) {
+	uint32_t h = 0;
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
+		h = h * P4 + (uint32_t)(int)s[i] * pow31(3) + (uint32_t)(int)s[i+1] * pow31(2)
+			+ (uint32_t)(int)s[i+2] * 31u + (uint32_t)(int)s[i+3];
+	}
+	return (jint)(int32_t)hashTail(h, s + i, n - i);
+}
+boolean equalsIgnoreCaseScalar(const char *a, const char *b, int n) {
+	return equalsIgnoreCaseTail(a, b, n);
+}
+int indexOfScalar(const char *s, int n, const char *p, int m) {
+	if (m == 0) return 0;
+	return indexOfTail(s, n, p, m, 0);
+}
+
+#ifdef HAVE_X86_KERNELS
+
+__attribute__((target("sse2")))
+inline __m128i toLower16(__m128i x) {
+	__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(x, _mm_set1_epi8('Z' + 1)));
+	return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+__attribute__((target("sse2")))
+boolean equalsIgnoreCaseSse2(const char *a, const char *b, int n) {
+	int i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+		__m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(toLower16(va), toLower16(vb))) != 0xffff) return false;
+	}
+	return equalsIgnoreCaseTail(a + i, b + i, n - i);
+}
+// first and last byte of the pattern are matched for 16 positions at once,
+// only positions where both match are compared in full
+__attribute__((target("sse2")))
+int indexOfSse2(const char *s, int n, const char *p, int m) {
+	if (m == 0) return 0;
+	if (m == 1 || m > n) return indexOfTail(s, n, p, m, 0);
+	const __m128i first = _mm_set1_epi8(p[0]);
+	const __m128i last = _mm_set1_epi8(p[m-1]);
+	int i = 0;
+	for (; i + m - 1 + 16 <= n; i += 16) {
+		__m128i f = _mm_cmpeq_epi8(first, _mm_loadu_si128((const __m128i *)(s + i)));
+		__m128i l = _mm_cmpeq_epi8(last, _mm_loadu_si128((const __m128i *)(s + i + m - 1)));
+		unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(f, l));
+		for (; mask != 0; mask &= mask - 1) {
+			int j = i + __builtin_ctz(mask);
+			if (std::memcmp(s + j + 1, p + 1, (size_t)m - 2) == 0) return j;
+		}
+	}
+	return indexOfTail(s, n, p, m, i);
+}
+
+// lane weights for a 32 byte block, byte k of the block gets 31^(31-k)
+// (constant initialized, strings are hashed during static initialization)
+alignas(32) const uint32_t hashWeights[32] = {
+	pow31(31), pow31(30), pow31(29), pow31(28), pow31(27), pow31(26), pow31(25), pow31(24),
+	pow31(23), pow31(22), pow31(21), pow31(20), pow31(19), pow31(18), pow31(17), pow31(16),
+	pow31(15), pow31(14), pow31(13), pow31(12), pow31(11), pow31(10), pow31(9), pow31(8),
+	pow31(7), pow31(6), pow31(5), pow31(4), pow31(3), pow31(2), pow31(1), pow31(0)
+};
+
+__attribute__((target("avx2")))
+inline __m256i load8x32(const char *s) {
+	return _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)s));
+}
+// four accumulators of eight lanes take 32 bytes per step: acc = acc*31^32 + bytes,
+// the lanes are weighted by their position in the block at the end
+__attribute__((target("avx2")))
+jint hashAvx2(const char *s, int n) {
+	if (n < 32) return hashScalar(s, n);
+	const __m256i p32 = _mm256_set1_epi32((int)pow31(32));
+	__m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+	int i = 0;
+	for (; i + 32 <= n; i += 32) {
+		a0 = _mm256_add_epi32(_mm256_mullo_epi32(a0, p32), load8x32(s + i));
+		a1 = _mm256_add_epi32(_mm256_mullo_epi32(a1, p32), load8x32(s + i + 8));
+		a2 = _mm256_add_epi32(_mm256_mullo_epi32(a2, p32), load8x32(s + i + 16));
+		a3 = _mm256_add_epi32(_mm256_mullo_epi32(a3, p32), load8x32(s + i + 24));
+	}
+	const __m256i *w = (const __m256i *)hashWeights;
+	__m256i sum = _mm256_add_epi32(
+		_mm256_add_epi32(_mm256_mullo_epi32(a0, _mm256_loadu_si256(w)), _mm256_mullo_epi32(a1, _mm256_loadu_si256(w + 1))),
+		_mm256_add_epi32(_mm256_mullo_epi32(a2, _mm256_loadu_si256(w + 2)), _mm256_mullo_epi32(a3, _mm256_loadu_si256(w + 3))));
+	__m128i s4 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	s4 = _mm_add_epi32(s4, _mm_shuffle_epi32(s4, 0x4e));
+	s4 = _mm_add_epi32(s4, _mm_shuffle_epi32(s4, 0xb1));
+	uint32_t h = (uint32_t)_mm_cvtsi128_si32(s4);
+	return (jint)(int32_t)hashTail(h, s + i, n - i);
+}
+__attribute__((target("avx2")))
+inline __m256i toLower32(__m256i x) {
+	__m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(x, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), x));
+	return _mm256_or_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+__attribute__((target("avx2")))
+boolean equalsIgnoreCaseAvx2(const char *a, const char *b, int n) {
+	int i = 0;
+	for (; i + 32 <= n; i += 32) {
+		__m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+		__m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+		if ((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(toLower32(va), toLower32(vb))) != 0xffffffffu) return false;
+	}
+	return equalsIgnoreCaseSse2(a + i, b + i, n - i);
+}
+__attribute__((target("avx2")))
+int indexOfAvx2(const char *s, int n, const char *p, int m) {
+	if (m == 0) return 0;
+	if (m == 1 || m > n) return indexOfTail(s, n, p, m, 0);
+	const __m256i first = _mm256_set1_epi8(p[0]);
+	const __m256i last = _mm256_set1_epi8(p[m-1]);
+	int i = 0;
+	for (; i + m - 1 + 32 <= n; i += 32) {
+		__m256i f = _mm256_cmpeq_epi8(first, _mm256_loadu_si256((const __m256i *)(s + i)));
+		__m256i l = _mm256_cmpeq_epi8(last, _mm256_loadu_si256((const __m256i *)(s + i + m - 1)));
+		unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(f, l));
+		for (; mask != 0; mask &= mask - 1) {
+			int j = i + __builtin_ctz(mask);
+			if (std::memcmp(s + j + 1, p + 1, (size_t)m - 2) == 0) return j;
+		}
+	}
+	int r = indexOfSse2(s + i, n - i, p, m);
+	return r < 0 ? r : i + r;
+}
+
+// SSE2 has no 32 bit multiply, its hash stays scalar
+const StringKernels::Impl sse2 = {"sse2", hashScalar, equalsIgnoreCaseSse2, indexOfSse2};
+const StringKernels::Impl avx2 = {"avx2", hashAvx2, equalsIgnoreCaseAvx2, indexOfAvx2};
+#endif
+
+}
+
+const StringKernels::Impl StringKernels::scalar = {"scalar", hashScalar, equalsIgnoreCaseScalar, indexOfScalar};
+std::atomic<const StringKernels::Impl*> StringKernels::active(null);
+
+int StringKernels::getImplementations(const Impl *impls[], int max) {
+	int n = 0;
+	if (n < max) impls[n++] = &scalar;
+#ifdef HAVE_X86_KERNELS
+	__builtin_cpu_init();
+	if (n < max && __builtin_cpu_supports("sse2")) impls[n++] = &sse2;
+	if (n < max && __builtin_cpu_supports("avx2")) impls[n++] = &avx2;
+#endif
+	return n;
+}
+const StringKernels::Impl *StringKernels::select() {
+	const Impl *impls[4];
+	const Impl *best = impls[getImplementations(impls, 4) - 1];
+	active.store(best, std::memory_order_relaxed);
+	return best;
+}
+boolean StringKernels::setActive(const char *name) {
+	const Impl *impls[4];
+	int n = getImplementations(impls, 4);
+	for (int i = 0; i < n; ++i) {
+		if (std::strcmp(impls[i]->name, name) == 0) {
+			active.store(impls[i], std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+}
@@ -1,29 +1,80 @@
+#include <lang/Fiber.hpp>
+#include <lang/Runtime.hpp>
 #include <lang/System.hpp>
 #include <lang/Thread.hpp>
 #include <lang/ThreadGroup.hpp>
-#include <util/HashMap.hpp>
+#include <util/concurrent/ConcurrentHashMap.hpp>
 #include <chrono>
 #include <thread>
+#include <vector>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 namespace {
-void setNativePriority(std::thread& thread, int priority) {
-	int policy;
-	sched_param sch_params;
-	pthread_getschedparam(thread.native_handle(), &policy, &sch_params);
+// nice values of the priorities 1..10 (as the JDK with ThreadPriorityPolicy=1)
+const int niceOf[Thread::MAX_PRIORITY + 1] = {0, 4, 3, 2, 1, 0, -1, -2, -3, -4, -5};
 
-	sch_params.sched_priority = priority;
-	pthread_setschedparam(thread.native_handle(), policy, &sch_params);
+int kernelThreadId() {
+	#ifdef __linux__
+	return (int)::syscall(SYS_gettid);
+	#else
+	return 0;
+	#endif
 }
-void setNativeName(std::thread& thread, const String& name, boolean& pending) {
+// the scheduling of a kernel thread: policy and nice are per thread on Linux
+#ifdef __linux__
+boolean setNativePriority(int nativeId, int priority, int rtPriority) {
+	if (nativeId == 0) return true;
+	sched_param sp;
+	if (rtPriority > 0) {
+		sp.sched_priority = rtPriority;
+		return ::sched_setscheduler(nativeId, SCHED_FIFO, &sp) == 0;
+	}
+	if (::sched_getscheduler(nativeId) != SCHED_OTHER) {
+		sp.sched_priority = 0;
+		if (::sched_setscheduler(nativeId, SCHED_OTHER, &sp) != 0) return false;
+	}
+	return ::setpriority(PRIO_PROCESS, (id_t)nativeId, niceOf[priority]) == 0;
+}
+// an empty set allows all CPUs (the kernel leaves out the ones of no use)
+void setNativeAffinity(int nativeId, const CpuSet& cpus) {
+	if (nativeId == 0) return ;
+	cpu_set_t cs;
+	CPU_ZERO(&cs);
+	if (cpus.isEmpty()) {
+		for (size_t c = 0; c < CPU_SETSIZE; ++c) CPU_SET(c, &cs);
+	}
+	else {
+		for (int c = cpus.nextSetBit(0); c >= 0; c = cpus.nextSetBit(c + 1)) CPU_SET((size_t)c, &cs);
+	}
+	::sched_setaffinity(nativeId, sizeof(cs), &cs);
+}
+CpuSet getNativeAffinity(int nativeId) {
+	cpu_set_t cs;
+	if (nativeId == 0 || ::sched_getaffinity(nativeId, sizeof(cs), &cs) != 0) return CpuSet::online();
+	CpuSet s;
+	for (int c = 0; c < CpuSet::MAX_CPUS && c < CPU_SETSIZE; ++c) {
+		if (CPU_ISSET((size_t)c, &cs)) s.set(c);
+	}
+	return s;
+}
+#else
+boolean setNativePriority(int nativeId, int priority, int rtPriority) { return rtPriority == 0; }
+void setNativeAffinity(int nativeId, const CpuSet& cpus) {}
+CpuSet getNativeAffinity(int nativeId) { return CpuSet::online(); }
+#endif
+void setNativeName(pthread_t thread, const String& name, boolean& pending) {
 	#ifdef __APPLE__
-	if (thread.get_id() == std::this_thread::get_id()) {
+	if (pthread_equal(thread, pthread_self())) {
 		pthread_setname_np(name.cstr());
 		pending = false;
 	}
 	else pending = true;
 	#else
 	pending = false;
-	pthread_setname_np(thread.native_handle(), name.cstr());
+	pthread_setname_np(thread, name.cstr());
 	#endif
 }
 class MainThreadGroup : extends ThreadGroup {
@@ -32,29 +83,29 @@ public:
 };
 class MainThread : extends Thread {
 public:
-	MainThread(ThreadGroup& g) : Thread(g, "main", RUNNABLE) {}
-	MainThread() : Thread("main", RUNNABLE) {}
+	MainThread(ThreadGroup& g) : Thread(g, "main", RUNNABLE) { callstack = &CallTrace::current(); nativeId = kernelThreadId(); }
+	MainThread() : Thread("main", RUNNABLE) { nativeId = kernelThreadId(); }
 };
 
+// the Thread of the calling thread, set by itself on start (initial-exec: a plain TLS load)
+__attribute__((tls_model("initial-exec"))) thread_local Thread *current = null;
+std::mutex callstackLock;  // guards Thread::callstack of other threads
+
+// the map of all threads serves enumeration and threads not started as Thread
 class Threads : extends Object {
-	class CallLock {
-		boolean& cl;
-	public:
-		CallLock(boolean& b) : cl(b) { cl=true; }
-		~CallLock() { cl=false; }
-	};
 	std::thread::id mainid;
-	boolean recursive=false; //guard for recursive trace call
 public:
 	Thread unknownThread;
 	long threadSeqNumber = 0;
 	long threadInitNumber = 0;
-	HashMap<std::thread::id,Thread*> thrmap;
+	// lock-free lookups, nothing in them is traced
+	util::concurrent::ConcurrentHashMap<std::thread::id,Thread*> thrmap;
 	MainThreadGroup maingroup;
 	MainThread main;
 
 	Threads() : thrmap(), main(maingroup) {
 		mainid = std::this_thread::get_id();
+		current = &main;
 		addThread(mainid, &main);
 		std::cout << "Threads init done" << std::endl;
 		unknownThread.setName("THREAD?");
@@ -63,6 +114,7 @@ public:
 	~Threads() {
 		std::cout << "Threads destructor" << std::endl;
 		removeThread(mainid);
+		if (current == &main) current = null;
 	}
 	long nextThreadNum() {
 		long n = 0;
@@ -79,28 +131,13 @@ public:
 		return tid;
 	}
 	void addThread(std::thread::id id, Thread* t) {
-		synchronized(thrmap) {
-			if (recursive) return; //ignore self tracing
-			CallLock cl(recursive);
-			thrmap.put(id, t);
-		}
+		thrmap.put(id, t);
 	}
 	void removeThread(std::thread::id id) {
-		synchronized(thrmap) {
-			if (recursive) return; //ignore self tracing
-			CallLock cl(recursive);
-			thrmap.remove(id);
-		}
+		thrmap.remove(id);
 	}
 	Thread* getThread(std::thread::id id) {
-		Thread *t = null;
-		synchronized(thrmap) {
-			if (recursive) return null; //ignore self tracing
-			CallLock cl(recursive);
-			if (!thrmap.containsKey(id)) t = &unknownThread;
-			else t = thrmap.get(id);
-		}
-		return t;
+		return thrmap.getOrDefault(id, &unknownThread);
 	}
 };
 
@@ -109,6 +146,16 @@ Threads& threads() {
 	static Threads t;
 	return t;
 }
+
+Thread *findCurrent() {
+	Thread *t = current;
+	if (t == null) {
+		t = threads().getThread(std::this_thread::get_id());
+		// a thread not started as Thread gets the shared unknownThread, which is not cached
+		if (t != null && t != &threads().unknownThread) current = t;
+	}
+	return t;
+}
 } //anoymous namespace
 
 namespace lang {
@@ -132,45 +179,57 @@ boolean Thread::isInterrupted(boolean ClearInterrupted) {
 	return r;
 }
 
-#ifdef BACKTRACE
-void Thread::tracePush(CallTrace *c) {
-	if (calltrace_size < BACKTRACE_SIZE)
-		calltrace[calltrace_size] = c;
-	++calltrace_size;
-}
-CallTrace *Thread::tracePop() {
-	if (calltrace_size == 0) return null;
-	--calltrace_size;
-	if (calltrace_size < BACKTRACE_SIZE)
-		return calltrace[calltrace_size];
-	return null;
-}
+// frees the shadow stack of the calling thread when it exits
+struct CallStackOwner {
+	CallTrace::Stack *stack = null;
+	~CallStackOwner() {
+		CallTrace::current().store(null, std::memory_order_relaxed);
+		delete stack;
+	}
+};
+thread_local CallStackOwner callStackOwner;
 
-void CallTrace::add() {
-	std::thread::id id = std::this_thread::get_id();
-	t = threads().getThread(id);
-	if (t!=null) t->tracePush(this);
+CallTrace::Stack& CallTrace::allocate() {
+	Stack *s = new Stack();
+	callStackOwner.stack = s;
+	// a reader holding the Thread's callstack sees the frames written after
+	current().store(s, std::memory_order_release);
+	return *s;
 }
-CallTrace::~CallTrace() {
-	if (t!=null) {
-		CallTrace *c = t->tracePop();
-		if (c == null) return ;
-		if (c != this) std::cerr << "stack mismach" << std::endl;
+
+Array<StackTraceElement> CallTrace::getStackTrace(const Stack& s) {
+	std::vector<Frame> frames;
+	int n = 0;
+	for (int retry = 0; retry < 100; ++retry) {
+		uint64_t t = s.top.load(std::memory_order_acquire);
+		n = 0;
+		// a push is writing a frame
+		if ((t >> 32) & 1) continue;
+		unsigned depth = (unsigned)t;
+		n = (int)(depth < MAX_DEPTH ? depth : MAX_DEPTH);
+		frames.resize((size_t)n);
+		for (int i = 0; i < n; ++i) frames[(size_t)i] = s.get((unsigned)(n - 1 - i));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		// pops leave the copied frames intact, a push may have overwritten them
+		if ((s.top.load(std::memory_order_relaxed) >> 32) == (t >> 32)) break;
+		n = 0;
 	}
+	Array<StackTraceElement> st(n);
+	for (int i = 0; i < n; ++i) st[i] = StackTraceElement(frames[(size_t)i].func, frames[(size_t)i].file, (int)frames[(size_t)i].line);
+	return st;
 }
-#endif
 
 Array<StackTraceElement> Thread::getStackTrace() const {
-#ifdef BACKTRACE
-	Array<StackTraceElement> st(calltrace_size);
-	for (int i=0; i < st.length; ++i) {
-		CallTrace *ct = calltrace[st.length - i - 1];
-		st[i] = StackTraceElement(ct->func,ct->file,ct->line);
+	if (this == current) {
+		Throwable t;
+		t.fillInStackTrace();
+		return t.getStackTrace();
 	}
-	return std::move(st);
-#else
-	return std::move(Throwable().getStackTrace());
-#endif
+	// the stack of another thread is valid while it runs
+	std::lock_guard<std::mutex> lock(callstackLock);
+	const CallTrace::Stack *s = callstack != null ? callstack->load(std::memory_order_acquire) : null;
+	if (s == null) return Array<StackTraceElement>();
+	return CallTrace::getStackTrace(*s);
 }
 Thread& Thread::operator=(Thread&& o) {
 	if (threadStatus != NEW) throw IllegalThreadStateException();
@@ -205,19 +264,45 @@ Thread::~Thread() {
 	System::out.println(getName() + " destructor");
 }
 void Thread::setPriority(int newPriority) {
-	setNativePriority(*thread, newPriority);
+	if (newPriority < MIN_PRIORITY || newPriority > MAX_PRIORITY) throw IllegalArgumentException("priority " + String::valueOf(newPriority));
+	if (group != null && newPriority > group->getMaxPriority()) newPriority = group->getMaxPriority();
+	priority = newPriority;
+	if (realtimePriority == 0) setNativePriority(nativeId, priority, 0);
+}
+boolean Thread::setRealtimePriority(int rtPriority) {
+	if (rtPriority < 0 || rtPriority > 99) throw IllegalArgumentException("real-time priority " + String::valueOf(rtPriority));
+	if (nativeId != 0 && !setNativePriority(nativeId, priority, rtPriority)) return false;
+	realtimePriority = rtPriority;
+	return true;
+}
+void Thread::setAffinity(const CpuSet& cpus) {
+	CpuSet usable = cpus;
+	usable.andWith(CpuSet::online());
+	if (!cpus.isEmpty() && usable.isEmpty()) throw IllegalArgumentException("no usable CPU in " + cpus.toString());
+	affinity = cpus;
+	setNativeAffinity(nativeId, cpus);
+}
+CpuSet Thread::getAffinity() const {
+	if (nativeId == 0) return affinity.isEmpty() ? CpuSet::online() : affinity;
+	return getNativeAffinity(nativeId);
 }
 void Thread::setName(const String& name) {
 	if (this->name.equals(name)) return ;
 	this->name=name;
 	if (threadStatus != NEW) {
-		setNativeName(*thread, name, pendingNameChange);
+		if (thread) setNativeName(thread->native_handle(), name, pendingNameChange);
 	}
 }
 void Thread::start() {
 	if (threadStatus != NEW) throw IllegalThreadStateException();
 
-	if (group) group->add(this);
+	if (group) {
+		group->add(this);
+		if (affinity.isEmpty()) {
+			int cpu = group->nextCpu();
+			if (cpu >= 0) affinity.set(cpu);
+		}
+	}
 
 	boolean started = false;
 	try {
@@ -248,13 +333,21 @@ void Thread::start0() {
 	LOGN("Starting new thread %s", getName().cstr());
 	this->thread = new std::thread([&] {
 		std::thread::id thrid = std::this_thread::get_id();
+		current = this;
+		{
+			std::lock_guard<std::mutex> lock(callstackLock);
+			callstack = &CallTrace::current();
+		}
 		threads().addThread(thrid, this);
 		Thread::selfupdate();
+		Runtime::threadStarted();
 		try {
 			//do { Thread::yield(); } while (threadStatus == NEW);
 			if (threadStatus == RUNNABLE) {
 				LOGN("Thread started %s", getName().cstr());
-				setPriority(priority);
+				nativeId = kernelThreadId();
+				setNativePriority(nativeId, priority, realtimePriority);
+				if (!affinity.isEmpty()) setNativeAffinity(nativeId, affinity);
 				run();
 			}
 		} catch(const Throwable& e) {
@@ -266,43 +359,55 @@ void Thread::start0() {
 			Throwable().fillInStackTrace().printStackTrace();
 		}
 		threadStatus = TERMINATED;
+		nativeId = 0;
+		if (group) group->threadTerminated(this);
 		LOGN("Thread finished %s", getName().cstr());
+		Runtime::threadFinished();
 		threads().removeThread(thrid);
+		{
+			std::lock_guard<std::mutex> lock(callstackLock);
+			callstack = null;
+		}
+		current = null;
 	});
 	//Thread::yield();
 	if (daemon) thread->detach();
 }
 void Thread::join(long millis) {TRACE;
 	if (thread == null) throw NullPointerException();
-	synchronized(*this) {
-	if (thread->joinable()) {
-		threadStatus = WAITING;
-		thread->join();
-		threadStatus = RUNNABLE;
-	}
-	}
+	// neither the monitor (the thread synchronizes on itself in sleep) nor the status
+	// (it is the joined thread's, one not yet running must still see RUNNABLE) is touched
+	std::lock_guard<std::mutex> g(joinLock);
+	if (thread->joinable()) thread->join();
 }
 void Thread::selfupdate() {
-	if (!thread) return ;
-	if (pendingNameChange) setNativeName(*thread, name, pendingNameChange);
+	if (pendingNameChange) setNativeName(pthread_self(), name, pendingNameChange);
 }
 
 // static methods
 Thread& Thread::currentThread() {
-	std::thread::id id = std::this_thread::get_id();
-	Thread *t = threads().getThread(id);
+	Thread *t = findCurrent();
 	if (t == null) {
-		System::err.println("FATAL: thread not found: " + String::valueOf(id));
+		System::err.println("FATAL: thread not found: " + String::valueOf(std::this_thread::get_id()));
 		std::abort();
 	}
 	return *t;
 }
 
 void Thread::yield() noexcept {
+	if (Fiber::current() != null) {
+		Fiber::yield();
+		return ;
+	}
 	Thread::currentThread().selfupdate();
 	std::this_thread::yield();
 }
 void Thread::sleep(long millis) {
+	// the carrier goes on with other fibers
+	if (Fiber::current() != null) {
+		Fiber::sleep(millis);
+		return ;
+	}
 	Thread& t = currentThread();
 	synchronized(t) {
 	t.threadStatus = WAITING;
@@ -311,6 +416,57 @@ void Thread::sleep(long millis) {
 	}
 }
 
+void ThreadGroup::setPlacement(Placement policy, const CpuSet& cpus) {
+	CpuSet usable = cpus.isEmpty() ? CpuSet::online() : cpus;
+	usable.andWith(CpuSet::online());
+	if (policy != NONE && usable.isEmpty()) throw IllegalArgumentException("no usable CPU in " + cpus.toString());
+	std::vector<int> order;
+	if (policy == EXPLICIT) {
+		for (int c = usable.nextSetBit(0); c >= 0; c = usable.nextSetBit(c + 1)) order.push_back(c);
+	}
+	else if (policy != NONE) {
+		std::vector<CpuSet> nodes;
+		for (int n = 0; n < Numa::nodeCount(); ++n) {
+			CpuSet s = Numa::cpusOfNode(n);
+			s.andWith(usable);
+			if (!s.isEmpty()) nodes.push_back(s);
+		}
+		if (policy == COMPACT) {
+			for (const CpuSet& s : nodes) {
+				for (int c = s.nextSetBit(0); c >= 0; c = s.nextSetBit(c + 1)) order.push_back(c);
+			}
+		}
+		else {
+			// the i-th CPU of every node, then the i+1-th
+			std::vector<int> next(nodes.size(), 0);
+			size_t left = 0;
+			for (const CpuSet& s : nodes) left += (size_t)s.cardinality();
+			while (left > 0) {
+				for (size_t n = 0; n < nodes.size(); ++n) {
+					int c = nodes[n].nextSetBit(next[n]);
+					if (c < 0) continue;
+					order.push_back(c);
+					next[n] = c + 1;
+					--left;
+				}
+			}
+		}
+	}
+	synchronized (*this) {
+		placement = policy;
+		placementCpus = Array<int>((int)order.size());
+		for (size_t i = 0; i < order.size(); ++i) placementCpus[(int)i] = order[i];
+		nplaced = 0;
+	}
+}
+int ThreadGroup::nextCpu() {
+	int cpu = -1;
+	synchronized (*this) {
+		if (placement != NONE && placementCpus.length > 0) cpu = placementCpus[nplaced++ % placementCpus.length];
+	}
+	return cpu;
+}
+
 int Thread::activeCount() {
 	return currentThread().getThreadGroup().activeCount();
 }
@@ -4,6 +4,7 @@
 #include <net/Socket.hpp>
 #include <util/ArrayList.hpp>
 #include <util/HashMap.hpp>
+#include <util/concurrent/ConcurrentHashMap.hpp>
 
 #include <sys/socket.h>
 
@@ -120,13 +121,14 @@ Array<Shared<InetAddress>> unknown_array(1);
 //	static ArrayList<Shared<NameService>> nameServices;
 //	return nameServices;
 //}
-HashMap<String,Array<Shared<InetAddress>>> addressCache;
+util::concurrent::ConcurrentHashMap<String,Array<Shared<InetAddress>>> addressCache;
 void cacheInitIfNeeded() {
-	static boolean addressCacheInit = false;
-	if (addressCacheInit) return ;
-	unknown_array[0] = impl.anyLocalAddress();
-	addressCache.put(impl.anyLocalAddress()->getHostName(), unknown_array);
-	addressCacheInit = true;
+	static boolean addressCacheInit = [] {
+		unknown_array[0] = impl.anyLocalAddress();
+		addressCache.put(impl.anyLocalAddress()->getHostName(), unknown_array);
+		return true;
+	}();
+	(void)addressCacheInit;
 }
 //void cacheAddresses(const String& hostname, const Array<Shared<InetAddress>>& addresses, boolean success) {
 //	addressCache.put(hostname, addresses);
@@ -134,12 +136,8 @@ void cacheInitIfNeeded() {
 const Array<Shared<InetAddress>> getCachedAddresses(const String& hostname) {
 	String h = hostname.toLowerCase();
 	Array<Shared<InetAddress>> ret;
-	synchronized (addressCache) {
-		cacheInitIfNeeded();
-		const HashMap<String,Array<Shared<InetAddress>>>& cache = addressCache;
-		const Array<Shared<InetAddress>>& a = cache.get(h);
-		if (a != null) ret = a;
-	}
+	cacheInitIfNeeded();
+	addressCache.get(h, ret);
 	return ret;
 }
 Array<Shared<InetAddress>> getAddressesFromNameService(const String& host, const InetAddress& reqAddr) {
@@ -1,4 +1,6 @@
+#include <lang/Fiber.hpp>
 #include <nio/channels/Channel.hpp>
+#include <util/Metrics.hpp>
 
 #include <unistd.h>
 #include <sys/socket.h>
@@ -144,6 +146,19 @@ public:
 	}
 };
 
+namespace {
+struct DatagramMetrics {
+	util::concurrent::LongAdder& sendCalls = util::Metrics::counter("nio.DatagramChannel.send.calls");
+	util::concurrent::LongAdder& sendBytes = util::Metrics::counter("nio.DatagramChannel.send.bytes");
+	util::concurrent::LongAdder& receiveCalls = util::Metrics::counter("nio.DatagramChannel.receive.calls");
+	util::concurrent::LongAdder& receiveBytes = util::Metrics::counter("nio.DatagramChannel.receive.bytes");
+};
+DatagramMetrics& datagramMetrics() {
+	static DatagramMetrics m;
+	return m;
+}
+}
+
 class DatagramChannelImpl : extends DatagramChannel {
 private:
 	static const int ST_UNINITIALIZED = -1;
@@ -190,7 +205,12 @@ private:
 		int rem = (pos <= lim ? lim - pos : 0);
 		if (rem == 0) return 0;
 		int flags = 0; //MSG_NOSIGNAL; // MSG_DONTWAIT | MSG_DONTROUTE
-		int n = (int)::recv(fd, &dst.array()[pos], rem, flags);
+		// a blocking read on a fiber parks it until readable, the carrier runs on
+		const boolean parks = Fiber::current() != null && isBlocking();
+		if (parks) flags |= MSG_DONTWAIT;
+		int n;
+		while ((n = (int)::recv(fd, &dst.array()[pos], rem, flags)) == -1 && parks && (errno == EAGAIN || errno == EWOULDBLOCK))
+			Fiber::awaitReadable(fd);
 		if (n == -1) LOGD("recv(fd=%d) error=%d (%s)", fd, errno, strerror(errno));
 		else {
 			dst.position(pos + n);
@@ -226,7 +246,12 @@ private:
 		struct sockaddr_in addr_remote;
 		socklen_t slen = sizeof(addr_remote);
 		int flags = 0; //MSG_NOSIGNAL; // | MSG_DONTWAIT;// | MSG_DONTROUTE
-		int n = (int)::recvfrom(fd, &dst.array()[pos], rem, flags, (struct sockaddr *)&addr_remote, &slen);
+		const boolean parks = Fiber::current() != null && isBlocking();
+		if (parks) flags |= MSG_DONTWAIT;
+		int n;
+		while ((n = (int)::recvfrom(fd, &dst.array()[pos], rem, flags, (struct sockaddr *)&addr_remote, &slen)) == -1 &&
+				parks && (errno == EAGAIN || errno == EWOULDBLOCK))
+			Fiber::awaitReadable(fd);
 		if (n == -1) LOGD("recvfrom(fd=%d) error=%d (%s)", fd, errno, strerror(errno));
 		else {
 			dst.position(pos + n);
@@ -320,6 +345,9 @@ public:
 			Finalize(readerThread = 0;end((n > 0) || (n == IOStatus::UNAVAILABLE)););
 			begin();
 			n = receive(fdVal, dst, last_sender);
+			DatagramMetrics& m = datagramMetrics();
+			m.receiveCalls.increment();
+			if (n > 0) m.receiveBytes.add(n);
 			if (n == -1) return (const SocketAddress&)null_obj;
 		}
 		return last_sender;
@@ -345,6 +373,9 @@ public:
 			begin();
 			if (!isOpen()) return 0;
 			n = send(fdVal, src, isa);
+			DatagramMetrics& m = datagramMetrics();
+			m.sendCalls.increment();
+			if (n > 0) m.sendBytes.add(n);
 		}
 		return 0;
 	}
@@ -0,0 +1,46 @@
+#include <util/concurrent/ConcurrentHashMap.hpp>
+#include <thread>
+
+namespace util { namespace concurrent {
+
+namespace {
+std::atomic<int> nextStripe{0};
+__attribute__((tls_model("initial-exec"))) thread_local int stripe = -1;
+}
+
+int Reclaimer::threadStripe() {
+	if (stripe < 0) stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+	return stripe;
+}
+
+Reclaimer::~Reclaimer() {
+	// no readers are left
+	for (const Retired& r : retired) r.deleter(r.p);
+}
+
+void Reclaimer::synchronize() {
+	std::lock_guard<std::mutex> lock(syncLock);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	// a reader may have read the phase just before a flip and count in the old one,
+	// two flips wait for it wherever it counted
+	for (int flip = 0; flip < 2; ++flip) {
+		int old = phase.load();
+		phase.store(old ^ 1);
+		for (Counter& c : counters[old]) {
+			while (c.readers.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+		}
+	}
+}
+
+void Reclaimer::reclaim() {
+	std::vector<Retired> batch;
+	{
+		std::lock_guard<std::mutex> lock(retiredLock);
+		batch.swap(retired);
+	}
+	if (batch.empty()) return;
+	synchronize();
+	for (const Retired& r : batch) r.deleter(r.p);
+}
+
+}}
@@ -0,0 +1,52 @@
+#include <util/concurrent/Futex.hpp>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#endif
+
+namespace util { namespace concurrent {
+
+#ifdef __linux__
+boolean Futex::wait(std::atomic<int>& word, int expected, jlong nanos) {
+	struct timespec ts, *tp = null;
+	if (nanos >= 0) {
+		ts.tv_sec = (time_t)(nanos / 1000000000);
+		ts.tv_nsec = (long)(nanos % 1000000000);
+		tp = &ts;
+	}
+	long r = syscall(SYS_futex, (int*)&word, FUTEX_WAIT_PRIVATE, expected, tp, null, 0);
+	return r == 0 || errno != ETIMEDOUT;
+}
+void Futex::wake(std::atomic<int>& word, int count) {
+	syscall(SYS_futex, (int*)&word, FUTEX_WAKE_PRIVATE, count, null, null, 0);
+}
+#else
+namespace {
+const unsigned STRIPES = 64;
+struct Stripe {
+	std::mutex mtx;
+	std::condition_variable cond;
+} stripes[STRIPES];
+Stripe& stripeOf(const void *addr) { return stripes[((uintptr_t)addr >> 4) % STRIPES]; }
+}
+boolean Futex::wait(std::atomic<int>& word, int expected, jlong nanos) {
+	Stripe& s = stripeOf(&word);
+	std::unique_lock<std::mutex> lock(s.mtx);
+	if (word.load() != expected) return true;
+	if (nanos < 0) { s.cond.wait(lock); return true; }
+	return s.cond.wait_for(lock, std::chrono::nanoseconds(nanos)) == std::cv_status::no_timeout;
+}
+void Futex::wake(std::atomic<int>& word, int count) {
+	Stripe& s = stripeOf(&word);
+	std::lock_guard<std::mutex> lock(s.mtx);
+	s.cond.notify_all();
+}
+#endif
+
+}}
@@ -0,0 +1,192 @@
+#include <lang/Exception.hpp>
+#include <lang/Fiber.hpp>
+#include <lang/System.hpp>
+#include <util/concurrent/Future.hpp>
+#include <util/concurrent/Futex.hpp>
+#include <util/concurrent/ScheduledExecutorService.hpp>
+
+namespace util { namespace concurrent {
+
+namespace {
+// the threads and fibers blocked in get, one per state, registered once and deleted with the state
+struct Waiter : FutureState::Continuation {
+	std::atomic<int> done{0};                // futex word of the threads
+	lang::Fiber::WaitQueue fibers;
+	FutureState *run(FutureState *) {
+		done.store(1, std::memory_order_release);
+		Futex::wakeAll(done);
+		fibers.wakeAll();
+		return null;
+	}
+	FutureState *drop() { return null; }
+};
+Waiter *waiterOf(FutureState *s) {
+	FutureState::Continuation *w = s->waiter.load(std::memory_order_acquire);
+	if (w != null) return static_cast<Waiter*>(w);
+	Waiter *n = new Waiter();
+	if (!s->waiter.compare_exchange_strong(w, n, std::memory_order_acq_rel, std::memory_order_acquire)) {
+		delete n;
+		return static_cast<Waiter*>(w);
+	}
+	// a timed out get leaves nothing behind: the next ones wait on the same word
+	s->addContinuation(n);
+	return n;
+}
+
+// cancels the timeout of the state once completed
+struct TimerCancel : FutureState::Continuation {
+	ScheduledFuture timer;
+	TimerCancel(const ScheduledFuture& timer) : timer(timer) {}
+	FutureState *run(FutureState *) { timer.cancel(); delete this; return null; }
+	FutureState *drop() { delete this; return null; }
+};
+
+// reference held by a timer task, released when the task is run or cancelled
+struct Ref {
+	FutureState *state;
+	Ref(FutureState *s) : state(s) { state->addRef(); }
+	Ref(const Ref& o) : state(o.state) { state->addRef(); }
+	~Ref() { state->release(); }
+};
+
+// shared by the timeouts of all futures, never destroyed
+ScheduledExecutorService& timer() {
+	static ScheduledExecutorService *t = new ScheduledExecutorService(1);
+	return *t;
+}
+}
+
+void FutureState::destroy(FutureState *s) {
+	s->nextFire = null;
+	while (s != null) {
+		FutureState *next = s->nextFire;
+		Continuation *c = s->stack.load(std::memory_order_acquire);
+		// pending, nobody can complete it any more: the dependents lose their source
+		if (c != completed()) {
+			while (c != null) {
+				Continuation *n = c->next;
+				FutureState *d = c->drop();
+				if (d != null && d->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					d->nextFire = next;
+					next = d;
+				}
+				c = n;
+			}
+		}
+		delete s->waiter.load(std::memory_order_relaxed);
+		delete s;
+		s = next;
+	}
+}
+
+void FutureState::postComplete() {
+	FutureState *s = this, *pending = null;
+	for (;;) {
+		Continuation *c = s->stack.exchange(completed(), std::memory_order_acq_rel);
+		if (c == completed()) c = null;
+		// pushed last first, run in the registration order
+		Continuation *order = null;
+		while (c != null) {
+			Continuation *n = c->next;
+			c->next = order;
+			order = c;
+			c = n;
+		}
+		while (order != null) {
+			Continuation *n = order->next;
+			FutureState *d = order->run(s);
+			if (d != null) {
+				d->nextFire = pending;
+				pending = d;
+			}
+			order = n;
+		}
+		if (s != this) s->release();
+		if (pending == null) break;
+		s = pending;
+		pending = s->nextFire;
+	}
+}
+
+FutureState *FutureState::pushContinuation(Continuation *c) {
+	Continuation *h = stack.load(std::memory_order_acquire);
+	while (h != completed()) {
+		c->next = h;
+		if (stack.compare_exchange_weak(h, c, std::memory_order_release, std::memory_order_acquire)) return null;
+	}
+	return c->run(this);
+}
+void FutureState::addContinuation(Continuation *c) {
+	FutureState *d = pushContinuation(c);
+	if (d != null) {
+		d->postComplete();
+		d->release();
+	}
+}
+
+boolean FutureState::await(jlong nanos) {
+	if (isDone()) return true;
+	Waiter *w = waiterOf(this);
+	jlong deadline = nanos >= 0 ? System::nanoTime() + nanos : 0;
+	boolean fiber = lang::Fiber::current() != null;
+	while (w->done.load(std::memory_order_acquire) == 0) {
+		jlong left = -1;
+		if (nanos >= 0) {
+			left = deadline - System::nanoTime();
+			if (left <= 0) break;
+		}
+		if (fiber) w->fibers.wait(w->done, 0, left);
+		else Futex::wait(w->done, 0, left);
+	}
+	return isDone();
+}
+
+void FutureState::setError(const std::exception_ptr& e) {
+	error = e;
+	try {
+		std::rethrow_exception(error);
+	} catch (const Throwable& t) {
+		// libstdc++ and libc++ rethrow the object error holds, which lives as long as the state
+		thrown = &t;
+	} catch (...) {
+		thrown = null;
+	}
+}
+
+const Throwable *FutureState::getException() const {
+	return isFailed() ? thrown : null;
+}
+
+void FutureState::failOnTimeout(jlong timeout, TimeUnit unit) {
+	Ref self(this);
+	onTimeout([self, timeout, unit] {
+		FutureState *s = self.state;
+		if (s->tryFail(wrap(TimeoutException("timed out after " + String::valueOf(timeout) + " " + unit.toString())))) s->postComplete();
+	}, timeout, unit);
+}
+void FutureState::onTimeout(std::function<void()> task, jlong timeout, TimeUnit unit) {
+	if (isDone()) return;
+	addContinuation(new TimerCancel(timer().schedule(std::move(task), timeout, unit)));
+}
+
+std::exception_ptr FutureState::currentThrowable() {
+	try {
+		throw;
+	} catch (const Throwable&) {
+		return std::current_exception();
+	} catch (const std::exception& e) {
+		return wrap(RuntimeException(Object::getClass(typeid(e)).getName() + ":" + e.what()));
+	} catch (...) {
+		return wrap(RuntimeException("unknown exception"));
+	}
+}
+std::exception_ptr FutureState::toThrowable(const std::exception_ptr& e) {
+	if (!e) return wrap(NullPointerException("no exception"));
+	try {
+		std::rethrow_exception(e);
+	} catch (...) {
+		return currentThrowable();
+	}
+}
+
+}}
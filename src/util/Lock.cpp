@@ -1,18 +1,423 @@
+#include <lang/System.hpp>
+#include <lang/Thread.hpp>
+#include <util/concurrent/Futex.hpp>
 #include <util/concurrent/Lock.hpp>
+#include <thread>
 
 namespace util { namespace concurrent {
 
+namespace {
+const unsigned SPIN_LIMIT = 100;
+// spinning only helps when the owner can run meanwhile
+const unsigned spinLimit = std::thread::hardware_concurrency() > 1 ? SPIN_LIMIT : 0;
+
+// identity of the current thread, the address of its own thread local
+__attribute__((tls_model("initial-exec"))) thread_local char threadMarker;
+inline const void *self() { return &threadMarker; }
+
+inline void cpuRelax() {
+#if defined(__i386__) || defined(__x86_64__)
+	__builtin_ia32_pause();
+#endif
+}
+
+// deadline of a wait of nanos, 0 without one (nanos < 0)
+inline jlong deadlineOf(jlong nanos) {
+	return nanos < 0 ? 0 : System::nanoTime() + nanos;
+}
+// nanos left until deadline (-1 without one), 0 when elapsed
+inline jlong leftUntil(jlong deadline) {
+	if (deadline == 0) return -1;
+	jlong left = deadline - System::nanoTime();
+	return left > 0 ? left : 0;
+}
+
+// read holds of the current thread, per lock: the last lock read without the vector
+struct ReadHold {
+	const ReentrantReadWriteLock *lock;
+	int count;
+};
+__attribute__((tls_model("initial-exec"))) thread_local ReadHold lastHold;
+thread_local std::vector<ReadHold> readHolds;
+int *readHoldsOf(const ReentrantReadWriteLock *l) {
+	if (lastHold.lock == l) return &lastHold.count;
+	for (ReadHold& h : readHolds) {
+		if (h.lock == l) return &h.count;
+	}
+	return null;
+}
+void addReadHold(const ReentrantReadWriteLock *l, int *held) {
+	if (held != null) ++*held;
+	else if (lastHold.lock == null) lastHold = ReadHold{l, 1};
+	else readHolds.push_back(ReadHold{l, 1});
+}
+void removeReadHold(const ReentrantReadWriteLock *l) {
+	if (lastHold.lock == l) {
+		lastHold.lock = null;
+		return;
+	}
+	for (size_t i = 0; i < readHolds.size(); ++i) {
+		if (readHolds[i].lock != l) continue;
+		readHolds[i] = readHolds.back();
+		readHolds.pop_back();
+		break;
+	}
+}
+}
+
+/**
+ * Condition of a ReentrantLock or of a write lock: a futex sequence bumped by signals.
+ * The waiter reads the sequence before it releases the lock, a signal coming
+ * before it sleeps makes the wait return at once.
+ */
+class ConditionObject : implements Condition {
+private:
+	ReentrantLock *lock;
+	ReentrantReadWriteLock *rw;
+	std::atomic<int> seq{0};
+	std::atomic<int> waiters{0};
+
+	boolean isHeld() const {
+		return lock != null ? lock->isHeldByCurrentThread() : rw->isWriteLockedByCurrentThread();
+	}
+	int releaseAll() {
+		int h;
+		if (lock != null) {
+			h = lock->holds;
+			lock->holds = 1;
+			lock->unlock();
+		}
+		else {
+			h = rw->writeHolds;
+			rw->writeHolds = 1;
+			rw->releaseWrite();
+		}
+		return h;
+	}
+	void reacquire(int h) {
+		if (lock != null) {
+			lock->lock();
+			lock->holds = h;
+		}
+		else {
+			rw->acquireWrite(-1);
+			rw->writeHolds = h;
+		}
+	}
+public:
+	ConditionObject(ReentrantLock *lock) : lock(lock), rw(null) {}
+	ConditionObject(ReentrantReadWriteLock *rw) : lock(null), rw(rw) {}
+
+	void await() {
+		awaitNanos(-1);
+	}
+	boolean await(long time, TimeUnit unit) {
+		jlong nanos = unit.toNanos(time);
+		return awaitNanos(nanos > 0 ? nanos : 0) > 0;
+	}
+	jlong awaitNanos(jlong nanos) {
+		if (!isHeld()) throw IllegalMonitorStateException();
+		int s = seq.load();
+		waiters.fetch_add(1);
+		int h = releaseAll();
+		jlong t0 = System::nanoTime();
+		if (nanos != 0) Futex::wait(seq, s, nanos);
+		waiters.fetch_sub(1);
+		reacquire(h);
+		return nanos < 0 ? 1 : nanos - (System::nanoTime() - t0);
+	}
+	void signal() {
+		if (!isHeld()) throw IllegalMonitorStateException();
+		if (waiters.load() == 0) return;
+		seq.fetch_add(1);
+		Futex::wake(seq, 1);
+	}
+	void signalAll() {
+		if (!isHeld()) throw IllegalMonitorStateException();
+		if (waiters.load() == 0) return;
+		seq.fetch_add(1);
+		Futex::wakeAll(seq);
+	}
+};
+
+struct ReentrantLock::Waiter {
+	std::atomic<int> granted{0};             // futex word, 1 when unlock handed the lock over
+	Waiter *next = null;
+};
+
+ReentrantLock::~ReentrantLock() {
+	for (Condition *c : conditions) delete c;
+}
+
+boolean ReentrantLock::acquire(jlong nanos) {
+	int c = 0;
+	if (word.compare_exchange_strong(c, 1, std::memory_order_acquire)) return true;
+	for (unsigned spins = 0; spins < spinLimit; ++spins) {
+		cpuRelax();
+		c = word.load(std::memory_order_relaxed);
+		if (c == 0 && word.compare_exchange_weak(c, 1, std::memory_order_acquire)) return true;
+	}
+	if (nanos == 0) return false;
+	jlong deadline = deadlineOf(nanos);
+	if (c != 2) c = word.exchange(2, std::memory_order_acquire);
+	while (c != 0) {
+		jlong left = leftUntil(deadline);
+		if (left == 0) return false;
+		Futex::wait(word, 2, left);
+		c = word.exchange(2, std::memory_order_acquire);
+	}
+	return true;
+}
+void ReentrantLock::release() {
+	if (word.fetch_sub(1, std::memory_order_release) != 1) {
+		word.store(0, std::memory_order_release);
+		Futex::wake(word, 1);
+	}
+}
+
+boolean ReentrantLock::acquireFair(jlong nanos) {
+	int c = 0;
+	// free means nobody is queued, unlock hands the lock over while there are waiters
+	if (word.compare_exchange_strong(c, 1, std::memory_order_acquire)) return true;
+	if (nanos == 0) return false;
+	Waiter w;
+	{
+		std::lock_guard<std::mutex> lock(queueLock);
+		for (c = word.load(); ; ) {
+			if (c == 0) {
+				if (word.compare_exchange_weak(c, 1, std::memory_order_acquire)) return true;
+			}
+			else if (c == 2 || word.compare_exchange_weak(c, 2)) break;
+		}
+		if (tail != null) tail->next = &w;
+		else head = &w;
+		tail = &w;
+	}
+	jlong deadline = deadlineOf(nanos);
+	while (w.granted.load(std::memory_order_acquire) == 0) {
+		jlong left = leftUntil(deadline);
+		if (left == 0) {
+			std::lock_guard<std::mutex> lock(queueLock);
+			if (w.granted.load(std::memory_order_acquire) != 0) break;
+			Waiter **p = &head, *prev = null;
+			while (*p != &w) { prev = *p; p = &(*p)->next; }
+			*p = w.next;
+			if (tail == &w) tail = prev;
+			if (head == null) {
+				c = 2;
+				word.compare_exchange_strong(c, 1);
+			}
+			return false;
+		}
+		Futex::wait(w.granted, 0, left);
+	}
+	return true;
+}
+void ReentrantLock::releaseFair() {
+	int c = 1;
+	if (word.compare_exchange_strong(c, 0, std::memory_order_release)) return;
+	std::lock_guard<std::mutex> lock(queueLock);
+	Waiter *w = head;
+	if (w == null) {
+		word.store(0, std::memory_order_release);
+		return;
+	}
+	head = w->next;
+	if (head == null) tail = null;
+	// stays locked, now for w
+	word.store(head == null ? 1 : 2, std::memory_order_relaxed);
+	w->granted.store(1, std::memory_order_release);
+	Futex::wake(w->granted, 1);
+}
+
 void ReentrantLock::lock() {
+	const void *me = self();
+	if (owner.load(std::memory_order_relaxed) == me) { ++holds; return; }
+	if (fair) acquireFair(-1);
+	else acquire(-1);
+	owner.store(me, std::memory_order_relaxed);
+	holds = 1;
 }
 void ReentrantLock::lockInterruptibly() {
+	if (Thread::currentThread().isInterrupted(true)) throw InterruptedException();
+	lock();
 }
 boolean ReentrantLock::tryLock() {
-	return false;
+	const void *me = self();
+	if (owner.load(std::memory_order_relaxed) == me) { ++holds; return true; }
+	int c = 0;
+	if (!word.compare_exchange_strong(c, 1, std::memory_order_acquire)) return false;
+	owner.store(me, std::memory_order_relaxed);
+	holds = 1;
+	return true;
 }
 boolean ReentrantLock::tryLock(long time, TimeUnit unit) {
-	return false;
+	const void *me = self();
+	if (owner.load(std::memory_order_relaxed) == me) { ++holds; return true; }
+	jlong nanos = unit.toNanos(time);
+	if (nanos < 0) nanos = 0;
+	if (!(fair ? acquireFair(nanos) : acquire(nanos))) return false;
+	owner.store(me, std::memory_order_relaxed);
+	holds = 1;
+	return true;
 }
 void ReentrantLock::unlock() {
+	if (owner.load(std::memory_order_relaxed) != self()) throw IllegalMonitorStateException();
+	if (--holds > 0) return;
+	owner.store(null, std::memory_order_relaxed);
+	if (fair) releaseFair();
+	else release();
+}
+Condition& ReentrantLock::newCondition() {
+	std::lock_guard<std::mutex> lock(queueLock);
+	conditions.push_back(new ConditionObject(this));
+	return *conditions.back();
+}
+boolean ReentrantLock::isHeldByCurrentThread() const {
+	return owner.load(std::memory_order_relaxed) == self();
+}
+
+class ReentrantReadWriteLock::ReadLock : implements Lock {
+private:
+	ReentrantReadWriteLock& rw;
+public:
+	ReadLock(ReentrantReadWriteLock& rw) : rw(rw) {}
+	void lock() { rw.acquireRead(-1); }
+	void lockInterruptibly() {
+		if (Thread::currentThread().isInterrupted(true)) throw InterruptedException();
+		rw.acquireRead(-1);
+	}
+	boolean tryLock() { return rw.acquireRead(0); }
+	boolean tryLock(long time, TimeUnit unit) {
+		jlong nanos = unit.toNanos(time);
+		return rw.acquireRead(nanos > 0 ? nanos : 0);
+	}
+	void unlock() { rw.releaseRead(); }
+	Condition& newCondition() { throw UnsupportedOperationException(); }
+};
+class ReentrantReadWriteLock::WriteLock : implements Lock {
+private:
+	ReentrantReadWriteLock& rw;
+public:
+	WriteLock(ReentrantReadWriteLock& rw) : rw(rw) {}
+	void lock() { rw.acquireWrite(-1); }
+	void lockInterruptibly() {
+		if (Thread::currentThread().isInterrupted(true)) throw InterruptedException();
+		rw.acquireWrite(-1);
+	}
+	boolean tryLock() { return rw.acquireWrite(0); }
+	boolean tryLock(long time, TimeUnit unit) {
+		jlong nanos = unit.toNanos(time);
+		return rw.acquireWrite(nanos > 0 ? nanos : 0);
+	}
+	void unlock() { rw.releaseWrite(); }
+	Condition& newCondition() {
+		std::lock_guard<std::mutex> lock(rw.conditionsLock);
+		rw.conditions.push_back(new ConditionObject(&rw));
+		return *rw.conditions.back();
+	}
+};
+
+ReentrantReadWriteLock::ReentrantReadWriteLock() : rl(new ReadLock(*this)), wl(new WriteLock(*this)) {}
+ReentrantReadWriteLock::~ReentrantReadWriteLock() {
+	for (Condition *c : conditions) delete c;
+	delete rl;
+	delete wl;
+}
+Lock& ReentrantReadWriteLock::readLock() { return *rl; }
+Lock& ReentrantReadWriteLock::writeLock() { return *wl; }
+
+void ReentrantReadWriteLock::wakeParked() {
+	if (parked.load() > 0) {
+		seq.fetch_add(1);
+		Futex::wakeAll(seq);
+	}
+}
+template<class Ready>
+boolean ReentrantReadWriteLock::park(Ready ready, jlong deadline) {
+	jlong left = leftUntil(deadline);
+	if (left == 0) return false;
+	// a release after the ready() check sees parked and bumps seq
+	int q = seq.load();
+	parked.fetch_add(1);
+	if (!ready()) Futex::wait(seq, q, left);
+	parked.fetch_sub(1);
+	return true;
+}
+
+boolean ReentrantReadWriteLock::acquireRead(jlong nanos) {
+	int *held = readHoldsOf(this);
+	if ((held != null && *held > 0) || writer.load(std::memory_order_relaxed) == self()) {
+		// reentrant read or downgrade, waiting writers must not block it
+		state.fetch_add(1, std::memory_order_acquire);
+		addReadHold(this, held);
+		return true;
+	}
+	auto ready = [this] { return (state.load() & WRITER) == 0 && writersWaiting.load() == 0; };
+	jlong deadline = 0;
+	for (unsigned spins = 0; ; ) {
+		int s = state.load();
+		if ((s & WRITER) == 0 && writersWaiting.load() == 0) {
+			if (state.compare_exchange_weak(s, s + 1, std::memory_order_acquire)) break;
+			continue;
+		}
+		if (nanos == 0) return false;
+		if (spins < spinLimit) { ++spins; cpuRelax(); continue; }
+		if (deadline == 0) deadline = deadlineOf(nanos);
+		if (!park(ready, deadline)) return false;
+	}
+	addReadHold(this, held);
+	return true;
+}
+void ReentrantReadWriteLock::releaseRead() {
+	int *held = readHoldsOf(this);
+	if (held == null || *held == 0) throw IllegalMonitorStateException();
+	if (--*held == 0) removeReadHold(this);
+	// the last reader lets the writers in
+	if (state.fetch_sub(1, std::memory_order_release) == 1) wakeParked();
+}
+boolean ReentrantReadWriteLock::acquireWrite(jlong nanos) {
+	const void *me = self();
+	if (writer.load(std::memory_order_relaxed) == me) { ++writeHolds; return true; }
+	int c = 0;
+	if (!state.compare_exchange_strong(c, WRITER, std::memory_order_acquire)) {
+		if (nanos == 0) return false;
+		auto ready = [this] { return state.load() == 0; };
+		jlong deadline = deadlineOf(nanos);
+		writersWaiting.fetch_add(1);
+		for (unsigned spins = 0; ; ) {
+			int s = state.load();
+			if (s == 0) {
+				if (state.compare_exchange_weak(s, WRITER, std::memory_order_acquire)) break;
+				continue;
+			}
+			if (spins < spinLimit) { ++spins; cpuRelax(); continue; }
+			if (!park(ready, deadline)) {
+				// readers held back by this writer may go
+				writersWaiting.fetch_sub(1);
+				wakeParked();
+				return false;
+			}
+		}
+		writersWaiting.fetch_sub(1);
+	}
+	writer.store(me, std::memory_order_relaxed);
+	writeHolds = 1;
+	return true;
+}
+void ReentrantReadWriteLock::releaseWrite() {
+	if (writer.load(std::memory_order_relaxed) != self()) throw IllegalMonitorStateException();
+	if (--writeHolds > 0) return;
+	writer.store(null, std::memory_order_relaxed);
+	state.fetch_sub(WRITER, std::memory_order_release);
+	wakeParked();
+}
+boolean ReentrantReadWriteLock::isWriteLockedByCurrentThread() const {
+	return writer.load(std::memory_order_relaxed) == self();
+}
+int ReentrantReadWriteLock::getReadHoldCount() const {
+	int *held = readHoldsOf(this);
+	return held != null ? *held : 0;
 }
 
 }}
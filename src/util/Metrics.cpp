@@ -0,0 +1,119 @@
+#include <lang/Exception.hpp>
+#include <util/Metrics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace util {
+
+namespace {
+enum Kind { COUNTER, GAUGE, HISTOGRAM };
+const char *kindNames[] = {"counter", "gauge", "histogram"};
+
+struct Entry {
+	String name;
+	Kind kind;
+	void *metric;
+};
+
+// registration is rare and locks, recording goes to the metric directly
+class Registry {
+private:
+	std::mutex lock;
+	Entry entries[Metrics::MAX_METRICS];
+	int count = 0;
+
+	static void *create(Kind kind) {
+		switch (kind) {
+			case COUNTER: return new util::concurrent::LongAdder();
+			case GAUGE: return new Metrics::Gauge();
+			default: return new Metrics::Histogram();
+		}
+	}
+public:
+	void *lookup(const String& name, Kind kind) {
+		std::lock_guard<std::mutex> g(lock);
+		for (int i = 0; i < count; ++i) {
+			if (!entries[i].name.equals(name)) continue;
+			if (entries[i].kind != kind)
+				throw IllegalArgumentException("metric " + name + " is a " + kindNames[entries[i].kind]);
+			return entries[i].metric;
+		}
+		if (count == Metrics::MAX_METRICS) throw IllegalStateException("too many metrics");
+		entries[count] = Entry{name, kind, create(kind)};
+		return entries[count++].metric;
+	}
+	std::vector<Entry> list() {
+		std::lock_guard<std::mutex> g(lock);
+		return std::vector<Entry>(entries, entries + count);
+	}
+};
+Registry& registry() {
+	static Registry r;
+	return r;
+}
+}
+
+jlong Metrics::Histogram::getCount() const {
+	jlong n = 0;
+	for (const std::atomic<jlong>& c : counts) n += c.load(std::memory_order_relaxed);
+	return n;
+}
+double Metrics::Histogram::getMean() const {
+	jlong n = getCount();
+	return n == 0 ? 0.0 : (double)getSum() / (double)n;
+}
+jlong Metrics::Histogram::percentile(double q) const {
+	jlong n = getCount();
+	if (n == 0) return 0;
+	jlong rank = (jlong)std::ceil(q * (double)n);
+	if (rank < 1) rank = 1;
+	jlong seen = 0;
+	for (int b = 0; b < BUCKETS; ++b) {
+		seen += counts[b].load(std::memory_order_relaxed);
+		if (seen >= rank) return std::min(highestOf(b), getMax());
+	}
+	return getMax();
+}
+void Metrics::Histogram::reset() {
+	for (std::atomic<jlong>& c : counts) c.store(0, std::memory_order_relaxed);
+	total.reset();
+	max.store(0, std::memory_order_relaxed);
+}
+
+util::concurrent::LongAdder& Metrics::counter(const String& name) {
+	return *(util::concurrent::LongAdder *)registry().lookup(name, COUNTER);
+}
+Metrics::Gauge& Metrics::gauge(const String& name) {
+	return *(Gauge *)registry().lookup(name, GAUGE);
+}
+Metrics::Histogram& Metrics::histogram(const String& name) {
+	return *(Histogram *)registry().lookup(name, HISTOGRAM);
+}
+
+void hashMapRehashed() {
+	static util::concurrent::LongAdder& rehashes = Metrics::counter("util.HashMap.rehash");
+	rehashes.increment();
+}
+
+String Metrics::snapshot() {
+	std::vector<Entry> all = registry().list();
+	std::sort(all.begin(), all.end(), [](const Entry& a, const Entry& b) { return a.name.compareTo(b.name) < 0; });
+	StringBuilder sb;
+	for (const Entry& e : all) {
+		sb.append(kindNames[e.kind]).append(' ').append(e.name).append(' ');
+		if (e.kind == COUNTER) sb.append(String::valueOf(((util::concurrent::LongAdder *)e.metric)->sum()));
+		else if (e.kind == GAUGE) sb.append(String::valueOf(((Gauge *)e.metric)->get()));
+		else {
+			const Histogram& h = *(Histogram *)e.metric;
+			sb.append(String::format("count=%ld mean=%.1f p50=%ld p90=%ld p99=%ld p999=%ld max=%ld",
+					h.getCount(), h.getMean(), h.percentile(0.5), h.percentile(0.9), h.percentile(0.99),
+					h.percentile(0.999), h.getMax()));
+		}
+		sb.append('\n');
+	}
+	return sb.toString();
+}
+
+} //namespace util
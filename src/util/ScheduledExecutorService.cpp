@@ -0,0 +1,417 @@
+#include <lang/Exception.hpp>
+#include <lang/Number.hpp>
+#include <lang/System.hpp>
+#include <lang/Thread.hpp>
+#include <util/concurrent/Futex.hpp>
+#include <util/concurrent/ScheduledExecutorService.hpp>
+
+namespace util { namespace concurrent {
+
+namespace {
+enum { FREE, PENDING, RUNNING, CANCELLED };
+const jlong MAX_TICKS = 0xffffffffL;     // span of the wheel
+std::atomic<int> timerNumber{0};
+}
+
+struct ScheduledExecutorService::Node : Link {
+	jlong expires;                           // tick
+	jlong period;                            // ticks: > 0 fixed rate, < 0 fixed delay, 0 once
+	jlong id;                                // 0 when free, stale handles do not match
+	int state;
+	std::function<void()> task;
+
+	void unlink() {
+		prev->next = next;
+		next->prev = prev;
+		prev = next = this;
+	}
+	void append(Link& head) {
+		prev = head.prev;
+		next = &head;
+		head.prev->next = this;
+		head.prev = this;
+	}
+};
+
+// the pool task of a periodic timer, which is finished also when the pool drops it
+class ScheduledExecutorService::Periodic {
+private:
+	ScheduledExecutorService *s;
+	Node *n;
+public:
+	Periodic(ScheduledExecutorService *s, Node *n) : s(s), n(n) {}
+	Periodic(Periodic&& o) : s(o.s), n(o.n) { o.n = null; }
+	~Periodic() { if (n != null) s->finish(n, false); }
+	void operator()() {
+		Node *r = n;
+		n = null;
+		s->runPeriodic(r);
+	}
+};
+
+ScheduledExecutorService::ScheduledExecutorService(int threads, long tick, TimeUnit unit)
+	: ScheduledExecutorService(new ThreadPool(threads), true, unit.toNanos(tick)) {}
+ScheduledExecutorService::ScheduledExecutorService(ThreadPool& pool, long tick, TimeUnit unit)
+	: ScheduledExecutorService(&pool, false, unit.toNanos(tick)) {}
+ScheduledExecutorService::ScheduledExecutorService(ThreadPool *pool, boolean ownPool, jlong tickNanos)
+		: pool(pool), ownPool(ownPool), tickNanos(tickNanos), origin(System::nanoTime()), self(std::make_shared<ScheduledFuture::Owner>(this)) {
+	if (tickNanos <= 0) {
+		if (ownPool) delete pool;
+		throw IllegalArgumentException("tick must be positive");
+	}
+	for (Link& l : root) l.prev = l.next = &l;
+	for (Link (&level)[LEVEL_SIZE] : levels) {
+		for (Link& l : level) l.prev = l.next = &l;
+	}
+	ticker = new lang::Thread([this] { tickerLoop(); });
+	ticker->setName("timer-" + String::valueOf(++timerNumber));
+	ticker->start();
+}
+ScheduledExecutorService::~ScheduledExecutorService() {
+	{
+		// the handles left over see their tasks done
+		std::lock_guard<std::mutex> g(self->lock);
+		self->service = null;
+	}
+	shutdownNow();
+	ticker->join();
+	delete ticker;
+	{
+		std::unique_lock<std::mutex> g(lock);
+		idle.wait(g, [this] { return running == 0; });
+	}
+	if (ownPool) delete pool;
+	for (Node *c : chunks) delete [] c;
+}
+
+ScheduledExecutorService::Node *ScheduledExecutorService::allocNode() {
+	if (freeNodes == null) {
+		Node *c = new Node[CHUNK];
+		chunks.push_back(c);
+		for (int i = 0; i < CHUNK; ++i) {
+			c[i].id = 0;
+			c[i].state = FREE;
+			c[i].next = i + 1 < CHUNK ? &c[i + 1] : null;
+		}
+		freeNodes = c;
+	}
+	Node *n = freeNodes;
+	freeNodes = (Node *)n->next;
+	n->prev = n->next = n;
+	++pending;
+	return n;
+}
+void ScheduledExecutorService::freeNode(Node *n) {
+	n->task = nullptr;
+	n->id = 0;
+	n->state = FREE;
+	n->next = freeNodes;
+	freeNodes = n;
+	--pending;
+}
+
+void ScheduledExecutorService::add(Node *n) {
+	jlong expires = n->expires;
+	jlong idx = expires - jiffies;
+	Link *slot;
+	if (idx < 0) slot = &root[jiffies & (ROOT_SIZE - 1)];
+	else if (idx < ROOT_SIZE) slot = &root[expires & (ROOT_SIZE - 1)];
+	else {
+		// beyond the wheel: park in the last slot, re-added when cascaded
+		if (idx > MAX_TICKS) expires = jiffies + MAX_TICKS, idx = MAX_TICKS;
+		int l = 0;
+		while (l < LEVELS - 1 && idx >= (jlong)1 << (ROOT_BITS + (l + 1) * LEVEL_BITS)) ++l;
+		slot = &levels[l][(expires >> (ROOT_BITS + l * LEVEL_BITS)) & (LEVEL_SIZE - 1)];
+	}
+	n->append(*slot);
+}
+void ScheduledExecutorService::cascade(int level, int index) {
+	Link& head = levels[level][index];
+	Link work;
+	if (head.next == &head) return;
+	work.next = head.next;
+	work.prev = head.prev;
+	work.next->prev = work.prev->next = &work;
+	head.prev = head.next = &head;
+	while (work.next != &work) {
+		Node *n = (Node *)work.next;
+		n->unlink();
+		add(n);
+	}
+}
+void ScheduledExecutorService::expire(jlong until, std::vector<std::function<void()>>& once, std::vector<Node*>& periodic) {
+	while (jiffies <= until) {
+		int index = (int)(jiffies & (ROOT_SIZE - 1));
+		// a lap of the root is over, bring the next slot of each level down
+		for (int l = 0; index == 0 && l < LEVELS; ++l) {
+			int i = (int)((jiffies >> (ROOT_BITS + l * LEVEL_BITS)) & (LEVEL_SIZE - 1));
+			cascade(l, i);
+			if (i != 0) break;
+		}
+		Link& head = root[index];
+		++jiffies;
+		while (head.next != &head) {
+			Node *n = (Node *)head.next;
+			n->unlink();
+			if (n->period == 0) {
+				once.push_back(std::move(n->task));
+				freeNode(n);
+			}
+			else {
+				n->state = RUNNING;
+				++running;
+				periodic.push_back(n);
+			}
+		}
+	}
+}
+jlong ScheduledExecutorService::nextTick() {
+	// the next occupied root slot, at latest the next cascade
+	jlong lap = (jiffies + ROOT_SIZE - 1) & ~(jlong)(ROOT_SIZE - 1);
+	for (jlong t = jiffies; t < lap; ++t) {
+		Link& head = root[t & (ROOT_SIZE - 1)];
+		if (head.next != &head) return t;
+	}
+	return lap;
+}
+
+jlong ScheduledExecutorService::currentTick() const {
+	return (System::nanoTime() - origin) / tickNanos;
+}
+jlong ScheduledExecutorService::ticksOf(jlong nanos) const {
+	if (nanos <= 0) return 0;
+	return nanos / tickNanos + (nanos % tickNanos != 0 ? 1 : 0);
+}
+jlong ScheduledExecutorService::deadline(jlong delay) const {
+	jlong elapsed = System::nanoTime() - origin;
+	if (delay > (jlong)Long::MAX_VALUE - elapsed) delay = (jlong)Long::MAX_VALUE - elapsed;
+	return ticksOf(elapsed + delay);
+}
+void ScheduledExecutorService::wakeTicker() {
+	wakeups.fetch_add(1);
+	Futex::wake(wakeups, 1);
+}
+
+void ScheduledExecutorService::tickerLoop() {
+	std::vector<std::function<void()>> once;
+	std::vector<Node*> periodic;
+	std::unique_lock<std::mutex> g(lock);
+	while (!stopped && !(shut && pending == 0)) {
+		jlong now = currentTick();
+		// an empty wheel has no ticks to replay
+		if (pending == 0 && now > jiffies) jiffies = now;
+		if (now >= jiffies) {
+			expire(now, once, periodic);
+			if (once.empty() && periodic.empty()) continue;
+			g.unlock();
+			for (std::function<void()>& f : once) {
+				try { pool->execute(std::move(f)); }
+				catch (const RejectedExecutionException& e) {}
+			}
+			for (Node *n : periodic) {
+				try { pool->execute(Periodic(this, n)); }
+				catch (const RejectedExecutionException& e) {}
+			}
+			once.clear();
+			periodic.clear();
+			g.lock();
+			continue;
+		}
+		jlong next = pending == 0 ? -1 : nextTick();
+		sleepUntil = next < 0 ? (jlong)Long::MAX_VALUE : next;
+		int w = wakeups.load();
+		g.unlock();
+		jlong nanos = -1;
+		if (next >= 0) {
+			nanos = origin + next * tickNanos - System::nanoTime();
+			if (nanos < 0) nanos = 0;
+		}
+		Futex::wait(wakeups, w, nanos);
+		g.lock();
+		sleepUntil = -1;
+	}
+}
+
+void ScheduledExecutorService::runPeriodic(Node *n) {
+	boolean skip;
+	{
+		std::lock_guard<std::mutex> g(lock);
+		skip = n->state == CANCELLED || shut;
+	}
+	if (skip) {
+		finish(n, false);
+		return;
+	}
+	try {
+		n->task();
+	} catch (...) {
+		finish(n, false);
+		throw;
+	}
+	finish(n, true);
+}
+void ScheduledExecutorService::finish(Node *n, boolean again) {
+	boolean wake;
+	std::function<void()> dropped;
+	{
+		std::lock_guard<std::mutex> g(lock);
+		if (!again || n->state == CANCELLED || shut) dropped = std::move(n->task);
+		wake = finishLocked(n, again);
+	}
+	if (wake) wakeTicker();
+}
+boolean ScheduledExecutorService::finishLocked(Node *n, boolean again) {
+	boolean wake = false;
+	if (!again || n->state == CANCELLED || shut) {
+		freeNode(n);
+		wake = shut && pending == 0;
+	}
+	else {
+		n->expires = n->period > 0 ? n->expires + n->period : deadline(0) - n->period;
+		n->state = PENDING;
+		add(n);
+		wake = sleepUntil >= 0 && n->expires < sleepUntil;
+	}
+	if (wake) sleepUntil = -1;
+	if (--running == 0) idle.notify_all();
+	return wake;
+}
+
+ScheduledFuture ScheduledExecutorService::insert(std::function<void()>&& task, jlong delay, jlong period) {
+	Node *n;
+	jlong id;
+	boolean wake;
+	{
+		std::lock_guard<std::mutex> g(lock);
+		if (shut) throw RejectedExecutionException();
+		// the ticker slept through the ticks of an empty wheel, do not replay them
+		if (pending == 0) {
+			jlong now = currentTick();
+			if (now > jiffies) jiffies = now;
+		}
+		n = allocNode();
+		n->task = std::move(task);
+		n->expires = deadline(delay);
+		n->period = period;
+		n->state = PENDING;
+		n->id = id = ++nextId;
+		add(n);
+		wake = sleepUntil >= 0 && n->expires < sleepUntil;
+		if (wake) sleepUntil = -1;
+	}
+	if (wake) wakeTicker();
+	return ScheduledFuture(self, n, id);
+}
+
+ScheduledFuture ScheduledExecutorService::schedule(std::function<void()> task, jlong delay, TimeUnit unit) {
+	return insert(std::move(task), unit.toNanos(delay), 0);
+}
+ScheduledFuture ScheduledExecutorService::scheduleAtFixedRate(std::function<void()> task, jlong initialDelay, jlong period, TimeUnit unit) {
+	if (period <= 0) throw IllegalArgumentException("period must be positive");
+	return insert(std::move(task), unit.toNanos(initialDelay), ticksOf(unit.toNanos(period)));
+}
+ScheduledFuture ScheduledExecutorService::scheduleWithFixedDelay(std::function<void()> task, jlong initialDelay, jlong delay, TimeUnit unit) {
+	if (delay <= 0) throw IllegalArgumentException("delay must be positive");
+	return insert(std::move(task), unit.toNanos(initialDelay), -ticksOf(unit.toNanos(delay)));
+}
+
+template<class F> void ScheduledExecutorService::drain(F f) {
+	Link *heads[] = {root, levels[0], levels[1], levels[2], levels[3]};
+	int sizes[] = {ROOT_SIZE, LEVEL_SIZE, LEVEL_SIZE, LEVEL_SIZE, LEVEL_SIZE};
+	for (int h = 0; h < LEVELS + 1; ++h) {
+		for (int i = 0; i < sizes[h]; ++i) {
+			Link& head = heads[h][i];
+			for (Link *l = head.next; l != &head; ) {
+				Node *n = (Node *)l;
+				l = l->next;
+				f(n);
+			}
+		}
+	}
+}
+
+void ScheduledExecutorService::shutdown() {
+	std::vector<std::function<void()>> dropped;
+	{
+		std::lock_guard<std::mutex> g(lock);
+		if (shut) return;
+		shut = true;
+		drain([this, &dropped](Node *n) {
+			if (n->period == 0) return;
+			n->unlink();
+			dropped.push_back(std::move(n->task));
+			freeNode(n);
+		});
+	}
+	wakeTicker();
+}
+int ScheduledExecutorService::shutdownNow() {
+	std::vector<std::function<void()>> dropped;
+	{
+		std::lock_guard<std::mutex> g(lock);
+		shut = stopped = true;
+		drain([this, &dropped](Node *n) {
+			n->unlink();
+			dropped.push_back(std::move(n->task));
+			freeNode(n);
+		});
+	}
+	wakeTicker();
+	return (int)dropped.size();
+}
+boolean ScheduledExecutorService::isShutdown() {
+	std::lock_guard<std::mutex> g(lock);
+	return shut;
+}
+long ScheduledExecutorService::size() {
+	std::lock_guard<std::mutex> g(lock);
+	return pending;
+}
+
+boolean ScheduledExecutorService::cancel(void *node, jlong id) {
+	std::function<void()> dropped;
+	std::lock_guard<std::mutex> g(lock);
+	Node *n = (Node *)node;
+	if (n->id != id) return false;
+	if (n->state == PENDING) {
+		n->unlink();
+		dropped = std::move(n->task);
+		freeNode(n);
+		return true;
+	}
+	if (n->state == RUNNING) {
+		n->state = CANCELLED;
+		return true;
+	}
+	return false;
+}
+boolean ScheduledExecutorService::isDone(void *node, jlong id) {
+	std::lock_guard<std::mutex> g(lock);
+	Node *n = (Node *)node;
+	return n->id != id || n->state == CANCELLED;
+}
+jlong ScheduledExecutorService::getDelay(void *node, jlong id, TimeUnit unit) {
+	std::lock_guard<std::mutex> g(lock);
+	Node *n = (Node *)node;
+	if (n->id != id || n->state != PENDING) return 0;
+	jlong nanos = origin + n->expires * tickNanos - System::nanoTime();
+	return unit.convert(nanos < 0 ? 0 : nanos, TimeUnit::NANOSECONDS);
+}
+
+boolean ScheduledFuture::cancel() {
+	if (owner == null) return false;
+	std::lock_guard<std::mutex> g(owner->lock);
+	return owner->service != null && owner->service->cancel(node, id);
+}
+boolean ScheduledFuture::isDone() const {
+	if (owner == null) return true;
+	std::lock_guard<std::mutex> g(owner->lock);
+	return owner->service == null || owner->service->isDone(node, id);
+}
+jlong ScheduledFuture::getDelay(TimeUnit unit) const {
+	if (owner == null) return 0;
+	std::lock_guard<std::mutex> g(owner->lock);
+	return owner->service == null ? 0 : owner->service->getDelay(node, id, unit);
+}
+
+}}
@@ -0,0 +1,134 @@
+#include <lang/System.hpp>
+#include <util/concurrent/Futex.hpp>
+#include <util/concurrent/StampedLock.hpp>
+#include <thread>
+
+namespace util { namespace concurrent {
+
+namespace {
+// spinning only helps when the holder can run meanwhile
+const unsigned spinLimit = std::thread::hardware_concurrency() > 1 ? 100 : 0;
+
+inline void cpuRelax() {
+#if defined(__i386__) || defined(__x86_64__)
+	__builtin_ia32_pause();
+#endif
+}
+}
+
+void StampedLock::wakeWaiters() {
+	if (waiters.load() > 0) {
+		seq.fetch_add(1);
+		Futex::wakeAll(seq);
+	}
+}
+boolean StampedLock::park(jlong s, jlong deadline) {
+	jlong left = -1;
+	if (deadline != 0) {
+		left = deadline - System::nanoTime();
+		if (left <= 0) return false;
+	}
+	// an unlock after the state check sees waiters and bumps seq
+	int q = seq.load();
+	waiters.fetch_add(1);
+	if (state.load() == s) Futex::wait(seq, q, left);
+	waiters.fetch_sub(1);
+	return true;
+}
+
+jlong StampedLock::acquireWrite(jlong nanos) {
+	jlong deadline = 0;
+	boolean waiting = false;
+	for (unsigned spins = 0; ; ) {
+		jlong s = state.load();
+		if ((s & (WBIT | RBITS)) == 0) {
+			if (state.compare_exchange_weak(s, s + WBIT, std::memory_order_acquire)) {
+				if (waiting) writersWaiting.fetch_sub(1);
+				// the data writes stay after the writer bit for optimistic readers
+				std::atomic_thread_fence(std::memory_order_release);
+				return s + WBIT;
+			}
+			continue;
+		}
+		if (nanos == 0) return 0;
+		if (spins < spinLimit) { ++spins; cpuRelax(); continue; }
+		if (!waiting) {
+			waiting = true;
+			writersWaiting.fetch_add(1);
+			if (nanos > 0) deadline = System::nanoTime() + nanos;
+		}
+		if (!park(s, deadline)) {
+			// readers held back by this writer may go
+			writersWaiting.fetch_sub(1);
+			wakeWaiters();
+			return 0;
+		}
+	}
+}
+jlong StampedLock::acquireRead(jlong nanos) {
+	jlong deadline = 0;
+	boolean waited = false;
+	for (unsigned spins = 0; ; ) {
+		jlong s = state.load();
+		// writer preferring, except for tryReadLock()
+		if ((s & WBIT) == 0 && (s & RBITS) < RBITS && (nanos == 0 || writersWaiting.load() == 0)) {
+			if (state.compare_exchange_weak(s, s + 1, std::memory_order_acquire)) return s + 1;
+			continue;
+		}
+		if (nanos == 0) return 0;
+		if (spins < spinLimit) { ++spins; cpuRelax(); continue; }
+		if (!waited && nanos > 0) deadline = System::nanoTime() + nanos;
+		waited = true;
+		if (!park(s, deadline)) return 0;
+	}
+}
+
+jlong StampedLock::tryWriteLock() {
+	jlong s = state.load();
+	if ((s & (WBIT | RBITS)) != 0 || !state.compare_exchange_strong(s, s + WBIT, std::memory_order_acquire)) return 0;
+	std::atomic_thread_fence(std::memory_order_release);
+	return s + WBIT;
+}
+jlong StampedLock::tryReadLock() {
+	return acquireRead(0);
+}
+
+void StampedLock::unlockWrite(jlong stamp) {
+	if ((stamp & WBIT) == 0 || state.load() != stamp) throw IllegalMonitorStateException();
+	// clears the writer bit carrying into the version
+	jlong next = stamp + WBIT;
+	state.store(next == 0 ? ORIGIN : next, std::memory_order_release);
+	wakeWaiters();
+}
+void StampedLock::unlockRead(jlong stamp) {
+	for (;;) {
+		jlong s = state.load();
+		if ((stamp & RBITS) == 0 || (s & SBITS) != (stamp & SBITS) || (s & RBITS) == 0) throw IllegalMonitorStateException();
+		if (state.compare_exchange_weak(s, s - 1, std::memory_order_release)) {
+			if ((s & RBITS) == 1 || (s & RBITS) == RBITS) wakeWaiters();
+			return;
+		}
+	}
+}
+void StampedLock::unlock(jlong stamp) {
+	if ((stamp & WBIT) != 0) unlockWrite(stamp);
+	else unlockRead(stamp);
+}
+
+jlong StampedLock::tryConvertToWriteLock(jlong stamp) {
+	for (;;) {
+		jlong s = state.load();
+		if (stamp == 0 || (s & SBITS & ~WBIT) != (stamp & SBITS & ~WBIT)) return 0;
+		if ((stamp & WBIT) != 0) return s == stamp ? stamp : 0;
+		if ((s & WBIT) != 0) return 0;
+		jlong readers = stamp & RBITS;
+		// optimistic: free; read: the only reader
+		if ((readers == 0 && (s & RBITS) != 0) || (readers != 0 && (s & RBITS) != 1)) return 0;
+		if (state.compare_exchange_weak(s, (s & ~RBITS) + WBIT, std::memory_order_acquire)) {
+			std::atomic_thread_fence(std::memory_order_release);
+			return (s & ~RBITS) + WBIT;
+		}
+	}
+}
+
+}}
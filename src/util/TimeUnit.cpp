@@ -0,0 +1,27 @@
+#include <lang/Number.hpp>
+#include <lang/Thread.hpp>
+#include <util/concurrent/TimeUnit.hpp>
+
+namespace util { namespace concurrent {
+
+const TimeUnit TimeUnit::NANOSECONDS(1l, "NANOSECONDS");
+const TimeUnit TimeUnit::MICROSECONDS(1000l, "MICROSECONDS");
+const TimeUnit TimeUnit::MILLISECONDS(1000000l, "MILLISECONDS");
+const TimeUnit TimeUnit::SECONDS(1000000000l, "SECONDS");
+const TimeUnit TimeUnit::MINUTES(60000000000l, "MINUTES");
+const TimeUnit TimeUnit::HOURS(3600000000000l, "HOURS");
+const TimeUnit TimeUnit::DAYS(86400000000000l, "DAYS");
+
+jlong TimeUnit::cvt(jlong d, jlong dst, jlong src) {
+	if (src == dst) return d;
+	if (src < dst) return d / (dst / src);
+	jlong r;
+	if (__builtin_mul_overflow(d, src / dst, &r)) return d < 0 ? (jlong)Long::MIN_VALUE : (jlong)Long::MAX_VALUE;
+	return r;
+}
+
+void TimeUnit::sleep(jlong timeout) const {
+	if (timeout > 0) Thread::sleep(toMillis(timeout));
+}
+
+}}
@@ -0,0 +1,627 @@
+#include <lang/Affinity.hpp>
+#include <lang/Fiber.hpp>
+#include <lang/System.hpp>
+#include <lang/Thread.hpp>
+#include <SyncQueue.hpp>
+#include <ThreadPool.hpp>
+#include <util/HashMap.hpp>
+#include <util/Metrics.hpp>
+#include <util/concurrent/ConcurrentHashMap.hpp>
+#include <util/concurrent/Future.hpp>
+#include <util/concurrent/Lock.hpp>
+#include <util/concurrent/ScheduledExecutorService.hpp>
+#include <util/concurrent/StampedLock.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <new>
+#include <queue>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+std::atomic<long> allocations{0};
+}
+// count every allocation made by the workloads below
+void *operator new(std::size_t n) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	void *p = std::malloc(n);
+	if (p == null) throw std::bad_alloc();
+	return p;
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+// n operations done by run(n), which returns when all are complete
+template<class F>
+void bench(const String& name, int n, F run) {
+	long a0 = allocations.load();
+	jlong t0 = System::nanoTime();
+	run(n);
+	jlong t = System::nanoTime() - t0;
+	System::out.printf("%-44s %10.1f ns/op %8.2f allocs/op\n", name.cstr(), (double)t/n, (double)(allocations.load() - a0)/n);
+}
+
+// the former SyncQueue: std::queue behind a mutex and condition variable
+template<class T>
+class FormerSyncQueue {
+	std::queue<T> queue;
+	std::mutex mutex;
+	std::condition_variable cond;
+	bool running = true;
+public:
+	void stop() {
+		running = false;
+		cond.notify_all();
+	}
+	bool isEmpty() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return queue.empty();
+	}
+	void enqueue(T& o) {
+		std::unique_lock<std::mutex> lock(mutex);
+		if (!running) throw SyncQueueException();
+		queue.push(o);
+		lock.unlock();
+		cond.notify_one();
+	}
+	T dequeue() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (queue.empty() && running) cond.wait(lock);
+		if (queue.empty()) throw SyncQueueException();
+		auto o = std::move(queue.front());
+		queue.pop();
+		return o;
+	}
+};
+
+// the former ThreadPool: one SyncQueue of std::function, with its workers actually started
+class FormerThreadPool {
+	FormerSyncQueue<std::function<void()>> queue;
+	std::vector<std::thread*> workers;
+public:
+	FormerThreadPool(int threads) {
+		for (int i=0; i < threads; ++i) workers.push_back(new std::thread([this] {
+			try {
+				while (true) queue.dequeue()();
+			} catch (const SyncQueueException& e) {}
+		}));
+	}
+	~FormerThreadPool() {
+		while (!queue.isEmpty()) std::this_thread::yield();
+		queue.stop();
+		for (std::thread *t : workers) { t->join(); delete t; }
+	}
+	void enqueue(std::function<void()> f) { queue.enqueue(f); }
+};
+
+// items carry their enqueue time, consumers collect the latencies
+struct Stamp {
+	jlong t0;
+};
+template<class Put, class Take>
+void benchQueue(const String& name, int producers, int consumers, int items, Put put, Take take) {
+	std::vector<std::vector<jlong>> latencies((size_t)consumers);
+	std::vector<std::thread*> threads;
+	jlong t0 = System::nanoTime();
+	for (int c=0; c < consumers; ++c) threads.push_back(new std::thread([&, c] {
+		std::vector<jlong>& lat = latencies[(size_t)c];
+		lat.reserve((size_t)(items / consumers));
+		for (int i=0; i < items / consumers; ++i) lat.push_back(System::nanoTime() - take().t0);
+	}));
+	for (int p=0; p < producers; ++p) threads.push_back(new std::thread([&] {
+		for (int i=0; i < items / producers; ++i) put(Stamp{System::nanoTime()});
+	}));
+	for (std::thread *t : threads) { t->join(); delete t; }
+	jlong t = System::nanoTime() - t0;
+	std::vector<jlong> all;
+	for (const std::vector<jlong>& l : latencies) all.insert(all.end(), l.begin(), l.end());
+	std::sort(all.begin(), all.end());
+	auto at = [&all](double q) { return (double)all[(size_t)(q * (double)(all.size() - 1))] / 1000; };
+	System::out.printf("%-44s %10.1f ns/op  p50 %7.1f  p99 %8.1f  p99.9 %8.1f us\n",
+			name.cstr(), (double)t/items, at(0.5), at(0.99), at(0.999));
+}
+
+void bench_queues() {
+	const int items = 160000;
+	const int counts[] = {1, 4, 16};
+	for (int n : counts) {
+		String pc = String::valueOf(n) + ":" + String::valueOf(n);
+		{
+			FormerSyncQueue<Stamp> q;
+			benchQueue("former SyncQueue " + pc, n, n, items, [&q](Stamp s) { q.enqueue(s); }, [&q] { return q.dequeue(); });
+		}
+		{
+			util::concurrent::MPMCQueue<Stamp> q(1024);
+			benchQueue("MPMCQueue " + pc, n, n, items, [&q](Stamp s) { q.enqueue(s); }, [&q] { Stamp s; q.dequeue(s); return s; });
+		}
+	}
+	// batches of 16 each way
+	util::concurrent::MPMCQueue<Stamp> q(1024);
+	std::vector<std::thread*> threads;
+	jlong t0 = System::nanoTime();
+	for (int c=0; c < 4; ++c) threads.push_back(new std::thread([&q] {
+		Stamp buf[16];
+		for (int got = 0; got < items / 4; ) got += q.dequeueN(buf, std::min(16, items / 4 - got));
+	}));
+	for (int p=0; p < 4; ++p) threads.push_back(new std::thread([&q] {
+		Stamp buf[16];
+		for (int i=0; i < items / 4; i += 16) {
+			for (Stamp& s : buf) s.t0 = System::nanoTime();
+			q.enqueueN(buf, 16);
+		}
+	}));
+	for (std::thread *t : threads) { t->join(); delete t; }
+	System::out.printf("%-44s %10.1f ns/op\n", "MPMCQueue 4:4, batches of 16", (double)(System::nanoTime() - t0)/items);
+}
+
+void waitFor(std::atomic<long>& done, long n) {
+	while (done.load() < n) std::this_thread::yield();
+}
+// a task with a few captures, beyond the inline buffer of std::function
+struct Work {
+	std::atomic<long> *done;
+	long a, b, c;
+	void operator()() const { done->fetch_add(a + b + c - 2); }
+};
+
+double work(long i) {
+	double x = (double)i;
+	for (int k=0; k < 200; ++k) x = x * 0.999 + 1.0;
+	return x;
+}
+
+void bench_pools(int threads) {
+	const int ops = 200000;
+	String n = String::valueOf(threads);
+	{
+		FormerThreadPool pool(threads);
+		bench("former pool, " + n + " threads, submit", ops, [&pool](int n) {
+			std::atomic<long> done{0};
+			for (int i=0; i < n; ++i) pool.enqueue(Work{&done, 1, 1, 1});
+			waitFor(done, n);
+		});
+	}
+	{
+		ThreadPool pool(threads);
+		bench("work stealing, " + n + " threads, submit", ops, [&pool](int n) {
+			std::atomic<long> done{0};
+			for (int i=0; i < n; ++i) pool.execute(Work{&done, 1, 1, 1});
+			waitFor(done, n);
+		});
+		bench("work stealing, " + n + " threads, fork from tasks", ops, [&pool](int n) {
+			std::atomic<long> done{0};
+			// tasks submitted by the workers go to their own deques
+			const int roots = 64;
+			for (int r=0; r < roots; ++r) pool.execute([&pool, &done, n] {
+				for (int i=0; i < n / roots; ++i) pool.execute(Work{&done, 1, 1, 1});
+			});
+			waitFor(done, n / roots * roots);
+		});
+	}
+
+	const int items = 1000000;
+	{
+		FormerThreadPool pool(threads);
+		bench("former pool, " + n + " threads, chunked sum", items, [&pool, threads](int n) {
+			const int chunks = 8 * threads;
+			std::atomic<long> done{0};
+			std::vector<double> sums((size_t)chunks);
+			for (int c=0; c < chunks; ++c) pool.enqueue([&done, &sums, c, n, chunks] {
+				double s = 0;
+				for (long i = (long)n * c / chunks; i < (long)n * (c + 1) / chunks; ++i) s += work(i);
+				sums[(size_t)c] = s;
+				done.fetch_add(1);
+			});
+			waitFor(done, chunks);
+		});
+	}
+	{
+		ThreadPool pool(threads);
+		bench("work stealing, " + n + " threads, parallelReduce", items, [&pool](int n) {
+			double s = pool.parallelReduce(0, n, 0, 0.0, [](long lo, long hi) {
+				double s = 0;
+				for (long i = lo; i < hi; ++i) s += work(i);
+				return s;
+			}, [](double a, double b) { return a + b; });
+			if (s == 0) System::out.println("");
+		});
+	}
+}
+
+// threads doing n operations altogether
+template<class Op>
+void contended(const String& name, int threads, int n, Op op) {
+	bench(name + ", " + String::valueOf(threads) + " threads", n, [threads, &op](int n) {
+		std::vector<std::thread*> all;
+		for (int t=0; t < threads; ++t) all.push_back(new std::thread([&op, n, threads] {
+			for (int i=0; i < n / threads; ++i) op(i);
+		}));
+		for (std::thread *t : all) { t->join(); delete t; }
+	});
+}
+
+void bench_locks() {
+	using namespace util::concurrent;
+	const int ops = 400000;
+	for (int threads = 1; threads <= 8; threads *= 2) {
+		long counter = 0;
+		std::mutex m;
+		contended("std::mutex", threads, ops, [&](int) { std::lock_guard<std::mutex> g(m); ++counter; });
+		ReentrantLock unfair, fair(true);
+		contended("ReentrantLock", threads, ops, [&](int) { unfair.lock(); ++counter; unfair.unlock(); });
+		contended("ReentrantLock fair", threads, ops / 10, [&](int) { fair.lock(); ++counter; fair.unlock(); });
+	}
+	// read-mostly: 90% reads of a pair, 10% writes
+	for (int threads = 1; threads <= 8; threads *= 2) {
+		jlong a = 0, b = 0;
+		std::atomic<jlong> seen{0};
+		std::mutex m;
+		contended("std::mutex 90% reads", threads, ops, [&](int i) {
+			std::lock_guard<std::mutex> g(m);
+			if (i % 10 == 0) { ++a; ++b; }
+			else seen.store(a + b, std::memory_order_relaxed);
+		});
+		ReentrantReadWriteLock rw;
+		contended("ReentrantReadWriteLock 90% reads", threads, ops, [&](int i) {
+			if (i % 10 == 0) { rw.writeLock().lock(); ++a; ++b; rw.writeLock().unlock(); }
+			else { rw.readLock().lock(); seen.store(a + b, std::memory_order_relaxed); rw.readLock().unlock(); }
+		});
+		StampedLock sl;
+		contended("StampedLock read lock 90% reads", threads, ops, [&](int i) {
+			if (i % 10 == 0) { jlong s = sl.writeLock(); ++a; ++b; sl.unlockWrite(s); }
+			else { jlong s = sl.readLock(); seen.store(a + b, std::memory_order_relaxed); sl.unlockRead(s); }
+		});
+		contended("StampedLock optimistic 90% reads", threads, ops, [&](int i) {
+			if (i % 10 == 0) { jlong s = sl.writeLock(); ++a; ++b; sl.unlockWrite(s); return; }
+			jlong s = sl.tryOptimisticRead();
+			jlong v = a + b;
+			if (!sl.validate(s)) {
+				s = sl.readLock();
+				v = a + b;
+				sl.unlockRead(s);
+			}
+			seen.store(v, std::memory_order_relaxed);
+		});
+	}
+}
+
+// keys spread over the map, readPercent of the operations are lookups, the rest put or remove
+void bench_maps() {
+	const int ops = 400000;
+	const long keys = 4096;
+	const int mixes[] = {95, 50};
+	for (int readPercent : mixes) {
+		String mix = String::valueOf(readPercent) + "% reads";
+		for (int threads = 1; threads <= 8; threads *= 2) {
+			util::HashMap<long,long> former;
+			util::concurrent::ConcurrentHashMap<long,long> map;
+			for (long k = 0; k < keys; k += 2) {
+				former.put(k, k);
+				map.put(k, k);
+			}
+			std::atomic<long> found{0};
+			contended("former synchronized HashMap " + mix, threads, ops, [&](int i) {
+				long k = (long)(((unsigned)i * 2654435761u) % keys);
+				synchronized(former) {
+					if (i % 100 < readPercent) { if (former.containsKey(k)) found.fetch_add(former.get(k), std::memory_order_relaxed); }
+					else if (i % 2 == 0) former.put(k, k);
+					else former.remove(k);
+				}
+			});
+			contended("ConcurrentHashMap " + mix, threads, ops, [&](int i) {
+				long k = (long)(((unsigned)i * 2654435761u) % keys);
+				long v;
+				if (i % 100 < readPercent) { if (map.get(k, v)) found.fetch_add(v, std::memory_order_relaxed); }
+				else if (i % 2 == 0) map.put(k, k);
+				else map.remove(k);
+			});
+		}
+	}
+}
+
+// a shared std::atomic against the striped LongAdder, and histogram recording
+void bench_counters() {
+	const int ops = 2000000;
+	for (int threads = 1; threads <= 8; threads *= 2) {
+		std::atomic<jlong> shared{0};
+		contended("std::atomic fetch_add", threads, ops, [&shared](int) { shared.fetch_add(1, std::memory_order_relaxed); });
+		util::concurrent::LongAdder adder;
+		contended("LongAdder increment", threads, ops, [&adder](int) { adder.increment(); });
+		util::Metrics::Histogram& h = util::Metrics::histogram("bench.histogram");
+		contended("Metrics::Histogram record", threads, ops, [&h](int i) { h.record(i); });
+	}
+}
+
+// the usual timer queue: deadlines ordered in a multimap behind a mutex
+class FormerTimerQueue {
+	typedef std::multimap<jlong, std::function<void()>> Timers;
+	std::mutex mutex;
+	Timers timers;
+public:
+	Timers::iterator schedule(std::function<void()> task, jlong delay) {
+		std::lock_guard<std::mutex> lock(mutex);
+		return timers.emplace(System::nanoTime() + delay, std::move(task));
+	}
+	void cancel(Timers::iterator t) {
+		std::lock_guard<std::mutex> lock(mutex);
+		timers.erase(t);
+	}
+};
+
+// connection timeouts: a timer armed and cancelled per request, a million more pending
+void bench_timers() {
+	using namespace util::concurrent;
+	const int ops = 1000000;
+	const int outstanding = 1000000;
+	const jlong second = 1000000000L;
+	FormerTimerQueue former;
+	ScheduledExecutorService timer;
+	for (int i=0; i < outstanding; ++i) {
+		former.schedule([] {}, (10 + i % 50) * second);
+		timer.schedule([] {}, (10 + i % 50) * second, TimeUnit::NANOSECONDS);
+	}
+	for (int threads = 1; threads <= 4; threads *= 2) {
+		contended("former multimap timers schedule+cancel", threads, ops, [&former](int i) {
+			former.cancel(former.schedule([] {}, (30 + i % 7) * second));
+		});
+		contended("ScheduledExecutorService schedule+cancel", threads, ops, [&timer](int i) {
+			timer.schedule([] {}, (30 + i % 7) * second, TimeUnit::NANOSECONDS).cancel();
+		});
+	}
+	System::out.printf("%ld timers pending\n", timer.size());
+}
+
+// round trips of a flag between two threads, on the given CPUs (unpinned when empty)
+void pingPong(const String& name, const CpuSet& a, const CpuSet& b) {
+	const int rounds = 100000;
+	bench(name, rounds, [&a, &b](int n) {
+		std::atomic<int> ball{0};
+		auto play = [&ball, n](int side) {
+			for (int i = side; i < 2 * n; i += 2) {
+				for (int spins = 0; ball.load(std::memory_order_acquire) != i; ++spins) {
+					if (spins > 100) std::this_thread::yield();
+				}
+				ball.store(i + 1, std::memory_order_release);
+			}
+		};
+		Thread pong([&play] { play(1); });
+		pong.setAffinity(b);
+		CpuSet saved = Thread::currentThread().getAffinity();
+		Thread::currentThread().setAffinity(a);
+		pong.start();
+		play(0);
+		pong.join();
+		Thread::currentThread().setAffinity(saved);
+	});
+}
+
+// ping-pong latency: free threads, pinned to one core, to two cores of a node, across nodes
+void bench_affinity() {
+	CpuSet online = CpuSet::online();
+	int first = online.nextSetBit(0);
+	int node = Numa::nodeOfCpu(first);
+	CpuSet local = Numa::cpusOfNode(node);
+	local.andWith(online);
+	int neighbour = local.nextSetBit(first + 1);
+	pingPong("ping-pong unpinned", CpuSet(), CpuSet());
+	pingPong("ping-pong pinned, same CPU", CpuSet({first}), CpuSet({first}));
+	if (neighbour >= 0) pingPong("ping-pong pinned, same node", CpuSet({first}), CpuSet({neighbour}));
+	for (int n = 0; n < Numa::nodeCount(); ++n) {
+		if (n == node) continue;
+		CpuSet remote = Numa::cpusOfNode(n);
+		remote.andWith(online);
+		if (remote.isEmpty()) continue;
+		pingPong("ping-pong pinned, across nodes", CpuSet({first}), CpuSet({remote.nextSetBit(0)}));
+		break;
+	}
+}
+
+// resident set size of the process
+long residentBytes() {
+	long pages = 0, resident = 0;
+	FILE *f = std::fopen("/proc/self/statm", "r");
+	if (f == null) return 0;
+	if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+	std::fclose(f);
+	return resident * ::sysconf(_SC_PAGESIZE);
+}
+
+// sessions which block: fibers parked on a few carriers against a thread each
+void bench_fibers() {
+	const int rounds = 200000;
+	FiberScheduler one(1);
+	bench("Fiber yield, switch", 2 * rounds, [&one](int n) {
+		auto play = [n] { for (int i = 0; i < n / 2; ++i) Fiber::yield(); };
+		Fiber a(one, play), b(one, play);
+		a.start();
+		b.start();
+		a.join();
+		b.join();
+	});
+	bench("Fiber park/unpark, round trip", rounds, [&one](int n) {
+		std::atomic<int> ball{0};
+		Fiber *pong = null;
+		Fiber ping(one, [&] {
+			for (int i = 0; i < 2 * n; i += 2) {
+				ball.store(i + 1, std::memory_order_release);
+				Fiber::unpark(*pong);
+				while (ball.load(std::memory_order_acquire) != i + 2) Fiber::park();
+			}
+		});
+		Fiber back(one, [&] {
+			for (int i = 1; i < 2 * n; i += 2) {
+				while (ball.load(std::memory_order_acquire) != i) Fiber::park();
+				ball.store(i + 1, std::memory_order_release);
+				Fiber::unpark(ping);
+			}
+		});
+		pong = &back;
+		back.start();
+		ping.start();
+		ping.join();
+		back.join();
+	});
+	bench("former threads condition variable, round trip", rounds / 4, [](int n) {
+		std::mutex m;
+		std::condition_variable cv;
+		int ball = 0;
+		auto play = [&](int side) {
+			std::unique_lock<std::mutex> lock(m);
+			for (int i = side; i < 2 * n; i += 2) {
+				cv.wait(lock, [&] { return ball == i; });
+				ball = i + 1;
+				cv.notify_one();
+			}
+		};
+		Thread pong([&play] { play(1); });
+		pong.start();
+		play(0);
+		pong.join();
+	});
+
+	const int sessions = 100000;
+	std::atomic<int> parked{0};
+	std::atomic<boolean> open{false};
+	std::vector<std::unique_ptr<Fiber>> fibers;
+	fibers.reserve(sessions);
+	long rss0 = residentBytes();
+	// started by an acceptor fiber, as a server would
+	bench("Fiber start, park, unpark, join (100k)", sessions, [&](int n) {
+		Fiber acceptor([&] {
+			for (int i = 0; i < n; ++i) {
+				fibers.emplace_back(new Fiber([&] {
+					parked.fetch_add(1);
+					while (!open.load()) Fiber::park();
+				}));
+				fibers.back()->start();
+			}
+			while (parked.load() < n) Fiber::yield();
+			long rss = residentBytes() - rss0;
+			System::out.printf("%-44s %10.1f KB/fiber  (%d carriers)\n", "Fiber parked, memory", (double)rss / n / 1024,
+					FiberScheduler::getDefault().getCarrierCount());
+			open = true;
+			for (std::unique_ptr<Fiber>& f : fibers) Fiber::unpark(*f);
+			for (std::unique_ptr<Fiber>& f : fibers) f->join();
+		});
+		acceptor.start();
+		acceptor.join();
+	});
+	fibers.clear();
+
+	const int threads = 1000;
+	std::mutex m;
+	std::condition_variable cv;
+	int blocked = 0;
+	rss0 = residentBytes();
+	{
+		std::vector<std::unique_ptr<Thread>> pool;
+		for (int i = 0; i < threads; ++i) {
+			pool.emplace_back(new Thread([&] {
+				std::unique_lock<std::mutex> lock(m);
+				++blocked;
+				cv.notify_all();
+				cv.wait(lock, [&] { return blocked < 0; });
+			}));
+			pool.back()->start();
+		}
+		std::unique_lock<std::mutex> lock(m);
+		cv.wait(lock, [&] { return blocked == threads; });
+		System::out.printf("%-44s %10.1f KB/thread (1000 threads)\n", "former threads blocked, memory", (double)(residentBytes() - rss0) / threads / 1024);
+		blocked = -1;
+		cv.notify_all();
+		lock.unlock();
+		for (std::unique_ptr<Thread>& t : pool) t->join();
+	}
+}
+
+// the former ThreadPool::submit, a std::promise completed by the task
+template<class F> std::future<long> formerSubmit(ThreadPool& pool, F f) {
+	std::shared_ptr<std::promise<long>> p = std::make_shared<std::promise<long>>();
+	pool.execute([p, f] {
+		try { p->set_value(f()); }
+		catch (...) { p->set_exception(std::current_exception()); }
+	});
+	return p->get_future();
+}
+}
+
+// continuation chains of 10 stages, per stage; fan-out of 100 requests joined, per request
+void bench_futures() {
+	using namespace util::concurrent;
+	const int stages = 1000000;
+	const int depth = 10;
+	bench("Future thenApply chain, completed after, per stage", stages, [](int n) {
+		long sum = 0;
+		for (int c = 0; c < n / depth; ++c) {
+			Promise<long> p;
+			Future<long> f = p.getFuture();
+			for (int i = 0; i < depth; ++i) f = f.thenApply([](long v) { return v + 1; });
+			p.complete((long)c);
+			sum += f.get();
+		}
+		if (sum == 0) System::out.println("");
+	});
+	bench("Future thenApply chain, completed before, per stage", stages, [](int n) {
+		long sum = 0;
+		for (int c = 0; c < n / depth; ++c) {
+			Future<long> f = completedFuture<long>((long)c);
+			for (int i = 0; i < depth; ++i) f = f.thenApply([](long v) { return v + 1; });
+			sum += f.get();
+		}
+		if (sum == 0) System::out.println("");
+	});
+	ThreadPool pool(2);
+	bench("Future thenApplyAsync chain on pool, per stage", stages / 10, [&pool](int n) {
+		std::vector<Future<long>> chains;
+		for (int c = 0; c < n / depth; ++c) {
+			Future<long> f = supplyAsync([c] { return (long)c; }, pool);
+			for (int i = 1; i < depth; ++i) f = f.thenApplyAsync([](long v) { return v + 1; }, pool);
+			chains.push_back(f);
+		}
+		for (Future<long>& f : chains) f.get();
+	});
+	bench("former std::future submit+get chain, per stage", stages / 10, [&pool](int n) {
+		for (int c = 0; c < n / depth; ++c) {
+			long v = (long)c;
+			for (int i = 0; i < depth; ++i) v = formerSubmit(pool, [v] { return v + 1; }).get();
+		}
+	});
+
+	const int requests = 100000;
+	const int fanout = 100;
+	bench("Future fan-out supplyAsync + allOf, per request", requests, [&pool](int n) {
+		for (int r = 0; r < n / fanout; ++r) {
+			std::vector<Future<long>> parts;
+			for (int i = 0; i < fanout; ++i) parts.push_back(supplyAsync([i] { return (long)i; }, pool));
+			allOf(parts).get();
+		}
+	});
+	bench("former fan-out submit + get each, per request", requests, [&pool](int n) {
+		for (int r = 0; r < n / fanout; ++r) {
+			std::vector<std::future<long>> parts;
+			for (int i = 0; i < fanout; ++i) parts.push_back(formerSubmit(pool, [i] { return (long)i; }));
+			for (std::future<long>& f : parts) f.get();
+		}
+	});
+}
+
+int main(int argc, const char *argv[]) {
+	bench_queues();
+	bench_locks();
+	bench_maps();
+	bench_counters();
+	bench_timers();
+	bench_affinity();
+	bench_fibers();
+	bench_futures();
+	int cores = (int)std::thread::hardware_concurrency();
+	for (int threads = 1; threads < cores; threads *= 2) bench_pools(threads);
+	bench_pools(cores > 0 ? cores : 1);
+	return 0;
+}
@@ -0,0 +1,402 @@
+#include <lang/Class.hpp>
+#include <lang/Math.hpp>
+#include <lang/Profiler.hpp>
+#include <lang/Runtime.hpp>
+#include <lang/System.hpp>
+#include <lang/Thread.hpp>
+#include <util/ArrayList.hpp>
+#include <util/HashMap.hpp>
+#include <thread>
+#include <cstdarg>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+template<class F>
+void bench(const String& name, int n, F f) {
+	jlong t0 = System::nanoTime();
+	for (int i=0; i < n; ++i) f(i);
+	jlong t = System::nanoTime() - t0;
+	System::out.printf("%-44s %10.1f ns/op\n", name.cstr(), (double)t/n);
+}
+// n operations split over the given number of threads
+template<class F>
+void benchThreads(const String& name, int threads, int n, F f) {
+	std::thread *t[64];
+	jlong t0 = System::nanoTime();
+	for (int i=0; i < threads; ++i) t[i] = new std::thread([&] {
+		for (int j=0; j < n/threads; ++j) f(j);
+	});
+	for (int i=0; i < threads; ++i) { t[i]->join(); delete t[i]; }
+	jlong dt = System::nanoTime() - t0;
+	System::out.printf("%-44s %10.1f ns/op\n", name.cstr(), (double)dt/n);
+}
+
+// distinct types to populate the class registry
+template<int A, int B> struct Tag {};
+template<int A, int B> struct FillTags {
+	static void run(const std::type_info **t) {
+		t[A*100+B-1] = &typeid(Tag<A,B-1>);
+		FillTags<A,B-1>::run(t);
+	}
+};
+template<int A> struct FillTags<A,0> {
+	static void run(const std::type_info **t) {}
+};
+const int MAX_TAGS = 1000;
+const std::type_info *tags[MAX_TAGS];
+void fillTags() {
+	FillTags<0,100>::run(tags); FillTags<1,100>::run(tags);
+	FillTags<2,100>::run(tags); FillTags<3,100>::run(tags);
+	FillTags<4,100>::run(tags); FillTags<5,100>::run(tags);
+	FillTags<6,100>::run(tags); FillTags<7,100>::run(tags);
+	FillTags<8,100>::run(tags); FillTags<9,100>::run(tags);
+}
+
+// the former registry: linear scan of a list under the list monitor
+class LinearClassMap {
+	ArrayList<const std::type_info*> types;
+public:
+	const std::type_info *find(const std::type_info& type) {
+		synchronized(types) {
+			for (SharedIterator<const std::type_info*> i = types.iterator(); i->hasNext(); ) {
+				const std::type_info *t = i->next();
+				if (*t == type) return t;
+			}
+		}
+		return null;
+	}
+	void add(const std::type_info& type) {
+		synchronized(types) {
+			if (find(type) == null) types.add(&type);
+		}
+	}
+};
+
+void bench_classRegistry() {
+	fillTags();
+	const int ops = 20000;
+	for (int ntypes : {10, 100, 1000}) {
+		LinearClassMap linear;
+		for (int i=0; i < ntypes; ++i) {
+			linear.add(*tags[i]);
+			Object::getClass(*tags[i]);
+		}
+		bench("getClass linear, types=" + String::valueOf(ntypes), ops, [&](int i) {
+			linear.find(*tags[i % ntypes]);
+		});
+		bench("getClass hashed, types=" + String::valueOf(ntypes), ops, [&](int i) {
+			Object::getClass(*tags[i % ntypes]);
+		});
+	}
+	bench("classOf<T> static cache", ops, [](int i) {
+		classOf<Tag<9,99>>();
+	});
+	Object o;
+	bench("Object::getClass().getName()", ops, [&](int i) {
+		o.getClass().getName();
+	});
+}
+
+void bench_monitor() {
+	const int ops = 200000;
+	Object o;
+	std::recursive_mutex mtx;
+	long counter = 0;
+	bench("synchronized uncontended", ops, [&](int i) {
+		synchronized(o) { ++counter; }
+	});
+	bench("synchronized recursive", ops, [&](int i) {
+		synchronized(o) { synchronized(o) { ++counter; } }
+	});
+	bench("recursive_mutex uncontended", ops, [&](int i) {
+		std::lock_guard<std::recursive_mutex> lock(mtx);
+		++counter;
+	});
+	// the former Object::Lock allocated its recursive_mutex on first use
+	bench("synchronized on fresh object", ops, [&](int i) {
+		Object fresh;
+		synchronized(fresh) { ++counter; }
+	});
+	bench("recursive_mutex allocated on first use", ops, [&](int i) {
+		std::unique_ptr<std::recursive_mutex> m(new std::recursive_mutex());
+		std::lock_guard<std::recursive_mutex> lock(*m);
+		++counter;
+	});
+	for (int threads : {2, 4, 8}) {
+		benchThreads("synchronized contended, threads=" + String::valueOf(threads), threads, ops, [&](int i) {
+			synchronized(o) { ++counter; }
+		});
+		benchThreads("recursive_mutex contended, threads=" + String::valueOf(threads), threads, ops, [&](int i) {
+			std::lock_guard<std::recursive_mutex> lock(mtx);
+			++counter;
+		});
+	}
+
+	// wait/notify round trip
+	const int rounds = 2000;
+	int turn = 0;
+	std::thread pong([&] {
+		synchronized(o) {
+			for (int i=0; i < rounds; ++i) {
+				while (turn != 1) o.wait();
+				turn = 0;
+				o.notify();
+			}
+		}
+	});
+	bench("wait/notify round trip", rounds, [&](int i) {
+		synchronized(o) {
+			turn = 1;
+			o.notify();
+			while (turn != 0) o.wait();
+		}
+	});
+	pong.join();
+
+	Object::MonitorStatistics st = Object::getMonitorStatistics();
+	System::out.printf("monitors: inflations=%lld deflations=%lld contended=%lld waits=%lld\n",
+			st.inflations, st.deflations, st.contended, st.waits);
+}
+
+template<class T>
+void bench_arrayCopy(const char *type) {
+	for (int bytes = 16; bytes <= 64*1024*1024; bytes *= 4) {
+		const int n = bytes/(int)sizeof(T);
+		const int ops = Math::max(1, (1<<24)/bytes);
+		Array<T> src(n), dst(n);
+		for (int i=0; i < n; ++i) src[i] = (T)i;
+		String suffix = String(type) + " " + String::valueOf(bytes) + "B";
+		bench("element loop " + suffix, ops, [&](int) {
+			for (int i=0; i < n; ++i) dst[i] = src[i];
+		});
+		bench("System::arraycopy " + suffix, ops, [&](int) {
+			System::arraycopy(src, 0, dst, 0, n);
+		});
+		bench("copy constructor " + suffix, ops, [&](int) {
+			Array<T> copy(src);
+		});
+	}
+}
+
+// the former capture: symbols resolved for every frame at throw time
+void eagerStackTrace() {
+	void *trace[50];
+	int got = ::backtrace(trace, 50);
+	Array<StackTraceElement> st(got);
+	for (int i=0; i < got; ++i) {
+		Dl_info info;
+		std::string addr = "[0x" + std::to_string((long)trace[i]) + "]";
+		if (dladdr(trace[i], &info) != 0 && info.dli_sname != null) {
+			int status = 0;
+			char *d = abi::__cxa_demangle(info.dli_sname, null, null, &status);
+			std::string func = status == 0 ? d : info.dli_sname;
+			std::free(d);
+			st[i] = StackTraceElement(String(func + " " + info.dli_fname + addr), "", 0);
+		}
+		else st[i] = StackTraceElement(String(addr), "", 0);
+	}
+}
+class Untraced : extends Exception {
+public:
+	using Exception::Exception;
+};
+void bench_exceptions() {
+	const int ops = 20000;
+	bench("throw/catch, eager symbolization (old)", ops, [](int i) {
+		try { throw Untraced(); } catch (const Untraced& e) { eagerStackTrace(); }
+	});
+	bench("throw/catch, raw addresses", ops, [](int i) {
+		try { throw Exception(); } catch (const Exception& e) {}
+	});
+	bench("throw/catch + getStackTrace, cached symbols", ops, [](int i) {
+		try { throw Exception(); } catch (const Exception& e) { e.getStackTrace(); }
+	});
+	Throwable::setStackTraceEnabled(classOf<Untraced>(), false);
+	bench("throw/catch, capture disabled", ops, [](int i) {
+		try { throw Untraced(); } catch (const Untraced& e) {}
+	});
+	Throwable::setStackTraceEnabled(classOf<Untraced>(), true);
+}
+
+// the former Logger::format: thread lookup, local time and a synchronous write under the stream monitor
+Object formerLock;
+void formerLog(int fd, const char *fn, unsigned ln, const char *fmt, ...) {
+	jlong jtm = System::currentTimeMillis();
+	time_t t = (time_t)(jtm/1000);
+	char tbuf[30], buf[1024];
+	struct tm stm;
+	String thn = Thread::currentThread().getName();
+	synchronized(formerLock) {
+		strftime(tbuf, sizeof(tbuf), "%H:%M:%S", localtime_r(&t, &stm));
+		int n = snprintf(buf, sizeof(buf), "%s.%03d [D] %s %s(%u): ", tbuf, (int)(jtm%1000), thn.cstr(), fn, ln);
+		va_list args;
+		va_start(args, fmt);
+		n += vsnprintf(buf + n, sizeof(buf) - (size_t)n, fmt, args);
+		va_end(args);
+		if (::write(fd, buf, (size_t)n) < 0) return;
+	}
+}
+void bench_logger() {
+	const int ops = 100000;
+	int fd = ::open("/dev/null", O_WRONLY);
+	bench("LOGD, former synchronous", ops, [&](int i) {
+		formerLog(fd, __FILE__, __LINE__, "recv(fd=%d) error=%d (%s)", i, 11, "Resource temporarily unavailable");
+	});
+	Logger::setOutput(fd);
+	Logger::setOverflow(Logger::BLOCK);
+	bench("LOGD, async ring buffer", ops, [&](int i) {
+		LOGD("recv(fd=%d) error=%d (%s)", i, 11, "Resource temporarily unavailable");
+	});
+	Logger::flush();
+	Logger::openBinary("/tmp/bench_lang.jlog", 64l << 20);
+	bench("LOGD, binary mode", ops, [&](int i) {
+		LOGD("recv(fd=%d) error=%d (%s)", i, 11, "Resource temporarily unavailable");
+	});
+	Logger::closeBinary();
+	::unlink("/tmp/bench_lang.jlog");
+	Logger::setLevel(Logger::INFO);
+	bench("LOGD, level disabled", ops, [&](int i) {
+		LOGD("recv(fd=%d) error=%d (%s)", i, 11, String::valueOf(i).cstr());
+	});
+	Logger::setLevel(Logger::DEBUG);
+	Logger::setOverflow(Logger::COUNT);
+	Logger::setOutput(STDERR_FILENO);
+	::close(fd);
+}
+// the former lookup: the map of thread ids under its monitor
+class FormerThreadMap {
+	HashMap<std::thread::id,Thread*> thrmap;
+public:
+	void add(Thread *t) {
+		synchronized(thrmap) { thrmap.put(std::this_thread::get_id(), t); }
+	}
+	Thread *get() {
+		Thread *t = null;
+		synchronized(thrmap) {
+			std::thread::id id = std::this_thread::get_id();
+			if (thrmap.containsKey(id)) t = thrmap.get(id);
+		}
+		return t;
+	}
+};
+// every thread times its own loop, the mean per call is reported
+void bench_currentThread() {
+	const int ops = 100000;
+	Logger::setLevel(Logger::WARN);
+	for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+		FormerThreadMap former;
+		std::atomic<jlong> formerTime(0), currentTime(0);
+		std::atomic<int> ready(0);
+		Thread *t[64];
+		for (int i=0; i < threads; ++i) {
+			t[i] = new Thread([&] {
+				Thread *self = &Thread::currentThread();
+				former.add(self);
+				for (++ready; ready.load() < threads; ) Thread::yield();
+				long sum = 0;
+				jlong t0 = System::nanoTime();
+				for (int j=0; j < ops; ++j) sum += (former.get() == self);
+				jlong t1 = System::nanoTime();
+				for (int j=0; j < ops; ++j) sum += (&Thread::currentThread() == self);
+				jlong t2 = System::nanoTime();
+				if (sum != 2*ops) System::err.println("wrong current thread");
+				formerTime += t1 - t0;
+				currentTime += t2 - t1;
+			});
+			t[i]->start();
+		}
+		for (int i=0; i < threads; ++i) delete t[i];
+		System::out.printf("%-44s %10.1f ns/op\n", ("currentThread, former map, threads=" + String::valueOf(threads)).cstr(),
+				(double)formerTime.load() / threads / ops);
+		System::out.printf("%-44s %10.1f ns/op\n", ("currentThread, thread_local, threads=" + String::valueOf(threads)).cstr(),
+				(double)currentTime.load() / threads / ops);
+	}
+	Logger::setLevel(Logger::DEBUG);
+}
+
+// the former CallTrace: the thread looked up in the locked map, then pushed to its array
+struct FormerCallStack {
+	const void *frames[2048];
+	unsigned size = 0;
+};
+FormerThreadMap formerThreads;
+FormerCallStack formerStack;
+class FormerCallTrace {
+	FormerCallStack *s;
+public:
+	FormerCallTrace(const char *func) {
+		s = formerThreads.get() != null ? &formerStack : null;
+		if (s != null && s->size < 2048) s->frames[s->size] = func;
+		if (s != null) ++s->size;
+	}
+	~FormerCallTrace() { if (s != null) --s->size; }
+};
+__attribute__((noinline)) int untraced(int i) { return i + 1; }
+__attribute__((noinline)) int traced(int i) { CallTrace c(__FUNCTION__, __FILE__, __LINE__); return i + 1; }
+__attribute__((noinline)) int formerTraced(int i) { FormerCallTrace c(__FUNCTION__); return i + 1; }
+
+void bench_callTrace() {
+	const int ops = 1000000;
+	formerThreads.add(&Thread::currentThread());
+	int r = 0;
+	bench("call, no trace", ops, [&](int i) { r += untraced(i); });
+	bench("call, shadow stack", ops, [&](int i) { r += traced(i); });
+	bench("call, former CallTrace", ops, [&](int i) { r += formerTraced(i); });
+	if (r == 0) System::out.println("");
+}
+
+void bench_profiler() {
+	// the events of one run fit in the ring of the thread
+	const int ops = 15000;
+	const void *fn = (const void *)&untraced;
+	bench("profiler enter/leave, not recording", ops, [&](int i) { Profiler::enter(fn); Profiler::leave(fn); });
+	Profiler::start("/tmp/bench_lang-profile");
+	bench("profiler enter/leave, recording", ops, [&](int i) { Profiler::enter(fn); Profiler::leave(fn); });
+	Profiler::stop();
+	::unlink("/tmp/bench_lang-profile.json");
+	::unlink("/tmp/bench_lang-profile.txt");
+}
+
+__attribute__((noinline)) unsigned long mix(unsigned long h) {
+	for (int i=0; i < 1000; ++i) h = (h ^ (h >> 29)) * 0xbf58476d1ce4e5b9ul;
+	return h;
+}
+jlong cpuTime(int ops, unsigned long& h) {
+	jlong t0 = System::nanoTime();
+	for (int i=0; i < ops; ++i) h = mix(h);
+	return System::nanoTime() - t0;
+}
+void bench_sampling() {
+	// about a second of cpu each, long enough for 100 samples at 100Hz
+	const int ops = 500000;
+	Runtime& rt = Runtime::getRuntime();
+	unsigned long h = 1;
+	cpuTime(ops / 10, h);
+	jlong off = cpuTime(ops, h);
+	rt.startProfiling(100);
+	jlong on = cpuTime(ops, h);
+	rt.stopProfiling();
+	System::out.printf("%-44s %10.1f ns/op\n", "cpu loop, not sampling", (double)off/ops);
+	System::out.printf("%-44s %10.1f ns/op\n", "cpu loop, sampling at 100Hz", (double)on/ops);
+	System::out.printf("%-44s %10.2f %%\n", "sampling overhead", 100.0 * (double)(on - off) / (double)off);
+	if (h == 0) System::out.println("");
+}
+}
+
+int main(int argc, const char *argv[]) {
+	bench_classRegistry();
+	bench_monitor();
+	bench_arrayCopy<byte>("Array<byte>");
+	bench_arrayCopy<int>("Array<int>");
+	bench_exceptions();
+	bench_logger();
+	bench_currentThread();
+	bench_callTrace();
+	bench_profiler();
+	bench_sampling();
+	return 0;
+}
@@ -0,0 +1,110 @@
+#include <lang/Character.hpp>
+#include <lang/FloatingDecimal.hpp>
+#include <lang/Number.hpp>
+#include <lang/System.hpp>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+namespace {
+long allocations = 0;
+}
+// count every allocation made by the workloads below
+void *operator new(std::size_t n) {
+	++allocations;
+	void *p = std::malloc(n);
+	if (p == null) throw std::bad_alloc();
+	return p;
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+template<class F>
+void bench(const String& name, int n, F f) {
+	long a0 = allocations;
+	jlong t0 = System::nanoTime();
+	for (int i=0; i < n; ++i) f(i);
+	jlong t = System::nanoTime() - t0;
+	System::out.printf("%-44s %10.1f ns/op %8.2f allocs/op\n", name.cstr(), (double)t/n, (double)(allocations - a0)/n);
+}
+
+// the former conversions: a stringstream per number, charAt and Character::digit per char
+String oldToString(long v) {
+	std::stringstream stream;
+	stream << std::dec << (unsigned long)(v < 0 ? -v : v);
+	return v < 0 ? "-" + stream.str() : stream.str();
+}
+int oldParseInt(const String& s, int radix) {
+	int result = 0;
+	boolean negative = false;
+	int i = 0;
+	char c = s.charAt(0);
+	if (c == '-') {negative=true; ++i;}
+	else if (c == '+') {++i;}
+	for (; i < s.length(); ++i) {
+		c = s.charAt(i);
+		int digit = Character::digit(c, radix);
+		if (digit < 0) throw NumberFormatException();
+		result *= radix;
+		result -= digit;
+	}
+	return negative ? result : -result;
+}
+
+const int N = 1024;
+long values[N];
+double doubles[N];
+String texts[N], doubleTexts[N];
+
+void fill() {
+	unsigned long seed = 7;
+	for (int i=0; i < N; ++i) {
+		seed = seed * 6364136223846793005ul + 1442695040888963407ul;
+		values[i] = (long)(seed >> (seed % 50 + 14)) - (long)(seed & 1) * 1000;
+		doubles[i] = (double)(seed >> 11) / (double)(1ul << (seed % 40 + 10));
+		texts[i] = String::valueOf((int)values[i]);
+		doubleTexts[i] = Double::toString(doubles[i]);
+	}
+}
+
+void bench_integers(const int ops) {
+	long sink = 0;
+	bench("Long::toString, former stringstream", ops, [&](int i) { sink += oldToString(values[i % N]).length(); });
+	bench("Long::toString", ops, [&](int i) { sink += Long::toString(values[i % N]).length(); });
+	char buf[Long::MAX_CHARS];
+	bench("Long::toChars into a buffer", ops, [&](int i) { sink += Long::toChars(values[i % N], buf); });
+	bench("Long::toHexString", ops, [&](int i) { sink += Long::toHexString(values[i % N]).length(); });
+	bench("std::to_string", ops, [&](int i) { sink += (long)std::to_string(values[i % N]).length(); });
+	bench("Integer::parseInt, former charAt/digit", ops, [&](int i) { sink += oldParseInt(texts[i % N], 10); });
+	bench("Integer::parseInt", ops, [&](int i) { sink += Integer::parseInt(texts[i % N]); });
+	bench("std::strtol", ops, [&](int i) { sink += std::strtol(texts[i % N].cstr(), null, 10); });
+	if (sink == 0) System::out.println("");
+}
+
+void bench_floating(const int ops) {
+	long sink = 0;
+	bench("String::valueOf(double), former std::to_string", ops, [&](int i) { sink += (long)std::to_string(doubles[i % N]).length(); });
+	bench("Double::toString", ops, [&](int i) { sink += Double::toString(doubles[i % N]).length(); });
+	char buf[FloatingDecimal::MAX_CHARS];
+	bench("FloatingDecimal::toChars into a buffer", ops, [&](int i) { sink += FloatingDecimal::toChars(doubles[i % N], buf); });
+	bench("snprintf %.17g", ops, [&](int i) { sink += std::snprintf(buf, sizeof(buf), "%.17g", doubles[i % N]); });
+	bench("Float::toString", ops, [&](int i) { sink += Float::toString((float)doubles[i % N]).length(); });
+	bench("Double::parseDouble", ops, [&](int i) { sink += (long)Double::parseDouble(doubleTexts[i % N]); });
+	bench("std::strtod", ops, [&](int i) { sink += (long)std::strtod(doubleTexts[i % N].cstr(), null); });
+	StringBuilder sb(64);
+	bench("StringBuilder append(double)", ops, [&](int i) {
+		sb.setLength(0);
+		sink += sb.append(doubles[i % N]).length();
+	});
+	if (sink == 0) System::out.println("");
+}
+}
+
+int main(int argc, const char *argv[]) {
+	const int ops = 200000;
+	fill();
+	bench_integers(ops);
+	bench_floating(ops);
+	return 0;
+}
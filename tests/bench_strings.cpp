@@ -0,0 +1,331 @@
+#include <lang/Character.hpp>
+#include <lang/String.hpp>
+#include <lang/StringKernels.hpp>
+#include <lang/Math.hpp>
+#include <lang/System.hpp>
+#include <cstdarg>
+#include <cstdio>
+#include <cctype>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+namespace {
+long allocations = 0;
+}
+// count every allocation made by the workloads below
+void *operator new(std::size_t n) {
+	++allocations;
+	void *p = std::malloc(n);
+	if (p == null) throw std::bad_alloc();
+	return p;
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+template<class F>
+void bench(const String& name, int n, F f) {
+	long a0 = allocations;
+	jlong t0 = System::nanoTime();
+	for (int i=0; i < n; ++i) f(i);
+	jlong t = System::nanoTime() - t0;
+	System::out.printf("%-44s %10.1f ns/op %8.2f allocs/op\n", name.cstr(), (double)t/n, (double)(allocations - a0)/n);
+}
+
+const char *query = "session=0123456789abcdef0123&user=someone.with.long.name&lang=en&page=12&sort=ascending&filter=none";
+const char *csv = "2024-01-01T00:00:00Z,instrument-name-1234,123.456,789.012,buy,exchange-identifier,confirmed,ok";
+
+// the former representation: every substring is a new std::string
+void bench_stdString(const int ops) {
+	std::string q(query), c(csv);
+	long sink = 0;
+	bench("std::string parse query", ops, [&](int) {
+		size_t b = 0;
+		while (b < q.length()) {
+			size_t e = q.find('&', b);
+			if (e == std::string::npos) e = q.length();
+			size_t eq = q.find('=', b);
+			std::string key = q.substr(b, eq - b);
+			std::string value = q.substr(eq + 1, e - eq - 1);
+			sink += (long)(key.length() + value.length());
+			b = e + 1;
+		}
+	});
+	bench("std::string split csv", ops, [&](int) {
+		size_t b = 0;
+		for (size_t e; (e = c.find(',', b)) != std::string::npos; b = e + 1) {
+			std::string field = c.substr(b, e - b);
+			sink += (long)field.length();
+		}
+	});
+	bench("std::string concat", ops, [&](int i) {
+		std::string s = std::string("instrument-name-") + std::to_string(i) + " at exchange-identifier";
+		std::string copy(s);
+		sink += (long)copy.length();
+	});
+	if (sink == 0) System::out.println("");
+}
+
+void bench_String(const int ops) {
+	String q(query), c(csv);
+	long sink = 0;
+	bench("String parse query", ops, [&](int) {
+		int b = 0;
+		while (b < q.length()) {
+			int e = q.indexOf('&', b);
+			if (e < 0) e = q.length();
+			int eq = q.indexOf('=', b);
+			String key = q.substring(b, eq);
+			String value = q.substring(eq + 1, e);
+			sink += key.length() + value.length();
+			b = e + 1;
+		}
+	});
+	bench("String split csv", ops, [&](int) {
+		int b = 0;
+		for (int e; (e = c.indexOf(',', b)) >= 0; b = e + 1) {
+			String field = c.substring(b, e);
+			sink += field.length();
+		}
+	});
+	bench("String concat", ops, [&](int i) {
+		String s = "instrument-name-" + String::valueOf(i) + " at exchange-identifier";
+		String copy(s);
+		sink += copy.length();
+	});
+	bench("String construct empty", ops, [&](int) {
+		String s;
+		sink += s.length();
+	});
+	bench("String copy short", ops, [&](int) {
+		String s(c.substring(0, 10));
+		sink += s.length();
+	});
+	bench("String copy shared", ops, [&](int) {
+		String s(c);
+		sink += s.length();
+	});
+	bench("String append", ops/10, [&](int) {
+		String s;
+		for (int i=0; i < 32; ++i) s += "field,";
+		sink += s.length();
+	});
+	if (sink == 0) System::out.println("");
+}
+
+// the former StringBuilder: a stringstream fed with String temporaries
+class StreamBuilder {
+	std::stringstream value;
+public:
+	StreamBuilder(int capacity) {}
+	template<class T>
+	StreamBuilder& append(const T& t) {
+		value << String::valueOf(t).intern();
+		return *this;
+	}
+	StreamBuilder& append(const char *str) {
+		value << str;
+		return *this;
+	}
+	String toString() const {
+		return value.str();
+	}
+};
+
+template<class B>
+String logLine(int i, int capacity=16) {
+	B b(capacity);
+	b.append("2024-01-01 12:00:00.").append(i % 1000).append(" [INFO] worker-").append(i % 8)
+	 .append(": processed ").append(i).append(" items in ").append(0.125 * i).append(" ms");
+	return b.toString();
+}
+template<class B>
+String mapToString(int n) {
+	B b(16);
+	b.append("{");
+	for (int i=0; i < n; ++i) {
+		if (i > 0) b.append(",");
+		b.append(i).append(":").append(String("value-") + String::valueOf(i));
+	}
+	b.append("}");
+	return b.toString();
+}
+
+void bench_StringBuilder(const int ops) {
+	long sink = 0;
+	bench("stringstream log line", ops, [&](int i) {
+		sink += logLine<StreamBuilder>(i).length();
+	});
+	bench("StringBuilder log line", ops, [&](int i) {
+		sink += logLine<StringBuilder>(i).length();
+	});
+	bench("StringBuilder log line, capacity 96", ops, [&](int i) {
+		sink += logLine<StringBuilder>(i, 96).length();
+	});
+	bench("stringstream map toString, 100 entries", ops/100, [&](int) {
+		sink += mapToString<StreamBuilder>(100).length();
+	});
+	bench("StringBuilder map toString, 100 entries", ops/100, [&](int) {
+		sink += mapToString<StringBuilder>(100).length();
+	});
+	if (sink == 0) System::out.println("");
+}
+
+// the former String::format: vsnprintf into a fixed stack buffer, truncated at 1023 chars
+String fixedFormat(const char *fmt, ...) {
+	char buf[1024];
+	va_list args;
+	va_start(args, fmt);
+	vsnprintf(buf, sizeof(buf), fmt, args);
+	va_end(args);
+	return String(buf);
+}
+
+void bench_format(const int ops) {
+	const char *fmt = "%s [%-5s] worker-%d: processed %ld items in %.3f ms (%s)";
+	const char *when = "2024-01-01 12:00:00.123";
+	String status("status-ok");
+	long sink = 0;
+	bench("fixed buffer vsnprintf log line", ops, [&](int i) {
+		sink += fixedFormat(fmt, when, "INFO", i % 8, (long)i, 0.125 * i, status.cstr()).length();
+	});
+	bench("String::format log line", ops, [&](int i) {
+		sink += String::format(fmt, when, "INFO", i % 8, (long)i, 0.125 * i, status).length();
+	});
+	StringBuilder sb(128);
+	bench("StringBuilder::appendFormat log line, reused", ops, [&](int i) {
+		sb.setLength(0);
+		sb.appendFormat(fmt, when, "INFO", i % 8, (long)i, 0.125 * i, status);
+		sink += sb.length();
+	});
+	bench("fixed buffer vsnprintf 4KB", ops/10, [&](int i) {
+		sink += fixedFormat("%s%s%s%s", query, csv, query, csv).length();
+	});
+	String big = String(query) + csv;
+	for (int i=0; i < 5; ++i) big += big;
+	bench("String::format 4KB (not truncated)", ops/10, [&](int i) {
+		sink += String::format("%s%s", big, big).length();
+	});
+	if (sink == 0) System::out.println("");
+}
+
+// the former loops
+jint oldHash(const char *s, int n) {
+	jint h = 0;
+	for (int i = 0; i < n; i++) h = 31 * h + s[i];
+	return h;
+}
+boolean oldEqualsIgnoreCase(const char *a, const char *b, int n) {
+	for (int i=0; i < n; ++i) {
+		if (tolower(a[i]) != tolower(b[i])) return false;
+	}
+	return true;
+}
+
+void bench_kernels(const int ops) {
+	const StringKernels::Impl *impls[4];
+	int nimpls = StringKernels::getImplementations(impls, 4);
+	long sink = 0;
+	for (int n : {8, 32, 128, 1024, 16384}) {
+		std::string text, upper;
+		for (int i=0; i < n; ++i) text += (char)('a' + i % 23);
+		for (char c : text) upper += (char)toupper(c);
+		text[(size_t)n - 1] = '#'; // the pattern is found at the end, the whole text is searched
+		std::string pattern = text.substr((size_t)n - 8);
+		const char *t = text.data(), *u = upper.data(), *p = pattern.data();
+		const int m = (int)pattern.length();
+		const int k = Math::max(1, ops * 8 / n);
+		String suffix = " n=" + String::valueOf(n);
+		bench("hash, former loop" + suffix, k, [&](int) { sink += oldHash(t, n); });
+		bench("equalsIgnoreCase, former tolower" + suffix, k, [&](int) { sink += oldEqualsIgnoreCase(t, u, n); });
+		bench("indexOf, std::string::find" + suffix, k, [&](int) { sink += (long)text.find(pattern); });
+		for (int i=0; i < nimpls; ++i) {
+			const StringKernels::Impl *im = impls[i];
+			bench("hash, " + String(im->name) + suffix, k, [&](int) { sink += im->hash(t, n); });
+			bench("equalsIgnoreCase, " + String(im->name) + suffix, k, [&](int) { sink += im->equalsIgnoreCase(t, u, n); });
+			bench("indexOf, " + String(im->name) + suffix, k, [&](int) { sink += im->indexOf(t, n, p, m); });
+		}
+		String a(text.c_str()), b(text.c_str());
+		bench("String::equals, same length" + suffix, k, [&](int) { sink += a.equals(b); });
+	}
+	if (sink == 0) System::out.println("");
+}
+
+// the former Character: virtual dispatch through CharacterData::of to bit packed Latin-1 properties
+class OldCharacterData {
+public:
+	static OldCharacterData& of(int ch);
+	virtual ~OldCharacterData() {}
+	virtual int getType(int ch) = 0;
+	virtual int digit(int ch, int radix) = 0;
+};
+class OldCharacterDataLatin1 : public OldCharacterData {
+	int A[256];
+public:
+	OldCharacterDataLatin1() {
+		for (int i=0; i < 256; ++i) A[i] = isdigit(i) ? (('0' << 5) & 0x3E0) + Character::DECIMAL_DIGIT_NUMBER : 0;
+	}
+	int getType(int ch) { return A[ch & 0xff] & 0x1F; }
+	int digit(int ch, int radix) {
+		int value = -1;
+		if (radix >= Character::MIN_RADIX && radix <= Character::MAX_RADIX) {
+			int val = A[ch & 0xff];
+			if ((val & 0x1F) == Character::DECIMAL_DIGIT_NUMBER) value = (ch + ((val & 0x3E0) >> 5)) & 0x1F;
+		}
+		return value < radix ? value : -1;
+	}
+};
+OldCharacterData& OldCharacterData::of(int ch) {
+	static OldCharacterDataLatin1 instance;
+	return instance;
+}
+
+void bench_character(const int ops) {
+	const int n = 4096;
+	char text[n], out[n];
+	byte types[n];
+	for (int i=0; i < n; ++i) text[i] = (char)(" 0123456789Latin-1 text\xE9\xE8, ABC"[i % 36]);
+	const int k = Math::max(1, ops / 100);
+	long sink = 0;
+	bench("getType, former virtual 4KB", k, [&](int) {
+		for (int i=0; i < n; ++i) sink += OldCharacterData::of(text[i]).getType(text[i]);
+	});
+	bench("getType, table 4KB", k, [&](int) {
+		for (int i=0; i < n; ++i) sink += Character::getType(text[i]);
+	});
+	bench("getType, bulk 4KB", k, [&](int) {
+		Character::getType(text, n, types);
+		sink += types[n-1];
+	});
+	bench("digit, former virtual 4KB", k, [&](int) {
+		for (int i=0; i < n; ++i) sink += OldCharacterData::of(text[i]).digit(text[i], 10);
+	});
+	bench("digit, table 4KB", k, [&](int) {
+		for (int i=0; i < n; ++i) sink += Character::digit(text[i], 10);
+	});
+	bench("isLetter, table 4KB", k, [&](int) {
+		for (int i=0; i < n; ++i) sink += Character::isLetter(text[i]);
+	});
+	bench("toupper, C library 4KB", k, [&](int) {
+		for (int i=0; i < n; ++i) out[i] = (char)toupper((byte)text[i]);
+		sink += out[n-1];
+	});
+	bench("toUpperCase, bulk 4KB", k, [&](int) {
+		Character::toUpperCase(text, n, out);
+		sink += out[n-1];
+	});
+	if (sink == 0) System::out.println("");
+}
+}
+
+int main(int argc, const char *argv[]) {
+	const int ops = 100000;
+	bench_stdString(ops);
+	bench_String(ops);
+	bench_StringBuilder(ops);
+	bench_format(ops);
+	bench_kernels(ops);
+	bench_character(ops);
+	return 0;
+}
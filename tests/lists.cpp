@@ -11,6 +11,32 @@ static void test_Array() {
 	int x[5];
 	System::out.println("basic array type = " + Object::getClass(typeid(x)).getName());
 }
+static void test_arraycopy() {
+	Array<int> a(8);
+	for (int i=0; i < a.length; ++i) a[i] = i;
+	System::arraycopy(a, 0, a, 2, 5); // overlapping, to the right
+	Array<String> s(4);
+	for (int i=0; i < s.length; ++i) s[i] = String::valueOf(i);
+	Object& src = s;
+	Object& dst = s;
+	System::arraycopy(src, 1, dst, 0, 3); // overlapping, to the left
+	String r;
+	for (int i=0; i < a.length; ++i) r += String::valueOf(a[i]);
+	r += " ";
+	for (int i=0; i < s.length; ++i) r += s[i];
+	System::out.println("arraycopy = " + r);
+
+	int buf[3] = {1, 2, 3};
+	Array<int> view = Array<int>::wrap(buf, 3);
+	view[1] = 5;
+	System::out.println("wrapped buf[1] = " + String::valueOf(buf[1]));
+	try {
+		System::arraycopy(a, 6, a, 0, 3);
+		System::err.println("arraycopy out of bounds not detected");
+	} catch(const IndexOutOfBoundsException& e) {
+		System::out.println("OK: expected exception received");
+	}
+}
 static void test_ArrayList() {
 	ArrayList<int> list;
 	for (int i=1; i < 10; ++i) list.enqueue(i);
@@ -52,6 +78,7 @@ static void test_HashMap() {
 int main(int argc, const char *argv[]) {
 	System::out.println("Array");
 	test_Array();
+	test_arraycopy();
 	System::out.println("ArrayList - simple types");
 	test_ArrayList();
 	System::out.println("ArrayList - Objects");
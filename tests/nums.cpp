@@ -1,12 +1,71 @@
+#include <lang/FloatingDecimal.hpp>
 #include <lang/Number.hpp>
 #include <lang/System.hpp>
 
+void test_integerCodecs() {TRACE;
+	System::out.println(Long::toString(Long::MIN_VALUE) + " " + Long::toString(Long::MAX_VALUE) + " " +
+			Integer::toString(-255, 16) + " " + Long::toBinaryString(10) + " " + Long::toString(0));
+	char buf[Long::MAX_CHARS];
+	int n = Long::toChars(-1234567890123L, buf);
+	System::out.printf("toChars %d %s\n", n, String::copyValueOf(buf, 0, n));
+	System::out.printf("%ld %ld %d %d\n", Long::parseLong("-9223372036854775808"), Long::parseLong("+000000000000000000001234567890123456"),
+			Integer::parseInt("7fffffff", 16), Integer::parseInt("-2147483648"));
+	for (const char *s : {"", "-", "9223372036854775808", "12x4", "2147483648"}) {
+		try {
+			if (std::strlen(s) == 10) Integer::parseInt(s);
+			else Long::parseLong(s);
+			System::out.printf("ERR: no exception for \"%s\"\n", s);
+		} catch (const NumberFormatException& e) {
+			System::out.println("OK: " + e.getMessage());
+		}
+	}
+	boolean badRadix = false;
+	try { Integer::parseInt("10", 37); } catch (const NumberFormatException& e) { badRadix = true; }
+	String concat = String("x") + 1.5 + " " + 7u + " " + -3 + " " + true;
+	if (!Integer::toHexString(-1).equals("ffffffff") || !Integer::toOctalString(-8).equals("37777777770") ||
+			!Long::toHexString(-1).equals("ffffffffffffffff") || !badRadix || !concat.equals("x1.5 7 -3 true"))
+		System::out.println("ERR: unsigned strings " + Integer::toHexString(-1) + " radix " + String::valueOf(badRadix) + " concat " + concat);
+}
+
+void test_floatingCodecs() {TRACE;
+	for (double d : {0.1, 0.3, 1.0, 100.0, 1e7, 9999999.0, 0.001, 9e-4, 1e23, 123.456, -0.0, 5e-324, 1.7976931348623157e308}) {
+		String s = Double::toString(d);
+		System::out.printf("%s %s\n", s, Double::parseDouble(s) == d ? "round trip" : "ERR: differs");
+	}
+	System::out.println(Float::toString(0.1f) + " " + Float::toString(16777216.0f) + " " + String::valueOf(2.5f));
+	for (const char *s : {" 3.5d ", "-1.0E-5", "Infinity", "NaN", "0x1.8p1", "123456789012345678901234567890", "1e400"}) {
+		System::out.printf("parse \"%s\" = %s\n", s, Double::toString(Double::parseDouble(s)));
+	}
+	try {
+		Double::parseDouble("1.2.3");
+		System::out.println("ERR: no exception");
+	} catch (const NumberFormatException& e) {
+		System::out.println("OK: " + e.getMessage());
+	}
+	// shortest and round trip against the C library, for random bit patterns
+	unsigned long seed = 1;
+	int errors = 0;
+	char buf[FloatingDecimal::MAX_CHARS + 1];
+	for (int i=0; i < 100000; ++i) {
+		seed = seed * 6364136223846793005ul + 1442695040888963407ul;
+		double d;
+		std::memcpy(&d, &seed, sizeof(d));
+		if (Double::isNaN(d) || Double::isInfinite(d)) continue;
+		int n = FloatingDecimal::toChars(d, buf);
+		buf[n] = 0;
+		if (std::strtod(buf, null) != d || FloatingDecimal::parseDouble(buf, n) != d) ++errors;
+	}
+	System::out.printf("random doubles: %d errors\n", errors);
+}
+
 int main() {
 	Boolean t1(true);
 	Short t2(1);
 	Integer t3(1);
 	Long t4(1);
 	Boolean::compare(true,false);
+	test_integerCodecs();
+	test_floatingCodecs();
 	int i = Integer::parseInt("123");
 	if (i != 123) LOGE("parseInt error");
 	i = Integer::parseInt("A23");
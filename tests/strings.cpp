@@ -1,12 +1,40 @@
+#include <lang/Character.hpp>
 #include <lang/Exception.hpp>
 #include <lang/String.hpp>
+#include <lang/StringKernels.hpp>
 #include <lang/System.hpp>
 #include <lang/Thread.hpp>
+#include <vector>
 
 void test_formatString() {TRACE;
 	String s = String::format("%d %.2f", 10, 1.1);
 	System::out.println(s);
 	System::out.printf("format %04d\n", 5);
+
+	// no fixed buffer: a long result is not truncated
+	String longArg = String::valueOf('x');
+	for (int i=0; i < 11; ++i) longArg += longArg;
+	String f = String::format("[%s] %d%%", longArg, 100);
+	System::out.printf("long format length=%d\n", f.length());
+	Object o;
+	System::out.println(String::format("%-8s|%5.1f|%x|%c|%s", String("str"), 2.25, 255u, 'c', true));
+	System::out.println(String::format("object %s", o).startsWith("object "));
+	// unsigned conversions of signed arguments keep their width
+	String widths = String::format("%x %X %o %u %lld", -1, (short)-2, -8, -1, -1ll);
+	if (!widths.equals("ffffffff FFFE 37777777770 4294967295 -1"))
+		System::err.println("wrong unsigned conversion: " + widths);
+	try {
+		String::format("%d", "text");
+		throw Exception("ERR: expected exception");
+	} catch(const IllegalFormatException& e) {
+		System::out.println("OK: " + e.getMessage());
+	}
+	try {
+		String::format("%d %d", 1);
+		throw Exception("ERR: expected exception");
+	} catch(const IllegalFormatException& e) {
+		System::out.println("OK: " + e.getMessage());
+	}
 }
 void test_String() {TRACE;
 	String s1;
@@ -23,11 +51,183 @@ void test_String() {TRACE;
 		System::out.println("OK: expected exception received");
 		e.printStackTrace();
 	}
+
+	// a shorter C string is not read past its end
+	String zero(std::string("a\0bcdefghijklmnopqrstuvwxyz", 27));
+	if (!s2.equals("abc") || s2.equals("ab") || s2.equals("abcd") || zero.equals("a") || s1.equals("a") || !s1.equals(""))
+		System::err.println("wrong equals(const char*)");
+}
+
+void test_substring() {TRACE;
+	String line("GET /index.html?lang=en HTTP/1.1");
+	int q = line.indexOf('?');
+	String path = line.substring(4, q);
+	String query = line.substring(q + 1, line.indexOf(' ', q));
+	System::out.println("path=" + path + " query=" + query);
+	// a substring in the middle of its buffer gets terminated on demand
+	System::out.printf("cstr=%s len=%d\n", line.substring(4, 20).cstr(), line.substring(4, 20).length());
+	System::out.println("trim=[" + String("  padded text  ").trim() + "]");
+	String h(line);
+	System::out.println("hash equal=" + String::valueOf(h.hashCode() == line.hashCode()) +
+			" lastIndexOf=" + String::valueOf(line.lastIndexOf("/")));
+
+	String acc;
+	for (int i=0; i < 10; ++i) acc += String::valueOf(i) + ",";
+	System::out.println("appended=" + acc + " upper=" + String("mixed Case").toUpperCase());
+}
+
+void test_StringBuilder() {TRACE;
+	StringBuilder sb(4);
+	sb.append("x=").append(-42).append(" y=").append(1.5).append(' ').append(true);
+	String first = sb.toString();
+	sb.insert(0, "[").append(']');
+	System::out.println(first + " -> " + sb.toString() + " capacity>=" + String::valueOf(sb.capacity() >= sb.length()));
+	sb.setLength(3);
+	sb.reverse();
+	sb.setCharAt(0, '=');
+	System::out.println("reversed=" + sb.toString() + " charAt(1)=" + String::valueOf(sb.charAt(1)));
+
+	// Strings sharing the buffer are not touched by later toString() calls
+	StringBuilder lb;
+	for (int i=0; i < 8; ++i) lb.append("shared buffer ").append(i);
+	String s1 = lb.toString();
+	jint h = s1.hashCode();
+	std::vector<std::thread> readers;
+	for (int t=0; t < 4; ++t) {
+		readers.push_back(std::thread([&lb,&s1,h]{
+			for (int i=0; i < 1000; ++i) {
+				String s = lb.toString();
+				if (s.hashCode() != h || !s.equals(s1)) { System::err.println("wrong shared toString"); break; }
+			}
+		}));
+	}
+	for (std::thread& r : readers) r.join();
+	lb.setLength(20);
+	if (lb.toString().length() != 20 || s1.hashCode() != h || std::strlen(s1.cstr()) != (size_t)s1.length())
+		System::err.println("wrong toString after setLength");
+}
+
+// reference implementations the kernels are checked against
+jint refHash(const char *s, int n) {
+	int32_t h = 0;
+	for (int i=0; i < n; ++i) h = (int32_t)(31u * (uint32_t)h + (uint32_t)(int)s[i]);
+	return h;
+}
+boolean refEqualsIgnoreCase(const char *a, const char *b, int n) {
+	for (int i=0; i < n; ++i) {
+		char ca = a[i] >= 'A' && a[i] <= 'Z' ? (char)(a[i] + 32) : a[i];
+		char cb = b[i] >= 'A' && b[i] <= 'Z' ? (char)(b[i] + 32) : b[i];
+		if (ca != cb) return false;
+	}
+	return true;
+}
+int refIndexOf(const char *s, int n, const char *p, int m) {
+	for (int i=0; i <= n - m; ++i) {
+		if (std::memcmp(s + i, p, (size_t)m) == 0) return i;
+	}
+	return -1;
+}
+void test_StringKernels() {TRACE;
+	const StringKernels::Impl *impls[4];
+	int nimpls = StringKernels::getImplementations(impls, 4);
+	unsigned seed = 1;
+	char a[300], b[300];
+	int errors = 0, checks = 0;
+	for (int n=0; n < 300; ++n) {
+		for (int i=0; i < n; ++i) {
+			seed = seed * 1103515245 + 12345;
+			// mostly a small alphabet, so that patterns are found, with some non ASCII bytes
+			a[i] = (seed >> 16) % 16 == 0 ? (char)(seed >> 8) : (char)('a' + (seed >> 16) % 4);
+			b[i] = (seed >> 20) % 2 ? (char)(a[i] - 32 * (a[i] >= 'a' && a[i] <= 'z')) : a[i];
+		}
+		if (n > 0 && n % 7 == 0) b[n/2] = '#';
+		for (int k=0; k < nimpls; ++k) {
+			const StringKernels::Impl *im = impls[k];
+			++checks;
+			if (im->hash(a, n) != refHash(a, n)) { ++errors; System::out.printf("%s hash n=%d\n", im->name, n); }
+			if (im->equalsIgnoreCase(a, b, n) != refEqualsIgnoreCase(a, b, n)) { ++errors; System::out.printf("%s equalsIgnoreCase n=%d\n", im->name, n); }
+			for (int m=0; m <= 40 && m <= n; m += 1 + m/4) {
+				const char *p = a + (n - m) * 2 / 3;
+				if (im->indexOf(a, n, p, m) != refIndexOf(a, n, p, m)) { ++errors; System::out.printf("%s indexOf n=%d m=%d\n", im->name, n, m); }
+				p = "abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd";
+				if (im->indexOf(a, n, p, m) != refIndexOf(a, n, p, m)) { ++errors; System::out.printf("%s indexOf absent n=%d m=%d\n", im->name, n, m); }
+			}
+		}
+	}
+	System::out.printf("kernels: %d implementations, %d errors in %d checks, active %s\n",
+			nimpls, errors, checks, StringKernels::getActive().name);
+	String s("Content-Type: text/plain; charset=UTF-8");
+	System::out.println(String::valueOf(s.hashCode()) + " " + String::valueOf(s.equalsIgnoreCase("content-type: TEXT/PLAIN; CHARSET=utf-8")) +
+			" " + String::valueOf(s.indexOf("charset")) + " " + String::valueOf(s.contains("UTF-16")));
+	// the empty string is found at fromIndex, clamped to the length
+	if (s.indexOf("", 5) != 5 || s.indexOf("", 1000) != s.length() || s.indexOf("plain", 1000) != -1)
+		System::err.println("wrong indexOf of the empty string");
+}
+
+void test_Character() {TRACE;
+	int errors = 0;
+	struct { int cp, type, digit16; boolean ws; int upper, lower; } expect[] = {
+		{'7', Character::DECIMAL_DIGIT_NUMBER, 7, false, '7', '7'},
+		{'f', Character::LOWERCASE_LETTER, 15, false, 'F', 'f'},
+		{'Q', Character::UPPERCASE_LETTER, -1, false, 'Q', 'q'},
+		{'\t', Character::CONTROL, -1, true, '\t', '\t'},
+		{0xA0, Character::SPACE_SEPARATOR, -1, false, 0xA0, 0xA0},
+		{0xB5, Character::LOWERCASE_LETTER, -1, false, 0x39C, 0xB5},
+		{0xDF, Character::LOWERCASE_LETTER, -1, false, 0xDF, 0xDF},
+		{0xFF, Character::LOWERCASE_LETTER, -1, false, 0x178, 0xFF},
+		{0x130, Character::UPPERCASE_LETTER, -1, false, 0x130, 'i'},
+		{0x3A3, Character::UPPERCASE_LETTER, -1, false, 0x3A3, 0x3C3},
+		{0x0663, Character::DECIMAL_DIGIT_NUMBER, 3, false, 0x663, 0x663},
+		{0x2028, Character::LINE_SEPARATOR, -1, true, 0x2028, 0x2028},
+		{0x4E2D, Character::OTHER_LETTER, -1, false, 0x4E2D, 0x4E2D},
+		{0xD800, Character::SURROGATE, -1, false, 0xD800, 0xD800},
+		{0xFF21, Character::UPPERCASE_LETTER, 10, false, 0xFF21, 0xFF41},
+		{0x10400, Character::UNASSIGNED, -1, false, 0x10400, 0x10400},
+	};
+	for (auto& e : expect) {
+		if (Character::getType(e.cp) != e.type || Character::digit(e.cp, 16) != e.digit16 || Character::isWhitespace(e.cp) != e.ws ||
+				Character::toUpperCase(e.cp) != e.upper || Character::toLowerCase(e.cp) != e.lower) {
+			++errors;
+			System::out.printf("Character U+%04X\n", e.cp);
+		}
+	}
+	// the char overloads and bulk variants agree with the code point lookups
+	char all[256], upper[256], lower[256];
+	for (int i=0; i < 256; ++i) all[i] = (char)i;
+	Array<byte> types(256);
+	Character::getType(Array<char>(all, 256), 0, 256, types);
+	Character::toUpperCase(all, 256, upper);
+	Character::toLowerCase(all, 256, lower);
+	for (int i=0; i < 256; ++i) {
+		const char c = all[i];
+		int u = Character::toUpperCase(i), l = Character::toLowerCase(i);
+		if (types[i] != Character::getType(c) || Character::getType(c) != Character::getType(i) ||
+				Character::isLetter(c) != Character::isLetter(i) || Character::digit(c, 36) != Character::digit(i, 36) ||
+				(byte)upper[i] != (u < 256 ? u : i) || (byte)lower[i] != (l < 256 ? l : i) || Character::toUpperCase(c) != upper[i]) {
+			++errors;
+			System::out.printf("Character Latin-1 %d\n", i);
+		}
+	}
+	String s("Mixed Case 42");
+	Array<char> a(s.length());
+	s.getChars(0, s.length(), &a[0], 0);
+	Character::toUpperCase(a, 6, 4);
+	Character::toLowerCase(s, 0, 5, &a[0]);
+	System::out.println(String(a) + " " + String::valueOf(Character::isLetter(0x4E2D)) + " " + String::valueOf(Character::digit(0x0663, 10)));
+	try {
+		Character::toUpperCase(a, 10, 4);
+		++errors;
+	} catch (const IndexOutOfBoundsException& e) {}
+	System::out.printf("Character: %d errors\n", errors);
 }
 
 int main(int argc, const char *argv[]) {TRACE;
 	System::out.println(Thread::currentThread().getName());
 	test_formatString();
+	test_substring();
+	test_StringBuilder();
+	test_StringKernels();
+	test_Character();
 	try {
 		test_String();
 	} catch(const lang::Exception& e) {
@@ -1,6 +1,29 @@
+#include <lang/Fiber.hpp>
+#include <lang/Number.hpp>
+#include <lang/Profiler.hpp>
+#include <lang/Runtime.hpp>
 #include <lang/System.hpp>
 #include <lang/Thread.hpp>
 #include <lang/ThreadGroup.hpp>
+#include <io/FileOutputStream.hpp>
+#include <nio/channels/Channel.hpp>
+#include <SyncQueue.hpp>
+#include <ThreadPool.hpp>
+#include <util/HashMap.hpp>
+#include <util/Metrics.hpp>
+#include <util/concurrent/ConcurrentHashMap.hpp>
+#include <util/concurrent/Future.hpp>
+#include <util/concurrent/Lock.hpp>
+#include <util/concurrent/ScheduledExecutorService.hpp>
+#include <util/concurrent/StampedLock.hpp>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 void test_mainthread() {TRACE;
 	System::out.println("Main thread name is "+Thread::currentThread().getName());
@@ -54,10 +77,1036 @@ void test_thread() {TRACE;
 	}).start();
 }
 
+void test_waitNotify() {TRACE;
+	Object monitor;
+	int value = 0;
+	Thread producer([&] {
+		for (int i=1; i <= 3; ++i) {
+			Thread::sleep(10);
+			synchronized(monitor) {
+				value = i;
+				monitor.notifyAll();
+			}
+		}
+	});
+	producer.start();
+	synchronized(monitor) {
+		while (value < 3) monitor.wait();
+	}
+	// joined by several threads at once
+	std::thread joiners[2];
+	for (std::thread& j : joiners) j = std::thread([&producer] { producer.join(); });
+	producer.join();
+	for (std::thread& j : joiners) j.join();
+
+	jlong t0 = System::currentTimeMillis();
+	synchronized(monitor) {
+		monitor.wait(50);
+	}
+	System::out.println("timed wait " + String::valueOf(System::currentTimeMillis() - t0) + "ms");
+	try {
+		monitor.notify();
+		System::err.println("notify without monitor not detected");
+	} catch(const IllegalMonitorStateException& e) {
+		System::out.println("OK: expected exception received");
+	}
+}
+
+void test_logger() {TRACE;
+	int evaluated = 0;
+	Logger::setLevel(Logger::WARN);
+	LOGD("not evaluated %d", ++evaluated);
+	Logger::setLevel(Logger::DEBUG);
+	System::out.println("disabled LOGD evaluated " + String::valueOf(evaluated) + " arguments");
+
+	// records of all threads arrive through the writer
+	int fds[2];
+	if (::pipe(fds) != 0) return;
+	::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+	Logger::setOutput(fds[1]);
+	const int threads = 4, lines = 100;
+	Thread *t[threads];
+	for (int i=0; i < threads; ++i) {
+		t[i] = new Thread([=] {
+			for (int j=0; j < lines; ++j) LOGI("(thread %d) line %d", i, j);
+		});
+		// longer than a native thread name
+		t[i]->setName("logger-test-thread-" + String::valueOf(i));
+		t[i]->start();
+	}
+	for (int i=0; i < threads; ++i) { t[i]->join(); delete t[i]; }
+	Logger::flush();
+	Logger::setOutput(STDERR_FILENO);
+	std::string out;
+	char buf[4096];
+	for (ssize_t n; (n = ::read(fds[0], buf, sizeof(buf))) > 0; ) out.append(buf, (size_t)n);
+	int count = 0;
+	for (size_t i = 0; (i = out.find(") line ", i)) != std::string::npos; ++i) ++count;
+	::close(fds[0]); ::close(fds[1]);
+	if (out.find("] logger-test-thread-3 ") == std::string::npos) System::err.println("wrong thread name in the log");
+	System::out.printf("logged %d of %d lines, dropped %lld\n", count, threads * lines, Logger::getDropped());
+}
+
+void logSamples() {
+	LOGI("int %d long %ld str %s char %c", -5, 1234567890123l, "abc", 'x');
+	LOGW("hex %08x float %.3f %g pad %5s|%-5s|", 255u, 3.14159, 1e-7, "ab", "cd");
+	LOGN("%*d|%.*s|%%", 6, 42, 2, "xyz");
+	LOGD("short %hd uchar %hhu size %zu", (short)-3, (unsigned char)200, (size_t)77);
+	LOGE(String("a string"));
+}
+// text of the lines without the time
+std::string withoutTime(const std::string& s) {
+	std::string r;
+	for (size_t i = 0; i < s.size(); ) {
+		size_t e = s.find('\n', i);
+		if (e == std::string::npos) e = s.size();
+		size_t b = s.find(' ', i);
+		if (b < e) r.append(s, b, e - b).append("\n");
+		i = e + 1;
+	}
+	return r;
+}
+std::string readAll(int fd) {
+	std::string out;
+	char buf[4096];
+	for (ssize_t n; (n = ::read(fd, buf, sizeof(buf))) > 0; ) out.append(buf, (size_t)n);
+	return out;
+}
+void test_binaryLog() {TRACE;
+	int fds[2];
+	if (::pipe(fds) != 0) return;
+	::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+	Logger::setOutput(fds[1]);
+	logSamples();
+	Logger::flush();
+	Logger::setOutput(STDERR_FILENO);
+	std::string text = readAll(fds[0]);
+
+	const char *path = "/tmp/threads-test.jlog";
+	Logger::openBinary(path, 1 << 20);
+	logSamples();
+	Logger::closeBinary();
+	Logger::decodeBinary(path, fds[1]);
+	std::string decoded = readAll(fds[0]);
+	::unlink(path);
+	::close(fds[0]); ::close(fds[1]);
+
+	// reopening while threads register their sites again must not deadlock
+	int devnull = ::open("/dev/null", O_WRONLY);
+	Logger::setOutput(devnull);
+	std::atomic<boolean> stop{false};
+	std::atomic<long> records{0};
+	std::vector<Thread*> loggers;
+	for (int t=0; t < 2; ++t) {
+		loggers.push_back(new Thread([&stop, &records] {
+			while (!stop.load()) { LOGE("reopen %ld", records.fetch_add(1)); }
+		}));
+		loggers.back()->start();
+	}
+	for (int i=0; i < 50; ++i) {
+		Logger::openBinary(path, 1 << 16);
+		Thread::sleep(1);
+	}
+	Logger::closeBinary();
+	stop = true;
+	for (Thread *t : loggers) { t->join(); delete t; }
+	Logger::setOutput(STDERR_FILENO);
+	::close(devnull);
+	::unlink(path);
+	if (withoutTime(text) != withoutTime(decoded)) {
+		System::err.println("binary log decodes differently");
+		System::err.print(String(text.c_str()));
+		System::err.print(String(decoded.c_str()));
+	}
+	else System::out.println("binary log decodes to the text log");
+}
+
+// the frames are pushed explicitly, the test does not depend on -DTRACE
+void test_callTrace() {TRACE;
+	std::atomic<int> state(0);
+	Thread t([&] {
+		CallTrace outer("outer", __FILE__, __LINE__);
+		CallTrace inner("inner", __FILE__, __LINE__);
+		state = 1;
+		while (state != 2) Thread::yield();
+	});
+	t.start();
+	while (state != 1) Thread::yield();
+	Array<StackTraceElement> st = t.getStackTrace();
+	state = 2;
+	t.join();
+	System::out.print("stack of " + t.getName() + ":");
+	for (int i=0; i < st.length; ++i) System::out.print(" " + st[i].getMethodName());
+	System::out.println("");
+	if (st.length < 2 || !st[0].getMethodName().equals("inner") || !st[1].getMethodName().equals("outer"))
+		System::err.println("wrong stack of other thread");
+}
+
+// marked by hand, the test does not depend on -finstrument-functions
+void profiledInner() {
+	Profiler::enter((const void *)&profiledInner);
+	Thread::sleep(1);
+	Profiler::leave((const void *)&profiledInner);
+}
+void profiledOuter() {
+	Profiler::enter((const void *)&profiledOuter);
+	for (int i=0; i < 3; ++i) profiledInner();
+	Profiler::leave((const void *)&profiledOuter);
+}
+std::string readFile(const std::string& path) {
+	std::string s;
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) return s;
+	s = readAll(fd);
+	::close(fd);
+	return s;
+}
+int count(const std::string& s, const std::string& what) {
+	int n = 0;
+	for (size_t i = 0; (i = s.find(what, i)) != std::string::npos; ++i) ++n;
+	return n;
+}
+void test_profiler() {TRACE;
+	const std::string path = "/tmp/threads-profile";
+	Profiler::addSymbolPrefix("profiled");
+	Profiler::start(path.c_str());
+	profiledOuter();
+	Thread t([]{ profiledOuter(); });
+	t.start();
+	t.join();
+	Profiler::stop();
+	Profiler::clearSymbolPrefixes();
+
+	std::string txt = readFile(path + ".txt"), json = readFile(path + ".json");
+	::unlink((path + ".txt").c_str());
+	::unlink((path + ".json").c_str());
+	long outer = 0, inner = 0;
+	size_t i = txt.find("profiledOuter()");
+	if (i != std::string::npos) outer = std::strtol(txt.c_str() + txt.rfind('\n', i) + 1, null, 10);
+	i = txt.find("profiledInner()");
+	if (i != std::string::npos) inner = std::strtol(txt.c_str() + txt.rfind('\n', i) + 1, null, 10);
+	int begins = count(json, "\"ph\":\"B\""), ends = count(json, "\"ph\":\"E\"");
+	if (outer == 0 || inner != 3 * outer || begins != ends || begins != outer + inner || json.find("\"traceEvents\"") != 1)
+		System::err.println("wrong profile\n" + String(txt.c_str()));
+	else System::out.println("profile of 2 threads: inner 3 times per outer, trace events paired");
+}
+
+__attribute__((noinline)) double sampledBusy(long millis) {
+	volatile double x = 1;
+	long end = System::currentTimeMillis() + millis;
+	while (System::currentTimeMillis() < end) {
+		for (int i=0; i < 10000; ++i) x = x * 1.0000001 + 1e-9;
+	}
+	return x;
+}
+void test_sampling() {TRACE;
+	Runtime& rt = Runtime::getRuntime();
+	rt.startProfiling(1000);
+	try {
+		rt.startProfiling();
+		System::err.println("second start allowed");
+	} catch (const IllegalStateException& e) {}
+	Thread t([]{ sampledBusy(200); });
+	t.setName("sampled");
+	t.start();
+	sampledBusy(200);
+	t.join();
+	rt.stopProfiling();
+
+	std::ostringstream os;
+	io::FileOutputStream fs(os);
+	io::PrintStream out(fs);
+	rt.dumpProfile(out);
+	std::string folded = os.str();
+	long busy = 0;
+	boolean sampledThread = false;
+	for (size_t i = 0; (i = folded.find("sampledBusy", i)) != std::string::npos; ++i) {
+		size_t eol = folded.find('\n', i), sp = folded.rfind(' ', eol);
+		busy += std::strtol(folded.c_str() + sp + 1, null, 10);
+		if (folded.compare(folded.rfind('\n', i) + 1, 8, "sampled;") == 0) sampledThread = true;
+		i = eol;
+	}
+	// a second session idles: the drainer must sleep, not spin
+	rt.startProfiling(1000);
+	struct timespec c0, c1;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &c0);
+	Thread::sleep(200);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &c1);
+	rt.stopProfiling();
+	jlong idleCpu = (c1.tv_sec - c0.tv_sec) * 1000000000L + c1.tv_nsec - c0.tv_nsec;
+	if (idleCpu > 50000000L) System::err.printf("wrong idle profiling: %ld ms cpu in 200 ms\n", idleCpu / 1000000);
+
+	// 400ms of cpu at 1kHz, cpu clock timers fire on the scheduler tick (100-1000Hz)
+	if (rt.isProfiling() || busy < 20 || !sampledThread)
+		System::err.println("wrong sampling profile\n" + String(folded.c_str()));
+	else System::out.println("sampled cpu profile of 2 threads");
+}
+
+void test_threadPool() {TRACE;
+	ThreadPool pool(4);
+	util::concurrent::Future<long> f = pool.submit([]{ return 6l * 7; });
+	util::concurrent::Future<void> g = pool.submit([]{ throw IllegalStateException("from task"); });
+	// nested submits go to the worker's own deque
+	util::concurrent::Future<long> nested = pool.submit([&pool]{
+		util::concurrent::Future<long> inner = pool.submit([]{ return 1l; });
+		return pool.parallelReduce(0, 1000, 10, 0l, [](long lo, long hi) { return hi - lo; }, [](long a, long b) { return a + b; }) + inner.get();
+	});
+	std::atomic<long> sum{0};
+	pool.parallelFor(0, 100000, 0, [&sum](long i) { sum.fetch_add(i, std::memory_order_relaxed); });
+	long squares = pool.parallelReduce(1, 101, 7, 0l, [](long lo, long hi) {
+		long s = 0;
+		for (long i = lo; i < hi; ++i) s += i * i;
+		return s;
+	}, [](long a, long b) { return a + b; });
+	// bool results, one per chunk
+	boolean allChunks = pool.parallelReduce(0, 1000, 1, true, [](long lo, long hi) { return hi > lo; }, [](boolean a, boolean b) { return a && b; });
+	boolean rethrown = false;
+	try {
+		pool.parallelFor(0, 100, 1, [](long i) { if (i == 50) throw IllegalArgumentException("50"); });
+	} catch (const IllegalArgumentException& e) { rethrown = true; }
+	boolean failed = false;
+	try { g.get(); } catch (const IllegalStateException& e) { failed = true; }
+
+	std::atomic<int> ran{0};
+	for (int i=0; i < 1000; ++i) pool.execute([&ran]{ ran.fetch_add(1); });
+	pool.shutdown();
+	boolean rejected = false;
+	try { pool.execute([]{}); } catch (const RejectedExecutionException& e) { rejected = true; }
+	try { pool.submit([]{ return 0; }); rejected = false; } catch (const RejectedExecutionException& e) {}
+	boolean terminated = pool.awaitTermination(10000);
+
+	ThreadPool stopped(1);
+	std::atomic<boolean> busy{false};
+	stopped.execute([&busy]{ busy = true; Thread::sleep(100); });
+	while (!busy) Thread::yield();
+	for (int i=0; i < 10; ++i) stopped.execute([&ran]{ ran.fetch_add(1000); });
+	int dropped = stopped.shutdownNow();
+
+	if (f.get() != 42 || nested.get() != 1001 || sum.load() != 99999l * 100000 / 2 || squares != 338350 || !allChunks ||
+			!rethrown || !failed || !rejected || !terminated || ran.load() + 1000 * dropped != 11000)
+		System::err.println("wrong thread pool results");
+	else System::out.println("thread pool: futures, nested submits, parallelFor/Reduce, shutdown");
+}
+
+void test_mpmcQueue() {TRACE;
+	util::concurrent::MPMCQueue<std::unique_ptr<long>> q(3);
+	int pushed = 0;
+	while (q.tryEnqueue(std::unique_ptr<long>(new long(pushed)))) ++pushed;
+	std::unique_ptr<long> p;
+	boolean fifo = q.tryDequeue(p) && *p == 0;
+	jlong t0 = System::currentTimeMillis();
+	util::concurrent::MPMCQueue<long> empty(16);
+	long v;
+	boolean timedOut = !empty.dequeue(v, 50) && System::currentTimeMillis() - t0 >= 50;
+
+	// 4 producers, 4 consumers, half of the items in batches
+	util::concurrent::MPMCQueue<long> mq(64);
+	const long items = 40000;
+	std::atomic<long> sum{0}, count{0};
+	std::vector<std::thread*> threads;
+	for (int c=0; c < 4; ++c) threads.push_back(new std::thread([&] {
+		long buf[8];
+		for (int n; (n = mq.dequeueN(buf, 8)) > 0; ) {
+			for (int i=0; i < n; ++i) sum.fetch_add(buf[i]);
+			count.fetch_add(n);
+		}
+	}));
+	for (int p=0; p < 4; ++p) threads.push_back(new std::thread([&mq, p, items] {
+		long buf[10];
+		for (long i = p; i < items / 2; i += 4) mq.enqueue(i);
+		for (long i = items / 2 + p * 10; i < items; i += 40) {
+			for (int k=0; k < 10; ++k) buf[k] = i + k;
+			mq.enqueueN(buf, 10);
+		}
+	}));
+	for (size_t i = 4; i < threads.size(); ++i) threads[i]->join();
+	mq.close();
+	for (size_t i = 0; i < 4; ++i) threads[i]->join();
+	for (std::thread *t : threads) delete t;
+	threads.clear();
+
+	// closed while producers run: every accepted item is dequeued
+	util::concurrent::MPMCQueue<long> cq(16);
+	std::atomic<long> accepted{0}, taken{0};
+	for (int c=0; c < 2; ++c) threads.push_back(new std::thread([&] {
+		for (long x; cq.dequeue(x); ) taken.fetch_add(1);
+	}));
+	for (int p=0; p < 4; ++p) threads.push_back(new std::thread([&] {
+		for (long i=0; cq.enqueue(i); ++i) accepted.fetch_add(1);
+	}));
+	Thread::sleep(20);
+	cq.close();
+	for (std::thread *t : threads) { t->join(); delete t; }
+	boolean closeRace = accepted.load() == taken.load() && cq.isEmpty();
+
+	SyncQueue<String> sq(4);
+	sq.enqueue(String("a"));
+	sq.stop();
+	boolean stopped = false;
+	try { sq.enqueue(String("b")); } catch (const SyncQueueException& e) { stopped = true; }
+	boolean drained = sq.dequeue().equals("a");
+	try { sq.dequeue(); stopped = false; } catch (const SyncQueueException& e) {}
+	// no default constructor
+	SyncQueue<std::reference_wrapper<long>> rq(2);
+	long referred = 5;
+	rq.enqueue(std::ref(referred));
+	drained = drained && &rq.dequeue().get() == &referred;
+
+	if (pushed != 4 || !fifo || !timedOut || count.load() != items || sum.load() != items * (items - 1) / 2 ||
+			mq.tryEnqueue(1l) || !stopped || !drained || !closeRace)
+		System::err.println("wrong MPMC queue results");
+	else System::out.println("MPMC queue: bounded, move-only, timed, batches, close");
+}
+
+void test_locks() {TRACE;
+	using namespace util::concurrent;
+	boolean units = TimeUnit::SECONDS.toMillis(3) == 3000 && TimeUnit::MILLISECONDS.toSeconds(2999) == 2 &&
+			TimeUnit::MINUTES.convert(2, TimeUnit::HOURS) == 120 && TimeUnit::DAYS.toNanos(Long::MAX_VALUE / 1000) == Long::MAX_VALUE &&
+			TimeUnit::SECONDS.toNanos(-Long::MAX_VALUE / 10) == Long::MIN_VALUE;
+
+	ReentrantLock lock;
+	lock.lock();
+	lock.lock();
+	boolean reentrant = lock.getHoldCount() == 2 && lock.isHeldByCurrentThread();
+	boolean timedOut = false;
+	std::thread([&lock, &timedOut] {
+		jlong t0 = System::currentTimeMillis();
+		timedOut = !lock.tryLock(50, TimeUnit::MILLISECONDS) && System::currentTimeMillis() - t0 >= 50;
+	}).join();
+	lock.unlock();
+	lock.unlock();
+	boolean notOwner = false;
+	try { lock.unlock(); } catch (const IllegalMonitorStateException& e) { notOwner = true; }
+
+	// 4 threads counting under each kind of lock
+	long counts[2] = {0, 0};
+	for (int fair = 0; fair < 2; ++fair) {
+		ReentrantLock l(fair != 0);
+		long& count = counts[fair];
+		std::vector<std::thread*> threads;
+		for (int t=0; t < 4; ++t) threads.push_back(new std::thread([&l, &count] {
+			for (int i=0; i < 20000; ++i) {
+				l.lock();
+				++count;
+				l.unlock();
+			}
+		}));
+		for (std::thread *t : threads) { t->join(); delete t; }
+	}
+
+	// producer/consumer over a condition
+	ReentrantLock pl;
+	Condition& notEmpty = pl.newCondition();
+	std::vector<int> items;
+	long consumed = 0;
+	std::thread consumer([&] {
+		for (int n = 0; n < 1000; ++n) {
+			pl.lock();
+			while (items.empty()) notEmpty.await();
+			consumed += items.back();
+			items.pop_back();
+			pl.unlock();
+		}
+	});
+	for (int i=0; i < 1000; ++i) {
+		pl.lock();
+		items.push_back(i);
+		notEmpty.signal();
+		pl.unlock();
+	}
+	consumer.join();
+	pl.lock();
+	boolean awaitTimeout = !notEmpty.await(10, TimeUnit::MILLISECONDS);
+	pl.unlock();
+
+	// a waiting writer keeps new readers out, not the reentrant ones
+	ReentrantReadWriteLock rw;
+	rw.readLock().lock();
+	std::atomic<boolean> written{false};
+	std::thread writer([&rw, &written] {
+		rw.writeLock().lock();
+		written = true;
+		rw.writeLock().unlock();
+	});
+	boolean preferred = false;
+	while (!preferred) std::thread([&rw, &preferred] {
+		if (rw.readLock().tryLock(20, TimeUnit::MILLISECONDS)) rw.readLock().unlock();
+		else preferred = true;
+	}).join();
+	boolean readReentrant = rw.readLock().tryLock() && rw.getReadHoldCount() == 2;
+	rw.readLock().unlock();
+	rw.readLock().unlock();
+	writer.join();
+	readReentrant = readReentrant && written;
+	rw.writeLock().lock();
+	rw.readLock().lock();
+	boolean downgrade = rw.getReadLockCount() == 1 && rw.isWriteLockedByCurrentThread();
+	rw.writeLock().unlock();
+	rw.readLock().unlock();
+	boolean rwFree = !rw.isWriteLocked() && rw.getReadLockCount() == 0;
+
+	StampedLock sl;
+	jlong x = 1, y = 2;
+	jlong stamp = sl.tryOptimisticRead();
+	jlong sum = x + y;
+	boolean valid = sl.validate(stamp) && sum == 3;
+	jlong ws = sl.writeLock();
+	x = 10;
+	sl.unlockWrite(ws);
+	boolean invalidated = !sl.validate(stamp) && sl.tryOptimisticRead() != stamp;
+	jlong rs = sl.readLock();
+	jlong cs = sl.tryConvertToWriteLock(rs);
+	boolean converted = cs != 0 && sl.isWriteLocked() && !sl.isReadLocked() && sl.tryOptimisticRead() == 0;
+	sl.unlock(cs);
+	boolean stale = false;
+	try { sl.unlockWrite(cs); } catch (const IllegalMonitorStateException& e) { stale = true; }
+
+	if (!units || !reentrant || !timedOut || !notOwner || counts[0] != 80000 || counts[1] != 80000 ||
+			consumed != 999 * 1000 / 2 || !awaitTimeout || !readReentrant || !downgrade || !rwFree ||
+			!valid || !invalidated || !converted || !stale)
+		System::err.println("wrong lock results");
+	else System::out.println("locks: reentrant, fair, timed, conditions, read-write, stamped");
+}
+
+void test_concurrentHashMap() {TRACE;
+	using util::concurrent::ConcurrentHashMap;
+	ConcurrentHashMap<String,int> names;
+	names.put("one", 1);
+	int v = 0;
+	boolean lookups = names.get("one", v) && v == 1 && !names.get("two", v) && names.getOrDefault("two", -1) == -1 &&
+			names.putIfAbsent("one", 5) == 1 && names.putIfAbsent("two", 2) == 2 &&
+			names.computeIfAbsent("three", [](const String& k) { return k.length(); }) == 5 &&
+			names.computeIfAbsent("three", [](const String& k) { return 0; }) == 5 && names.size() == 3;
+	boolean removed = names.remove("two") && !names.remove("two") && !names.containsKey("two") && names.size() == 2;
+
+	// writers grow and shrink the table under readers of the stable keys
+	ConcurrentHashMap<long,long> map;
+	const long stable = 1000;
+	for (long k = 0; k < stable; ++k) map.put(k, k * 2);
+	std::atomic<boolean> stop{false};
+	std::atomic<long> misses{0};
+	std::atomic<int> computed{0};
+	std::vector<std::thread*> threads;
+	for (int r = 0; r < 4; ++r) threads.push_back(new std::thread([&map, &stop, &misses, stable] {
+		long v;
+		for (long i = 0; !stop.load(); ++i) {
+			if (!map.get(i % stable, v) || v != i % stable * 2) misses.fetch_add(1);
+		}
+	}));
+	for (int w = 0; w < 4; ++w) threads.push_back(new std::thread([&map, &computed, w, stable] {
+		for (long i = 0; i < 20000; ++i) {
+			long k = stable + w * 20000 + i;
+			map.put(k, k);
+			map.computeIfAbsent(-1 - i, [&computed](long k) { computed.fetch_add(1); return k; });
+			if (i % 2 == 0) map.remove(k);
+		}
+	}));
+	for (size_t i = 4; i < threads.size(); ++i) threads[i]->join();
+	stop = true;
+	for (size_t i = 0; i < 4; ++i) threads[i]->join();
+	for (std::thread *t : threads) delete t;
+	long sum = 0;
+	map.forEach([&sum](long k, long v) { sum += v - k; });
+
+	if (!lookups || !removed || misses.load() != 0 || computed.load() != 20000 ||
+			map.size() != stable + 4 * 10000 + 20000 || sum != stable * (stable - 1) / 2)
+		System::err.println("wrong concurrent hash map results");
+	else System::out.println("concurrent hash map: lookups, putIfAbsent, computeIfAbsent, resize under readers");
+}
+
+void test_metrics() {TRACE;
+	util::concurrent::LongAdder adder;
+	std::vector<std::thread*> threads;
+	for (int t=0; t < 4; ++t) threads.push_back(new std::thread([&adder] {
+		for (int i=0; i < 10000; ++i) adder.increment();
+	}));
+	for (std::thread *t : threads) { t->join(); delete t; }
+	boolean summed = adder.sum() == 40000 && adder.sumThenReset() == 40000 && adder.sum() == 0;
+
+	util::Metrics::Histogram& h = util::Metrics::histogram("test.latency");
+	for (jlong v = 1; v <= 1000; ++v) h.record(v * 1000);
+	jlong p50 = h.percentile(0.5), p99 = h.percentile(0.99);
+	// within the bucket resolution of 1/16
+	boolean histogram = h.getCount() == 1000 && h.getMax() == 1000000 && p50 >= 500000 && p50 <= 500000 * 17 / 16 &&
+			p99 >= 990000 && p99 <= 1000000 && h.percentile(1.0) == 1000000;
+
+	util::Metrics::counter("test.count").add(3);
+	boolean same = &util::Metrics::counter("test.count") == &util::Metrics::counter("test.count");
+	boolean kinds = false;
+	try { util::Metrics::gauge("test.count"); } catch (const IllegalArgumentException& e) { kinds = true; }
+
+	util::HashMap<int,int> map;
+	jlong rehashes = util::Metrics::counter("util.HashMap.rehash").sum();
+	// 16 buckets doubled past 12, 24, 48 and 96 entries
+	for (int i=0; i < 100; ++i) map.put(i, i);
+	boolean rehashed = util::Metrics::counter("util.HashMap.rehash").sum() - rehashes == 4 && map.get(77) == 77;
+	{
+		ThreadPool pool(2);
+		for (int i=0; i < 100; ++i) pool.execute([]{});
+	}
+	String snapshot = util::Metrics::snapshot();
+	boolean exported = snapshot.indexOf("counter test.count 3\n") >= 0 && snapshot.indexOf("gauge ThreadPool.queued 0\n") >= 0 &&
+			snapshot.indexOf("histogram ThreadPool.task.latency.ns count=") >= 0 && snapshot.indexOf("histogram test.latency count=1000 ") >= 0;
+
+	if (!summed || !histogram || !same || !kinds || !rehashed || !exported) {
+		System::err.println("wrong metrics results");
+		System::err.println(snapshot);
+	}
+	else System::out.println("metrics: LongAdder, histogram percentiles, registry, snapshot");
+}
+
+void test_scheduler() {TRACE;
+	using util::concurrent::ScheduledExecutorService;
+	using util::concurrent::ScheduledFuture;
+	using util::concurrent::TimeUnit;
+	const int N = 10000;
+	// 100us ticks: the delays up to 50ms cross laps of the root wheel
+	ScheduledExecutorService timer(2, 100, TimeUnit::MICROSECONDS);
+	std::atomic<int> fired{0}, early{0};
+	for (int i=0; i < N; ++i) {
+		jlong delay = (i * 7919L) % 50000, due = System::nanoTime() + delay * 1000;
+		timer.schedule([&fired, &early, due] {
+			if (System::nanoTime() < due) early.fetch_add(1);
+			fired.fetch_add(1);
+		}, delay, TimeUnit::MICROSECONDS);
+	}
+	std::atomic<int> cancelledRuns{0};
+	std::vector<ScheduledFuture> cancelled;
+	for (int i=0; i < 1000; ++i) {
+		cancelled.push_back(timer.schedule([&cancelledRuns] { cancelledRuns.fetch_add(1); }, 20 + i % 30, TimeUnit::MILLISECONDS));
+	}
+	boolean cancels = true;
+	for (ScheduledFuture& f : cancelled) cancels &= f.cancel() && !f.cancel() && f.isDone();
+
+	std::atomic<int> rate{0}, delayed{0}, thrown{0};
+	ScheduledFuture r = timer.scheduleAtFixedRate([&rate] { rate.fetch_add(1); }, 0, 5, TimeUnit::MILLISECONDS);
+	ScheduledFuture d = timer.scheduleWithFixedDelay([&delayed] { delayed.fetch_add(1); }, 0, 5, TimeUnit::MILLISECONDS);
+	ScheduledFuture t = timer.scheduleAtFixedRate([&thrown] { thrown.fetch_add(1); throw RuntimeException("periodic failure"); }, 0, 1, TimeUnit::MILLISECONDS);
+	ScheduledFuture far = timer.schedule([] {}, 10, TimeUnit::DAYS);
+	jlong farDays = far.getDelay(TimeUnit::HOURS);
+	for (int i=0; i < 200 && fired.load() < N; ++i) Thread::sleep(10);
+	Thread::sleep(100);
+	boolean periodic = r.cancel() && d.cancel() && rate.load() >= 10 && delayed.load() >= 10 && thrown.load() == 1 && t.isDone();
+	int rateRuns = rate.load();
+	Thread::sleep(20);
+	periodic &= rate.load() <= rateRuns + 1;
+	boolean longDelay = farDays > 239 && farDays <= 240 && !far.isDone() && timer.size() == 1;
+
+	timer.schedule([] {}, 1, TimeUnit::HOURS);
+	timer.shutdown();
+	boolean rejected = false;
+	try { timer.schedule([] {}, 1, TimeUnit::MILLISECONDS); } catch (const RejectedExecutionException& e) { rejected = true; }
+	boolean stopped = timer.isShutdown() && rejected && timer.shutdownNow() == 2 && timer.size() == 0;
+
+	// a handle outliving its executor
+	ScheduledFuture orphan;
+	{
+		ScheduledExecutorService scoped(1);
+		orphan = scoped.schedule([] {}, 1, TimeUnit::HOURS);
+	}
+	stopped &= orphan.isDone() && !orphan.cancel() && orphan.getDelay(TimeUnit::MILLISECONDS) == 0;
+
+	if (fired.load() != N || early.load() != 0 || !cancels || cancelledRuns.load() != 0 || !periodic || !longDelay || !stopped) {
+		System::err.printf("wrong scheduler results: fired %d early %d, cancelled runs %d, rate %d delay %d thrown %d, far %ld h, stopped %d\n",
+				fired.load(), early.load(), cancelledRuns.load(), rate.load(), delayed.load(), thrown.load(), farDays, (int)stopped);
+	}
+	else System::out.println("scheduler: timing wheel delays, cancel, fixed rate/delay, shutdown");
+}
+
+void test_affinity() {TRACE;
+	CpuSet parsed = CpuSet::parse("0-3,8,10-11");
+	boolean lists = parsed.cardinality() == 7 && parsed.toString().equals("0-3,8,10-11") && parsed.get(8) && !parsed.get(9) &&
+			CpuSet({5, 1, 2}).toString().equals("1-2,5") && CpuSet().toString().length() == 0;
+	try { CpuSet::parse("1-x"); lists = false; } catch (const IllegalArgumentException& e) {}
+
+	CpuSet online = CpuSet::online();
+	int first = online.nextSetBit(0), last = first;
+	for (int c = first; c >= 0; c = online.nextSetBit(c + 1)) last = c;
+	boolean topology = !online.isEmpty() && Numa::nodeCount() >= 1 && Runtime::getRuntime().availableProcessors() == online.cardinality() &&
+			Numa::cpusOfNode(Numa::nodeOfCpu(first)).get(first);
+
+	// pinned before start, then moved while running
+	std::atomic<int> ranOn{-1}, movedTo{-1};
+	Thread pinned([&] {
+		ranOn = Numa::currentCpu();
+		Thread::currentThread().setAffinity(CpuSet({last}));
+		Thread::yield();
+		movedTo = Numa::currentCpu();
+	});
+	pinned.setAffinity(CpuSet({first}));
+	pinned.start();
+	pinned.join();
+	boolean pinning = ranOn.load() == first && movedTo.load() == last;
+	try { pinned.setAffinity(CpuSet({CpuSet::MAX_CPUS - 1})); pinning = false; } catch (const IllegalArgumentException& e) {}
+
+	ThreadGroup group("placed");
+	group.setPlacement(ThreadGroup::COMPACT);
+	std::vector<int> placed;
+	std::mutex placedLock;
+	{
+		ThreadPool pool(2, group);
+		pool.parallelFor(0, 64, 1, [&](long) {
+			CpuSet cpus = Thread::currentThread().getAffinity();
+			if (cpus.cardinality() != 1) return;
+			std::lock_guard<std::mutex> g(placedLock);
+			placed.push_back(cpus.nextSetBit(0));
+		});
+	}
+	// the calling thread takes chunks too, only the workers are pinned
+	boolean placement = !placed.empty();
+	for (int c : placed) placement &= online.get(c);
+
+	// nice values per thread
+	std::atomic<int> niceLow{-100}, niceNorm{-100};
+	boolean realtime = true;
+	Thread prio([&] {
+		Thread& t = Thread::currentThread();
+		int tid = (int)::syscall(SYS_gettid);
+		t.setPriority(Thread::MIN_PRIORITY);
+		niceLow = ::getpriority(PRIO_PROCESS, (id_t)tid);
+		try { t.setPriority(Thread::MAX_PRIORITY + 1); realtime = false; } catch (const IllegalArgumentException& e) {}
+		try { t.setRealtimePriority(100); realtime = false; } catch (const IllegalArgumentException& e) {}
+		// permitted or not depends on the user, it must not stick
+		if (t.setRealtimePriority(1)) realtime &= ::sched_getscheduler(tid) == SCHED_FIFO && t.getRealtimePriority() == 1;
+		realtime &= t.setRealtimePriority(0) && ::sched_getscheduler(tid) == SCHED_OTHER;
+		niceNorm = ::getpriority(PRIO_PROCESS, (id_t)tid);
+	});
+	prio.start();
+	prio.join();
+	boolean priority = niceLow.load() == 4 && niceNorm.load() == 4 && realtime;
+
+	const size_t size = 1 << 20;
+	char *local = (char *)Numa::allocateLocal(size);
+	char *onNode = (char *)Numa::allocateOnNode(size, Numa::nodeOfCpu(first));
+	local[size - 1] = 1;
+	onNode[size - 1] = 1;
+	boolean memory = local[0] == 0 && onNode[0] == 0 && Thread::currentThread().getAffinity().equals(online);
+	Numa::free(local, size);
+	Numa::free(onNode, size);
+
+	if (!lists || !topology || !pinning || !placement || !priority || !memory) {
+		System::err.printf("wrong affinity results: lists %d topology %d pinning %d (ran on %d, moved to %d) placement %d priority %d (nice %d, %d) memory %d\n",
+				(int)lists, (int)topology, (int)pinning, ranOn.load(), movedTo.load(), (int)placement, (int)priority, niceLow.load(), niceNorm.load(), (int)memory);
+	}
+	else System::out.println("affinity: cpu sets " + online.toString() + " on " + String::valueOf(Numa::nodeCount()) + " nodes, pinning, placement, priorities");
+}
+
+void test_fibers() {TRACE;
+	const int N = 10000;
+	std::atomic<int> ran{0};
+	std::mutex carriersLock;
+	std::vector<std::thread::id> carriers;
+	{
+		FiberScheduler two(2);
+		std::vector<std::unique_ptr<Fiber>> fibers;
+		for (int i=0; i < N; ++i) {
+			fibers.emplace_back(new Fiber(two, [&, i] {
+				for (int y=0; y < 3; ++y) Fiber::yield();
+				if (i % 100 == 0) Fiber::sleep(1 + i % 5);
+				std::lock_guard<std::mutex> g(carriersLock);
+				if (std::find(carriers.begin(), carriers.end(), std::this_thread::get_id()) == carriers.end())
+					carriers.push_back(std::this_thread::get_id());
+				ran.fetch_add(1);
+			}));
+			fibers.back()->start();
+		}
+		for (std::unique_ptr<Fiber>& f : fibers) f->join();
+	}
+	boolean many = ran.load() == N && carriers.size() <= 2;
+
+	// one carrier: whatever blocks below must park the fiber, not the carrier
+	FiberScheduler one(1);
+	int pings = 0;
+	Fiber *pongFiber = null;
+	Fiber ping(one, [&] {
+		for (int i=0; i < 1000; ++i) {
+			pings = i + 1;
+			Fiber::unpark(*pongFiber);
+			while (pings != -(i + 1)) Fiber::park();
+		}
+	});
+	Fiber pong(one, [&] {
+		for (int i=0; i < 1000; ++i) {
+			while (pings != i + 1) Fiber::park();
+			pings = -(i + 1);
+			Fiber::unpark(ping);
+		}
+	});
+	pongFiber = &pong;
+	pong.start();
+	ping.start();
+	ping.join();
+	pong.join();
+	boolean parking = pings == -1000 && ping.getState() == Fiber::TERMINATED;
+
+	// switched out inside synchronized: the others contend and park on the monitor
+	Object monitor;
+	long counter = 0;
+	std::vector<std::unique_ptr<Fiber>> lockers;
+	for (int i=0; i < 50; ++i) {
+		lockers.emplace_back(new Fiber(one, [&] {
+			for (int j=0; j < 20; ++j) {
+				synchronized(monitor) {
+					long c = counter;
+					Fiber::yield();
+					counter = c + 1;
+				}
+			}
+		}));
+		lockers.back()->start();
+	}
+	for (std::unique_ptr<Fiber>& f : lockers) f->join();
+
+	int value = 0, seen = 0;
+	Fiber consumer(one, [&] {
+		synchronized(monitor) {
+			while (value < 3) {
+				monitor.wait();
+				++seen;
+			}
+		}
+	});
+	Fiber producer(one, [&] {
+		for (int i=1; i <= 3; ++i) {
+			Thread::sleep(5);
+			synchronized(monitor) {
+				value = i;
+				monitor.notifyAll();
+			}
+		}
+	});
+	consumer.start();
+	producer.start();
+	// joined from a fiber too
+	Fiber joiner(one, [&] { consumer.join(); producer.join(); });
+	joiner.start();
+	joiner.join();
+	boolean monitors = counter == 1000 && value == 3 && seen >= 1 && seen <= 3;
+
+	// a hundred sleeps of 50ms overlap on the one carrier
+	jlong t0 = System::currentTimeMillis();
+	std::vector<std::unique_ptr<Fiber>> sleepers;
+	for (int i=0; i < 100; ++i) {
+		sleepers.emplace_back(new Fiber(one, [] { Thread::sleep(50); }));
+		sleepers.back()->start();
+	}
+	for (std::unique_ptr<Fiber>& f : sleepers) f->join();
+	jlong slept = System::currentTimeMillis() - t0;
+	boolean sleeping = slept >= 50 && slept < 2000;
+
+	// exceptions thrown and caught across switches
+	int caught = 0;
+	Fiber thrower(one, [&] {
+		for (int i=0; i < 10; ++i) {
+			try {
+				Fiber::yield();
+				throw IllegalStateException("on a fiber");
+			} catch (const IllegalStateException& e) {
+				++caught;
+			}
+		}
+	});
+	Fiber other(one, [&] {
+		for (int i=0; i < 10; ++i) {
+			try { throw IllegalArgumentException("other"); } catch (const IllegalArgumentException& e) { Fiber::yield(); }
+		}
+	});
+	thrower.start();
+	other.start();
+	thrower.join();
+	other.join();
+	boolean exceptions = caught == 10 && std::uncaught_exception() == false;
+
+	// a blocking datagram read parks, the other fiber keeps the carrier
+	using namespace nio::channels;
+	Shared<Selector> selector = Selector::open();
+	Shared<DatagramChannel> rx = selector->provider()->openDatagramChannel();
+	Shared<DatagramChannel> tx = selector->provider()->openDatagramChannel();
+	rx->bind(InetSocketAddress("localhost", 8123));
+	tx->connect(InetSocketAddress("localhost", 8123));
+	std::atomic<int> received{0};
+	std::atomic<long> spins{0};
+	std::atomic<boolean> done{false};
+	Fiber reader(one, [&] {
+		Shared<nio::ByteBuffer> buf = nio::ByteBuffer::allocate(16);
+		rx->receive(*buf);
+		received = buf->position();
+		done = true;
+	});
+	Fiber spinner(one, [&] { while (!done) { spins.fetch_add(1); Fiber::yield(); } });
+	reader.start();
+	spinner.start();
+	while (spins.load() < 100) Thread::sleep(1);
+	Shared<nio::ByteBuffer> msg = nio::ByteBuffer::allocate(10);
+	for (int i=0; i < 10; ++i) msg->put((byte)i);
+	msg->flip();
+	tx->write(*msg);
+	reader.join();
+	spinner.join();
+	// two fibers waiting for the one descriptor are both woken
+	std::atomic<int> readers{0};
+	int pfd[2];
+	if (::pipe(pfd) != 0) return;
+	::fcntl(pfd[0], F_SETFL, O_NONBLOCK);
+	auto readOne = [&] {
+		char c;
+		while (::read(pfd[0], &c, 1) != 1) Fiber::awaitReadable(pfd[0]);
+		readers.fetch_add(1);
+	};
+	Fiber reader1(one, readOne), reader2(one, readOne);
+	reader1.start();
+	reader2.start();
+	Thread::sleep(20);
+	if (::write(pfd[1], "ab", 2) != 2) return;
+	reader1.join();
+	reader2.join();
+	::close(pfd[0]); ::close(pfd[1]);
+	boolean channels = received.load() == 10 && spins.load() >= 100 && readers.load() == 2;
+
+	if (!many || !parking || !monitors || !sleeping || !exceptions || !channels) {
+		System::err.printf("wrong fiber results: ran %d on %d carriers, pings %d, counter %ld value %d seen %d, slept %ld ms, caught %d, received %d\n",
+				ran.load(), (int)carriers.size(), pings, counter, value, seen, slept, caught, received.load());
+	}
+	else System::out.println("fibers: " + String::valueOf(N) + " on 2 carriers, park/unpark, synchronized, wait/notify, sleep, join, exceptions, channel read");
+}
+
+void test_futures() {TRACE;
+	using namespace util::concurrent;
+	ThreadPool pool(4);
+
+	// a chain registered before completion, completed by another thread
+	Promise<int> p;
+	Future<String> chain = p.getFuture()
+		.thenApply([](int v) { return v * 2; })
+		.thenApply([](int v) { return (long)v + 1; })
+		.thenApply([](long v) { return String::valueOf(v); });
+	Thread completer([&p] { Thread::sleep(10); p.complete(20); });
+	completer.start();
+	boolean chained = chain.get().equals("41") && !p.complete(1);
+	completer.join();
+
+	// async stages, compose and combine
+	Future<int> a = supplyAsync([] { return 6; }, pool);
+	Future<int> b = a.thenApplyAsync([](int v) { return v * 7; }, pool);
+	Future<long> composed = b.thenCompose([&pool](int v) {
+		return supplyAsync([v] { return (long)v * 1000; }, pool);
+	});
+	Future<String> combined = composed.thenCombine(a, [](long x, int y) { return String::valueOf(x + y); });
+	Future<void> done = combined.thenApply([](const String&) {});
+	done.get();
+	boolean composition = b.get() == 42 && composed.get() == 42000 && combined.get().equals("42006");
+
+	// failures skip the stages up to exceptionally, std::exception becomes RuntimeException
+	std::atomic<int> skipped{0};
+	Future<int> failing = supplyAsync([]() -> int { throw IllegalStateException("failed stage"); }, pool);
+	Future<int> after = failing.thenApply([&skipped](int v) { skipped.fetch_add(1); return v; });
+	Future<int> recovered = after.exceptionally([](const Throwable& e) { return e.getMessage().equals("failed stage") ? 1 : 0; });
+	boolean rethrown = false;
+	try { after.get(); } catch (const IllegalStateException& e) { rethrown = true; }
+	Future<int> stdFailure = completedFuture<int>(1).thenApply([](int v) -> int { throw std::out_of_range("bad index"); });
+	const Throwable *converted = stdFailure.getException();
+	Promise<void> explicitFailure;
+	explicitFailure.completeExceptionally(IllegalArgumentException("explicit"));
+	boolean failures = rethrown && skipped.load() == 0 && recovered.get() == 1 && after.isCompletedExceptionally() &&
+			converted != null && instanceof<RuntimeException>(converted) && converted->getMessage().indexOf("bad index") >= 0 &&
+			instanceof<IllegalArgumentException>(explicitFailure.getFuture().getException());
+
+	// fan-out and fan-in
+	const int N = 100;
+	std::vector<Future<long>> parts;
+	for (int i=0; i < N; ++i) parts.push_back(supplyAsync([i] { return (long)i * i; }, pool));
+	Future<long> total = allOf(parts).thenApply([](const std::vector<long>& v) {
+		long s = 0;
+		for (long x : v) s += x;
+		return s;
+	});
+	std::vector<Promise<int>> racers(3);
+	std::vector<Future<int>> racing;
+	for (Promise<int>& r : racers) racing.push_back(r.getFuture());
+	Future<int> first = anyOf(racing);
+	racers[1].complete(11);
+	racers[0].complete(10);
+	std::vector<Future<void>> voids;
+	voids.push_back(completedFuture<void>());
+	voids.push_back(failedFuture<void>(IllegalStateException("one failed")));
+	voids.push_back(Promise<void>().getFuture());
+	Future<void> failFast = allOf(voids);
+	boolean fanning = total.get() == 328350 && first.get() == 11 && failFast.isCompletedExceptionally() &&
+			allOf(std::vector<Future<int>>()).get().empty();
+
+	// timeouts
+	Promise<int> never;
+	Future<int> timedOut = never.getFuture().orTimeout(20, TimeUnit::MILLISECONDS);
+	Future<int> defaulted = Promise<int>().getFuture().completeOnTimeout(5, 20, TimeUnit::MILLISECONDS);
+	boolean waitTimedOut = false, orTimedOut = false;
+	try { Promise<int>().getFuture().get(10, TimeUnit::MILLISECONDS); } catch (const TimeoutException& e) { waitTimedOut = true; }
+	try { timedOut.get(); } catch (const TimeoutException& e) { orTimedOut = true; }
+	Future<int> inTime = completedFuture<int>(3).orTimeout(1, TimeUnit::MILLISECONDS);
+	Thread::sleep(5);
+	// polled with timed gets, the waiter is shared, then completed while a thread waits
+	Promise<int> polled;
+	int polls = 0;
+	for (int i=0; i < 10000; ++i) {
+		try { polled.getFuture().get(0, TimeUnit::MILLISECONDS); } catch (const TimeoutException& e) { ++polls; }
+	}
+	Thread pollCompleter([&polled] { Thread::sleep(10); polled.complete(9); });
+	pollCompleter.start();
+	boolean polledDone = polls == 10000 && polled.getFuture().get(10, TimeUnit::SECONDS) == 9;
+	pollCompleter.join();
+	boolean timeouts = waitTimedOut && orTimedOut && !never.complete(1) && defaulted.get() == 5 && inTime.get() == 3 && polledDone;
+
+	// a long chain completes in a loop, not recursively
+	Promise<long> start;
+	Future<long> longChain = start.getFuture();
+	for (int i=0; i < 100000; ++i) longChain = longChain.thenApply([](long v) { return v + 1; });
+	start.complete(0l);
+	// as deep through futures already completed when composed
+	Promise<long> composeStart;
+	Future<long> composeChain = composeStart.getFuture();
+	for (int i=0; i < 100000; ++i) composeChain = composeChain.thenCompose([](long v) { return completedFuture<long>(v + 1); });
+	composeStart.complete(0l);
+	boolean deep = longChain.get() == 100000 && composeChain.get() == 100000;
+
+	// a fiber parks in get
+	Promise<int> forFiber;
+	int fromFiber = 0;
+	lang::Fiber waiter([&forFiber, &fromFiber] { fromFiber = forFiber.getFuture().get(); });
+	waiter.start();
+	Thread::sleep(5);
+	forFiber.complete(7);
+	waiter.join();
+
+	pool.shutdown();
+	pool.awaitTermination(10000);
+	Future<int> rejected = supplyAsync([] { return 1; }, pool);
+	boolean rejections = instanceof<RejectedExecutionException>(rejected.getException());
+
+	if (!chained || !composition || !failures || !fanning || !timeouts || !deep || fromFiber != 7 || !rejections) {
+		System::err.printf("wrong future results: chain %d, composition %d, failures %d, fan-out %d, timeouts %d, deep %d, fiber %d, rejected %d\n",
+				(int)chained, (int)composition, (int)failures, (int)fanning, (int)timeouts, (int)deep, fromFiber, (int)rejections);
+	}
+	else System::out.println("futures: chains, async stages, compose/combine, failures, allOf/anyOf, timeouts, fibers");
+}
+
 int main(int argc, const char *argv[]) {TRACE;
 	test_mainthread();
 	test_backtrace();
+	test_waitNotify();
 	test_thread();
+	test_logger();
+	test_binaryLog();
+	test_callTrace();
+	test_profiler();
+	test_sampling();
+	test_threadPool();
+	test_mpmcQueue();
+	test_locks();
+	test_concurrentHashMap();
+	test_metrics();
+	test_scheduler();
+	test_affinity();
+	test_fibers();
+	test_futures();
 	System::out.println("Threads done");
 	Thread::sleep(1000);
 }
@@ -0,0 +1,85 @@
+#!/usr/bin/perl
+# Generates src/lang/CharacterData.cpp, the two stage property table of the BMP,
+# from the Unicode character database of the perl installation:
+#   perl tools/GenerateCharacter.pl > src/lang/CharacterData.cpp
+use strict;
+use warnings;
+use Unicode::UCD qw(charinfo);
+
+my %types = (
+	Cn => 0, Lu => 1, Ll => 2, Lt => 3, Lm => 4, Lo => 5, Mn => 6, Me => 7, Mc => 8,
+	Nd => 9, Nl => 10, No => 11, Zs => 12, Zl => 13, Zp => 14, Cc => 15, Cf => 16,
+	Co => 18, Cs => 19, Pd => 20, Ps => 21, Pe => 22, Pc => 23, Po => 24, Sm => 25,
+	Sc => 26, Sk => 27, So => 28, Pi => 29, Pf => 30,
+);
+my $BLOCK = 128;
+
+my (@records, %recordIndex, @blocks, %blockIndex, @index);
+my @block;
+for my $cp (0 .. 0xFFFF) {
+	my $info = charinfo($cp);
+	my $cat = $info ? $info->{category} : ($cp >= 0xD800 && $cp <= 0xDFFF ? 'Cs' : ($cp >= 0xE000 && $cp <= 0xF8FF ? 'Co' : 'Cn'));
+	my $type = $types{$cat};
+	my $digit = 255;
+	$digit = $info->{decimal} if $cat eq 'Nd' && $info->{decimal} ne '';
+	$digit = $cp - 0x41 + 10 if $cp >= 0x41 && $cp <= 0x5A;
+	$digit = $cp - 0x61 + 10 if $cp >= 0x61 && $cp <= 0x7A;
+	$digit = $cp - 0xFF21 + 10 if $cp >= 0xFF21 && $cp <= 0xFF3A;
+	$digit = $cp - 0xFF41 + 10 if $cp >= 0xFF41 && $cp <= 0xFF5A;
+	my $ws = (($cat eq 'Zs' || $cat eq 'Zl' || $cat eq 'Zp') && $cp != 0xA0 && $cp != 0x2007 && $cp != 0x202F)
+		|| ($cp >= 0x09 && $cp <= 0x0D) || ($cp >= 0x1C && $cp <= 0x1F) ? 1 : 0;
+	my $upper = $info && $info->{upper} ne '' ? hex($info->{upper}) : $cp;
+	my $lower = $info && $info->{lower} ne '' ? hex($info->{lower}) : $cp;
+	$upper = $cp if $upper > 0xFFFF;
+	$lower = $cp if $lower > 0xFFFF;
+	my $rec = sprintf("{%d, %d, %s, 0x%04X, 0x%04X}", $type, $digit, $ws ? "true" : "false",
+		($upper - $cp) & 0xFFFF, ($lower - $cp) & 0xFFFF);
+	if (!exists $recordIndex{$rec}) {
+		$recordIndex{$rec} = scalar @records;
+		push @records, $rec;
+	}
+	push @block, $recordIndex{$rec};
+	if (@block == $BLOCK) {
+		my $key = join(",", @block);
+		if (!exists $blockIndex{$key}) {
+			$blockIndex{$key} = scalar @blocks;
+			push @blocks, [@block];
+		}
+		push @index, $blockIndex{$key};
+		@block = ();
+	}
+}
+
+sub rows {
+	my ($per, @v) = @_;
+	my @out;
+	while (@v) {
+		push @out, "\t" . join(", ", splice(@v, 0, $per)) . ",";
+	}
+	return join("\n", @out);
+}
+
+my $version = Unicode::UCD::UnicodeVersion();
+my ($nrecords, $nblocks, $nindex) = (scalar @records, scalar(@blocks) * $BLOCK, scalar @index);
+my $recordRows = rows(2, @records);
+my $blockRows = rows(16, map { @$_ } @blocks);
+my $indexRows = rows(32, @index);
+print <<"END";
+// Generated by tools/GenerateCharacter.pl from Unicode $version, do not edit.
+#include <lang/Character.hpp>
+
+namespace lang {
+
+const CharacterData::Properties CharacterData::records[$nrecords] = {
+$recordRows
+};
+const unsigned short CharacterData::blocks[$nblocks] = {
+$blockRows
+};
+const unsigned char CharacterData::index[$nindex] = {
+$indexRows
+};
+
+}
+END
+print STDERR scalar(@records), " records, ", scalar(@blocks), " blocks\n";
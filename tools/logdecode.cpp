@@ -0,0 +1,18 @@
+#include <lang/System.hpp>
+#include <unistd.h>
+
+// prints the text of binary log files written in Logger binary mode
+int main(int argc, const char *argv[]) {
+	if (argc < 2) {
+		System::err.println("usage: logdecode <file>...");
+		return 1;
+	}
+	try {
+		for (int i = 1; i < argc; ++i) Logger::decodeBinary(argv[i], STDOUT_FILENO);
+	}
+	catch (const Exception& e) {
+		System::err.println(e.toString());
+		return 1;
+	}
+	return 0;
+}